@@ -35,6 +35,9 @@ bool Application::init(const int& width, const int& height) {
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
 	//1.2 OpenGLúģʽȾģʽ
 	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+	//1.3 Ȼ + 8λģ建 (ʹģ建)
+	glfwWindowHint(GLFW_DEPTH_BITS, 24);
+	glfwWindowHint(GLFW_STENCIL_BITS, 8);
 
 	//2 
 	mWindow = glfwCreateWindow(mWidth, mHeight, "OpenGLStudy", NULL, NULL);
@@ -92,9 +95,53 @@ void Application::destroy() {
 }
 
 void Application::getCursorPosition(double* x, double* y) {
+	//ַз¼ʱĹλã֤¼ʱһ
+	if (mDispatching) {
+		*x = mEventCursorX;
+		*y = mEventCursorY;
+		return;
+	}
 	glfwGetCursorPos(mWindow, x, y);
 }
 
+void Application::dispatchInput() {
+	mDispatching = true;
+
+	InputEvent event;
+	while (mInputQueue.pop(event)) {
+		mInputTime = event.time;
+
+		switch (event.type) {
+		case InputEventType::Key:
+			if (mKeyBoardCallback != nullptr) {
+				mKeyBoardCallback(event.code, event.action, event.mods);
+			}
+			break;
+		case InputEventType::MouseButton:
+			mEventCursorX = event.x;
+			mEventCursorY = event.y;
+			if (mMouseCallback != nullptr) {
+				mMouseCallback(event.code, event.action, event.mods);
+			}
+			break;
+		case InputEventType::Cursor:
+			mEventCursorX = event.x;
+			mEventCursorY = event.y;
+			if (mCursorCallback != nullptr) {
+				mCursorCallback(event.x, event.y);
+			}
+			break;
+		case InputEventType::Scroll:
+			if (mScrollCallback != nullptr) {
+				mScrollCallback(event.x);
+			}
+			break;
+		}
+	}
+
+	mDispatching = false;
+}
+
 
 void Application::frameBufferSizeCallback(GLFWwindow* window, int width, int height) {
 	std::cout << "Resize" << std::endl;
@@ -111,29 +158,50 @@ void Application::frameBufferSizeCallback(GLFWwindow* window, int width, int hei
 
 void Application::keyCallback(GLFWwindow* window, int key, int scancode, int action, int mods) {
 	Application* self = (Application*)glfwGetWindowUserPointer(window);
-	if (self->mKeyBoardCallback != nullptr) {
-		self->mKeyBoardCallback(key, action, mods);
-	}
+
+	//ֻӣȴdispatchInputͳһַ
+	InputEvent event;
+	event.type = InputEventType::Key;
+	event.time = glfwGetTime();
+	event.code = key;
+	event.action = action;
+	event.mods = mods;
+	self->mInputQueue.push(event);
 }
 
 void Application::mouseCallback(GLFWwindow* window, int button, int action, int mods) {
 	Application* self = (Application*)glfwGetWindowUserPointer(window);
-	if (self->mMouseCallback != nullptr) {
-		self->mMouseCallback(button, action, mods);
-	}
+
+	InputEvent event;
+	event.type = InputEventType::MouseButton;
+	event.time = glfwGetTime();
+	event.code = button;
+	event.action = action;
+	event.mods = mods;
+	//¼ʱĹλ
+	glfwGetCursorPos(window, &event.x, &event.y);
+	self->mInputQueue.push(event);
 }
 
 void Application::cursorCallback(GLFWwindow* window, double xpos, double ypos) {
 	Application* self = (Application*)glfwGetWindowUserPointer(window);
-	if (self->mCursorCallback != nullptr) {
-		self->mCursorCallback(xpos, ypos);
-	}
+
+	//߻رÿ֡ᴥܶΣлĹ¼ϲΪһ
+	InputEvent event;
+	event.type = InputEventType::Cursor;
+	event.time = glfwGetTime();
+	event.x = xpos;
+	event.y = ypos;
+	self->mInputQueue.push(event);
 }
 
-//Ϣxoffsetû
+//Ϣxoffsetû
 void Application::scrollCallback(GLFWwindow* window, double xoffset, double yoffset) {
 	Application* self = (Application*)glfwGetWindowUserPointer(window);
-	if (self->mScrollCallback != nullptr) {
-		self->mScrollCallback(yoffset);
-	}
+
+	InputEvent event;
+	event.type = InputEventType::Scroll;
+	event.time = glfwGetTime();
+	event.x = yoffset;
+	self->mInputQueue.push(event);
 }
@@ -25,9 +25,13 @@
 *				3.4 һKeyBoardCallback͵ĳԱ
 *				3.5 һSetKeyBoardCallbackĺ üӦص
 *				3.6 * ѧʹglfwUserPointer
+*		5	¼(InputQueue)
+*				5.1 glfwصֻѴʱ¼д
+*				5.2 ÿһ֡һdispatchInputͳһ˳ַص
 *
 */
 #include <iostream>
+#include "inputQueue.h"
 
 
 #define app Application::getInstance()
@@ -51,6 +55,10 @@ public:
 
 	bool update();
 
+	//ѱ֡۵ȫ¼ʱ˳Key/Mouse/Cursor/Scrollص
+	//ÿһģ֡һΣӦupdate֮update֮ǰ
+	void dispatchInput();
+
 	void destroy();
 
 
@@ -58,6 +66,10 @@ public:
 	uint32_t getHeight()const { return mHeight; }
 	void getCursorPosition(double* x, double* y);
 
+	//ǰڷַ¼ʱ̣룩ڷַʱΪһ¼ʱ
+	double getInputTime()const { return mInputTime; }
+	const InputQueue& getInputQueue()const { return mInputQueue; }
+
 	void setResizeCallback(ResizeCallback callback) { mResizeCallback = callback; }
 	void setKeyBoardCallback(KeyBoardCallback callback) { mKeyBoardCallback = callback; }
 	void setMouseCallback(MouseCallback callback) { mMouseCallback = callback; }
@@ -86,5 +98,12 @@ private:
 	CursorCallback mCursorCallback{ nullptr };
 	ScrollCallback mScrollCallback{ nullptr };
 
+	//¼
+	InputQueue mInputQueue;
+	bool mDispatching{ false };
+	double mInputTime{ 0.0 };
+	double mEventCursorX{ 0.0 };
+	double mEventCursorY{ 0.0 };
+
 	Application();
 };
@@ -47,8 +47,11 @@ void CameraControl::onKey(int key, int action, int mods) {
 	//1 ⰴ»̧𣬸һ
 	bool pressed = action == GLFW_PRESS ? true : false;
 
-	//2 ¼keyMap
-	mKeyMap[key] = pressed;
+	//2 ¼ڰλͼGLFW_KEY_UNKNOWN(-1)Խ簴ֱӺ
+	if (key < 0 || key > GLFW_KEY_LAST) {
+		return;
+	}
+	mKeyState.set(key, pressed);
 }
 
 void CameraControl::update() {
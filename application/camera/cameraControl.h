@@ -2,12 +2,12 @@
 
 #include "../../glframework/core.h"
 #include "camera.h"
-#include <map>//stl:map
+#include <bitset>//stl:bitset
 
 class CameraControl {
 public:
 	CameraControl();
-	~CameraControl();
+	virtual ~CameraControl();
 
 	//ڼ̳CameraControl࣬пܻʵԼ߼
 	virtual void onMouse(int button, int action, double xpos, double ypos);
@@ -22,6 +22,9 @@ public:
 	void setSensitivity(float s) { mSensitivity = s; }
 	void setScaleSpeed(float s) { mScaleSpeed = s; }
 
+	//ǰƶٶȣ絥λ/룩ɻƽĿupdateи£Ԥλ
+	glm::vec3 getVelocity() const { return mVelocity; }
+
 protected:
 	//1 갴״̬
 	bool mLeftMouseDown = false;
@@ -34,12 +37,15 @@ protected:
 	//3 ж
 	float mSensitivity = 0.2f;
 
-	//4 ¼ذİ״̬
-	std::map<int, bool> mKeyMap;
+	//4 ¼ذİ״ֱ̬Ϊ±꣬ƽλͼ
+	std::bitset<GLFW_KEY_LAST + 1> mKeyState;
 
 	//5 洢ǰƵһ
 	Camera* mCamera = nullptr;
 
 	//6 ¼ŵٶ
 	float mScaleSpeed = 0.2f;
+
+	//7 ƶٶȣ絥λ/룩
+	glm::vec3 mVelocity{ 0.0f };
 };
\ No newline at end of file
@@ -1,4 +1,17 @@
 #include "gameCameraControl.h"
+#include "../../glframework/collision/collisionWorld.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace {
+	//yСĽӴ棨Լ45ڵ£
+	constexpr float MIN_GROUND_NORMAL_Y = 0.7f;
+	//ٶȣٶȣԼ5룩
+	constexpr float MAX_FALL_SECONDS = 5.0f;
+	//泬ô౶۸ʱ䣬ͣԭӳл·ûκν
+	constexpr float MAX_FALL_PROBE = 200.0f;
+}
 
 GameCameraControl::GameCameraControl() {
 
@@ -40,32 +53,115 @@ void GameCameraControl::yaw(float angle) {
 }
 
 
+void GameCameraControl::setWalking(bool walking) {
+	mWalking = walking;
+	mGrounded = false;
+	mFallSpeed = 0.0f;
+}
+
+void GameCameraControl::levelCamera() {
+	glm::vec3 right = mCamera->mRight;
+	right.y = 0.0f;
+	mCamera->mRight = glm::length(right) > 1e-4f ? glm::normalize(right) : glm::vec3(1.0f, 0.0f, 0.0f);
+	mCamera->mUp = glm::vec3(0.0f, 1.0f, 0.0f);
+	mPitch = 0.0f;
+	mGrounded = false;
+	mFallSpeed = 0.0f;
+	mLastUpdateTime = glfwGetTime();
+}
+
 void GameCameraControl::update() {
+	double now = glfwGetTime();
+	double deltaTime = now - mLastUpdateTime;
+	mLastUpdateTime = now;
+
 	//ƶ
 	glm::vec3 direction(0.0f);
 
 	auto front = glm::cross(mCamera->mUp, mCamera->mRight);
 	auto right = mCamera->mRight;
+	//ʱֻˮƽƶͷ/̧ͷ
+	if (mWalking) {
+		front.y = 0.0f;
+		right.y = 0.0f;
+		front = glm::length(front) > 1e-4f ? glm::normalize(front) : glm::vec3(0.0f);
+		right = glm::length(right) > 1e-4f ? glm::normalize(right) : glm::vec3(0.0f);
+	}
 
-	if (mKeyMap[GLFW_KEY_W]) {
+	if (mKeyState.test(GLFW_KEY_W)) {
 		direction += front;
 	}
 
-	if (mKeyMap[GLFW_KEY_S]) {
+	if (mKeyState.test(GLFW_KEY_S)) {
 		direction -= front;
 	}
 
-	if (mKeyMap[GLFW_KEY_A]) {
+	if (mKeyState.test(GLFW_KEY_A)) {
 		direction -= right;
 	}
 
-	if (mKeyMap[GLFW_KEY_D]) {
+	if (mKeyState.test(GLFW_KEY_D)) {
 		direction += right;
 	}
 
 	//ʱdirectionпܲΪ1ĳȣҲп0ĳ
+	glm::vec3 offset(0.0f);
 	if (glm::length(direction) != 0) {
 		direction = glm::normalize(direction);
-		mCamera->mPosition += direction * mSpeed;
+		offset = direction * mSpeed;
+	}
+	if (mCollisionWorld) {
+		//ٵ֡ʱ0.1䣬һδ¥
+		offset = moveWithCollision(offset, static_cast<float>(std::clamp(deltaTime, 0.0, 0.1)));
 	}
+	mCamera->mPosition += offset;
+
+	//ÿupdateƶmSpeedÿٶ
+	mVelocity = deltaTime > 0.0 && deltaTime < 0.5 ? offset / static_cast<float>(deltaTime) : glm::vec3(0.0f);
+}
+
+glm::vec3 GameCameraControl::moveWithCollision(const glm::vec3& offset, float deltaTime) {
+	auto start = std::chrono::steady_clock::now();
+	const glm::vec3 up(0.0f, 1.0f, 0.0f);
+
+	//ʱײĵײŵƽʱľ۾
+	glm::vec3 eyeToCenter = mWalking ? -up * (mEyeHeight - mRadius) : glm::vec3(0.0f);
+	glm::vec3 center = mCamera->mPosition + eyeToCenter;
+	glm::vec3 target;
+	if (!mWalking) {
+		target = mCollisionWorld->moveSphere(center, mRadius, offset).position;
+	}
+	else {
+		//1 ̧һ̨ףˮƽƶʱ̨׵ϰ¥ݡ·أᵲס
+		glm::vec3 lifted = mCollisionWorld->moveSphere(center, mRadius, up * mStepHeight).position;
+		float liftedHeight = lifted.y - center.y;
+
+		//2 ˮƽƶǽʱǽ
+		glm::vec3 moved = mCollisionWorld->moveSphere(lifted, mRadius, offset).position;
+
+		//3 £̧ߵĸ߶ + վڵʱأ¥/£+ ʱ
+		float drop = liftedHeight;
+		if (mGrounded) {
+			mFallSpeed = 0.0f;
+			drop += mStepHeight;
+		}
+		else {
+			//·Զûеʱͣ
+			CollisionWorld::Hit ground;
+			if (mCollisionWorld->findGround(moved, mEyeHeight * MAX_FALL_PROBE, ground)) {
+				mFallSpeed = std::min(mFallSpeed + mGravity * deltaTime, mGravity * MAX_FALL_SECONDS);
+			}
+			else {
+				mFallSpeed = 0.0f;
+			}
+			drop += mFallSpeed * deltaTime;
+		}
+		//ֻһΣվʱ»
+		CollisionWorld::MoveResult down = mCollisionWorld->moveSphere(moved, mRadius, -up * drop, 1);
+		mGrounded = down.blocked && down.highestNormalY >= MIN_GROUND_NORMAL_Y;
+		target = down.position;
+	}
+
+	mCollisionMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+	return target - center;
 }
\ No newline at end of file
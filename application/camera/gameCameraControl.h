@@ -2,6 +2,8 @@
 
 #include "cameraControl.h"
 
+class CollisionWorld;
+
 class GameCameraControl :public CameraControl {
 public:
 	GameCameraControl();
@@ -12,11 +14,44 @@ public:
 
 	void setSpeed(float s) { mSpeed = s; }
 
+	//ײúΪһɨ뽨ײǽʱǽ滬nullptrʾɴСȨ
+	void setCollisionWorld(CollisionWorld* world) { mCollisionWorld = world; }
+	//ײ뾶۾ĸ߶ȣ絥λͬ
+	void setCollisionShape(float radius, float eyeHeight) { mRadius = radius; mEyeHeight = eyeHeight; }
+	//ֱ/µ̨׸߶
+	void setStepHeight(float h) { mStepHeight = h; }
+	//ٶȣ絥λ/^2
+	void setGravity(float g) { mGravity = g; }
+
+	//ģʽֻˮƽƶ䲢ŵ棨Ҫײ磩ɷУײʱȻײ
+	void setWalking(bool walking);
+	bool isWalking() const { return mWalking; }
+
+	//ˮƽ򡢸ǹ㣬лʱ
+	void levelCamera();
+
+	//һupdateײѯĺʱ΢룩
+	double getCollisionMicroseconds() const { return mCollisionMicroseconds; }
+
 private:
 	void pitch(float angle);
 	void yaw(float angle);
 
+	//ײ֡λoffsetʵʵλ
+	glm::vec3 moveWithCollision(const glm::vec3& offset, float deltaTime);
+
 private:
 	float mPitch{ 0.0f };
 	float mSpeed{ 0.1f };
+	double mLastUpdateTime{ 0.0 };
+
+	CollisionWorld* mCollisionWorld{ nullptr };
+	float mRadius{ 0.3f };
+	float mEyeHeight{ 1.7f };
+	float mStepHeight{ 0.35f };
+	float mGravity{ 9.81f };
+	bool mWalking{ false };
+	bool mGrounded{ false };	//һ֡Ƿվڵ
+	float mFallSpeed{ 0.0f };	//µٶ
+	double mCollisionMicroseconds{ 0.0 };
 };
\ No newline at end of file
@@ -11,6 +11,12 @@ public:
 
 	void scale(float deltaScale)override;
 
+	//ֱҰǶȣ
+	float getFovy() const { return mFovy; }
+
+	//Զƽ
+	float getFar() const { return mFar; }
+
 private:
 	float mFovy = 0.0f;
 	float mAspect = 0.0f;
@@ -0,0 +1,64 @@
+#include "inputQueue.h"
+
+InputQueue::InputQueue() {
+
+}
+
+InputQueue::~InputQueue() {
+
+}
+
+bool InputQueue::push(const InputEvent& event) {
+	//1 βͬ¼ϲ
+	//	ֻͽŵһ¼ϲ֤/갴ƶ֮Ⱥ˳򲻱
+	if (mCount > 0) {
+		InputEvent& last = mEvents[(mHead + mCount - 1) % CAPACITY];
+		if (last.type == event.type) {
+			if (event.type == InputEventType::Cursor) {
+				//λǾֵλüɣм
+				last.x = event.x;
+				last.y = event.y;
+				last.time = event.time;
+				last.merged += event.merged;
+				mCoalesced++;
+				return true;
+			}
+			if (event.type == InputEventType::Scroll) {
+				//ƫҪۼ
+				last.x += event.x;
+				last.y += event.y;
+				last.time = event.time;
+				last.merged += event.merged;
+				mCoalesced++;
+				return true;
+			}
+		}
+	}
+
+	//2 ¼
+	if (mCount == CAPACITY) {
+		mDropped++;
+		return false;
+	}
+
+	//3 дβ
+	mEvents[(mHead + mCount) % CAPACITY] = event;
+	mCount++;
+	return true;
+}
+
+bool InputQueue::pop(InputEvent& event) {
+	if (mCount == 0) {
+		return false;
+	}
+
+	event = mEvents[mHead];
+	mHead = (mHead + 1) % CAPACITY;
+	mCount--;
+	return true;
+}
+
+void InputQueue::clear() {
+	mHead = 0;
+	mCount = 0;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+/*
+*
+*Ŀ	   ꣺ ¼Уglfwص¼
+*˵	   
+*
+*		1	glfwصֻ¼д붨ζУʱֱ߼
+*		2	Ĺƶ¼ϲΪһֻλã¼ۼƫ
+*		3	ÿһģ֡ApplicationͳһһζУʱ˳ַص
+*		4	ʱ¼ڻصзڴ
+*
+*/
+#include <array>
+#include <cstdint>
+
+enum class InputEventType : uint8_t {
+	Key,
+	MouseButton,
+	Cursor,
+	Scroll
+};
+
+struct InputEvent {
+	InputEventType type{ InputEventType::Key };
+	double time{ 0.0 };		//¼ʱ̣glfwGetTime룩
+
+	//Keycode=keyMouseButtoncode=button
+	int code{ 0 };
+	int action{ 0 };
+	int mods{ 0 };
+
+	//CursorλãMouseButtonʱĹλãScrollxΪƫ
+	double x{ 0.0 };
+	double y{ 0.0 };
+
+	//ϲ¼ԭʼ¼ͳƣ
+	uint32_t merged{ 1 };
+};
+
+class InputQueue {
+public:
+	static constexpr uint32_t CAPACITY = 256;
+
+	InputQueue();
+	~InputQueue();
+
+	//д¼/¼βͬ¼ϲ
+	//falseʾ¼
+	bool push(const InputEvent& event);
+
+	//ʱ˳ȡ¼Ϊշfalse
+	bool pop(InputEvent& event);
+
+	void clear();
+
+	uint32_t size()const { return mCount; }
+	bool empty()const { return mCount == 0; }
+
+	//ͳϢۼƱϲ¼¼
+	uint64_t getCoalescedCount()const { return mCoalesced; }
+	uint64_t getDroppedCount()const { return mDropped; }
+
+private:
+	std::array<InputEvent, CAPACITY> mEvents;
+	uint32_t mHead{ 0 };	//±
+	uint32_t mCount{ 0 };	//ǰ¼
+
+	uint64_t mCoalesced{ 0 };
+	uint64_t mDropped{ 0 };
+};
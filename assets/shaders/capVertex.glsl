@@ -0,0 +1,23 @@
+#version 460 core
+//ڣƽϵһıΣgl_VertexIDɣҪ㻺 (ClipSet::drawCaps)
+
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+uniform vec3 capCenter;        // ı ()
+uniform vec3 capAxisU;         // ıε
+uniform vec3 capAxisV;
+uniform vec4 clipPlanes[6];    // ƽ棬ڵƽ汾ClipSetر
+
+out float gl_ClipDistance[6];
+
+const vec2 corners[4] = vec2[](vec2(-1.0, -1.0), vec2(1.0, -1.0), vec2(-1.0, 1.0), vec2(1.0, 1.0));
+
+void main()
+{
+	vec2 corner = corners[gl_VertexID];
+	vec4 position = vec4(capCenter + capAxisU * corner.x + capAxisV * corner.y, 1.0);
+	for (int i = 0; i < 6; ++i) {
+		gl_ClipDistance[i] = dot(clipPlanes[i], position);
+	}
+	gl_Position = projectionMatrix * viewMatrix * position;
+}
@@ -1,13 +1,31 @@
 #version 460 core
-out vec4 FragColor; // Ƭɫɫ
+layout(location = 0) out vec4 FragColor; // Ƭɫɫ (ȨOITۻͨΪȨԤɫ)
+layout(location = 1) out float Revealage; // ֻڼȨOITۻͨʹ (WeightedBlendedOit)Ĭ֡Դ
 
 // in vec3 color; // Ӷɫֵɫ (ʱʹ)
 in vec2 uv; // <<< Ӷɫֵ
+flat in int objectIndex; //  (Աек)-1ʾû
 
 uniform sampler2D sampler; // <<< uniform
+uniform float opacity; // ʵĲ͸ (d)ֻ͸ͨʱ
+uniform int oitPass; // 1: ȨOITۻͨ
+uniform int thematicColoring; // 1: Եרɫɫ (thematicColors.h)
+layout(std430, binding = 4) readonly buffer ObjectColors { vec4 objectColors[]; }; // ÿһɫalphaΪϱ
 
 void main()
 {
   FragColor = texture(sampler, uv); // <<< ʹΪɫ
+  FragColor.a *= opacity;
+  if (thematicColoring == 1 && objectIndex >= 0 && objectIndex < objectColors.length()) {
+    vec4 theme = objectColors[objectIndex];
+    FragColor.rgb = mix(FragColor.rgb, theme.rgb, theme.a);
+  }
   // FragColor = vec4(color, 1.0); // ʹöɫʹ
-}
\ No newline at end of file
+  if (oitPass == 1) {
+    // Ȩȵݼ͸ڼȨƽռ (McGuire & Bavoil 2013, ʽ10ı)
+    float alpha = FragColor.a;
+    float weight = clamp(alpha * max(1e-2, 3e3 * pow(1.0 - gl_FragCoord.z, 3.0)), 1e-2, 3e3);
+    FragColor = vec4(FragColor.rgb * alpha, alpha) * weight;
+    Revealage = alpha;
+  }
+}
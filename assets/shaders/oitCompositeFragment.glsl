@@ -0,0 +1,22 @@
+#version 460 core
+out vec4 FragColor;
+
+uniform sampler2D accumulation; // ȨԤɫ֮ (rgb) ͼȨĲ͸֮ (a)
+uniform sampler2D revealage;    // ͸͸֮
+
+void main()
+{
+	ivec2 pixel = ivec2(gl_FragCoord.xy);
+	float reveal = texelFetch(revealage, pixel, 0).r;
+	if (reveal >= 1.0) {
+		discard; // û͸㸲ǣ
+	}
+	vec4 accum = texelFetch(accumulation, pixel, 0);
+	// 뾫ۻΪinfʱһ
+	if (isinf(max(max(abs(accum.r), abs(accum.g)), abs(accum.b)))) {
+		accum.rgb = vec3(accum.a);
+	}
+	vec3 average = accum.rgb / max(accum.a, 1e-5);
+	//  1 - reveal ϵ (ϺSRC_ALPHA, ONE_MINUS_SRC_ALPHA)
+	FragColor = vec4(average, 1.0 - reveal);
+}
@@ -0,0 +1,9 @@
+#version 460 core
+//ȨOITĺϳͨĻΣgl_VertexIDɣҪ㻺 (WeightedBlendedOit::composite)
+//ɼԻķͨͺϳҲʹ (VisibilityBuffer::classifycomposite)
+
+void main()
+{
+	vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2) * 2.0 - 1.0;
+	gl_Position = vec4(position, 0.0, 1.0);
+}
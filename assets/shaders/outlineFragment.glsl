@@ -0,0 +1,9 @@
+#version 460 core
+out vec4 FragColor;
+
+uniform vec3 outlineColor; // ɫ
+
+void main()
+{
+	FragColor = vec4(outlineColor, 1.0);
+}
@@ -0,0 +1,37 @@
+#version 460 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec4 aNormalA; // ķߣwΪ1ʾ (ۺۡʱ߽硢ű߽)
+layout (location = 2) in vec3 aNormalB; // һķ
+
+uniform mat4 transform;
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+uniform mat3 normalMatrix;     // transformת
+uniform vec3 cameraPosition;   // ռ
+uniform float depthBias;       // ߶ȳͻ (NDC)
+uniform vec4 clipPlanes[6];    // ƽ (꣬ClipSet)
+
+//ü0~5Ϊƽ棬6Ϊж
+out float gl_ClipDistance[7];
+
+//ǻƣ⻬ֻһ泯һʱ
+//òüGPUϲõ (˵жϲͬʱֻһĲ)
+void main()
+{
+	vec4 worldPosition = transform * vec4(aPos, 1.0);
+	for (int i = 0; i < 6; ++i) {
+		gl_ClipDistance[i] = dot(clipPlanes[i], worldPosition);
+	}
+	if (aNormalA.w > 0.5) {
+		gl_ClipDistance[6] = 1.0;
+	}
+	else {
+		vec3 toCamera = cameraPosition - worldPosition.xyz;
+		float facingA = dot(normalMatrix * aNormalA.xyz, toCamera);
+		float facingB = dot(normalMatrix * aNormalB, toCamera);
+		gl_ClipDistance[6] = -facingA * facingB;
+	}
+	vec4 position = projectionMatrix * viewMatrix * worldPosition;
+	position.z -= depthBias * position.w;
+	gl_Position = position;
+}
@@ -0,0 +1,71 @@
+#version 460 core
+//ɱ̶ȡûжԣӹSSBOаgl_VertexIDȡ (GeometryArena)
+//Ƭɫͨ·ͬ (fragment.glsl)ɼͨʹvisibilityFragment.glsl
+
+layout (location = 0) in uint aDrawIndex; // ƱţÿʵԣɼbaseInstanceѡ
+
+struct DrawRecord {
+	uint vertexOffset;  // vertexWordsе ()
+	uint indexOffset;   // indexWordsе ()
+	uint format;        // FORMAT_COMPACT | FORMAT_INDEX16
+	uint transform;     // transformsе±
+	uint firstIndex;    // ǰLODĵһ (ɼԻĽͨʹ)
+	uint material;      // ֡Ĳ (ͬ)
+	uint objectId;      //  (רɫ)0xFFFFFFFFʾû
+	uint reserved;
+};
+
+layout (std430, binding = 0) readonly buffer VertexWords { uint vertexWords[]; };
+layout (std430, binding = 1) readonly buffer IndexWords { uint indexWords[]; };
+layout (std430, binding = 2) readonly buffer DrawRecords { DrawRecord draws[]; };
+layout (std430, binding = 3) readonly buffer Transforms { mat4 transforms[]; };
+
+const uint FORMAT_COMPACT = 1u;  // pack::CompactVertex (4)ΪPosXYZ + UV (5float)
+const uint FORMAT_INDEX16 = 2u;  // 16λһ
+
+out vec2 uv;
+flat out uint drawIndex; // ɼͨдŻ
+flat out int objectIndex; // ţvertex.glslͬ
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+uniform vec4 clipPlanes[6];    // ƽ (꣬ClipSet)δ򿪵Ĳü벻
+
+out float gl_ClipDistance[6];
+
+void main()
+{
+	DrawRecord draw = draws[aDrawIndex];
+	drawIndex = aDrawIndex;
+	objectIndex = int(draw.objectId);
+
+	// 1. gl_VertexID = first + ţMeshеλ
+	uint i = uint(gl_VertexID);
+	uint index;
+	if ((draw.format & FORMAT_INDEX16) != 0u) {
+		uint word = indexWords[draw.indexOffset + (i >> 1)];
+		index = (i & 1u) != 0u ? (word >> 16) : (word & 0xFFFFu);
+	}
+	else {
+		index = indexWords[draw.indexOffset + i];
+	}
+
+	// 2. 㣺ʽλú
+	vec3 localPosition;
+	if ((draw.format & FORMAT_COMPACT) != 0u) {
+		// λΪunorm16 (transformеĶ任ԭ)Ϊhalf
+		uint base = draw.vertexOffset + index * 4u;
+		localPosition = vec3(unpackUnorm2x16(vertexWords[base]), unpackUnorm2x16(vertexWords[base + 1u]).x);
+		uv = unpackHalf2x16(vertexWords[base + 3u]);
+	}
+	else {
+		uint base = draw.vertexOffset + index * 5u;
+		localPosition = uintBitsToFloat(uvec3(vertexWords[base], vertexWords[base + 1u], vertexWords[base + 2u]));
+		uv = uintBitsToFloat(uvec2(vertexWords[base + 3u], vertexWords[base + 4u]));
+	}
+
+	vec4 position = transforms[draw.transform] * vec4(localPosition, 1.0);
+	for (int c = 0; c < 6; ++c) {
+		gl_ClipDistance[c] = dot(clipPlanes[c], position);
+	}
+	gl_Position = projectionMatrix * viewMatrix * position;
+}
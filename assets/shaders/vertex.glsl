@@ -4,16 +4,25 @@ layout (location = 2) in vec2 aUV
 ;
 
 out vec2 uv;
+flat out int objectIndex; // ţרɫʱƬɫɫ
 uniform mat4 transform;
 uniform mat4 viewMatrix;
 uniform mat4 projectionMatrix;
+uniform int objectId;         // ģ͵Ľ (Model::setObjectId)-1ʾû
+uniform vec4 clipPlanes[6];    // ƽ (꣬ClipSet)δ򿪵Ĳü벻
+
+out float gl_ClipDistance[6];
 
 //aPosΪattributeԣshader
 //ĵ
 void main()
 {
-	vec4 position = vec4(aPos, 1.0);
-	position = projectionMatrix * viewMatrix * transform * position;
+	vec4 position = transform * vec4(aPos, 1.0);
+	for (int i = 0; i < 6; ++i) {
+		gl_ClipDistance[i] = dot(clipPlanes[i], position);
+	}
+	position = projectionMatrix * viewMatrix * position;
 	gl_Position = position;
 	uv = aUV;               // <<< Ƭɫ
+	objectIndex = objectId;
 }
\ No newline at end of file
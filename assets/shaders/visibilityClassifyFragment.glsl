@@ -0,0 +1,28 @@
+#version 460 core
+//ɼԻķͨÿصĲдɲ (ɫΪoitCompositeVertex.glslVisibilityBuffer::classify)
+//ضֵ1
+
+struct DrawRecord {
+	uint vertexOffset;
+	uint indexOffset;
+	uint format;
+	uint transform;
+	uint firstIndex;
+	uint material;      // ֡Ĳ
+	uint objectId;
+	uint reserved;
+};
+
+layout (std430, binding = 2) readonly buffer DrawRecords { DrawRecord draws[]; };
+
+uniform usampler2D visibilityIds;   // x = Ʊ + 1 (0ʾ)y = ͼԪ
+
+void main()
+{
+	uint drawId = texelFetch(visibilityIds, ivec2(gl_FragCoord.xy), 0).x;
+	if (drawId == 0u) {
+		discard;
+	}
+	// VisibilityBuffer::materialDepthһ
+	gl_FragDepth = float(draws[drawId - 1u].material + 1u) * (1.0 / 1048576.0);
+}
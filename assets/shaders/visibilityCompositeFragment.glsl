@@ -0,0 +1,19 @@
+#version 460 core
+//ɼԻĺϳɣѽͨɫͿɼͨдصǰ֡ (ɫΪoitCompositeVertex.glslVisibilityBuffer::composite)
+//֮ǰֱӻƵMeshȲ
+
+out vec4 FragColor;
+
+uniform usampler2D visibilityIds;   // x = Ʊ + 1 (0ʾ)
+uniform sampler2D visibilityDepth;
+uniform sampler2D resolvedColor;
+
+void main()
+{
+	ivec2 pixel = ivec2(gl_FragCoord.xy);
+	if (texelFetch(visibilityIds, pixel, 0).x == 0u) {
+		discard; // ûм壬
+	}
+	FragColor = texelFetch(resolvedColor, pixel, 0);
+	gl_FragDepth = texelFetch(visibilityDepth, pixel, 0).r;
+}
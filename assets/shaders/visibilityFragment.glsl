@@ -0,0 +1,13 @@
+#version 460 core
+//ɼԻĿɼֻͨд (Ʊ + 1, ͼԪ)ɹ̶д (VisibilityBuffer)
+//ɫΪpullingVertex.glsl
+
+layout(location = 0) out uvec2 VisibilityId;
+
+flat in uint drawIndex;
+
+void main()
+{
+	// 0ʾԻƱż1
+	VisibilityId = uvec2(drawIndex + 1u, uint(gl_PrimitiveID));
+}
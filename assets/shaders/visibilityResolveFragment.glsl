@@ -0,0 +1,113 @@
+#version 460 core
+//ɼԻĽͨÿʻһȫ (ɫΪvisibilityResolveVertex.glslGeometryArena::resolveVisibility)
+//ȵGL_EQUALԱֻ֤ڵǰʵбɫҲдȣǰȲʼЧ
+//ص (Ʊ, ͼԪ) ӹSSBOȡΣؽ͸У󰴲ɫ
+//pullingVertex.glslһ£ɫfragment.glslһ
+
+layout(early_fragment_tests) in;
+
+layout(location = 0) out vec4 FragColor;
+
+struct DrawRecord {
+	uint vertexOffset;
+	uint indexOffset;
+	uint format;
+	uint transform;
+	uint firstIndex;    // ǰLODĵһ
+	uint material;      // ֡Ĳ
+	uint objectId;      //  (רɫ)
+	uint reserved;
+};
+
+layout (std430, binding = 0) readonly buffer VertexWords { uint vertexWords[]; };
+layout (std430, binding = 1) readonly buffer IndexWords { uint indexWords[]; };
+layout (std430, binding = 2) readonly buffer DrawRecords { DrawRecord draws[]; };
+layout (std430, binding = 3) readonly buffer Transforms { mat4 transforms[]; };
+layout (std430, binding = 4) readonly buffer ObjectColors { vec4 objectColors[]; }; // ObjectColorBuffer
+
+const uint FORMAT_COMPACT = 1u;
+const uint FORMAT_INDEX16 = 2u;
+
+uniform usampler2D visibilityIds;   // x = Ʊ + 1 (زͨȲ)y = ͼԪ
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+
+uniform sampler2D sampler;
+uniform float opacity;
+uniform int thematicColoring;       // 1: objectColorsɫ
+
+uint fetchIndex(DrawRecord draw, uint i)
+{
+	if ((draw.format & FORMAT_INDEX16) != 0u) {
+		uint word = indexWords[draw.indexOffset + (i >> 1)];
+		return (i & 1u) != 0u ? (word >> 16) : (word & 0xFFFFu);
+	}
+	return indexWords[draw.indexOffset + i];
+}
+
+void fetchVertex(DrawRecord draw, uint index, out vec3 localPosition, out vec2 texCoord)
+{
+	if ((draw.format & FORMAT_COMPACT) != 0u) {
+		uint base = draw.vertexOffset + index * 4u;
+		localPosition = vec3(unpackUnorm2x16(vertexWords[base]), unpackUnorm2x16(vertexWords[base + 1u]).x);
+		texCoord = unpackHalf2x16(vertexWords[base + 3u]);
+	}
+	else {
+		uint base = draw.vertexOffset + index * 5u;
+		localPosition = uintBitsToFloat(uvec3(vertexWords[base], vertexWords[base + 1u], vertexWords[base + 2u]));
+		texCoord = uintBitsToFloat(uvec2(vertexWords[base + 3u], vertexWords[base + 4u]));
+	}
+}
+
+// Ļp (NDC) ͸У
+vec3 barycentrics(vec4 c0, vec4 c1, vec4 c2, vec2 p)
+{
+	// ⣺ÿ㣬lambda_i / w_i Ļռ
+	vec2 n0 = c0.xy / c0.w;
+	vec2 n1 = c1.xy / c1.w;
+	vec2 n2 = c2.xy / c2.w;
+	float area = (n1.x - n0.x) * (n2.y - n0.y) - (n2.x - n0.x) * (n1.y - n0.y);
+	float b1 = ((p.x - n0.x) * (n2.y - n0.y) - (n2.x - n0.x) * (p.y - n0.y)) / area;
+	float b2 = ((n1.x - n0.x) * (p.y - n0.y) - (p.x - n0.x) * (n1.y - n0.y)) / area;
+	vec3 screen = vec3(1.0 - b1 - b2, b1, b2);
+	vec3 perspective = screen / vec3(c0.w, c1.w, c2.w);
+	return perspective / (perspective.x + perspective.y + perspective.z);
+}
+
+void main()
+{
+	ivec2 pixel = ivec2(gl_FragCoord.xy);
+	uvec2 id = texelFetch(visibilityIds, pixel, 0).xy;
+	DrawRecord draw = draws[id.x - 1u];
+
+	// 1. ȡΣͼԪŶӦǰLODеĵڼ
+	uint first = draw.firstIndex + id.y * 3u;
+	vec3 p0, p1, p2;
+	vec2 t0, t1, t2;
+	fetchVertex(draw, fetchIndex(draw, first), p0, t0);
+	fetchVertex(draw, fetchIndex(draw, first + 1u), p1, t1);
+	fetchVertex(draw, fetchIndex(draw, first + 2u), p2, t2);
+	mat4 toClip = projectionMatrix * viewMatrix * transforms[draw.transform];
+	vec4 c0 = toClip * vec4(p0, 1.0);
+	vec4 c1 = toClip * vec4(p1, 1.0);
+	vec4 c2 = toClip * vec4(p2, 1.0);
+
+	// 2. غҲࡢϷصֵ꣬õĵ (mipmap)
+	vec2 texel = 2.0 / vec2(textureSize(visibilityIds, 0));
+	vec2 ndc = gl_FragCoord.xy * texel - 1.0;
+	vec3 b = barycentrics(c0, c1, c2, ndc);
+	vec3 bx = barycentrics(c0, c1, c2, ndc + vec2(texel.x, 0.0));
+	vec3 by = barycentrics(c0, c1, c2, ndc + vec2(0.0, texel.y));
+	vec2 uv = mat3x2(t0, t1, t2) * b;
+	vec2 uvx = mat3x2(t0, t1, t2) * bx;
+	vec2 uvy = mat3x2(t0, t1, t2) * by;
+
+	// 3. fragment.glslͬɫںϳʱд
+	FragColor = textureGrad(sampler, uv, uvx - uv, uvy - uv);
+	FragColor.a *= opacity;
+	int objectIndex = int(draw.objectId);
+	if (thematicColoring == 1 && objectIndex >= 0 && objectIndex < objectColors.length()) {
+		vec4 theme = objectColors[objectIndex];
+		FragColor.rgb = mix(FragColor.rgb, theme.rgb, theme.a);
+	}
+}
@@ -0,0 +1,12 @@
+#version 460 core
+//ɼԻͨȫ (GeometryArena::resolveVisibility)
+//ȺΪǰʵĲȣͨдGL_EQUALԣֻʵͨ
+
+uniform float materialDepth;        // VisibilityBuffer::materialDepthڿռ
+
+void main()
+{
+	vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2) * 2.0 - 1.0;
+	// ĬȷΧ [0, 1] = NDC * 0.5 + 0.5materialDepth2^-20û
+	gl_Position = vec4(position, materialDepth * 2.0 - 1.0, 1.0);
+}
@@ -0,0 +1,138 @@
+#include "assetPipeline.h"
+#include "../texture.h"
+#include "../pack/assetPack.h"
+
+#include <iostream>
+#include <memory>
+
+AssetPipeline* AssetPipeline::mInstance = nullptr;
+
+AssetPipeline* AssetPipeline::getInstance() {
+    if (mInstance == nullptr) {
+        mInstance = new AssetPipeline();
+    }
+    return mInstance;
+}
+
+void AssetPipeline::load(const std::string& filePath, const std::string& textureBaseDir, ModelCallback callback) {
+    m_pending.fetch_add(1, std::memory_order_acq_rel);
+    if (filePath.size() >= 4 && filePath.compare(filePath.size() - 4, 4, ".pak") == 0) {
+        spawn(loadPackedModel(filePath, std::move(callback)));
+        return;
+    }
+    spawn(loadModel(filePath, textureBaseDir, std::move(callback)));
+}
+
+Task<void> AssetPipeline::loadPackedModel(std::string filePath, ModelCallback callback) {
+    AssetScheduler* scheduler = AssetScheduler::getInstance();
+
+    // 0. һμǰGL߳ϲѯֵ֧ʽ֮߳̿ǰֵ֧ͼ
+    if (!AssetPack::isDriverSupportKnown()) {
+        co_await scheduler->nextGLFrame();
+        AssetPack::queryDriverSupport();
+    }
+
+    // 1. 򿪲ӳԴȡѹģͺõͼ (߳)
+    co_await scheduler->switchToWorker();
+    std::unique_ptr<AssetPack> assetPack = std::make_unique<AssetPack>();
+    AssetPack::PreparedModel prepared;
+    bool ok = false;
+    if (assetPack->open(filePath)) {
+        const pack::PackEntry* entry = assetPack->findFirst(pack::EntryType::CompactModel);
+        if (entry == nullptr) {
+            entry = assetPack->findFirst(pack::EntryType::Model);
+        }
+        ok = entry != nullptr && assetPack->prepareModel(assetPack->getName(*entry), prepared);
+    }
+
+    // 2. GLԴ (GL߳)δѹĶ//ֱӴӳڴϴ֮ͲҪ
+    co_await scheduler->nextGLFrame();
+    Model* model = ok ? assetPack->createModel(prepared) : nullptr;
+    if (model == nullptr) {
+        std::cerr << "ERROR: No model could be loaded from asset pack: " << filePath << std::endl;
+    }
+    assetPack->close();
+    m_pending.fetch_sub(1, std::memory_order_acq_rel);
+    if (callback) {
+        callback(model);
+    }
+    else {
+        delete model;
+    }
+}
+
+Task<void> AssetPipeline::loadModel(std::string filePath, std::string textureBaseDir, ModelCallback callback) {
+    AssetScheduler* scheduler = AssetScheduler::getInstance();
+
+    // ȡOBJļڵĿ¼ڼMTLļ
+    std::string objBaseDir = filePath.substr(0, filePath.find_last_of("/\\") + 1);
+    std::string texDir = textureBaseDir.empty() ? objBaseDir + "materials_textures/" : textureBaseDir;
+
+    ModelData data;
+    std::vector<MaterialData> materials;
+    bool ok = false;
+    {
+        // 1. ȡOBJļ (I/O߳)
+        FileData objFile = co_await scheduler->readFile(filePath);
+
+        // 2.  (߳)
+        if (objFile.ok) {
+            co_await scheduler->switchToWorker();
+            ok = Model::parseObj(objFile.view(), filePath, data);
+            if (ok) {
+                Model::buildOutlines(data); // ߺײҲڹ߳
+                Model::buildCollisionMesh(data);
+            }
+        }
+    }
+
+    if (ok && !data.mtlLibName.empty()) {
+        // 3. ȡʿ
+        FileData mtlFile = co_await scheduler->readFile(objBaseDir + data.mtlLibName);
+        if (mtlFile.ok) {
+            co_await scheduler->switchToWorker();
+            materials = Material::parseMtl(mtlFile.view(), texDir);
+        }
+
+        // 4. ͼжȡͽ
+        std::vector<Task<void>> textureTasks;
+        for (MaterialData& material : materials) {
+            if (!material.diffuseTexturePath.empty()) {
+                textureTasks.push_back(decodeTexture(material));
+            }
+        }
+        co_await scheduler->whenAll(textureTasks);
+    }
+
+    // 5. GLԴ (GL߳)
+    co_await scheduler->nextGLFrame();
+    Model* model = nullptr;
+    if (ok) {
+        model = new Model(filePath, std::move(data), std::move(materials));
+        std::cout << "Model '" << filePath << "' loaded asynchronously." << std::endl;
+    }
+    else {
+        std::cerr << "ERROR: Model could not be loaded or is empty: " << filePath << std::endl;
+    }
+    m_pending.fetch_sub(1, std::memory_order_acq_rel);
+    if (callback) {
+        callback(model);
+    }
+    else {
+        delete model;
+    }
+}
+
+Task<void> AssetPipeline::decodeTexture(MaterialData& material) {
+    AssetScheduler* scheduler = AssetScheduler::getInstance();
+
+    FileData imageFile = co_await scheduler->readFile(material.diffuseTexturePath);
+    if (imageFile.ok) {
+        co_await scheduler->switchToWorker();
+        Texture::decode(reinterpret_cast<const unsigned char*>(imageFile.bytes.data()), imageFile.bytes.size(), material.diffuseImage);
+    }
+    if (material.diffuseImage.empty()) {
+        // ȡʧܣ·GL߳ϴMaterialʱͬһ
+        material.diffuseTexturePath.clear();
+    }
+}
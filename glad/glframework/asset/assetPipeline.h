@@ -0,0 +1,55 @@
+#pragma once
+
+#include "assetScheduler.h"
+#include "../model.h"         // ModelData / Model
+#include "../material.h"      // MaterialData
+
+#include <atomic>             // std::atomic
+#include <functional>         // std::function
+#include <string>             // std::string
+
+// AssetPipeline첽ģͼˮߣȫΨһ
+// һģ͵дһЭ̣˳д׶Զɵʵ̣߳
+//   ȡOBJ (I/O߳) -> 뼸δ (߳)
+//   -> ȡMTL (I/O߳) ->  (߳)
+//   -> жȡͼ (I/O߳ + ̣߳fork-join)
+//   -> GLԴ (GḶ߳ÿ֡ʱԤ)
+// ͬʱصĶģ֮以ȴI/OCPUGPUϴύУѭض
+// ʹǰ᣺ѭÿ֡ AssetScheduler::getInstance()->pumpGLQueue(...)
+class AssetPipeline {
+public:
+    // ɵĻصGL߳ϵãʧʱmodelΪnullptr
+    // صӹmodelȨ
+    using ModelCallback = std::function<void(Model* model)>;
+
+    ~AssetPipeline() = default;
+
+    static AssetPipeline* getInstance();
+
+    // 첽һOBJģͣء
+    // - filePath: OBJļ·".pak"βʱΪtools/modelConverterɵԴ򿪣
+    //   ذеĵһģ (ҪͼδtextureBaseDir)
+    // - textureBaseDir: Ŀ¼ΪʱʹOBJļĿ¼µ "materials_textures/" (Model캯һ)
+    // - callback: ɺGL߳ϵá
+    void load(const std::string& filePath, const std::string& textureBaseDir, ModelCallback callback);
+
+    // ڼصģ
+    size_t getPendingCount() const { return m_pending.load(std::memory_order_acquire); }
+
+private:
+    AssetPipeline() = default;
+
+    // һģ͵
+    Task<void> loadModel(std::string filePath, std::string textureBaseDir, ModelCallback callback);
+
+    // Դģͣڹ߳ϴ򿪲ӳѹĿGLֻ߳Դ
+    Task<void> loadPackedModel(std::string filePath, ModelCallback callback);
+
+    // ȡһʵͼдmaterial.diffuseImage
+    static Task<void> decodeTexture(MaterialData& material);
+
+private:
+    static AssetPipeline* mInstance;
+
+    std::atomic<size_t> m_pending{ 0 };
+};
@@ -0,0 +1,170 @@
+#include "assetScheduler.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+
+AssetScheduler* AssetScheduler::mInstance = nullptr;
+
+AssetScheduler* AssetScheduler::getInstance() {
+    if (mInstance == nullptr) {
+        mInstance = new AssetScheduler();
+    }
+    return mInstance;
+}
+
+AssetScheduler::AssetScheduler() {
+    for (size_t i = 0; i < IO_THREAD_COUNT; ++i) {
+        m_ioThreads.emplace_back(&AssetScheduler::ioLoop, this);
+    }
+}
+
+AssetScheduler::~AssetScheduler() {
+    shutdown();
+}
+
+void AssetScheduler::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_ioMutex);
+        if (!m_running) {
+            return;
+        }
+        m_running = false;
+    }
+    m_ioCondition.notify_all();
+    for (std::thread& thread : m_ioThreads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    m_ioThreads.clear();
+
+    // δɵļЭ̲ٻָ
+    std::lock_guard<std::mutex> lock(m_glMutex);
+    size_t abandoned = m_ioRequests.size() + m_glQueue.size();
+    if (abandoned > 0) {
+        std::cerr << "WARNING: AssetScheduler shut down with " << abandoned << " pending asset step(s)." << std::endl;
+    }
+    m_ioRequests.clear();
+    m_glQueue.clear();
+}
+
+// --- ļȡ ---
+
+AssetScheduler::ReadFileAwaiter AssetScheduler::readFile(const std::string& path) {
+    ReadFileAwaiter awaiter{ this, FileData() };
+    awaiter.result.path = path;
+    return awaiter;
+}
+
+void AssetScheduler::ReadFileAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    {
+        std::lock_guard<std::mutex> lock(scheduler->m_ioMutex);
+        scheduler->m_ioRequests.push_back({ &result, handle });
+    }
+    scheduler->m_ioCondition.notify_one();
+}
+
+void AssetScheduler::ioLoop() {
+    while (true) {
+        IoRequest request;
+        {
+            std::unique_lock<std::mutex> lock(m_ioMutex);
+            m_ioCondition.wait(lock, [this]() { return !m_running || !m_ioRequests.empty(); });
+            if (!m_running) {
+                return;
+            }
+            request = m_ioRequests.front();
+            m_ioRequests.pop_front();
+        }
+
+        // һԶȡļ
+        FileData& file = *request.result;
+        std::ifstream stream(file.path, std::ios::binary | std::ios::ate);
+        if (stream.is_open()) {
+            std::streamsize size = stream.tellg();
+            stream.seekg(0);
+            file.bytes.resize(static_cast<size_t>(size));
+            file.ok = static_cast<bool>(stream.read(file.bytes.data(), size));
+        }
+        if (!file.ok) {
+            std::cerr << "ERROR: Could not read file: " << file.path << std::endl;
+            file.bytes.clear();
+        }
+
+        // I/Oֻ߳I/OĴ߳
+        std::coroutine_handle<> handle = request.handle;
+        JobSystem::getInstance()->run([handle]() { handle.resume(); });
+    }
+}
+
+// --- ߳ ---
+
+void AssetScheduler::WorkerAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    JobSystem::getInstance()->run([handle]() { handle.resume(); }, nullptr, priority);
+}
+
+// --- GL߳ ---
+
+void AssetScheduler::GLFrameAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    std::lock_guard<std::mutex> lock(scheduler->m_glMutex);
+    scheduler->m_glQueue.push_back(handle);
+}
+
+size_t AssetScheduler::pumpGLQueue(double budgetMs) {
+    auto start = std::chrono::steady_clock::now();
+
+    // ֻ֡ʼʱѾŶӵЭ
+    size_t queued = getGLQueueSize();
+    size_t resumed = 0;
+    while (resumed < queued) {
+        std::coroutine_handle<> handle;
+        {
+            std::lock_guard<std::mutex> lock(m_glMutex);
+            if (m_glQueue.empty()) {
+                break;
+            }
+            handle = m_glQueue.front();
+            m_glQueue.pop_front();
+        }
+        handle.resume();
+        ++resumed;
+
+        // ٻָһⵥϴԤʱԶòִ
+        double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (elapsedMs >= budgetMs) {
+            break;
+        }
+    }
+    return resumed;
+}
+
+size_t AssetScheduler::getGLQueueSize() {
+    std::lock_guard<std::mutex> lock(m_glMutex);
+    return m_glQueue.size();
+}
+
+// --- fork-join ---
+
+bool AssetScheduler::WhenAllAwaiter::await_suspend(std::coroutine_handle<> handle) {
+    m_parent = handle;
+    // һΣ֤֮ǰᱻָ
+    m_remaining.store(m_tasks.size() + 1, std::memory_order_relaxed);
+    for (Task<void>& task : m_tasks) {
+        Task<void>* taskPtr = &task;
+        JobSystem::getInstance()->run([taskPtr, this]() { runAndSignal(*taskPtr, this); });
+    }
+    // ѾڼʱֱӼ
+    return m_remaining.fetch_sub(1, std::memory_order_acq_rel) != 1;
+}
+
+taskDetail::DetachedTask AssetScheduler::WhenAllAwaiter::runAndSignal(Task<void>& task, WhenAllAwaiter* awaiter) {
+    co_await task;
+    awaiter->signal();
+}
+
+void AssetScheduler::WhenAllAwaiter::signal() {
+    if (m_remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        m_parent.resume();
+    }
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "task.h"
+#include "../job/jobSystem.h" // Э̵CPU׶JobSystemĹִ߳
+
+#include <atomic>             // std::atomic
+#include <condition_variable> // I/O̵߳ȴ
+#include <deque>              // 
+#include <mutex>              // std::mutex
+#include <string>             // std::string
+#include <string_view>        // std::string_view
+#include <thread>             // I/O߳
+#include <vector>             // std::vector
+
+// һļȡĽ
+struct FileData {
+    std::string path;
+    std::vector<char> bytes;
+    bool ok = false;    // ļǷɹ򿪲
+
+    std::string_view view() const { return std::string_view(bytes.data(), bytes.size()); }
+};
+
+// AssetSchedulerԴЭ̵ĵȫΨһ
+// ṩȴ壬һˮߵĸ׶ηɵʵ߳ϣ
+// - readFile(path): רI/O߳϶ȡļڹ߳ϻָЭ̣
+// - switchToWorker(): лJobSystemĹ߳ϼִ (CPU׶)
+// - nextGLFrame(): GL̵߳ĶУѭpumpGLQueue()ʱָ (GPUϴ׶)
+// ټwhenAll()Զfork-joinЭ̴˳д
+// ɰǧԴI/OCPUGPUϴԶС
+class AssetScheduler {
+public:
+    ~AssetScheduler();
+
+    static AssetScheduler* getInstance();
+
+    // --- ȴ ---
+
+    struct ReadFileAwaiter {
+        AssetScheduler* scheduler;
+        FileData result;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle);
+        FileData await_resume() { return std::move(result); }
+    };
+
+    struct WorkerAwaiter {
+        JobPriority priority;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle);
+        void await_resume() const noexcept {}
+    };
+
+    struct GLFrameAwaiter {
+        AssetScheduler* scheduler;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> handle);
+        void await_resume() const noexcept {}
+    };
+
+    // ȴһȫɣÿΪһ߳һɵָȴ
+    class WhenAllAwaiter {
+    public:
+        explicit WhenAllAwaiter(std::vector<Task<void>>& tasks) : m_tasks(tasks) {}
+
+        bool await_ready() const noexcept { return m_tasks.empty(); }
+        bool await_suspend(std::coroutine_handle<> handle);
+        void await_resume() const noexcept {}
+
+    private:
+        static taskDetail::DetachedTask runAndSignal(Task<void>& task, WhenAllAwaiter* awaiter);
+        void signal();
+
+        std::vector<Task<void>>& m_tasks;
+        std::atomic<size_t> m_remaining{ 0 };
+        std::coroutine_handle<> m_parent;
+    };
+
+    // I/O߳϶ȡļ
+    ReadFileAwaiter readFile(const std::string& path);
+
+    // л߳
+    WorkerAwaiter switchToWorker(JobPriority priority = JobPriority::Normal) { return WorkerAwaiter{ priority }; }
+
+    // һpumpGLQueue()GL߳ϻָ
+    GLFrameAwaiter nextGLFrame() { return GLFrameAwaiter{ this }; }
+
+    // ִһȫɺtasksڵȴڼ뱣Ч
+    WhenAllAwaiter whenAll(std::vector<Task<void>>& tasks) { return WhenAllAwaiter(tasks); }
+
+    // GL߳ÿ֡һΣָ֮֡ǰŶӵGL׶Эֱ̣ΪջʱbudgetMs롣
+    // λָЭٴεȴnextGLFrame()ŵһ֡
+    // رλָЭ
+    size_t pumpGLQueue(double budgetMs);
+
+    // ȴGLеЭ
+    size_t getGLQueueSize();
+
+    // ֹͣI/Ọ߳˳ǰ (JobSystem::shutdown()֮ǰ)
+    void shutdown();
+
+private:
+    AssetScheduler();
+
+    struct IoRequest {
+        FileData* result;
+        std::coroutine_handle<> handle;
+    };
+
+    void ioLoop();
+
+private:
+    static AssetScheduler* mInstance;
+
+    static constexpr size_t IO_THREAD_COUNT = 2;
+    std::vector<std::thread> m_ioThreads;
+    std::mutex m_ioMutex;
+    std::condition_variable m_ioCondition;
+    std::deque<IoRequest> m_ioRequests;
+    bool m_running = true;
+
+    std::mutex m_glMutex;
+    std::deque<std::coroutine_handle<>> m_glQueue;
+};
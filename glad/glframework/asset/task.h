@@ -0,0 +1,126 @@
+#pragma once
+
+#include <coroutine>          // C++20Э
+#include <exception>          // std::terminate
+#include <optional>           // ڱЭ̷ֵ
+#include <type_traits>        // std::is_void_v
+#include <utility>            // std::move, std::exchange
+
+// Task<T>Э
+// - ʱִУco_awaitʱſʼִУִϺָȴЭ (Գתƣݹջ)
+// - Эпco_await AssetSchedulerṩI/O̡߳GL֡ȵȴ壬
+//   ÿλָܷڲͬ߳ϣ
+// - ֻƶʱЭ֡
+// spawn()spawnӹڡ
+// Դش벻ʹ쳣Э׳쳣ֱֹ
+template<typename T = void>
+class Task;
+
+namespace taskDetail {
+    struct PromiseBase {
+        // Э̽ʱָȴߣûеȴʱͣյ㣬Taskʱ
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+
+            template<typename Promise>
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+                std::coroutine_handle<> continuation = handle.promise().m_continuation;
+                return continuation ? continuation : std::noop_coroutine();
+            }
+
+            void await_resume() noexcept {}
+        };
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        FinalAwaiter final_suspend() noexcept { return {}; }
+        void unhandled_exception() noexcept { std::terminate(); }
+
+        std::coroutine_handle<> m_continuation;
+    };
+
+    template<typename T>
+    struct Promise : PromiseBase {
+        Task<T> get_return_object() noexcept;
+
+        template<typename U>
+        void return_value(U&& value) { m_value.emplace(std::forward<U>(value)); }
+
+        std::optional<T> m_value;
+    };
+
+    template<>
+    struct Promise<void> : PromiseBase {
+        Task<void> get_return_object() noexcept;
+
+        void return_void() noexcept {}
+    };
+}
+
+template<typename T>
+class Task {
+public:
+    using promise_type = taskDetail::Promise<T>;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Task() = default;
+    explicit Task(Handle handle) : m_handle(handle) {}
+    ~Task() {
+        if (m_handle) {
+            m_handle.destroy();
+        }
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    Task(Task&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+    Task& operator=(Task&& other) noexcept {
+        std::swap(m_handle, other.m_handle);
+        return *this;
+    }
+
+    bool isDone() const { return !m_handle || m_handle.done(); }
+
+    // Ϊȴ壺ָȴ
+    bool await_ready() const noexcept { return isDone(); }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        m_handle.promise().m_continuation = awaiting;
+        return m_handle;
+    }
+
+    T await_resume() {
+        if constexpr (!std::is_void_v<T>) {
+            return std::move(*m_handle.promise().m_value);
+        }
+    }
+
+private:
+    Handle m_handle;
+};
+
+namespace taskDetail {
+    template<typename T>
+    Task<T> Promise<T>::get_return_object() noexcept {
+        return Task<T>(std::coroutine_handle<Promise<T>>::from_promise(*this));
+    }
+
+    inline Task<void> Promise<void>::get_return_object() noexcept {
+        return Task<void>(std::coroutine_handle<Promise<void>>::from_promise(*this));
+    }
+
+    // ԶЭ֡Э̣spawnwhenAllڲʵ
+    struct DetachedTask {
+        struct promise_type {
+            DetachedTask get_return_object() noexcept { return {}; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() noexcept {}
+            void unhandled_exception() noexcept { std::terminate(); }
+        };
+    };
+}
+
+// һڵǰִ߳еһιΪֹԶͷ
+inline taskDetail::DetachedTask spawn(Task<void> task) {
+    co_await task;
+}
@@ -0,0 +1,463 @@
+#include "attributeTable.h"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+namespace {
+    // CSVһУ֧˫ŰΧֶ
+    void splitCsvLine(const std::string& line, std::vector<std::string>& fields) {
+        fields.clear();
+        std::string field;
+        bool quoted = false;
+        for (size_t i = 0; i < line.size(); ++i) {
+            char c = line[i];
+            if (quoted) {
+                if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                    field.push_back('"');
+                    ++i;
+                }
+                else if (c == '"') {
+                    quoted = false;
+                }
+                else {
+                    field.push_back(c);
+                }
+            }
+            else if (c == '"') {
+                quoted = true;
+            }
+            else if (c == ',') {
+                fields.push_back(std::move(field));
+                field.clear();
+            }
+            else if (c != '\r') {
+                field.push_back(c);
+            }
+        }
+        fields.push_back(std::move(field));
+    }
+
+    std::string trim(const std::string& s) {
+        size_t begin = s.find_first_not_of(" \t");
+        if (begin == std::string::npos) {
+            return std::string();
+        }
+        size_t end = s.find_last_not_of(" \t");
+        return s.substr(begin, end - begin + 1);
+    }
+
+    bool parseInt(const std::string& s, int32_t& value) {
+        const char* end = s.data() + s.size();
+        auto result = std::from_chars(s.data(), end, value);
+        return result.ec == std::errc() && result.ptr == end && value != AttributeTable::MISSING_INT;
+    }
+
+    bool parseFloat(const std::string& s, float& value) {
+        const char* end = s.data() + s.size();
+        auto result = std::from_chars(s.data(), end, value);
+        return result.ec == std::errc() && result.ptr == end && std::isfinite(value);
+    }
+}
+
+bool AttributeTable::loadCsv(const std::string& path) {
+    clear();
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "ERROR: Could not open attribute table: " << path << std::endl;
+        return false;
+    }
+
+    // 1. ֶΣеҪвȷ
+    std::string line;
+    std::vector<std::string> header;
+    if (!std::getline(file, line)) {
+        std::cerr << "ERROR: Attribute table is empty: " << path << std::endl;
+        return false;
+    }
+    splitCsvLine(line, header);
+    if (header.size() < 2) {
+        std::cerr << "ERROR: Attribute table has no attribute columns: " << path << std::endl;
+        return false;
+    }
+    size_t attributeCount = header.size() - 1;
+    std::vector<std::string> ids;
+    std::vector<std::string> cells;     // д洢ÿattributeCount
+    std::vector<std::string> fields;
+    size_t lineNumber = 1;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        if (trim(line).empty()) {
+            continue;
+        }
+        splitCsvLine(line, fields);
+        std::string id = trim(fields[0]);
+        if (id.empty()) {
+            std::cerr << "WARNING: Skipping attribute row without building id (" << path << ":" << lineNumber << ")." << std::endl;
+            continue;
+        }
+        ids.push_back(std::move(id));
+        for (size_t c = 1; c <= attributeCount; ++c) {
+            cells.push_back(c < fields.size() ? trim(fields[c]) : std::string());
+        }
+    }
+
+    // 2. ƶÿе
+    std::vector<ColumnType> types(attributeCount, ColumnType::Int);
+    for (size_t c = 0; c < attributeCount; ++c) {
+        for (size_t r = 0; r < ids.size(); ++r) {
+            const std::string& cell = cells[r * attributeCount + c];
+            if (cell.empty()) {
+                continue;
+            }
+            int32_t intValue = 0;
+            float floatValue = 0.0f;
+            if (types[c] == ColumnType::Int && !parseInt(cell, intValue)) {
+                types[c] = ColumnType::Float;
+            }
+            if (types[c] == ColumnType::Float && !parseFloat(cell, floatValue)) {
+                types[c] = ColumnType::Category;
+                break;
+            }
+        }
+    }
+
+    // 3. д
+    std::vector<int> columns(attributeCount);
+    for (size_t c = 0; c < attributeCount; ++c) {
+        std::string name = trim(header[c + 1]);
+        columns[c] = addColumn(name, types[c]);
+        if (columns[c] == NO_COLUMN) {
+            std::cerr << "WARNING: Ignoring duplicate attribute column '" << name << "' in " << path << std::endl;
+        }
+    }
+    size_t duplicates = 0;
+    size_t overflows = 0;
+    for (size_t r = 0; r < ids.size(); ++r) {
+        if (findRow(ids[r]) != NO_ROW) {
+            duplicates++;
+            continue;
+        }
+        uint32_t row = addRow(ids[r]);
+        for (size_t c = 0; c < attributeCount; ++c) {
+            const std::string& cell = cells[r * attributeCount + c];
+            if (columns[c] == NO_COLUMN || cell.empty()) {
+                continue;
+            }
+            int32_t intValue = 0;
+            float floatValue = 0.0f;
+            switch (types[c]) {
+            case ColumnType::Int:
+                parseInt(cell, intValue);
+                setInt(columns[c], row, intValue);
+                break;
+            case ColumnType::Float:
+                parseFloat(cell, floatValue);
+                setFloat(columns[c], row, floatValue);
+                break;
+            case ColumnType::Category:
+                if (!setCategory(columns[c], row, cell)) {
+                    overflows++;
+                }
+                break;
+            }
+        }
+    }
+    if (duplicates > 0) {
+        std::cerr << "WARNING: Ignored " << duplicates << " attribute rows with duplicate building ids in " << path << std::endl;
+    }
+    if (overflows > 0) {
+        std::cerr << "WARNING: " << overflows << " attribute values exceed " << MAX_CATEGORIES
+            << " distinct strings per column and were stored as missing (" << path << ")." << std::endl;
+    }
+    std::cout << "Attribute table " << path << ": " << getRowCount() << " buildings, " << getColumnCount() << " columns" << std::endl;
+    return true;
+}
+
+void AttributeTable::clear() {
+    m_buildingIds.clear();
+    m_rows.clear();
+    m_columns.clear();
+}
+
+void AttributeTable::resizeColumn(Column& column, size_t rows) {
+    switch (column.type) {
+    case ColumnType::Int:
+        column.ints.resize(rows, MISSING_INT);
+        break;
+    case ColumnType::Float:
+        column.floats.resize(rows, std::numeric_limits<float>::quiet_NaN());
+        break;
+    case ColumnType::Category:
+        column.codes.resize(rows, static_cast<uint16_t>(MISSING_CATEGORY));
+        break;
+    }
+}
+
+uint32_t AttributeTable::addRow(const std::string& buildingId) {
+    auto it = m_rows.find(buildingId);
+    if (it != m_rows.end()) {
+        return it->second;
+    }
+    uint32_t row = static_cast<uint32_t>(m_buildingIds.size());
+    m_buildingIds.push_back(buildingId);
+    m_rows.emplace(buildingId, row);
+    for (Column& column : m_columns) {
+        resizeColumn(column, m_buildingIds.size());
+    }
+    return row;
+}
+
+int AttributeTable::addColumn(const std::string& name, ColumnType type) {
+    if (findColumn(name) != NO_COLUMN) {
+        return NO_COLUMN;
+    }
+    Column column;
+    column.name = name;
+    column.type = type;
+    if (type == ColumnType::Category) {
+        column.dictionary.push_back(std::string());
+        column.lookup.emplace(std::string(), MISSING_CATEGORY);
+    }
+    resizeColumn(column, m_buildingIds.size());
+    m_columns.push_back(std::move(column));
+    return static_cast<int>(m_columns.size() - 1);
+}
+
+void AttributeTable::setInt(int column, uint32_t row, int32_t value) {
+    m_columns[column].ints[row] = value;
+}
+
+void AttributeTable::setFloat(int column, uint32_t row, float value) {
+    m_columns[column].floats[row] = value;
+}
+
+bool AttributeTable::setCategory(int column, uint32_t row, const std::string& value) {
+    Column& c = m_columns[column];
+    auto it = c.lookup.find(value);
+    uint32_t code = MISSING_CATEGORY;
+    if (it != c.lookup.end()) {
+        code = it->second;
+    }
+    else if (c.dictionary.size() <= MAX_CATEGORIES) {
+        code = static_cast<uint32_t>(c.dictionary.size());
+        c.dictionary.push_back(value);
+        c.lookup.emplace(value, code);
+    }
+    else {
+        c.codes[row] = static_cast<uint16_t>(MISSING_CATEGORY);
+        return false;
+    }
+    c.codes[row] = static_cast<uint16_t>(code);
+    return true;
+}
+
+uint32_t AttributeTable::findRow(const std::string& buildingId) const {
+    auto it = m_rows.find(buildingId);
+    return it != m_rows.end() ? it->second : NO_ROW;
+}
+
+int AttributeTable::findColumn(const std::string& name) const {
+    for (size_t i = 0; i < m_columns.size(); ++i) {
+        if (m_columns[i].name == name) {
+            return static_cast<int>(i);
+        }
+    }
+    return NO_COLUMN;
+}
+
+int32_t AttributeTable::getInt(int column, uint32_t row) const {
+    const Column& c = m_columns[column];
+    return c.type == ColumnType::Int ? c.ints[row] : MISSING_INT;
+}
+
+float AttributeTable::getFloat(int column, uint32_t row) const {
+    const Column& c = m_columns[column];
+    if (c.type == ColumnType::Float) {
+        return c.floats[row];
+    }
+    if (c.type == ColumnType::Int && c.ints[row] != MISSING_INT) {
+        return static_cast<float>(c.ints[row]);
+    }
+    return std::numeric_limits<float>::quiet_NaN();
+}
+
+uint32_t AttributeTable::getCategoryCode(int column, uint32_t row) const {
+    const Column& c = m_columns[column];
+    return c.type == ColumnType::Category ? c.codes[row] : MISSING_CATEGORY;
+}
+
+uint32_t AttributeTable::findCategory(int column, const std::string& value) const {
+    const Column& c = m_columns[column];
+    auto it = c.lookup.find(value);
+    return it != c.lookup.end() ? it->second : MISSING_CATEGORY;
+}
+
+AttributeTable::Selection AttributeTable::selectAll() const {
+    size_t rows = getRowCount();
+    Selection selection((rows + 63) / 64, ~uint64_t(0));
+    if (rows % 64 != 0) {
+        selection.back() = (uint64_t(1) << (rows % 64)) - 1;
+    }
+    return selection;
+}
+
+template<typename Test>
+void AttributeTable::filter(Selection& selection, Test&& test) const {
+    size_t rows = getRowCount();
+    selection.resize((rows + 63) / 64, 0);
+    for (size_t block = 0; block < selection.size(); ++block) {
+        if (selection[block] == 0) {
+            continue;
+        }
+        size_t begin = block * 64;
+        size_t end = std::min(begin + 64, rows);
+        selection[block] &= test(begin, end);
+    }
+}
+
+void AttributeTable::selectRange(int column, double minValue, double maxValue, Selection& selection) const {
+    const Column& c = m_columns[column];
+    if (c.type == ColumnType::Category) {
+        std::fill(selection.begin(), selection.end(), 0);
+        return;
+    }
+    if (c.type == ColumnType::Int) {
+        // Χ߽磬ȽϲҪתÿֵȱʧֵINT32_MIN½ΪINT32_MIN + 1
+        double low = std::max(std::ceil(minValue), static_cast<double>(MISSING_INT) + 1.0);
+        double high = std::min(std::floor(maxValue), static_cast<double>(std::numeric_limits<int32_t>::max()));
+        if (!(low <= high)) {
+            std::fill(selection.begin(), selection.end(), 0);
+            return;
+        }
+        int32_t lo = static_cast<int32_t>(low);
+        int32_t hi = static_cast<int32_t>(high);
+        const int32_t* values = c.ints.data();
+        filter(selection, [values, lo, hi](size_t begin, size_t end) {
+            uint64_t bits = 0;
+            for (size_t i = begin; i < end; ++i) {
+                bits |= static_cast<uint64_t>((values[i] >= lo) & (values[i] <= hi)) << (i - begin);
+            }
+            return bits;
+        });
+        return;
+    }
+    // NaNκֵȽ϶ΪfalseȱʧֵȻᱻѡ
+    float lo = static_cast<float>(minValue);
+    float hi = static_cast<float>(maxValue);
+    const float* values = c.floats.data();
+    filter(selection, [values, lo, hi](size_t begin, size_t end) {
+        uint64_t bits = 0;
+        for (size_t i = begin; i < end; ++i) {
+            bits |= static_cast<uint64_t>((values[i] >= lo) & (values[i] <= hi)) << (i - begin);
+        }
+        return bits;
+    });
+}
+
+void AttributeTable::selectCategory(int column, uint32_t code, Selection& selection) const {
+    const Column& c = m_columns[column];
+    if (c.type != ColumnType::Category || code == MISSING_CATEGORY || code >= c.dictionary.size()) {
+        std::fill(selection.begin(), selection.end(), 0);
+        return;
+    }
+    uint16_t target = static_cast<uint16_t>(code);
+    const uint16_t* codes = c.codes.data();
+    filter(selection, [codes, target](size_t begin, size_t end) {
+        uint64_t bits = 0;
+        for (size_t i = begin; i < end; ++i) {
+            bits |= static_cast<uint64_t>(codes[i] == target) << (i - begin);
+        }
+        return bits;
+    });
+}
+
+size_t AttributeTable::countSelected(const Selection& selection) {
+    size_t count = 0;
+    for (uint64_t bits : selection) {
+        count += static_cast<size_t>(std::popcount(bits));
+    }
+    return count;
+}
+
+AttributeTable::Summary AttributeTable::summarize(int column, const Selection& selection) const {
+    Summary summary;
+    const Column& c = m_columns[column];
+    if (c.type == ColumnType::Category) {
+        return summary;
+    }
+    double minValue = std::numeric_limits<double>::max();
+    double maxValue = std::numeric_limits<double>::lowest();
+    size_t rows = getRowCount();
+    for (size_t block = 0; block < selection.size() && block * 64 < rows; ++block) {
+        uint64_t bits = selection[block];
+        if (bits == 0) {
+            continue;
+        }
+        size_t begin = block * 64;
+        size_t end = std::min(begin + 64, rows);
+        for (size_t i = begin; i < end; ++i) {
+            if ((bits >> (i - begin) & 1) == 0) {
+                continue;
+            }
+            double value = 0.0;
+            if (c.type == ColumnType::Int) {
+                if (c.ints[i] == MISSING_INT) {
+                    continue;
+                }
+                value = c.ints[i];
+            }
+            else {
+                if (std::isnan(c.floats[i])) {
+                    continue;
+                }
+                value = c.floats[i];
+            }
+            summary.count++;
+            summary.sum += value;
+            minValue = std::min(minValue, value);
+            maxValue = std::max(maxValue, value);
+        }
+    }
+    if (summary.count > 0) {
+        summary.minValue = minValue;
+        summary.maxValue = maxValue;
+    }
+    return summary;
+}
+
+std::vector<size_t> AttributeTable::countCategories(int column, const Selection& selection) const {
+    const Column& c = m_columns[column];
+    if (c.type != ColumnType::Category) {
+        return std::vector<size_t>();
+    }
+    std::vector<size_t> counts(c.dictionary.size(), 0);
+    size_t rows = getRowCount();
+    for (size_t block = 0; block < selection.size() && block * 64 < rows; ++block) {
+        uint64_t bits = selection[block];
+        size_t begin = block * 64;
+        while (bits != 0) {
+            // ֻѡеУȡλ1
+            size_t offset = static_cast<size_t>(std::countr_zero(bits));
+            bits &= bits - 1;
+            if (begin + offset < rows) {
+                counts[c.codes[begin + offset]]++;
+            }
+        }
+    }
+    return counts;
+}
+
+std::string AttributeTable::buildingIdFromPath(const std::string& path) {
+    std::filesystem::path file(path);
+    if (!file.has_filename()) {
+        // Ŀ¼·Էָβ
+        file = file.parent_path();
+    }
+    return file.stem().string();
+}
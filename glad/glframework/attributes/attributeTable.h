@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstddef>            // size_t
+#include <cstdint>            // uint32_t
+#include <string>             // std::string
+#include <unordered_map>      // ڽ -> кšַ -> ֵ
+#include <vector>             // std::vector
+
+// AttributeTable֯ʽԱ (߶ȡݡܡЧȼ)
+// - ÿһյ飺Ϊint32ΪfloatַаֵΪuint16 (ÿ65535ֵͬ)
+//   кżڱеıţҲShaderobjectColors± (thematicColors.h)
+// - ѯɨ裺ѡÿһλλ64һ޷֧ɣλϣ
+//   ͳֻȡһкλҪУ
+// - ȱʧֵΪMISSING_INTΪNaNַΪ0 (ַ)ȱʧֵᱻκѡУҲͳơ
+// ģ͵ĶӦϵΪOBJļȥչ ( "buildings/a123.obj" -> "a123")buildingIdFromPath
+// غֻڶ߳ͬʱѯ
+class AttributeTable {
+public:
+    enum class ColumnType : uint8_t {
+        Int,
+        Float,
+        Category,   // ֵַ
+    };
+
+    static constexpr uint32_t NO_ROW = ~0u;
+    static constexpr int NO_COLUMN = -1;
+    static constexpr int32_t MISSING_INT = INT32_MIN;
+    static constexpr uint32_t MISSING_CATEGORY = 0;    // ֵеĵ0ǿַ
+    static constexpr uint32_t MAX_CATEGORIES = 65535;
+
+    // ÿһλrowselection[row / 64]ĵrow % 64λ
+    using Selection = std::vector<uint64_t>;
+
+    // ֵѡΧڵͳ (ȱʧֵ)
+    struct Summary {
+        size_t count = 0;
+        double sum = 0.0;
+        double minValue = 0.0;  // countΪ0ʱΪ0
+        double maxValue = 0.0;
+
+        double mean() const { return count > 0 ? sum / static_cast<double>(count) : 0.0; }
+    };
+
+    // ȡCSVļһΪһΪţÿиƶ
+    // (ȫʱΪIntȫʱΪFloatΪCategoryֶΪȱʧֵ)
+    // ֶο˫ŰΧ (е""ʾһ)ظĽֻһСʧʱfalseΪա
+    bool loadCsv(const std::string& path);
+
+    // к
+    void clear();
+
+    // й (߹߻ɵ)
+    // һвкţѴʱекšеΪȱʧֵ
+    uint32_t addRow(const std::string& buildingId);
+    // һвкţͬѴʱNO_COLUMN
+    int addColumn(const std::string& name, ColumnType type);
+    void setInt(int column, uint32_t row, int32_t value);
+    void setFloat(int column, uint32_t row, float value);
+    // ֵʱдȱʧֵfalse
+    bool setCategory(int column, uint32_t row, const std::string& value);
+
+    size_t getRowCount() const { return m_buildingIds.size(); }
+    size_t getColumnCount() const { return m_columns.size(); }
+    uint32_t findRow(const std::string& buildingId) const;
+    const std::string& getBuildingId(uint32_t row) const { return m_buildingIds[row]; }
+
+    int findColumn(const std::string& name) const;
+    const std::string& getColumnName(int column) const { return m_columns[column].name; }
+    ColumnType getColumnType(int column) const { return m_columns[column].type; }
+    bool isNumeric(int column) const { return m_columns[column].type != ColumnType::Category; }
+
+    // ֵ (Ͳʱȱʧֵ)
+    int32_t getInt(int column, uint32_t row) const;
+    float getFloat(int column, uint32_t row) const;
+    uint32_t getCategoryCode(int column, uint32_t row) const;
+
+    // ַеֵ䣺getCategories(column)[code]ΪӦַ
+    const std::vector<std::string>& getCategories(int column) const { return m_columns[column].dictionary; }
+    // ַı룬ʱMISSING_CATEGORY
+    uint32_t findCategory(int column, const std::string& value) const;
+
+    // ѡ
+    Selection selectAll() const;
+    // selectionĻֵֻ[minValue, maxValue]֮ (к͸)
+    void selectRange(int column, double minValue, double maxValue, Selection& selection) const;
+    // selectionĻַֻеcode
+    void selectCategory(int column, uint32_t code, Selection& selection) const;
+    static size_t countSelected(const Selection& selection);
+    static bool isSelected(const Selection& selection, uint32_t row) {
+        return row / 64 < selection.size() && (selection[row / 64] >> (row % 64) & 1) != 0;
+    }
+
+    // ֵѡϵͳ
+    Summary summarize(int column, const Selection& selection) const;
+    // ַѡÿ (±Ϊ)
+    std::vector<size_t> countCategories(int column, const Selection& selection) const;
+
+    // ģ·õţļȥչ (Ŀ¼·ȡһĿ¼)
+    static std::string buildingIdFromPath(const std::string& path);
+
+private:
+    struct Column {
+        std::string name;
+        ColumnType type = ColumnType::Int;
+        std::vector<int32_t> ints;
+        std::vector<float> floats;
+        std::vector<uint16_t> codes;
+        std::vector<std::string> dictionary;                  //  -> ַ0Ϊַ
+        std::unordered_map<std::string, uint32_t> lookup;     // ַ -> 
+    };
+
+    // кɨһУÿ64еĿtest(begin, end)õѡλselection
+    template<typename Test>
+    void filter(Selection& selection, Test&& test) const;
+
+    // вȱʧֵ
+    static void resizeColumn(Column& column, size_t rows);
+
+private:
+    std::vector<std::string> m_buildingIds;                    // к -> 
+    std::unordered_map<std::string, uint32_t> m_rows;          //  -> к
+    std::vector<Column> m_columns;
+};
@@ -0,0 +1,96 @@
+#include "thematicColors.h"
+#include "../../wrapper/checkError.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace thematic {
+    void rampColors(const AttributeTable& table, int column, const AttributeTable::Selection* selection,
+        const glm::vec4& lowColor, const glm::vec4& highColor, std::vector<glm::vec4>& colors) {
+        colors.assign(table.getRowCount(), glm::vec4(0.0f));
+        if (column < 0 || static_cast<size_t>(column) >= table.getColumnCount() || !table.isNumeric(column)) {
+            return;
+        }
+        AttributeTable::Selection all;
+        if (!selection) {
+            all = table.selectAll();
+            selection = &all;
+        }
+        AttributeTable::Summary summary = table.summarize(column, *selection);
+        if (summary.count == 0) {
+            return;
+        }
+        float minValue = static_cast<float>(summary.minValue);
+        float range = static_cast<float>(summary.maxValue - summary.minValue);
+        float scale = range > 0.0f ? 1.0f / range : 0.0f;
+        for (uint32_t row = 0; row < colors.size(); ++row) {
+            float value = table.getFloat(column, row);
+            if (std::isnan(value) || !AttributeTable::isSelected(*selection, row)) {
+                continue;
+            }
+            colors[row] = glm::mix(lowColor, highColor, std::clamp((value - minValue) * scale, 0.0f, 1.0f));
+        }
+    }
+
+    void categoryColors(const AttributeTable& table, int column, const AttributeTable::Selection* selection,
+        float alpha, std::vector<glm::vec4>& colors) {
+        colors.assign(table.getRowCount(), glm::vec4(0.0f));
+        if (column < 0 || static_cast<size_t>(column) >= table.getColumnCount() || table.isNumeric(column)) {
+            return;
+        }
+        // ÿɫֻһ
+        const std::vector<std::string>& categories = table.getCategories(column);
+        std::vector<glm::vec4> palette(categories.size(), glm::vec4(0.0f));
+        for (size_t code = 1; code < palette.size(); ++code) {
+            float hue = std::fmod(static_cast<float>(code) * 0.618034f, 1.0f) * 6.0f;
+            glm::vec3 rgb = glm::clamp(glm::vec3(std::abs(hue - 3.0f) - 1.0f, 2.0f - std::abs(hue - 2.0f), 2.0f - std::abs(hue - 4.0f)), 0.0f, 1.0f);
+            palette[code] = glm::vec4(glm::mix(glm::vec3(1.0f), rgb, 0.75f), alpha);
+        }
+        for (uint32_t row = 0; row < colors.size(); ++row) {
+            if (selection && !AttributeTable::isSelected(*selection, row)) {
+                continue;
+            }
+            colors[row] = palette[table.getCategoryCode(column, row)];
+        }
+    }
+
+    void defaultColors(const AttributeTable& table, int column, std::vector<glm::vec4>& colors) {
+        if (table.isNumeric(column)) {
+            rampColors(table, column, nullptr, glm::vec4(0.2f, 0.4f, 1.0f, 0.85f), glm::vec4(1.0f, 0.25f, 0.1f, 0.85f), colors);
+        }
+        else {
+            categoryColors(table, column, nullptr, 0.85f, colors);
+        }
+    }
+}
+
+ObjectColorBuffer::~ObjectColorBuffer() {
+    if (m_buffer != 0) {
+        GL_CALL(glDeleteBuffers(1, &m_buffer));
+        m_buffer = 0;
+    }
+}
+
+void ObjectColorBuffer::update(const std::vector<glm::vec4>& colors) {
+    if (m_buffer == 0) {
+        GL_CALL(glGenBuffers(1, &m_buffer));
+    }
+    size_t bytes = colors.size() * sizeof(glm::vec4);
+    GL_CALL(glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_buffer));
+    if (bytes > m_capacity || m_capacity == 0) {
+        // յSSBOܰ󶨣ٷһɫ
+        m_capacity = std::max(bytes, sizeof(glm::vec4));
+        GL_CALL(glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(m_capacity), nullptr, GL_DYNAMIC_DRAW));
+    }
+    if (bytes > 0) {
+        GL_CALL(glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, static_cast<GLsizeiptr>(bytes), colors.data()));
+    }
+    GL_CALL(glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0));
+    m_count = colors.size();
+}
+
+void ObjectColorBuffer::bind() const {
+    if (m_buffer != 0) {
+        GL_CALL(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, BINDING, m_buffer));
+    }
+}
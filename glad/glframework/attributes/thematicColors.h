@@ -0,0 +1,54 @@
+#pragma once
+
+#include "../core.h"          // GLAD, glm
+#include "attributeTable.h"
+
+#include <cstddef>            // size_t
+#include <vector>             // std::vector
+
+// רɫԱеĳһиɫ
+// ɫԱк (ÿһvec4)alphaΪɫϵı0ʾֲɫ (ȱʧֵδѡе)
+// ɫϴObjectColorBufferShaderк (Model::setObjectId) ң
+// лרֻҪɫһҪ޸Ļؽκβʡ
+namespace thematic {
+    // ֵУѡеСֵֵӳ䵽lowColor ~ highColor
+    // selectionΪnullptrʱʹ
+    void rampColors(const AttributeTable& table, int column, const AttributeTable::Selection* selection,
+        const glm::vec4& lowColor, const glm::vec4& highColor, std::vector<glm::vec4>& colors);
+
+    // ַУÿֵͬһɫ (ɫఴƽֲڱɫ)
+    void categoryColors(const AttributeTable& table, int column, const AttributeTable::Selection* selection,
+        float alpha, std::vector<glm::vec4>& colors);
+
+    // еѡrampColors ( -> ) categoryColors
+    void defaultColors(const AttributeTable& table, int column, std::vector<glm::vec4>& colors);
+}
+
+// ObjectColorBufferÿһɫSSBO (binding = BINDING)
+// assets/shaders/fragment.glslvisibilityResolveFragment.glslthematicColoringΪ1ʱȡobjectColors[objectId]
+// ֻGL߳ʹá
+class ObjectColorBuffer {
+public:
+    // ShaderObjectColorsbindingһ (0 ~ 3ΪGeometryArenaĹ)
+    static constexpr GLuint BINDING = 4;
+
+    ObjectColorBuffer() = default;
+    ~ObjectColorBuffer();
+
+    // GL󣬽ֹ
+    ObjectColorBuffer(const ObjectColorBuffer&) = delete;
+    ObjectColorBuffer& operator=(const ObjectColorBuffer&) = delete;
+
+    // ϴɫ㹻ʱֻеĻ
+    void update(const std::vector<glm::vec4>& colors);
+
+    // 󶨵BINDING
+    void bind() const;
+
+    size_t size() const { return m_count; }
+
+private:
+    GLuint m_buffer = 0;
+    size_t m_capacity = 0;  // ֽ
+    size_t m_count = 0;
+};
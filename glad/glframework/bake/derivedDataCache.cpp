@@ -0,0 +1,332 @@
+#include "derivedDataCache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr uint32_t ENTRY_MAGIC = 0x31434444;   // "DDC1"
+    constexpr uint64_t PRIME_1 = 0x9E3779B185EBCA87ull;
+    constexpr uint64_t PRIME_2 = 0xC2B2AE3D27D4EB4Full;
+    constexpr uint64_t PRIME_3 = 0x165667B19E3779F9ull;
+
+    // ļͷ
+    struct EntryHeader {
+        uint32_t magic;
+        uint32_t reserved;
+        uint64_t size;              // ݵֽ
+        uint64_t checksum[2];       // ݵhash128
+    };
+
+    uint64_t rotateLeft(uint64_t value, int bits) {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    // 64λս (MurmurHash3 fmix64)
+    uint64_t finalizeHash(uint64_t value) {
+        value ^= value >> 33;
+        value *= 0xFF51AFD7ED558CCDull;
+        value ^= value >> 33;
+        value *= 0xC4CEB9FE1A85EC53ull;
+        value ^= value >> 33;
+        return value;
+    }
+
+    // ǰִ߳еbuild (buildеparallelForڱ߳ҲҪ)
+    thread_local int t_buildDepth = 0;
+}
+
+// ---------------- DerivedDataKey ----------------
+
+DerivedDataKey::DerivedDataKey(std::string_view kind, uint32_t version)
+    : m_kind(kind)
+{
+    m_hash[0] = PRIME_1;
+    m_hash[1] = PRIME_2;
+    addString(kind);
+    addValue(version);
+}
+
+void DerivedDataKey::hash128(const void* data, size_t size, uint64_t seed, uint64_t out[2]) {
+    // ÿδ8ֽڣĹϣ
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t h1 = seed ^ (size * PRIME_1);
+    uint64_t h2 = ~seed ^ (size * PRIME_2);
+    size_t wordCount = size / 8;
+    for (size_t i = 0; i < wordCount; ++i) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i * 8, 8);
+        h1 = rotateLeft(h1 ^ (word * PRIME_1), 31) * PRIME_2;
+        h2 = rotateLeft(h2 ^ (word * PRIME_3), 27) * PRIME_1 + h1;
+    }
+    uint64_t tail = 0;
+    if (size > wordCount * 8) {
+        // sizeΪ0ʱdataΪָ (vectordata())ܴmemcpy
+        std::memcpy(&tail, bytes + wordCount * 8, size - wordCount * 8);
+    }
+    h1 = rotateLeft(h1 ^ (tail * PRIME_1), 31) * PRIME_2;
+    h2 = rotateLeft(h2 ^ (tail * PRIME_3), 27) * PRIME_1 + h1;
+
+    h1 = finalizeHash(h1 + h2);
+    h2 = finalizeHash(h2 + h1);
+    out[0] = h1;
+    out[1] = h2;
+}
+
+DerivedDataKey& DerivedDataKey::addBytes(const void* data, size_t size) {
+    // ÿ뵥ϣ˳룬ĳҲϣı߽粻
+    uint64_t chunk[2];
+    hash128(data, size, m_hash[0], chunk);
+    m_hash[0] = finalizeHash((m_hash[0] * PRIME_3) ^ chunk[0]);
+    m_hash[1] = finalizeHash((m_hash[1] * PRIME_1) ^ chunk[1]);
+    return *this;
+}
+
+DerivedDataKey& DerivedDataKey::addString(std::string_view text) {
+    return addBytes(text.data(), text.size());
+}
+
+std::string DerivedDataKey::toString() const {
+    static const char DIGITS[] = "0123456789abcdef";
+    std::string name = m_kind + "-";
+    for (uint64_t part : m_hash) {
+        for (int shift = 60; shift >= 0; shift -= 4) {
+            name += DIGITS[(part >> shift) & 0xF];
+        }
+    }
+    return name;
+}
+
+// ---------------- DerivedDataCache ----------------
+
+DerivedDataCache::DerivedDataCache(const std::string& directory, uint64_t maxBytes)
+    : m_maxBytes(maxBytes)
+{
+    if (directory.empty()) {
+        return;
+    }
+    std::error_code error;
+    fs::create_directories(directory, error);
+    if (!fs::is_directory(directory, error)) {
+        std::cerr << "WARNING: Derived data cache directory is not usable, caching disabled: " << directory << std::endl;
+        return;
+    }
+    m_directory = directory;
+}
+
+std::string DerivedDataCache::getDefaultDirectory() {
+    if (const char* directory = std::getenv("GLFRAMEWORK_DDC")) {
+        if (directory[0] != '\0') {
+            return directory;
+        }
+    }
+    std::error_code error;
+    fs::path temp = fs::temp_directory_path(error);
+    return ((error ? fs::path(".") : temp) / "glframework-ddc").string();
+}
+
+std::string DerivedDataCache::pathFor(const std::string& name) const {
+    // ϣǰλֳ256Ŀ¼ⵥĿ¼ļ
+    size_t dash = name.rfind('-');
+    std::string bucket = dash != std::string::npos && name.size() >= dash + 3 ? name.substr(dash + 1, 2) : std::string("00");
+    return (fs::path(m_directory) / bucket / (name + ".ddc")).string();
+}
+
+bool DerivedDataCache::readEntry(const std::string& name, std::vector<uint8_t>& data) {
+    std::string path = pathFor(name);
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    EntryHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != ENTRY_MAGIC) {
+        return false;
+    }
+    // ͷеĳȱļʣಿһ£Ϊ𻵣ڴ
+    std::error_code error;
+    uint64_t fileSize = fs::file_size(path, error);
+    if (error || fileSize < sizeof(header) || header.size != fileSize - sizeof(header)) {
+        std::cerr << "WARNING: Corrupt derived data ignored: " << path << std::endl;
+        return false;
+    }
+    data.resize(static_cast<size_t>(header.size));
+    if (!file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+        data.clear();
+        return false;
+    }
+    uint64_t checksum[2];
+    DerivedDataKey::hash128(data.data(), data.size(), 0, checksum);
+    if (checksum[0] != header.checksum[0] || checksum[1] != header.checksum[1]) {
+        std::cerr << "WARNING: Corrupt derived data ignored: " << path << std::endl;
+        data.clear();
+        return false;
+    }
+    file.close();
+
+    // ¼һʹõʱ䣬trim()ݴ̭
+    fs::last_write_time(path, fs::file_time_type::clock::now(), error);
+    m_bytesRead += data.size();
+    return true;
+}
+
+bool DerivedDataCache::writeEntry(const std::string& name, const std::vector<uint8_t>& data) {
+    std::string path = pathFor(name);
+    std::error_code error;
+    fs::create_directories(fs::path(path).parent_path(), error);
+
+    // дΨһʱļдٸȡῴдһļ
+    static std::atomic<uint64_t> counter{ 0 };
+    std::string tempPath = path + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()))
+        + "." + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count())
+        + "." + std::to_string(counter++) + ".tmp";
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "WARNING: Could not write derived data: " << tempPath << std::endl;
+            return false;
+        }
+        EntryHeader header = {};
+        header.magic = ENTRY_MAGIC;
+        header.size = data.size();
+        DerivedDataKey::hash128(data.data(), data.size(), 0, header.checksum);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file) {
+            file.close();
+            fs::remove(tempPath, error);
+            return false;
+        }
+    }
+    fs::rename(tempPath, path, error);
+    if (error) {
+        // һܸ̿ոдͬһ (ͬ)д뼴
+        fs::remove(tempPath, error);
+        return fs::exists(path, error);
+    }
+    m_bytesWritten += data.size();
+    return true;
+}
+
+bool DerivedDataCache::get(const DerivedDataKey& key, std::vector<uint8_t>& data) {
+    if (!isEnabled() || !readEntry(key.toString(), data)) {
+        m_misses++;
+        return false;
+    }
+    m_hits++;
+    return true;
+}
+
+bool DerivedDataCache::put(const DerivedDataKey& key, const std::vector<uint8_t>& data) {
+    return isEnabled() && writeEntry(key.toString(), data);
+}
+
+bool DerivedDataCache::getOrBuild(const DerivedDataKey& key, std::vector<uint8_t>& data, const std::function<bool(std::vector<uint8_t>&)>& build) {
+    if (!isEnabled()) {
+        m_misses++;
+        return build(data);
+    }
+    std::string name = key.toString();
+    bool registered = false;
+    for (;;) {
+        if (readEntry(name, data)) {
+            m_hits++;
+            return true;
+        }
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_building.insert(name).second) {
+            registered = true;
+            break;
+        }
+        // ߳Լڹ (buildͨparallelForڱ߳) ʱܵȴ
+        // ȵĿǱ߳Ĺһڵȱ߳㹹̡߳ʱȥأֱӹ
+        // ֻвκι̲߳Żȴȴϵɻ
+        if (t_buildDepth > 0) {
+            break;
+        }
+        // ߳ڹͬһɺ¶ȡ (ʧʱɱ߳¹)
+        m_buildFinished.wait(lock, [&]() { return m_building.count(name) == 0; });
+    }
+
+    m_misses++;
+    data.clear();
+    t_buildDepth++;
+    bool built = build(data);
+    t_buildDepth--;
+    if (built) {
+        writeEntry(name, data);
+    }
+    if (registered) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_building.erase(name);
+        }
+        m_buildFinished.notify_all();
+    }
+    return built;
+}
+
+size_t DerivedDataCache::trim() {
+    if (!isEnabled()) {
+        return 0;
+    }
+    struct CachedFile {
+        fs::path path;
+        uint64_t size;
+        fs::file_time_type lastUsed;
+    };
+    std::vector<CachedFile> files;
+    uint64_t totalBytes = 0;
+    std::error_code error;
+    for (fs::recursive_directory_iterator it(m_directory, error), end; !error && it != end; it.increment(error)) {
+        if (!it->is_regular_file(error) || it->path().extension() != ".ddc") {
+            continue;
+        }
+        CachedFile file = { it->path(), static_cast<uint64_t>(it->file_size(error)), it->last_write_time(error) };
+        totalBytes += file.size;
+        files.push_back(std::move(file));
+    }
+    if (totalBytes <= m_maxBytes) {
+        return 0;
+    }
+
+    // δʹõǰ
+    std::sort(files.begin(), files.end(), [](const CachedFile& a, const CachedFile& b) {
+        return a.lastUsed < b.lastUsed;
+    });
+    size_t removed = 0;
+    for (const CachedFile& file : files) {
+        if (totalBytes <= m_maxBytes) {
+            break;
+        }
+        if (fs::remove(file.path, error)) {
+            totalBytes -= file.size;
+            removed++;
+        }
+    }
+    std::cout << "Derived data cache trimmed: " << removed << " entries removed, " << totalBytes / (1024 * 1024) << " MB kept." << std::endl;
+    return removed;
+}
+
+DerivedDataCache::Stats DerivedDataCache::getStats() const {
+    Stats stats;
+    stats.hits = m_hits.load();
+    stats.misses = m_misses.load();
+    stats.bytesRead = m_bytesRead.load();
+    stats.bytesWritten = m_bytesWritten.load();
+    return stats;
+}
+
+void DerivedDataCache::logStats(const std::string& toolName) const {
+    Stats stats = getStats();
+    size_t requests = stats.hits + stats.misses;
+    std::cout << toolName << " derived data cache (" << (isEnabled() ? m_directory : std::string("disabled")) << "): "
+        << stats.hits << "/" << requests << " hits, "
+        << stats.bytesRead / 1024 << " KB read, " << stats.bytesWritten / 1024 << " KB written." << std::endl;
+}
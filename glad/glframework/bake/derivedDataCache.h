@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>             // ͳƼ
+#include <condition_variable> // ڵȴڹĿ
+#include <cstdint>            // uint64_t
+#include <functional>         // std::function
+#include <mutex>              // std::mutex
+#include <string>             // std::string
+#include <string_view>        // std::string_view
+#include <type_traits>        // std::is_arithmetic_v
+#include <unordered_set>      // ڼ¼ڹĿ
+#include <vector>             // std::vector
+
+// DerivedDataKeyݵݵַ
+// ɲࡢ㷨İ汾ţԼ (ļݡ) 128λϣɡ
+// ͬĲͬļģ޹ (粻ͬģõͬһͼֻһ)
+// ϣǼܹϣֻڻҡ
+class DerivedDataKey {
+public:
+    // - kind: ࣬ͬʱΪļǰ׺ ( "texture")
+    // - version: 㷨/ʽİ汾޸㷨ʱ1ʹɲȫʧЧ
+    DerivedDataKey(std::string_view kind, uint32_t version);
+
+    DerivedDataKey& addBytes(const void* data, size_t size);
+    DerivedDataKey& addString(std::string_view text);
+
+    template<typename T>
+    DerivedDataKey& addValue(const T& value) {
+        static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "Only plain values can be hashed directly");
+        return addBytes(&value, sizeof(T));
+    }
+
+    // "kind-32λʮƹϣ"
+    std::string toString() const;
+
+    // һݼ128λϣ (ҲڻļУ)
+    static void hash128(const void* data, size_t size, uint64_t seed, uint64_t out[2]);
+
+private:
+    std::string m_kind;
+    uint64_t m_hash[2];
+};
+
+// DerivedDataCacheĿ¼еݻ (߹ʹãʱҪ)
+// - ÿΪ Ŀ¼/ǰλϣ/.ddcݴȺУ飬𻵵ļΪδУ
+// - ддʱļٸ̡߽߳̿ͬʱʹͬһĿ¼
+// - ʱļ޸ʱ䣬trim()޸ʱɾδʹõĲʹܴСޣ
+// - getOrBuildͬһĲֻһΣõȴȡ
+//   ߳ڹʱ (Ƕbuild) ȴֱظ⻥ȴ
+// Ŀ¼Ϊջ޷ʱرգgetOrBuildֱӹ
+class DerivedDataCache {
+public:
+    struct Stats {
+        size_t hits = 0;
+        size_t misses = 0;
+        uint64_t bytesRead = 0;
+        uint64_t bytesWritten = 0;
+    };
+
+    static constexpr uint64_t DEFAULT_MAX_BYTES = 4ull << 30;
+
+    explicit DerivedDataCache(const std::string& directory = getDefaultDirectory(), uint64_t maxBytes = DEFAULT_MAX_BYTES);
+
+    DerivedDataCache(const DerivedDataCache&) = delete;
+    DerivedDataCache& operator=(const DerivedDataCache&) = delete;
+
+    // GLFRAMEWORK_DDCָĿ¼δʱΪϵͳʱĿ¼µglframework-ddc
+    static std::string getDefaultDirectory();
+
+    bool isEnabled() const { return !m_directory.empty(); }
+    const std::string& getDirectory() const { return m_directory; }
+
+    // ȡһڻʱfalse
+    bool get(const DerivedDataKey& key, std::vector<uint8_t>& data);
+    // дһѴʱ
+    bool put(const DerivedDataKey& key, const std::vector<uint8_t>& data);
+
+    // ʱȡbuildɣbuildtrueʱд뻺档Ƿõݡ
+    bool getOrBuild(const DerivedDataKey& key, std::vector<uint8_t>& data, const std::function<bool(std::vector<uint8_t>&)>& build);
+
+    // ɾδʹõĲֱܴСmaxBytesɾĲ
+    size_t trim();
+
+    Stats getStats() const;
+    // ʺͶд
+    void logStats(const std::string& toolName) const;
+
+private:
+    std::string pathFor(const std::string& name) const;
+    bool readEntry(const std::string& name, std::vector<uint8_t>& data);
+    bool writeEntry(const std::string& name, const std::vector<uint8_t>& data);
+
+private:
+    std::string m_directory;        // Ϊձʾر
+    uint64_t m_maxBytes;
+
+    std::mutex m_mutex;
+    std::condition_variable m_buildFinished;
+    std::unordered_set<std::string> m_building;  // ڹļ
+
+    std::atomic<size_t> m_hits{ 0 };
+    std::atomic<size_t> m_misses{ 0 };
+    std::atomic<uint64_t> m_bytesRead{ 0 };
+    std::atomic<uint64_t> m_bytesWritten{ 0 };
+};
@@ -0,0 +1,624 @@
+#include "meshBaker.h"
+#include "../job/jobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+namespace bake {
+namespace {
+    // λȽϵĸ-0+0Ϊͬ
+    uint32_t floatBits(float value) {
+        value += 0.0f;
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    struct PositionKey {
+        uint32_t bits[3];
+        bool operator==(const PositionKey& other) const { return std::memcmp(bits, other.bits, sizeof(bits)) == 0; }
+    };
+
+    struct VertexKey {
+        uint32_t bits[8];
+        bool operator==(const VertexKey& other) const { return std::memcmp(bits, other.bits, sizeof(bits)) == 0; }
+    };
+
+    template<size_t N>
+    size_t hashBits(const uint32_t (&bits)[N]) {
+        uint64_t hash = 1469598103934665603ull;
+        for (uint32_t value : bits) {
+            hash = (hash ^ value) * 1099511628211ull;
+        }
+        return static_cast<size_t>(hash ^ (hash >> 32));
+    }
+
+    struct PositionKeyHash {
+        size_t operator()(const PositionKey& key) const { return hashBits(key.bits); }
+    };
+
+    struct VertexKeyHash {
+        size_t operator()(const VertexKey& key) const { return hashBits(key.bits); }
+    };
+
+    PositionKey makePositionKey(const glm::vec3& position) {
+        return { { floatBits(position.x), floatBits(position.y), floatBits(position.z) } };
+    }
+
+    VertexKey makeVertexKey(const Vertex& vertex) {
+        return { { floatBits(vertex.position.x), floatBits(vertex.position.y), floatBits(vertex.position.z),
+            floatBits(vertex.normal.x), floatBits(vertex.normal.y), floatBits(vertex.normal.z),
+            floatBits(vertex.texCoord.x), floatBits(vertex.texCoord.y) } };
+    }
+
+    // ---- Forsyth㻺Ż ----
+    constexpr int FORSYTH_CACHE_SIZE = 32;
+
+    float forsythVertexScore(int cachePosition, uint32_t remainingTriangles) {
+        if (remainingTriangles == 0) {
+            return -1.0f;
+        }
+        float score = 0.0f;
+        if (cachePosition >= 0) {
+            // ù̶ѡһιߵγɳ
+            score = cachePosition < 3 ? 0.75f
+                : std::pow(1.0f - static_cast<float>(cachePosition - 3) / (FORSYTH_CACHE_SIZE - 3), 1.5f);
+        }
+        // ʣٵĶȴ꣬¹
+        return score + 2.0f / std::sqrt(static_cast<float>(remainingTriangles));
+    }
+
+    constexpr uint32_t INVALID = 0xFFFFFFFFu;
+}
+
+void generateNormals(const std::vector<float>& interleaved, const std::vector<unsigned int>& indices, float creaseAngle,
+    std::vector<Vertex>& corners) {
+    size_t vertexCount = interleaved.size() / 5;
+    size_t triangleCount = indices.size() / 3;
+    corners.assign(triangleCount * 3, Vertex());
+    if (triangleCount == 0) {
+        return;
+    }
+    auto positionOf = [&](uint32_t v) {
+        return glm::vec3(interleaved[v * 5], interleaved[v * 5 + 1], interleaved[v * 5 + 2]);
+    };
+
+    // 1. ͬһλõĶ (UVӷ) Ϊһ
+    std::vector<uint32_t> groupOf(vertexCount);
+    std::unordered_map<PositionKey, uint32_t, PositionKeyHash> groups;
+    groups.reserve(vertexCount);
+    for (uint32_t v = 0; v < vertexCount; ++v) {
+        groupOf[v] = groups.emplace(makePositionKey(positionOf(v)), static_cast<uint32_t>(groups.size())).first->second;
+    }
+
+    // 2. 淨 (δһĲΪȨ) ÿб (CSR)
+    std::vector<glm::vec3> faceNormals(triangleCount);
+    std::vector<uint32_t> groupOffsets(groups.size() + 1, 0);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        glm::vec3 a = positionOf(indices[t * 3]);
+        faceNormals[t] = glm::cross(positionOf(indices[t * 3 + 1]) - a, positionOf(indices[t * 3 + 2]) - a);
+        for (int k = 0; k < 3; ++k) {
+            ++groupOffsets[groupOf[indices[t * 3 + k]] + 1];
+        }
+    }
+    std::partial_sum(groupOffsets.begin(), groupOffsets.end(), groupOffsets.begin());
+    std::vector<uint32_t> groupFaces(groupOffsets.back());
+    std::vector<uint32_t> cursor(groupOffsets.begin(), groupOffsets.end() - 1);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        for (int k = 0; k < 3; ++k) {
+            groupFaces[cursor[groupOf[indices[t * 3 + k]]]++] = static_cast<uint32_t>(t);
+        }
+    }
+
+    // 3. ÿǵķߣֻۼ뱾нСۺ۽ǵ棬Ӳõͬķ
+    float cosCrease = std::cos(glm::radians(creaseAngle));
+    JobSystem::getInstance()->parallelFor(0, triangleCount, [&](size_t begin, size_t end) {
+        for (size_t t = begin; t < end; ++t) {
+            float faceLength = glm::length(faceNormals[t]);
+            glm::vec3 faceDirection = faceLength > 0.0f ? faceNormals[t] / faceLength : glm::vec3(0.0f, 1.0f, 0.0f);
+            for (int k = 0; k < 3; ++k) {
+                uint32_t v = indices[t * 3 + k];
+                uint32_t group = groupOf[v];
+                glm::vec3 sum(0.0f);
+                for (uint32_t i = groupOffsets[group]; i < groupOffsets[group + 1]; ++i) {
+                    const glm::vec3& other = faceNormals[groupFaces[i]];
+                    float otherLength = glm::length(other);
+                    if (otherLength > 0.0f && glm::dot(faceDirection, other / otherLength) >= cosCrease) {
+                        sum += other;
+                    }
+                }
+                float sumLength = glm::length(sum);
+                Vertex& corner = corners[t * 3 + k];
+                corner.position = positionOf(v);
+                corner.normal = sumLength > 0.0f ? sum / sumLength : faceDirection;
+                corner.texCoord = glm::vec2(interleaved[v * 5 + 3], interleaved[v * 5 + 4]);
+            }
+        }
+    }, 4096);
+}
+
+void weldVertices(const std::vector<Vertex>& corners, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+    vertices.clear();
+    indices.resize(corners.size());
+    std::unordered_map<VertexKey, uint32_t, VertexKeyHash> unique;
+    unique.reserve(corners.size());
+    for (size_t i = 0; i < corners.size(); ++i) {
+        auto result = unique.emplace(makeVertexKey(corners[i]), static_cast<uint32_t>(vertices.size()));
+        if (result.second) {
+            vertices.push_back(corners[i]);
+        }
+        indices[i] = result.first->second;
+    }
+}
+
+void optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount) {
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) {
+        return;
+    }
+
+    // ÿδб (CSRƵĩβ)
+    std::vector<uint32_t> remaining(vertexCount, 0);
+    for (uint32_t index : indices) {
+        ++remaining[index];
+    }
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        offsets[v + 1] = offsets[v] + remaining[v];
+    }
+    std::vector<uint32_t> vertexTriangles(indices.size());
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        for (int k = 0; k < 3; ++k) {
+            vertexTriangles[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+        }
+    }
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScore(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        vertexScore[v] = forsythVertexScore(-1, remaining[v]);
+    }
+    auto triangleScore = [&](size_t t) {
+        return vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+    };
+    std::vector<bool> emitted(triangleCount, false);
+    uint32_t best = 0;
+    float bestScore = triangleScore(0);
+    for (size_t t = 1; t < triangleCount; ++t) {
+        float score = triangleScore(t);
+        if (score > bestScore) {
+            bestScore = score;
+            best = static_cast<uint32_t>(t);
+        }
+    }
+
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+    std::vector<uint32_t> cache, nextCache;
+    cache.reserve(FORSYTH_CACHE_SIZE + 3);
+    nextCache.reserve(FORSYTH_CACHE_SIZE + 3);
+    size_t fallbackCursor = 0;
+
+    for (size_t step = 0; step < triangleCount; ++step) {
+        if (best == INVALID) {
+            // еĶ㶼ûʣΣһδ¿ʼ
+            while (emitted[fallbackCursor]) {
+                ++fallbackCursor;
+            }
+            best = static_cast<uint32_t>(fallbackCursor);
+        }
+        emitted[best] = true;
+        const uint32_t* tri = &indices[size_t(best) * 3];
+        output.insert(output.end(), tri, tri + 3);
+
+        // ʣбƳ
+        for (int k = 0; k < 3; ++k) {
+            uint32_t v = tri[k];
+            uint32_t* list = &vertexTriangles[offsets[v]];
+            for (uint32_t i = 0; i < remaining[v]; ++i) {
+                if (list[i] == best) {
+                    std::swap(list[i], list[remaining[v] - 1]);
+                    --remaining[v];
+                    break;
+                }
+            }
+        }
+
+        // »棺εĶǰ棬˳ӣı
+        nextCache.assign(tri, tri + 3);
+        for (uint32_t v : cache) {
+            if (v != tri[0] && v != tri[1] && v != tri[2]) {
+                nextCache.push_back(v);
+            }
+        }
+        for (size_t i = 0; i < nextCache.size(); ++i) {
+            uint32_t v = nextCache[i];
+            cachePosition[v] = i < FORSYTH_CACHE_SIZE ? static_cast<int>(i) : -1;
+            vertexScore[v] = forsythVertexScore(cachePosition[v], remaining[v]);
+        }
+        if (nextCache.size() > FORSYTH_CACHE_SIZE) {
+            nextCache.resize(FORSYTH_CACHE_SIZE);
+        }
+        cache.swap(nextCache);
+
+        // ֻлж (͸ձĶ) صη仯һδӻ涥ѡ
+        best = INVALID;
+        bestScore = -1.0f;
+        for (uint32_t v : cache) {
+            for (uint32_t i = 0; i < remaining[v]; ++i) {
+                uint32_t t = vertexTriangles[offsets[v] + i];
+                float score = triangleScore(t);
+                if (score > bestScore) {
+                    bestScore = score;
+                    best = t;
+                }
+            }
+        }
+    }
+    indices.swap(output);
+}
+
+void optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices) {
+    constexpr size_t CACHE_SIZE = 16;
+    constexpr size_t MIN_CLUSTER_TRIANGLES = 128;
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount < MIN_CLUSTER_TRIANGLES * 2) {
+        return;
+    }
+
+    // 1. зִأ㶼δлһĿʼ (Ӳ߽)
+    //    ؽϴʱδеδҲп (߽)ԻӰС
+    std::vector<uint32_t> clusterStarts;
+    std::vector<size_t> stamp(vertices.size(), 0);
+    size_t time = CACHE_SIZE + 1;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        int misses = 0;
+        for (int k = 0; k < 3; ++k) {
+            uint32_t v = indices[t * 3 + k];
+            if (time - stamp[v] > CACHE_SIZE) {
+                stamp[v] = time++;
+                ++misses;
+            }
+        }
+        size_t clusterSize = clusterStarts.empty() ? t : t - clusterStarts.back();
+        if (clusterStarts.empty() || misses == 3 || (misses >= 2 && clusterSize >= MIN_CLUSTER_TRIANGLES)) {
+            clusterStarts.push_back(static_cast<uint32_t>(t));
+        }
+    }
+    if (clusterStarts.size() < 2) {
+        return;
+    }
+    clusterStarts.push_back(static_cast<uint32_t>(triangleCount));
+
+    // 2. ÿصȨĺƽߣҳĴǰ
+    size_t clusterCount = clusterStarts.size() - 1;
+    std::vector<glm::vec3> clusterCentroid(clusterCount), clusterNormal(clusterCount);
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+    for (size_t c = 0; c < clusterCount; ++c) {
+        glm::vec3 centroid(0.0f), normal(0.0f);
+        float area = 0.0f;
+        for (uint32_t t = clusterStarts[c]; t < clusterStarts[c + 1]; ++t) {
+            const glm::vec3& a = vertices[indices[t * 3]].position;
+            const glm::vec3& b = vertices[indices[t * 3 + 1]].position;
+            const glm::vec3& d = vertices[indices[t * 3 + 2]].position;
+            glm::vec3 n = glm::cross(b - a, d - a);
+            float triangleArea = glm::length(n);
+            centroid += (a + b + d) / 3.0f * triangleArea;
+            normal += n;
+            area += triangleArea;
+        }
+        meshCentroid += centroid;
+        meshArea += area;
+        clusterCentroid[c] = area > 0.0f ? centroid / area : vertices[indices[clusterStarts[c] * 3]].position;
+        clusterNormal[c] = normal;
+    }
+    meshCentroid = meshArea > 0.0f ? meshCentroid / meshArea : glm::vec3(0.0f);
+
+    std::vector<float> sortKey(clusterCount);
+    for (size_t c = 0; c < clusterCount; ++c) {
+        float normalLength = glm::length(clusterNormal[c]);
+        sortKey[c] = normalLength > 0.0f ? glm::dot(clusterCentroid[c] - meshCentroid, clusterNormal[c] / normalLength) : 0.0f;
+    }
+    std::vector<uint32_t> order(clusterCount);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return sortKey[a] > sortKey[b]; });
+
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+    for (uint32_t c : order) {
+        output.insert(output.end(), indices.begin() + size_t(clusterStarts[c]) * 3, indices.begin() + size_t(clusterStarts[c + 1]) * 3);
+    }
+    indices.swap(output);
+}
+
+void optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices) {
+    std::vector<uint32_t> remap(vertices.size(), INVALID);
+    std::vector<Vertex> ordered;
+    ordered.reserve(vertices.size());
+    for (uint32_t& index : indices) {
+        if (remap[index] == INVALID) {
+            remap[index] = static_cast<uint32_t>(ordered.size());
+            ordered.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+    // ûбκõĶ㱻
+    vertices.swap(ordered);
+}
+
+std::vector<uint32_t> simplifyClusters(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+    uint32_t gridResolution, float& error) {
+    error = 0.0f;
+    glm::vec3 minBounds(std::numeric_limits<float>::max()), maxBounds(std::numeric_limits<float>::lowest());
+    for (uint32_t index : indices) {
+        minBounds = glm::min(minBounds, vertices[index].position);
+        maxBounds = glm::max(maxBounds, vertices[index].position);
+    }
+    glm::vec3 extent = maxBounds - minBounds;
+    float cellSize = std::max({ extent.x, extent.y, extent.z }) / static_cast<float>(std::max(1u, gridResolution));
+    if (indices.empty() || !(cellSize > 0.0f)) {
+        return indices;
+    }
+    glm::uvec3 dims = glm::uvec3(glm::max(glm::ceil(extent / cellSize), glm::vec3(1.0f)));
+
+    // 1. ڵĸӣÿӵλƽֵ
+    std::vector<uint32_t> clusterOf(vertices.size(), INVALID);
+    std::unordered_map<uint64_t, uint32_t> clusters;
+    std::vector<glm::vec3> clusterSum;
+    std::vector<uint32_t> clusterCount;
+    for (uint32_t index : indices) {
+        if (clusterOf[index] != INVALID) {
+            continue;
+        }
+        glm::uvec3 cell = glm::uvec3(glm::min(glm::vec3(dims - glm::uvec3(1)), glm::floor((vertices[index].position - minBounds) / cellSize)));
+        uint64_t key = cell.x + static_cast<uint64_t>(dims.x) * (cell.y + static_cast<uint64_t>(dims.y) * cell.z);
+        auto result = clusters.emplace(key, static_cast<uint32_t>(clusterSum.size()));
+        if (result.second) {
+            clusterSum.push_back(glm::vec3(0.0f));
+            clusterCount.push_back(0);
+        }
+        clusterOf[index] = result.first->second;
+        clusterSum[result.first->second] += vertices[index].position;
+        ++clusterCount[result.first->second];
+    }
+
+    // 2. ÿѡƽλԭΪLODֱӹԭ
+    std::vector<uint32_t> representative(clusterSum.size(), INVALID);
+    std::vector<float> bestDistance(clusterSum.size(), std::numeric_limits<float>::max());
+    for (uint32_t v = 0; v < vertices.size(); ++v) {
+        uint32_t cluster = clusterOf[v];
+        if (cluster == INVALID) {
+            continue;
+        }
+        glm::vec3 d = vertices[v].position - clusterSum[cluster] / static_cast<float>(clusterCount[cluster]);
+        float distance = glm::dot(d, d);
+        if (distance < bestDistance[cluster]) {
+            bestDistance[cluster] = distance;
+            representative[cluster] = v;
+        }
+    }
+
+    // 3. ϵĽͬһӵ˻ȥ
+    std::vector<uint32_t> result;
+    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+        uint32_t a = clusterOf[indices[t]], b = clusterOf[indices[t + 1]], c = clusterOf[indices[t + 2]];
+        if (a == b || b == c || a == c) {
+            continue;
+        }
+        result.push_back(representative[a]);
+        result.push_back(representative[b]);
+        result.push_back(representative[c]);
+    }
+    error = cellSize * std::sqrt(3.0f);
+    return result;
+}
+
+float computeAcmr(const std::vector<uint32_t>& indices, size_t vertexCount, size_t cacheSize) {
+    if (indices.size() < 3) {
+        return 0.0f;
+    }
+    std::vector<size_t> stamp(vertexCount, 0);
+    size_t time = cacheSize + 1;
+    size_t misses = 0;
+    for (uint32_t index : indices) {
+        if (time - stamp[index] > cacheSize) {
+            stamp[index] = time++;
+            ++misses;
+        }
+    }
+    return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+}
+
+uint16_t floatToHalf(float value) {
+    uint32_t f;
+    std::memcpy(&f, &value, sizeof(f));
+    uint32_t sign = (f >> 16) & 0x8000u;
+    uint32_t rawExponent = (f >> 23) & 0xFFu;
+    uint32_t mantissa = f & 0x7FFFFFu;
+    if (rawExponent == 0xFFu) {
+        return static_cast<uint16_t>(sign | 0x7C00u | (mantissa ? 0x200u : 0u)); // Inf / NaN
+    }
+    int exponent = static_cast<int>(rawExponent) - 127 + 15;
+    if (exponent >= 31) {
+        return static_cast<uint16_t>(sign | 0x7C00u); // Ϊ
+    }
+    if (exponent <= 0) {
+        // ǹż
+        if (exponent < -10) {
+            return static_cast<uint16_t>(sign);
+        }
+        mantissa |= 0x800000u;
+        uint32_t shift = static_cast<uint32_t>(14 - exponent);
+        uint32_t half = mantissa >> shift;
+        uint32_t rest = mantissa & ((1u << shift) - 1);
+        uint32_t halfway = 1u << (shift - 1);
+        if (rest > halfway || (rest == halfway && (half & 1u))) {
+            ++half;
+        }
+        return static_cast<uint16_t>(sign | half);
+    }
+    uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    uint32_t rest = mantissa & 0x1FFFu;
+    // λһֱָȻȷ
+    if (rest > 0x1000u || (rest == 0x1000u && (half & 1u))) {
+        ++half;
+    }
+    return static_cast<uint16_t>(half);
+}
+
+float halfToFloat(uint16_t value) {
+    uint32_t sign = static_cast<uint32_t>(value & 0x8000u) << 16;
+    uint32_t exponent = (value >> 10) & 0x1Fu;
+    uint32_t mantissa = value & 0x3FFu;
+    uint32_t f;
+    if (exponent == 0) {
+        if (mantissa == 0) {
+            f = sign;
+        }
+        else {
+            // ǹ񻯺ת
+            exponent = 127 - 15 + 1;
+            while ((mantissa & 0x400u) == 0) {
+                mantissa <<= 1;
+                --exponent;
+            }
+            f = sign | (exponent << 23) | ((mantissa & 0x3FFu) << 13);
+        }
+    }
+    else if (exponent == 31) {
+        f = sign | 0x7F800000u | (mantissa << 13);
+    }
+    else {
+        f = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+    }
+    float result;
+    std::memcpy(&result, &f, sizeof(result));
+    return result;
+}
+
+pack::CompactVertex quantizeVertex(const Vertex& vertex, const glm::vec3& quantizeOffset, const glm::vec3& quantizeScale) {
+    pack::CompactVertex out = {};
+    for (int axis = 0; axis < 3; ++axis) {
+        float normalized = quantizeScale[axis] > 0.0f ? (vertex.position[axis] - quantizeOffset[axis]) / quantizeScale[axis] : 0.0f;
+        out.position[axis] = static_cast<uint16_t>(std::lround(std::clamp(normalized, 0.0f, 1.0f) * 65535.0f));
+    }
+    auto snorm10 = [](float value) {
+        int quantized = static_cast<int>(std::lround(std::clamp(value, -1.0f, 1.0f) * 511.0f));
+        return static_cast<uint32_t>(quantized) & 0x3FFu;
+    };
+    out.normal = snorm10(vertex.normal.x) | (snorm10(vertex.normal.y) << 10) | (snorm10(vertex.normal.z) << 20);
+    out.texCoord[0] = floatToHalf(vertex.texCoord.x);
+    out.texCoord[1] = floatToHalf(vertex.texCoord.y);
+    return out;
+}
+
+void bakeModel(const ModelData& data, const MeshBakeOptions& options, CompactModelData& out, MeshBakeStats* stats) {
+    struct Work {
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        std::vector<Lod> lods;
+        MeshBakeStats stats;
+    };
+    std::vector<Work> work(data.meshes.size());
+
+    // 1. MeshJobSystemϲŻ
+    JobSystem::getInstance()->parallelFor(0, data.meshes.size(), [&](size_t begin, size_t end) {
+        for (size_t m = begin; m < end; ++m) {
+            const MeshData& mesh = data.meshes[m];
+            Work& w = work[m];
+            std::vector<Vertex> corners;
+            generateNormals(mesh.vertices, mesh.indices, options.creaseAngle, corners);
+            std::vector<uint32_t> lod0;
+            weldVertices(corners, w.vertices, lod0);
+            w.stats.inputVertices = mesh.vertices.size() / 5;
+            w.stats.triangles = lod0.size() / 3;
+            w.stats.acmrBefore = computeAcmr(lod0, w.vertices.size()) * w.stats.triangles;
+
+            optimizeVertexCache(lod0, w.vertices.size());
+            optimizeOverdraw(lod0, w.vertices);
+            w.stats.acmrAfter = computeAcmr(lod0, w.vertices.size()) * w.stats.triangles;
+
+            // LODÿLOD 0򻯣𼶼룻ٵòļ
+            w.indices = lod0;
+            w.lods.push_back({ 0, static_cast<uint32_t>(lod0.size()), 0.0f });
+            uint32_t grid = options.lodGridResolution;
+            size_t previousTriangles = lod0.size() / 3;
+            while (w.lods.size() < std::min<uint32_t>(options.lodCount, pack::MAX_LODS) && grid >= 2 && previousTriangles > 0) {
+                float error = 0.0f;
+                std::vector<uint32_t> simplified = simplifyClusters(w.vertices, lod0, grid, error);
+                grid /= 2;
+                size_t triangles = simplified.size() / 3;
+                if (triangles == 0) {
+                    break;
+                }
+                if (static_cast<float>(triangles) > static_cast<float>(previousTriangles) * (1.0f - options.minLodReduction)) {
+                    continue;
+                }
+                optimizeVertexCache(simplified, w.vertices.size());
+                w.lods.push_back({ static_cast<uint32_t>(w.indices.size()), static_cast<uint32_t>(simplified.size()), error });
+                w.indices.insert(w.indices.end(), simplified.begin(), simplified.end());
+                w.stats.lodTriangles += triangles;
+                previousTriangles = triangles;
+            }
+
+            // LODĴ㶼LOD 0״ʹʱLOD 0˳
+            optimizeVertexFetch(w.vertices, w.indices);
+            w.stats.outputVertices = w.vertices.size();
+        }
+    }, 1);
+
+    // 2. ģ͹һΧʱֻҪһԭ
+    glm::vec3 minBounds(std::numeric_limits<float>::max()), maxBounds(std::numeric_limits<float>::lowest());
+    for (const Work& w : work) {
+        for (const Vertex& vertex : w.vertices) {
+            minBounds = glm::min(minBounds, vertex.position);
+            maxBounds = glm::max(maxBounds, vertex.position);
+        }
+    }
+    if (minBounds.x > maxBounds.x) {
+        minBounds = maxBounds = glm::vec3(0.0f);
+    }
+    out.minCoords = data.minCoords;
+    out.maxCoords = data.maxCoords;
+    out.origin = data.origin;
+    out.quantizeOffset = minBounds;
+    out.quantizeScale = glm::max(maxBounds - minBounds, glm::vec3(1e-6f));
+    out.meshes.clear();
+
+    MeshBakeStats total;
+    for (size_t m = 0; m < work.size(); ++m) {
+        Work& w = work[m];
+        total.inputVertices += w.stats.inputVertices;
+        total.outputVertices += w.stats.outputVertices;
+        total.triangles += w.stats.triangles;
+        total.lodTriangles += w.stats.lodTriangles;
+        total.acmrBefore += w.stats.acmrBefore;
+        total.acmrAfter += w.stats.acmrAfter;
+        if (w.indices.empty()) {
+            continue;
+        }
+        CompactMeshData mesh;
+        mesh.materialName = data.meshes[m].materialName;
+        mesh.vertices.resize(w.vertices.size());
+        for (size_t v = 0; v < w.vertices.size(); ++v) {
+            mesh.vertices[v] = quantizeVertex(w.vertices[v], out.quantizeOffset, out.quantizeScale);
+        }
+        mesh.indices = std::move(w.indices);
+        mesh.lods = std::move(w.lods);
+        out.meshes.push_back(std::move(mesh));
+    }
+    if (total.triangles > 0) {
+        total.acmrBefore /= static_cast<float>(total.triangles);
+        total.acmrAfter /= static_cast<float>(total.triangles);
+    }
+    if (stats) {
+        *stats = total;
+    }
+}
+}
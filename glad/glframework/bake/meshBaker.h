@@ -0,0 +1,103 @@
+#pragma once
+
+#include "../core.h"          // glm
+#include "../model.h"         // ModelData
+#include "../pack/packFormat.h" // CompactVertex, MAX_LODS
+
+#include <cstdint>            // uint32_t
+#include <string>             // std::string
+#include <vector>             // std::vector
+
+// Ż (tools/modelConverterʹãʱҪ)
+// bakeModelModelDataеÿMeshִУ
+//   1. չΪǶ㣬ۺ۽ɷ (нСcreaseAngleƽӲ)
+//   2. λ//UVȫͬĶ㣻
+//   3. 㻺Ż (Forsythٶ㷨)
+//   4. ȻŻδагɴأĴǰ棬ȻĴظڵ󻭵ģ
+//   5. öLODLODLOD 0Ķ㣬ÿŻ
+//   6. ȡŻ㰴״γֵ˳ţ
+//   7. ΪCompactVertex㲻65536ʱʹ16λ
+// Ҳ߹иá
+namespace bake {
+    // ޸ĺ決㷨ʽʱ1ʹݻеľɽʧЧ
+    constexpr uint32_t MESH_BAKE_VERSION = 1;
+
+    struct MeshBakeOptions {
+        uint32_t lodCount = pack::MAX_LODS;  // ɵLOD (LOD 0)
+        float creaseAngle = 60.0f;           // ƽۺ۽ ()
+        uint32_t lodGridResolution = 64;     // LOD 1ϵĸ֮ÿ
+        float minLodReduction = 0.2f;        // ٲʱɸֵLOD
+    };
+
+    // Żʹõδ
+    struct Vertex {
+        glm::vec3 position = glm::vec3(0.0f);
+        glm::vec3 normal = glm::vec3(0.0f);
+        glm::vec2 texCoord = glm::vec2(0.0f);
+    };
+
+    struct Lod {
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+        float error = 0.0f;
+    };
+
+    struct CompactMeshData {
+        std::string materialName;
+        std::vector<pack::CompactVertex> vertices;
+        std::vector<uint32_t> indices;       // LOD
+        std::vector<Lod> lods;
+    };
+
+    struct CompactModelData {
+        glm::vec3 minCoords = glm::vec3(0.0f);   // ԭʼµı߽ (ModelData)
+        glm::vec3 maxCoords = glm::vec3(0.0f);
+        glm::dvec3 origin = glm::dvec3(0.0);
+        glm::vec3 quantizeOffset = glm::vec3(0.0f);
+        glm::vec3 quantizeScale = glm::vec3(1.0f);
+        std::vector<CompactMeshData> meshes;
+    };
+
+    struct MeshBakeStats {
+        size_t inputVertices = 0;
+        size_t outputVertices = 0;
+        size_t triangles = 0;           // LOD 0
+        size_t lodTriangles = 0;        // LOD 1ϵ
+        float acmrBefore = 0.0f;        // ƽδ (ÿ)Żǰ
+        float acmrAfter = 0.0f;         // Ż
+    };
+
+    // Żģͣmeshesdata.meshesһһӦ (ûεMesh)
+    void bakeModel(const ModelData& data, const MeshBakeOptions& options, CompactModelData& out, MeshBakeStats* stats = nullptr);
+
+    // ---- Ĳ ----
+
+    // PosXYZ + UVչΪǶ㲢ɷ (creaseAngle)
+    void generateNormals(const std::vector<float>& interleaved, const std::vector<unsigned int>& indices, float creaseAngle,
+        std::vector<Vertex>& corners);
+
+    // ȫͬĶ㣬cornersΪǶ (corners.size()Ϊ3ı)
+    void weldVertices(const std::vector<Vertex>& corners, std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+    // Forsyth㻺Żԭ
+    void optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+
+    // ڲƻֲԵǰ°ΣٹȻ
+    void optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices);
+
+    // 㰴״ʹõ˳ţд
+    void optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<uint32_t>& indices);
+
+    // 򻯣gridResolutionΪϵĸصԭ㣻errorΪӵĶԽ߳
+    std::vector<uint32_t> simplifyClusters(const std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices,
+        uint32_t gridResolution, float& error);
+
+    // ģFIFO㻺棬ÿεƽδд
+    float computeAcmr(const std::vector<uint32_t>& indices, size_t vertexCount, size_t cacheSize = 16);
+
+    // һ (λ[quantizeOffset, quantizeOffset + quantizeScale])
+    pack::CompactVertex quantizeVertex(const Vertex& vertex, const glm::vec3& quantizeOffset, const glm::vec3& quantizeScale);
+
+    uint16_t floatToHalf(float value);
+    float halfToFloat(uint16_t value);
+}
@@ -0,0 +1,308 @@
+#include "textureBaker.h"
+#include "../job/jobSystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace bake {
+namespace {
+    // sRGB <-> 
+    const float* srgbToLinearTable() {
+        static const std::vector<float> table = []() {
+            std::vector<float> values(256);
+            for (int i = 0; i < 256; ++i) {
+                float c = i / 255.0f;
+                values[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+            }
+            return values;
+        }();
+        return table.data();
+    }
+
+    unsigned char linearToSrgb(float value) {
+        value = std::clamp(value, 0.0f, 1.0f);
+        float c = value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+        return static_cast<unsigned char>(std::lround(c * 255.0f));
+    }
+
+    // ---- BC1 ----
+
+    uint16_t packRgb565(const float color[3]) {
+        int r = static_cast<int>(std::lround(std::clamp(color[0], 0.0f, 255.0f) * 31.0f / 255.0f));
+        int g = static_cast<int>(std::lround(std::clamp(color[1], 0.0f, 255.0f) * 63.0f / 255.0f));
+        int b = static_cast<int>(std::lround(std::clamp(color[2], 0.0f, 255.0f) * 31.0f / 255.0f));
+        return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+    }
+
+    void unpackRgb565(uint16_t packed, int color[3]) {
+        int r = (packed >> 11) & 31, g = (packed >> 5) & 63, b = packed & 31;
+        color[0] = (r << 3) | (r >> 2);
+        color[1] = (g << 2) | (g >> 4);
+        color[2] = (b << 3) | (b >> 2);
+    }
+
+    // һµ4ɫɫ (c0 > c1)c0 == c1ʱֻõ0
+    void buildPalette(uint16_t c0, uint16_t c1, int palette[4][3]) {
+        unpackRgb565(c0, palette[0]);
+        unpackRgb565(c1, palette[1]);
+        for (int i = 0; i < 3; ++i) {
+            palette[2][i] = (2 * palette[0][i] + palette[1][i]) / 3;
+            palette[3][i] = (palette[0][i] + 2 * palette[1][i]) / 3;
+        }
+    }
+
+    // Ϊÿѡĵɫɫƽ
+    int chooseIndices(const unsigned char block[16][4], uint16_t c0, uint16_t c1, uint32_t& indices) {
+        int palette[4][3];
+        buildPalette(c0, c1, palette);
+        int paletteSize = c0 == c1 ? 1 : 4;
+        indices = 0;
+        int totalError = 0;
+        for (int p = 0; p < 16; ++p) {
+            int bestIndex = 0, bestError = 0x7FFFFFFF;
+            for (int i = 0; i < paletteSize; ++i) {
+                int dr = block[p][0] - palette[i][0], dg = block[p][1] - palette[i][1], db = block[p][2] - palette[i][2];
+                int error = dr * dr + dg * dg + db * db;
+                if (error < bestError) {
+                    bestError = error;
+                    bestIndex = i;
+                }
+            }
+            indices |= static_cast<uint32_t>(bestIndex) << (p * 2);
+            totalError += bestError;
+        }
+        return totalError;
+    }
+
+    // ֤c0 > c1 (4ɫģʽ)˵ʱ0/12/3
+    void orderEndpoints(uint16_t& c0, uint16_t& c1, uint32_t& indices) {
+        if (c0 < c1) {
+            std::swap(c0, c1);
+            indices ^= 0x55555555u;
+        }
+    }
+
+    void compressBlock(const unsigned char block[16][4], uint8_t out[8]) {
+        // 1. ɫľֵЭݵ
+        float mean[3] = { 0.0f, 0.0f, 0.0f };
+        for (int p = 0; p < 16; ++p) {
+            for (int i = 0; i < 3; ++i) {
+                mean[i] += block[p][i] / 16.0f;
+            }
+        }
+        float cov[6] = {};
+        for (int p = 0; p < 16; ++p) {
+            float r = block[p][0] - mean[0], g = block[p][1] - mean[1], b = block[p][2] - mean[2];
+            cov[0] += r * r; cov[1] += r * g; cov[2] += r * b;
+            cov[3] += g * g; cov[4] += g * b; cov[5] += b * b;
+        }
+        float axis[3] = { 1.0f, 1.0f, 1.0f };
+        for (int iteration = 0; iteration < 8; ++iteration) {
+            float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+            float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+            float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+            float length = std::max({ std::abs(x), std::abs(y), std::abs(z) });
+            if (length <= 0.0f) {
+                break;
+            }
+            axis[0] = x / length; axis[1] = y / length; axis[2] = z / length;
+        }
+
+        // 2. ͶӰΧΪ˵㣬1/16
+        float minProjection = 1e30f, maxProjection = -1e30f;
+        for (int p = 0; p < 16; ++p) {
+            float projection = (block[p][0] - mean[0]) * axis[0] + (block[p][1] - mean[1]) * axis[1] + (block[p][2] - mean[2]) * axis[2];
+            minProjection = std::min(minProjection, projection);
+            maxProjection = std::max(maxProjection, projection);
+        }
+        float inset = (maxProjection - minProjection) / 16.0f;
+        float axisLengthSquared = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+        float high[3], low[3];
+        for (int i = 0; i < 3; ++i) {
+            float direction = axisLengthSquared > 0.0f ? axis[i] / axisLengthSquared : 0.0f;
+            high[i] = mean[i] + direction * (maxProjection - inset);
+            low[i] = mean[i] + direction * (minProjection + inset);
+        }
+        uint16_t c0 = packRgb565(high), c1 = packRgb565(low);
+        uint32_t indices = 0;
+        if (c0 < c1) {
+            std::swap(c0, c1);
+        }
+        int error = chooseIndices(block, c0, c1, indices);
+
+        // 3. ̶С϶˵㣺color = a * c0 + b * c1Ȩ
+        if (c0 != c1) {
+            static const float weightA[4] = { 1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f };
+            float aa = 0.0f, bb = 0.0f, ab = 0.0f, ax[3] = {}, bx[3] = {};
+            for (int p = 0; p < 16; ++p) {
+                float a = weightA[(indices >> (p * 2)) & 3], b = 1.0f - a;
+                aa += a * a; bb += b * b; ab += a * b;
+                for (int i = 0; i < 3; ++i) {
+                    ax[i] += a * block[p][i];
+                    bx[i] += b * block[p][i];
+                }
+            }
+            float determinant = aa * bb - ab * ab;
+            if (std::abs(determinant) > 1e-6f) {
+                float fitHigh[3], fitLow[3];
+                for (int i = 0; i < 3; ++i) {
+                    fitHigh[i] = (ax[i] * bb - bx[i] * ab) / determinant;
+                    fitLow[i] = (bx[i] * aa - ax[i] * ab) / determinant;
+                }
+                uint16_t r0 = packRgb565(fitHigh), r1 = packRgb565(fitLow);
+                uint32_t refinedIndices = 0;
+                if (r0 < r1) {
+                    std::swap(r0, r1);
+                }
+                int refinedError = chooseIndices(block, r0, r1, refinedIndices);
+                if (refinedError < error) {
+                    c0 = r0;
+                    c1 = r1;
+                    indices = refinedIndices;
+                }
+            }
+        }
+        orderEndpoints(c0, c1, indices);
+
+        out[0] = static_cast<uint8_t>(c0 & 0xFF);
+        out[1] = static_cast<uint8_t>(c0 >> 8);
+        out[2] = static_cast<uint8_t>(c1 & 0xFF);
+        out[3] = static_cast<uint8_t>(c1 >> 8);
+        for (int i = 0; i < 4; ++i) {
+            out[4 + i] = static_cast<uint8_t>(indices >> (i * 8));
+        }
+    }
+}
+
+std::vector<ImageData> generateMips(const ImageData& image) {
+    std::vector<ImageData> mips;
+    mips.push_back(image);
+    const float* toLinear = srgbToLinearTable();
+    while (mips.back().width > 1 || mips.back().height > 1) {
+        const ImageData& source = mips.back();
+        ImageData mip;
+        mip.width = std::max(1, source.width / 2);
+        mip.height = std::max(1, source.height / 2);
+        mip.pixels.resize(static_cast<size_t>(mip.width) * mip.height * 4);
+        JobSystem::getInstance()->parallelFor(0, static_cast<size_t>(mip.height), [&](size_t begin, size_t end) {
+            for (size_t y = begin; y < end; ++y) {
+                for (int x = 0; x < mip.width; ++x) {
+                    float sum[4] = {};
+                    // ߴʱһ/ֻȡ߽
+                    for (int dy = 0; dy < 2; ++dy) {
+                        int sy = std::min(source.height - 1, static_cast<int>(y) * 2 + dy);
+                        for (int dx = 0; dx < 2; ++dx) {
+                            int sx = std::min(source.width - 1, x * 2 + dx);
+                            const unsigned char* p = &source.pixels[(static_cast<size_t>(sy) * source.width + sx) * 4];
+                            sum[0] += toLinear[p[0]];
+                            sum[1] += toLinear[p[1]];
+                            sum[2] += toLinear[p[2]];
+                            sum[3] += p[3];
+                        }
+                    }
+                    unsigned char* out = &mip.pixels[(y * mip.width + x) * 4];
+                    out[0] = linearToSrgb(sum[0] / 4.0f);
+                    out[1] = linearToSrgb(sum[1] / 4.0f);
+                    out[2] = linearToSrgb(sum[2] / 4.0f);
+                    out[3] = static_cast<unsigned char>(std::lround(sum[3] / 4.0f));
+                }
+            }
+        }, 16);
+        mips.push_back(std::move(mip));
+    }
+    return mips;
+}
+
+bool hasTranslucency(const ImageData& image) {
+    for (size_t i = 3; i < image.pixels.size(); i += 4) {
+        if (image.pixels[i] != 255) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void compressBc1(const unsigned char* rgba, int width, int height, uint8_t* out) {
+    int blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    JobSystem::getInstance()->parallelFor(0, static_cast<size_t>(blocksY), [&](size_t begin, size_t end) {
+        unsigned char block[16][4];
+        for (size_t by = begin; by < end; ++by) {
+            for (int bx = 0; bx < blocksX; ++bx) {
+                // Ե4x4Ŀظ߽
+                for (int p = 0; p < 16; ++p) {
+                    int x = std::min(width - 1, bx * 4 + (p & 3));
+                    int y = std::min(height - 1, static_cast<int>(by) * 4 + (p >> 2));
+                    std::memcpy(block[p], rgba + (static_cast<size_t>(y) * width + x) * 4, 4);
+                }
+                compressBlock(block, out + (by * blocksX + bx) * 8);
+            }
+        }
+    }, 8);
+}
+
+void decompressBc1(const uint8_t* blocks, int width, int height, unsigned char* rgba) {
+    int blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    for (int by = 0; by < blocksY; ++by) {
+        for (int bx = 0; bx < blocksX; ++bx) {
+            const uint8_t* block = blocks + (static_cast<size_t>(by) * blocksX + bx) * 8;
+            uint16_t c0 = static_cast<uint16_t>(block[0] | (block[1] << 8));
+            uint16_t c1 = static_cast<uint16_t>(block[2] | (block[3] << 8));
+            uint32_t indices = block[4] | (block[5] << 8) | (block[6] << 16) | (static_cast<uint32_t>(block[7]) << 24);
+            int palette[4][4];
+            unpackRgb565(c0, palette[0]);
+            unpackRgb565(c1, palette[1]);
+            palette[0][3] = palette[1][3] = palette[2][3] = palette[3][3] = 255;
+            for (int i = 0; i < 3; ++i) {
+                if (c0 > c1) {
+                    palette[2][i] = (2 * palette[0][i] + palette[1][i]) / 3;
+                    palette[3][i] = (palette[0][i] + 2 * palette[1][i]) / 3;
+                }
+                else {
+                    // 3ɫģʽ4Ϊ͸
+                    palette[2][i] = (palette[0][i] + palette[1][i]) / 2;
+                    palette[3][i] = 0;
+                }
+            }
+            if (c0 <= c1) {
+                palette[3][3] = 0;
+            }
+            for (int p = 0; p < 16; ++p) {
+                int x = bx * 4 + (p & 3), y = by * 4 + (p >> 2);
+                if (x >= width || y >= height) {
+                    continue;
+                }
+                const int* color = palette[(indices >> (p * 2)) & 3];
+                unsigned char* out = rgba + (static_cast<size_t>(y) * width + x) * 4;
+                for (int i = 0; i < 4; ++i) {
+                    out[i] = static_cast<unsigned char>(color[i]);
+                }
+            }
+        }
+    }
+}
+
+void bakeTexture(const ImageData& image, const TextureBakeOptions& options, BakedTexture& out) {
+    std::vector<ImageData> mips = generateMips(image);
+    out.width = static_cast<uint32_t>(image.width);
+    out.height = static_cast<uint32_t>(image.height);
+    out.mipCount = static_cast<uint32_t>(mips.size());
+    out.format = options.compress && !hasTranslucency(image) ? pack::TextureFormat::Bc1 : pack::TextureFormat::Rgba8;
+
+    uint64_t totalSize = 0;
+    for (const ImageData& mip : mips) {
+        totalSize += pack::mipSize(out.format, static_cast<uint32_t>(mip.width), static_cast<uint32_t>(mip.height));
+    }
+    out.data.resize(static_cast<size_t>(totalSize));
+    uint8_t* cursor = out.data.data();
+    for (const ImageData& mip : mips) {
+        if (out.format == pack::TextureFormat::Bc1) {
+            compressBc1(mip.pixels.data(), mip.width, mip.height, cursor);
+        }
+        else {
+            std::memcpy(cursor, mip.pixels.data(), mip.pixels.size());
+        }
+        cursor += pack::mipSize(out.format, static_cast<uint32_t>(mip.width), static_cast<uint32_t>(mip.height));
+    }
+}
+}
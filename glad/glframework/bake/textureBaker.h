@@ -0,0 +1,42 @@
+#pragma once
+
+#include "../texture.h"       // ImageData
+#include "../pack/packFormat.h" // TextureFormat
+
+#include <cstdint>            // uint8_t
+#include <vector>             // std::vector
+
+// mipmapѹΪBC1 (tools/modelConverterʹ)
+// - mipmapԿռ2x2ʽ˲ (ͼsRGB洢ֱƽƫ)
+// - BC1룺ÿ4x4ɫ (Э) ȡ˵㣬С˰һζ˵㣬
+//   ȡСĽ
+// - а͸صͼRGBA8 (BC1ֻ1λ͸)
+// decompressBc1Ҳʱʹã֧S3TCʱԴеBC1ѹRGBA8ϴ
+namespace bake {
+    // ޸mipmapɡѹ㷨ʽʱ1ʹݻеľɽʧЧ
+    constexpr uint32_t TEXTURE_BAKE_VERSION = 1;
+
+    struct TextureBakeOptions {
+        bool compress = true;           // falseʱRGBA8ֻmipmap
+    };
+
+    struct BakedTexture {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        pack::TextureFormat format = pack::TextureFormat::Rgba8;
+        uint32_t mipCount = 0;
+        std::vector<uint8_t> data;      // mipmap (packFormat.h)
+    };
+
+    // mipmap0ΪԭͼһΪ1x1
+    std::vector<ImageData> generateMips(const ImageData& image);
+
+    // ǷalphaΪ255
+    bool hasTranslucency(const ImageData& image);
+
+    // ѹ/ѹһͼout/rgbaĴСֱΪpack::mipSize(Bc1, ...)width * height * 4ֽ
+    void compressBc1(const unsigned char* rgba, int width, int height, uint8_t* out);
+    void decompressBc1(const uint8_t* blocks, int width, int height, unsigned char* rgba);
+
+    void bakeTexture(const ImageData& image, const TextureBakeOptions& options, BakedTexture& out);
+}
@@ -0,0 +1,157 @@
+#include "clipSet.h"
+#include "../shader.h"
+#include "../../wrapper/checkError.h"
+
+#include <cmath>
+#include <iostream>
+
+ClipSet::~ClipSet() {
+    if (m_capVao != 0) {
+        GL_CALL(glDeleteVertexArrays(1, &m_capVao));
+        m_capVao = 0;
+    }
+}
+
+int ClipSet::addPlane(const glm::vec3& normal, const glm::vec3& point) {
+    if (m_planeCount >= MAX_PLANES) {
+        std::cerr << "WARNING: ClipSet supports at most " << MAX_PLANES << " planes, plane ignored." << std::endl;
+        return -1;
+    }
+    int index = m_planeCount++;
+    setPlane(index, normal, point);
+    return index;
+}
+
+void ClipSet::setPlane(int index, const glm::vec3& normal, const glm::vec3& point) {
+    if (index < 0 || index >= m_planeCount) {
+        return;
+    }
+    // ߹һƽ淽̵ֵƽľ룬GPUֵĲüҲ絥λԱ仯
+    glm::vec3 n = glm::normalize(normal);
+    m_planes[index] = glm::vec4(n, -glm::dot(n, point));
+}
+
+void ClipSet::setBox(const glm::vec3& minCorner, const glm::vec3& maxCorner) {
+    clear();
+    for (int axis = 0; axis < 3; ++axis) {
+        glm::vec3 normal(0.0f);
+        normal[axis] = 1.0f;
+        addPlane(normal, minCorner);
+        addPlane(-normal, maxCorner);
+    }
+}
+
+void ClipSet::clear() {
+    m_planeCount = 0;
+}
+
+ClipSet::Classification ClipSet::classify(const glm::vec3& minCorner, const glm::vec3& maxCorner, const glm::mat4& transform) const {
+    // ƽ p  M * x ֵƽ transpose(M) * p Ծֲ x ֵ
+    glm::mat4 toLocal = glm::transpose(transform);
+    glm::vec3 center = (minCorner + maxCorner) * 0.5f;
+    glm::vec3 halfExtent = (maxCorner - minCorner) * 0.5f;
+    Classification result = Classification::Inside;
+    for (int i = 0; i < m_planeCount; ++i) {
+        if (!(m_activeMask & (1u << i))) {
+            continue;
+        }
+        glm::vec4 plane = toLocal * m_planes[i];
+        glm::vec3 normal(plane);
+        // Χĵƽ淽ֵӼΧط߷İ뾶õнǵȡֵΧ
+        float distance = glm::dot(normal, center) + plane.w;
+        float radius = glm::dot(glm::abs(normal), halfExtent);
+        if (distance + radius < 0.0f) {
+            return Classification::Clipped;
+        }
+        if (distance - radius < 0.0f) {
+            result = Classification::Intersecting;
+        }
+    }
+    return result;
+}
+
+void ClipSet::apply(Shader& shader) const {
+    // Чƽ洫 (0, 0, 0, 1)ʹӦĲü뱻Ҳõκζ
+    std::array<glm::vec4, MAX_PLANES> planes;
+    for (int i = 0; i < MAX_PLANES; ++i) {
+        bool active = i < m_planeCount && (m_activeMask & (1u << i));
+        planes[i] = active ? m_planes[i] : glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        if (active) {
+            GL_CALL(glEnable(GL_CLIP_DISTANCE0 + i));
+        }
+        else {
+            GL_CALL(glDisable(GL_CLIP_DISTANCE0 + i));
+        }
+    }
+    shader.setVector4("clipPlanes", glm::value_ptr(planes[0]), MAX_PLANES);
+}
+
+void ClipSet::disableClipDistances() {
+    for (int i = 0; i < MAX_PLANES; ++i) {
+        GL_CALL(glDisable(GL_CLIP_DISTANCE0 + i));
+    }
+}
+
+void ClipSet::drawCaps(Shader& capShader, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix,
+    const glm::vec3& center, float extent, const glm::vec3& color, const std::function<void()>& drawGeometry) {
+    if (m_planeCount == 0) {
+        return;
+    }
+    if (m_capVao == 0) {
+        GL_CALL(glGenVertexArrays(1, &m_capVao));
+    }
+
+    const uint32_t allPlanes = m_activeMask;
+    GL_CALL(glEnable(GL_STENCIL_TEST));
+    for (int i = 0; i < m_planeCount; ++i) {
+        if (!(allPlanes & (1u << i))) {
+            continue;
+        }
+        // ƽ볡Χཻʱûз
+        glm::vec3 normal(m_planes[i]);
+        float centerDistance = glm::dot(normal, center) + m_planes[i].w;
+        if (std::abs(centerDistance) >= extent) {
+            continue;
+        }
+
+        // 1. ֻƽiüͳÿرǵıż (Ȳԣ涼)
+        GL_CALL(glClear(GL_STENCIL_BUFFER_BIT));
+        GL_CALL(glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE));
+        GL_CALL(glDepthMask(GL_FALSE));
+        GL_CALL(glDisable(GL_DEPTH_TEST));
+        GL_CALL(glStencilFunc(GL_ALWAYS, 0, 0xFF));
+        GL_CALL(glStencilOp(GL_KEEP, GL_KEEP, GL_INVERT));
+        m_activeMask = 1u << i;
+        drawGeometry();
+
+        // 2. ƽϻƷıΣƽüֻģֵ0
+        GL_CALL(glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE));
+        GL_CALL(glDepthMask(GL_TRUE));
+        GL_CALL(glEnable(GL_DEPTH_TEST));
+        GL_CALL(glStencilFunc(GL_NOTEQUAL, 0, 0xFF));
+        GL_CALL(glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP));
+        m_activeMask = allPlanes & ~(1u << i);
+
+        // ıεΪΧƽϵͶӰƽһ
+        glm::vec3 capCenter = center - normal * centerDistance;
+        glm::vec3 helper = std::abs(normal.y) < 0.9f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+        glm::vec3 axisU = glm::normalize(glm::cross(normal, helper)) * extent;
+        glm::vec3 axisV = glm::cross(normal, axisU);
+
+        capShader.begin();
+        apply(capShader);
+        capShader.setMatrix4x4("viewMatrix", viewMatrix);
+        capShader.setMatrix4x4("projectionMatrix", projectionMatrix);
+        capShader.setVector3("capCenter", capCenter.x, capCenter.y, capCenter.z);
+        capShader.setVector3("capAxisU", axisU.x, axisU.y, axisU.z);
+        capShader.setVector3("capAxisV", axisV.x, axisV.y, axisV.z);
+        capShader.setVector3("capColor", color.x, color.y, color.z);
+        GL_CALL(glBindVertexArray(m_capVao));
+        GL_CALL(glDrawArrays(GL_TRIANGLE_STRIP, 0, 4));
+        GL_CALL(glBindVertexArray(0));
+        capShader.end();
+    }
+    m_activeMask = allPlanes;
+    GL_CALL(glDisable(GL_STENCIL_TEST));
+    disableClipDistances();
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "../core.h"          // GLAD, glm
+
+#include <array>              // std::array
+#include <cstdint>            // uint32_t
+#include <functional>         // std::function
+
+class Shader;
+
+// ClipSetƽк (ʱģп)
+// - ÿƽ汣 ax + by + cz + d >= 0 һ ()ƽͬʱЧʱǵĽ
+//   км6ڵƽ棻
+// - üGPUͨgl_ClipDistance[i] (ɫд룬assets/shaders/vertex.glsl)
+//   еͼԪڹդ֮ǰͱõҪƬɫdiscard
+// - ֮ǰclassify()CPUжMeshİΧУȫеMesh (Ƭ) ֱ
+//   㴦ĿҲʡ
+// - ķ (cap) ģ建ɣdrawCaps()
+// ֻGL߳ʹá
+class ClipSet {
+public:
+    // ͬʱЧƽռòü0 ~ MAX_PLANES-1ShaderжʹòüMAX_PLANES
+    static constexpr int MAX_PLANES = 6;
+
+    enum class Classification {
+        Inside,         // ȫᱻü
+        Intersecting,   // ĳƽཻGPUü
+        Clipped         // ȫеҪ
+    };
+
+    ClipSet() = default;
+    ~ClipSet();
+
+    // зõVAOֹ
+    ClipSet(const ClipSet&) = delete;
+    ClipSet& operator=(const ClipSet&) = delete;
+
+    // һƽ棺normalָһ࣬pointΪƽϵһ㡣ƽţʱ-1
+    int addPlane(const glm::vec3& normal, const glm::vec3& point);
+
+    // ޸һеƽ (罻ʽ϶)Чʱ
+    void setPlane(int index, const glm::vec3& normal, const glm::vec3& point);
+
+    // к滻ƽ棺ֻڲ
+    void setBox(const glm::vec3& minCorner, const glm::vec3& maxCorner);
+
+    // ɾƽ
+    void clear();
+
+    bool empty() const { return m_planeCount == 0; }
+    int getPlaneCount() const { return m_planeCount; }
+    const glm::vec4& getPlane(int index) const { return m_planes[index]; }
+
+    // жϰΧ뵱ǰЧƽĹϵ
+    // - minCorner/maxCorner: ֲµİΧУ
+    // - transform: ֲ굽ı任 (ƽ任ֲжϣҪ任Χ)
+    // ûƽʱInside
+    Classification classify(const glm::vec3& minCorner, const glm::vec3& maxCorner, const glm::mat4& transform = glm::mat4(1.0f)) const;
+
+    // ƽ洫Shader (uniform vec4 clipPlanes[MAX_PLANES])ֻЧƽӦGL_CLIP_DISTANCEi
+    // Shader::begin()֮󡢻֮ǰ
+    void apply(Shader& shader) const;
+
+    // رƽӦGL_CLIP_DISTANCEi
+    static void disableClipDistances();
+
+    // ķڣ֮ (ҪȻ8λģ建)
+    // ÿƽ棬ֻһƽüرɫд»һ鼸壬涼תģֵ
+    // ȥ渲ǵأƽ϶Ӧĵλڷģڲ֮ƽϻһ
+    // ı (ƽü)ֻдģֵ0أдȡ
+    // - capShader: assets/shaders/capVertex.glsl / capFragment.glsl
+    // - center/extent: İΧ򣬷ıθƽΧĽ
+    // - drawGeometry: Ʊеļ壬ҪԼShaderapply() (classifyֻͬʹõǰƽ)
+    void drawCaps(Shader& capShader, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix,
+        const glm::vec3& center, float extent, const glm::vec3& color, const std::function<void()>& drawGeometry);
+
+private:
+    std::array<glm::vec4, MAX_PLANES> m_planes{};
+    int m_planeCount = 0;
+    uint32_t m_activeMask = ~0u;    // Чƽ (drawCapsڼÿֻһ)
+    GLuint m_capVao = 0;            // ıεĶShadergl_VertexIDɣֻҪһVAO
+};
@@ -0,0 +1,153 @@
+#include "bvh.h"
+#include "../spatial/spaceFillingCurve.h"
+
+#include <limits>
+#include <numeric>
+
+namespace collision {
+    namespace {
+        constexpr int BIN_COUNT = 16;
+        // ҶӳʱʹSAHΪֵҲ
+        constexpr uint32_t MAX_FORCED_LEAF = 16;
+
+        float surfaceArea(const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+            glm::vec3 extent = glm::max(boundsMax - boundsMin, glm::vec3(0.0f));
+            return 2.0f * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+        }
+
+        struct BuildTask {
+            uint32_t node;
+            uint32_t first;
+            uint32_t count;
+            uint32_t depth;
+        };
+
+        struct Bin {
+            glm::vec3 boundsMin = glm::vec3(std::numeric_limits<float>::max());
+            glm::vec3 boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+            uint32_t count = 0;
+        };
+    }
+
+    void buildBvh(const std::vector<glm::vec3>& boxesMin, const std::vector<glm::vec3>& boxesMax, uint32_t maxLeafSize,
+        std::vector<BvhNode>& nodes, std::vector<uint32_t>& order) {
+        nodes.clear();
+        order.resize(boxesMin.size());
+        std::iota(order.begin(), order.end(), 0u);
+        if (order.empty()) {
+            return;
+        }
+        maxLeafSize = std::max(maxLeafSize, 1u);
+
+        std::vector<glm::vec3> centroids(boxesMin.size());
+        for (size_t i = 0; i < centroids.size(); ++i) {
+            centroids[i] = (boxesMin[i] + boxesMax[i]) * 0.5f;
+        }
+        // ͼԪȰĵMorton˳ٹʱͨorderӷʰΧУ
+        // Ϊļ˳ʱÿһ㶼ʣźͬһͼԪڴҲһ
+        // orderص÷ı
+        std::vector<uint32_t> curve = spatial::curveOrder(centroids, spatial::Curve::Morton);
+        std::vector<glm::vec3> sortedMin = spatial::permute(boxesMin, curve);
+        std::vector<glm::vec3> sortedMax = spatial::permute(boxesMax, curve);
+        centroids = spatial::permute(centroids, curve);
+
+        nodes.reserve(order.size() * 2 / maxLeafSize + 1);
+        nodes.push_back(BvhNode());
+        std::vector<BuildTask> tasks;
+        tasks.push_back({ 0, 0, static_cast<uint32_t>(order.size()), 0 });
+        while (!tasks.empty()) {
+            BuildTask task = tasks.back();
+            tasks.pop_back();
+
+            // 1. ڵΧкͼԪĵİΧ
+            glm::vec3 boundsMin(std::numeric_limits<float>::max()), boundsMax(std::numeric_limits<float>::lowest());
+            glm::vec3 centroidMin = boundsMin, centroidMax = boundsMax;
+            for (uint32_t i = task.first; i < task.first + task.count; ++i) {
+                uint32_t primitive = order[i];
+                boundsMin = glm::min(boundsMin, sortedMin[primitive]);
+                boundsMax = glm::max(boundsMax, sortedMax[primitive]);
+                centroidMin = glm::min(centroidMin, centroids[primitive]);
+                centroidMax = glm::max(centroidMax, centroids[primitive]);
+            }
+            nodes[task.node].boundsMin = boundsMin;
+            nodes[task.node].boundsMax = boundsMax;
+            nodes[task.node].first = task.first;
+            nodes[task.node].count = task.count;
+            // ܱջƣʱʣµͼԪȫŽҶ
+            if (task.count <= maxLeafSize || task.depth + 2 >= MAX_BVH_DEPTH) {
+                continue;
+            }
+
+            // 2. ķֲ䣬SAHСĻ
+            glm::vec3 centroidExtent = centroidMax - centroidMin;
+            int axis = centroidExtent.x >= centroidExtent.y && centroidExtent.x >= centroidExtent.z ? 0 : (centroidExtent.y >= centroidExtent.z ? 1 : 2);
+            uint32_t middle = task.first + task.count / 2;
+            if (centroidExtent[axis] > 0.0f) {
+                Bin bins[BIN_COUNT];
+                float binScale = BIN_COUNT / centroidExtent[axis];
+                auto binOf = [&](uint32_t primitive) {
+                    return std::min(BIN_COUNT - 1, static_cast<int>((centroids[primitive][axis] - centroidMin[axis]) * binScale));
+                };
+                for (uint32_t i = task.first; i < task.first + task.count; ++i) {
+                    Bin& bin = bins[binOf(order[i])];
+                    bin.boundsMin = glm::min(bin.boundsMin, sortedMin[order[i]]);
+                    bin.boundsMax = glm::max(bin.boundsMax, sortedMax[order[i]]);
+                    bin.count++;
+                }
+                // ۻҲ
+                float rightArea[BIN_COUNT];
+                uint32_t rightCount[BIN_COUNT];
+                Bin accumulated;
+                for (int b = BIN_COUNT - 1; b > 0; --b) {
+                    accumulated.boundsMin = glm::min(accumulated.boundsMin, bins[b].boundsMin);
+                    accumulated.boundsMax = glm::max(accumulated.boundsMax, bins[b].boundsMax);
+                    accumulated.count += bins[b].count;
+                    rightArea[b] = accumulated.count > 0 ? surfaceArea(accumulated.boundsMin, accumulated.boundsMax) : 0.0f;
+                    rightCount[b] = accumulated.count;
+                }
+                float bestCost = std::numeric_limits<float>::max();
+                int bestSplit = -1;
+                accumulated = Bin();
+                for (int b = 1; b < BIN_COUNT; ++b) {
+                    accumulated.boundsMin = glm::min(accumulated.boundsMin, bins[b - 1].boundsMin);
+                    accumulated.boundsMax = glm::max(accumulated.boundsMax, bins[b - 1].boundsMax);
+                    accumulated.count += bins[b - 1].count;
+                    if (accumulated.count == 0 || rightCount[b] == 0) {
+                        continue;
+                    }
+                    float cost = accumulated.count * surfaceArea(accumulated.boundsMin, accumulated.boundsMax) + rightCount[b] * rightArea[b];
+                    if (cost < bestCost) {
+                        bestCost = cost;
+                        bestSplit = b;
+                    }
+                }
+                float leafCost = task.count * surfaceArea(boundsMin, boundsMax);
+                if (bestSplit > 0 && bestCost >= leafCost && task.count <= MAX_FORCED_LEAF) {
+                    continue;
+                }
+                if (bestSplit > 0) {
+                    middle = static_cast<uint32_t>(std::partition(order.begin() + task.first, order.begin() + task.first + task.count,
+                        [&](uint32_t primitive) { return binOf(primitive) < bestSplit; }) - order.begin());
+                }
+            }
+            // ȫغϻʧʱλ԰
+            if (middle == task.first || middle == task.first + task.count) {
+                middle = task.first + task.count / 2;
+                std::nth_element(order.begin() + task.first, order.begin() + middle, order.begin() + task.first + task.count,
+                    [&](uint32_t a, uint32_t b) { return centroids[a][axis] < centroids[b][axis]; });
+            }
+
+            // 3. ӽڵڴ
+            uint32_t left = static_cast<uint32_t>(nodes.size());
+            nodes.push_back(BvhNode());
+            nodes.push_back(BvhNode());
+            nodes[task.node].first = left;
+            nodes[task.node].count = 0;
+            tasks.push_back({ left, task.first, middle - task.first, task.depth + 1 });
+            tasks.push_back({ left + 1, middle, task.first + task.count - middle, task.depth + 1 });
+        }
+        for (uint32_t& primitive : order) {
+            primitive = curve[primitive];
+        }
+    }
+}
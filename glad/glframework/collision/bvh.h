@@ -0,0 +1,119 @@
+#pragma once
+
+#include "../core.h"          // glm
+
+#include <algorithm>          // std::min/std::max
+#include <cmath>              // std::abs
+#include <cstddef>            // size_t
+#include <cstdint>            // uint32_t
+#include <vector>             // std::vector
+
+// ײѯõľ̬Χ (BVH)
+// CollisionMesh () CollisionWorld (ʵ) ͬһֽڵ͹㷨
+// - ͼԪΧķ (binned SAH)ÿҶmaxLeafSizeͼԪ޸ģ
+// - ڵ32ֽڣӽڵڴţʱһջȷӽڵ㣬
+//   ҵк߶ΣԶ
+// ֻѯڶ߳ͬʱС
+namespace collision {
+    struct BvhNode {
+        glm::vec3 boundsMin;
+        uint32_t first;         // ڲڵ㣺ӽڵ± (ӽڵΪfirst + 1)ҶӣһͼԪorderеλ
+        glm::vec3 boundsMax;
+        uint32_t count;         // ҶеͼԪ0ʾڲڵ
+    };
+    static_assert(sizeof(BvhNode) == 32, "BvhNode must stay 32 bytes");
+
+    // ջȣʱ֤߲
+    constexpr size_t MAX_BVH_DEPTH = 64;
+
+    // ΪboxesMin/boxesMaxͼԪorderΪҶõͼԪ± (ҶiͼԪΪorder[first .. first + count))
+    void buildBvh(const std::vector<glm::vec3>& boxesMin, const std::vector<glm::vec3>& boxesMax, uint32_t maxLeafSize,
+        std::vector<BvhNode>& nodes, std::vector<uint32_t>& order);
+
+    // ߶origin + t * delta (t[0, tMax]) radius֮ΧཻСtཻʱfalse
+    inline bool intersectSegmentBox(const glm::vec3& origin, const glm::vec3& inverseDelta, float radius,
+        const glm::vec3& boxMin, const glm::vec3& boxMax, float tMax, float& tEnter) {
+        glm::vec3 t0 = (boxMin - glm::vec3(radius) - origin) * inverseDelta;
+        glm::vec3 t1 = (boxMax + glm::vec3(radius) - origin) * inverseDelta;
+        glm::vec3 tNear = glm::min(t0, t1);
+        glm::vec3 tFar = glm::max(t0, t1);
+        tEnter = std::max({ tNear.x, tNear.y, tNear.z, 0.0f });
+        float tExit = std::min({ tFar.x, tFar.y, tFar.z, tMax });
+        return tEnter <= tExit;
+    }
+
+    // 1 / deltaΪ0ʱһܴ棬0 * inf
+    inline glm::vec3 safeInverse(const glm::vec3& delta) {
+        glm::vec3 inverse;
+        for (int axis = 0; axis < 3; ++axis) {
+            inverse[axis] = std::abs(delta[axis]) > 1e-20f ? 1.0f / delta[axis] : (delta[axis] < 0.0f ? -1e30f : 1e30f);
+        }
+        return inverse;
+    }
+
+    // ɨ߶ (radius) ཻҶӣɽԶ
+    // visitLeaf(first, count, tMax) ҶеͼԪҵʱtMax (tΪ߶ϵı)
+    template<typename VisitLeaf>
+    void traverseSegment(const std::vector<BvhNode>& nodes, const glm::vec3& origin, const glm::vec3& delta, float radius,
+        float& tMax, VisitLeaf&& visitLeaf) {
+        if (nodes.empty()) {
+            return;
+        }
+        glm::vec3 inverseDelta = safeInverse(delta);
+        float tEnter = 0.0f;
+        if (!intersectSegmentBox(origin, inverseDelta, radius, nodes[0].boundsMin, nodes[0].boundsMax, tMax, tEnter)) {
+            return;
+        }
+        uint32_t stack[MAX_BVH_DEPTH];
+        size_t top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const BvhNode& node = nodes[stack[--top]];
+            if (node.count > 0) {
+                visitLeaf(node.first, node.count, tMax);
+                continue;
+            }
+            const BvhNode& left = nodes[node.first];
+            const BvhNode& right = nodes[node.first + 1];
+            float tLeft = 0.0f, tRight = 0.0f;
+            bool hitLeft = intersectSegmentBox(origin, inverseDelta, radius, left.boundsMin, left.boundsMax, tMax, tLeft);
+            bool hitRight = intersectSegmentBox(origin, inverseDelta, radius, right.boundsMin, right.boundsMax, tMax, tRight);
+            // Զջȳջ
+            if (hitLeft && hitRight) {
+                bool leftFirst = tLeft <= tRight;
+                stack[top++] = leftFirst ? node.first + 1 : node.first;
+                stack[top++] = leftFirst ? node.first : node.first + 1;
+            }
+            else if (hitLeft) {
+                stack[top++] = node.first;
+            }
+            else if (hitRight) {
+                stack[top++] = node.first + 1;
+            }
+        }
+    }
+
+    // ΧཻҶӣvisitLeaf(first, count)
+    template<typename VisitLeaf>
+    void traverseBox(const std::vector<BvhNode>& nodes, const glm::vec3& boxMin, const glm::vec3& boxMax, VisitLeaf&& visitLeaf) {
+        if (nodes.empty()) {
+            return;
+        }
+        uint32_t stack[MAX_BVH_DEPTH];
+        size_t top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const BvhNode& node = nodes[stack[--top]];
+            if (node.boundsMax.x < boxMin.x || node.boundsMax.y < boxMin.y || node.boundsMax.z < boxMin.z
+                || node.boundsMin.x > boxMax.x || node.boundsMin.y > boxMax.y || node.boundsMin.z > boxMax.z) {
+                continue;
+            }
+            if (node.count > 0) {
+                visitLeaf(node.first, node.count);
+                continue;
+            }
+            stack[top++] = node.first + 1;
+            stack[top++] = node.first;
+        }
+    }
+}
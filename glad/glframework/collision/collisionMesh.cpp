@@ -0,0 +1,338 @@
+#include "collisionMesh.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
+namespace {
+    constexpr uint32_t MAX_LEAF_TRIANGLES = 4;
+
+    // Ϊ64λÿ21λ (ΧĸӻƣֻܰԶĶΪһӣ
+    // ÷ģͳߴ˸ᷢ)
+    uint64_t cellKey(const glm::vec3& position, float inverseCellSize) {
+        auto axis = [&](float value) {
+            return static_cast<uint64_t>(static_cast<int64_t>(std::floor(value * inverseCellSize))) & 0x1FFFFFull;
+        };
+        return axis(position.x) << 42 | axis(position.y) << 21 | axis(position.z);
+    }
+
+    // ηa * t^2 + b * t + c = 0 (a > 0) [0, tMax]нСĸ
+    bool lowestRoot(float a, float b, float c, float tMax, float& root) {
+        float discriminant = b * b - 4.0f * a * c;
+        if (discriminant < 0.0f) {
+            return false;
+        }
+        float t = (-b - std::sqrt(discriminant)) / (2.0f * a);
+        if (t < 0.0f || t > tMax) {
+            return false;
+        }
+        root = t;
+        return true;
+    }
+}
+
+void CollisionMesh::build(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices, float cellSize) {
+    m_triangles.clear();
+    m_nodes.clear();
+    m_boundsMin = m_boundsMax = glm::vec3(0.0f);
+
+    // 1. ࣺͬһеĶϲΪǵƽλ
+    std::vector<uint32_t> clusterOf(positions.size());
+    std::vector<glm::vec3> clusterPositions;
+    if (cellSize > 0.0f) {
+        std::unordered_map<uint64_t, uint32_t> clusters;
+        std::vector<uint32_t> clusterCounts;
+        float inverseCellSize = 1.0f / cellSize;
+        for (size_t v = 0; v < positions.size(); ++v) {
+            auto result = clusters.emplace(cellKey(positions[v], inverseCellSize), static_cast<uint32_t>(clusterPositions.size()));
+            if (result.second) {
+                clusterPositions.push_back(glm::vec3(0.0f));
+                clusterCounts.push_back(0);
+            }
+            clusterOf[v] = result.first->second;
+            clusterPositions[result.first->second] += positions[v];
+            clusterCounts[result.first->second]++;
+        }
+        for (size_t c = 0; c < clusterPositions.size(); ++c) {
+            clusterPositions[c] /= static_cast<float>(clusterCounts[c]);
+        }
+    }
+    else {
+        for (size_t v = 0; v < positions.size(); ++v) {
+            clusterOf[v] = static_cast<uint32_t>(v);
+        }
+        clusterPositions = positions;
+    }
+
+    // 2. ȥ˻ (ͬһӣΪ0) ظ (۶˳)
+    std::vector<std::array<uint32_t, 3>> corners;
+    corners.reserve(indices.size() / 3);
+    for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+        if (indices[t] >= positions.size() || indices[t + 1] >= positions.size() || indices[t + 2] >= positions.size()) {
+            continue;
+        }
+        std::array<uint32_t, 3> triangle = { clusterOf[indices[t]], clusterOf[indices[t + 1]], clusterOf[indices[t + 2]] };
+        if (triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[0] == triangle[2]) {
+            continue;
+        }
+        glm::vec3 a = clusterPositions[triangle[0]], b = clusterPositions[triangle[1]], c = clusterPositions[triangle[2]];
+        glm::vec3 normal = glm::cross(b - a, c - a);
+        float longestEdge = std::max({ glm::dot(b - a, b - a), glm::dot(c - b, c - b), glm::dot(a - c, a - c) });
+        if (glm::dot(normal, normal) <= 1e-12f * longestEdge * longestEdge) {
+            continue;
+        }
+        std::sort(triangle.begin(), triangle.end());
+        corners.push_back(triangle);
+    }
+    std::sort(corners.begin(), corners.end());
+    corners.erase(std::unique(corners.begin(), corners.end()), corners.end());
+    if (corners.empty()) {
+        return;
+    }
+
+    // 3. ΰҶ˳ţѯʱ
+    std::vector<glm::vec3> boxesMin(corners.size()), boxesMax(corners.size());
+    for (size_t t = 0; t < corners.size(); ++t) {
+        const glm::vec3& a = clusterPositions[corners[t][0]];
+        const glm::vec3& b = clusterPositions[corners[t][1]];
+        const glm::vec3& c = clusterPositions[corners[t][2]];
+        boxesMin[t] = glm::min(a, glm::min(b, c));
+        boxesMax[t] = glm::max(a, glm::max(b, c));
+    }
+    std::vector<uint32_t> order;
+    collision::buildBvh(boxesMin, boxesMax, MAX_LEAF_TRIANGLES, m_nodes, order);
+    m_triangles.resize(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        const std::array<uint32_t, 3>& triangle = corners[order[i]];
+        m_triangles[i] = { clusterPositions[triangle[0]], clusterPositions[triangle[1]], clusterPositions[triangle[2]] };
+    }
+    m_triangles.shrink_to_fit();
+    m_nodes.shrink_to_fit();
+    m_boundsMin = m_nodes[0].boundsMin;
+    m_boundsMax = m_nodes[0].boundsMax;
+}
+
+bool CollisionMesh::raycast(const glm::vec3& origin, const glm::vec3& delta, Hit& hit) const {
+    float tMax = hit.t;
+    bool found = false;
+    collision::traverseSegment(m_nodes, origin, delta, 0.0f, tMax, [&](uint32_t first, uint32_t count, float& tLimit) {
+        for (uint32_t i = first; i < first + count; ++i) {
+            // Moller-Trumbore˫
+            const Triangle& triangle = m_triangles[i];
+            glm::vec3 edge1 = triangle.b - triangle.a;
+            glm::vec3 edge2 = triangle.c - triangle.a;
+            glm::vec3 p = glm::cross(delta, edge2);
+            float determinant = glm::dot(edge1, p);
+            if (std::abs(determinant) < 1e-20f) {
+                continue;
+            }
+            float inverseDeterminant = 1.0f / determinant;
+            glm::vec3 s = origin - triangle.a;
+            float u = glm::dot(s, p) * inverseDeterminant;
+            if (u < 0.0f || u > 1.0f) {
+                continue;
+            }
+            glm::vec3 q = glm::cross(s, edge1);
+            float v = glm::dot(delta, q) * inverseDeterminant;
+            if (v < 0.0f || u + v > 1.0f) {
+                continue;
+            }
+            float t = glm::dot(edge2, q) * inverseDeterminant;
+            if (t < 0.0f || t >= tLimit) {
+                continue;
+            }
+            tLimit = t;
+            found = true;
+            glm::vec3 normal = glm::normalize(glm::cross(edge1, edge2));
+            hit.normal = glm::dot(normal, delta) > 0.0f ? -normal : normal;
+            hit.point = origin + delta * t;
+        }
+    });
+    if (found) {
+        hit.t = tMax;
+    }
+    return found;
+}
+
+bool CollisionMesh::sweepSphere(const glm::vec3& center, float radius, const glm::vec3& motion, Hit& hit) const {
+    float tMax = hit.t;
+    bool found = false;
+    collision::traverseSegment(m_nodes, center, motion, radius, tMax, [&](uint32_t first, uint32_t count, float& tLimit) {
+        for (uint32_t i = first; i < first + count; ++i) {
+            Hit candidate;
+            if (!sweepTriangle(m_triangles[i], center, radius, motion, tLimit, candidate)) {
+                continue;
+            }
+            // ͬʱӴʱ (ǽ)ȡ˶Ǹ
+            if (found && candidate.t == tLimit && glm::dot(candidate.normal, motion) >= glm::dot(hit.normal, motion)) {
+                continue;
+            }
+            tLimit = candidate.t;
+            hit = candidate;
+            found = true;
+        }
+    });
+    return found;
+}
+
+bool CollisionMesh::findPenetration(const glm::vec3& center, float radius, glm::vec3& normal, float& depth) const {
+    bool found = false;
+    depth = 0.0f;
+    collision::traverseBox(m_nodes, center - glm::vec3(radius), center + glm::vec3(radius), [&](uint32_t first, uint32_t count) {
+        for (uint32_t i = first; i < first + count; ++i) {
+            const Triangle& triangle = m_triangles[i];
+            glm::vec3 offset = center - closestPoint(triangle, center);
+            float distance = glm::length(offset);
+            if (distance >= radius || radius - distance <= depth) {
+                continue;
+            }
+            depth = radius - distance;
+            found = true;
+            if (distance > 1e-6f * radius) {
+                normal = offset / distance;
+            }
+            else {
+                // ϣϵһƳ
+                glm::vec3 face = glm::normalize(glm::cross(triangle.b - triangle.a, triangle.c - triangle.a));
+                normal = face.y < 0.0f ? -face : face;
+            }
+        }
+    });
+    return found;
+}
+
+bool CollisionMesh::sweepTriangle(const Triangle& triangle, const glm::vec3& center, float radius, const glm::vec3& motion,
+    float tMax, Hit& hit) {
+    // 1. Ѿصֻ赲ڲƶ
+    glm::vec3 closest = closestPoint(triangle, center);
+    glm::vec3 offset = center - closest;
+    float distanceSquared = glm::dot(offset, offset);
+    if (distanceSquared < radius * radius) {
+        if (glm::dot(motion, offset) >= 0.0f || distanceSquared <= 0.0f) {
+            return false;
+        }
+        hit.t = 0.0f;
+        hit.normal = offset / std::sqrt(distanceSquared);
+        hit.point = closest;
+        return true;
+    }
+
+    // 2. ڲط߷ľdistanceradiusʱӴ
+    glm::vec3 normal = glm::cross(triangle.b - triangle.a, triangle.c - triangle.a);
+    float normalLength = glm::length(normal);
+    if (normalLength > 0.0f) {
+        normal /= normalLength;
+        float distance = glm::dot(center - triangle.a, normal);
+        if (distance < 0.0f) {
+            normal = -normal;
+            distance = -distance;
+        }
+        float approach = -glm::dot(motion, normal);
+        if (approach > 0.0f) {
+            float t = (distance - radius) / approach;
+            if (t > tMax) {
+                return false;
+            }
+            glm::vec3 contact = center + motion * t - normal * radius;
+            // Ӵ (궼Ǹ)
+            glm::vec3 c0 = glm::cross(triangle.b - triangle.a, contact - triangle.a);
+            glm::vec3 c1 = glm::cross(triangle.c - triangle.b, contact - triangle.b);
+            glm::vec3 c2 = glm::cross(triangle.a - triangle.c, contact - triangle.c);
+            glm::vec3 face = glm::cross(triangle.b - triangle.a, triangle.c - triangle.a);
+            if (glm::dot(c0, face) >= 0.0f && glm::dot(c1, face) >= 0.0f && glm::dot(c2, face) >= 0.0f) {
+                hit.t = std::max(t, 0.0f);
+                hit.normal = normal;
+                hit.point = contact;
+                return true;
+            }
+        }
+        else if (distance >= radius) {
+            // ƽһƽлԶƽ棬ܽӴ
+            return false;
+        }
+    }
+
+    // 3.  (ҵԲ) 򶥵 ()
+    bool found = false;
+    float best = tMax;
+    glm::vec3 contact(0.0f);
+    float motionSquared = glm::dot(motion, motion);
+    const glm::vec3* vertices[3] = { &triangle.a, &triangle.b, &triangle.c };
+    for (int k = 0; k < 3; ++k) {
+        const glm::vec3& vertex = *vertices[k];
+        glm::vec3 toCenter = center - vertex;
+        float t = 0.0f;
+        if (motionSquared > 0.0f
+            && lowestRoot(motionSquared, 2.0f * glm::dot(motion, toCenter), glm::dot(toCenter, toCenter) - radius * radius, best, t)) {
+            best = t;
+            contact = vertex;
+            found = true;
+        }
+
+        const glm::vec3& next = *vertices[(k + 1) % 3];
+        glm::vec3 edge = next - vertex;
+        float edgeSquared = glm::dot(edge, edge);
+        float edgeDotMotion = glm::dot(edge, motion);
+        float edgeDotCenter = glm::dot(edge, toCenter);
+        // ĵֱߵľΪradiusʱ (߳edgeSquared)
+        float a = edgeSquared * motionSquared - edgeDotMotion * edgeDotMotion;
+        float b = 2.0f * (edgeSquared * glm::dot(toCenter, motion) - edgeDotCenter * edgeDotMotion);
+        float c = edgeSquared * (glm::dot(toCenter, toCenter) - radius * radius) - edgeDotCenter * edgeDotCenter;
+        // c <= 0޳Բڵ߶صֻ˵㣬ɶ㴦
+        if (a > 1e-12f * edgeSquared * motionSquared && c > 0.0f && lowestRoot(a, b, c, best, t)) {
+            float f = (edgeDotMotion * t + edgeDotCenter) / edgeSquared;
+            if (f >= 0.0f && f <= 1.0f) {
+                best = t;
+                contact = vertex + edge * f;
+                found = true;
+            }
+        }
+    }
+    if (!found) {
+        return false;
+    }
+    glm::vec3 normalAtContact = center + motion * best - contact;
+    float length = glm::length(normalAtContact);
+    hit.t = best;
+    hit.normal = length > 0.0f ? normalAtContact / length : -glm::normalize(motion);
+    hit.point = contact;
+    return true;
+}
+
+glm::vec3 CollisionMesh::closestPoint(const Triangle& triangle, const glm::vec3& p) {
+    // pڵVoronoi (㡢ߡ)  (Ericson, Real-Time Collision Detection 5.1.5)
+    const glm::vec3& a = triangle.a;
+    const glm::vec3& b = triangle.b;
+    const glm::vec3& c = triangle.c;
+    glm::vec3 ab = b - a, ac = c - a, ap = p - a;
+    float d1 = glm::dot(ab, ap), d2 = glm::dot(ac, ap);
+    if (d1 <= 0.0f && d2 <= 0.0f) {
+        return a;
+    }
+    glm::vec3 bp = p - b;
+    float d3 = glm::dot(ab, bp), d4 = glm::dot(ac, bp);
+    if (d3 >= 0.0f && d4 <= d3) {
+        return b;
+    }
+    float vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+        return a + ab * (d1 / (d1 - d3));
+    }
+    glm::vec3 cp = p - c;
+    float d5 = glm::dot(ab, cp), d6 = glm::dot(ac, cp);
+    if (d6 >= 0.0f && d5 <= d6) {
+        return c;
+    }
+    float vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+        return a + ac * (d2 / (d2 - d6));
+    }
+    float va = d3 * d6 - d5 * d4;
+    if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+    float denominator = 1.0f / (va + vb + vc);
+    return a + ab * (vb * denominator) + ac * (vc * denominator);
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "../core.h"          // glm
+#include "bvh.h"
+
+#include <cstddef>            // size_t
+#include <cstdint>            // uint32_t
+#include <vector>             // std::vector
+
+// CollisionMeshһģ͵ײ (ģͿռеľ̬ + BVH)
+// ʱȾ (Model::createCollisionMesh)
+// - cellSize࣬ϲͬһеĶ㣬ȥ˻κظ (෴)
+//   ߽֮ȸСϸڱѹƽǽ桢¥塢¥ݵȴ߶ȵ汣
+// - ˫棬ֳ
+// - ޸ģκGLڹ߳Ϲڶ߳ͬʱѯ
+// ѯģͿռнУռĲѯCollisionWorld
+class CollisionMesh {
+public:
+    // һСtΪ߶/ɨϵı (0 ~ 1)
+    struct Hit {
+        float t = 1.0f;
+        glm::vec3 normal = glm::vec3(0.0f, 1.0f, 0.0f);   // ָ/һĵλ
+        glm::vec3 point = glm::vec3(0.0f);                // ϵĽӴ
+    };
+
+    CollisionMesh() = default;
+
+    // ιcellSizeΪĸӴС (ģͿռ)0ʱ
+    void build(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices, float cellSize);
+
+    bool empty() const { return m_triangles.empty(); }
+    size_t getTriangleCount() const { return m_triangles.size(); }
+    size_t getNodeCount() const { return m_nodes.size(); }
+    size_t getMemoryBytes() const { return m_triangles.capacity() * sizeof(Triangle) + m_nodes.capacity() * sizeof(collision::BvhNode); }
+    const glm::vec3& getBoundsMin() const { return m_boundsMin; }
+    const glm::vec3& getBoundsMax() const { return m_boundsMax; }
+
+    // ߶origin -> origin + deltaε㣬hit.tΪʱΪиĵʱhittrue
+    bool raycast(const glm::vec3& origin, const glm::vec3& delta, Hit& hit) const;
+
+    // 뾶Ϊradiuscenterɨӵcenter + motionһνӴλáhit.tΪʱΪ
+    // Ѿصʱֻмڲƶ (t = 0)Զرƶ赲
+    bool sweepSphere(const glm::vec3& center, float radius, const glm::vec3& motion, Hit& hit) const;
+
+    // صΣdepthΪҪnormalƳľ룬ûصʱfalse
+    bool findPenetration(const glm::vec3& center, float radius, glm::vec3& normal, float& depth) const;
+
+private:
+    struct Triangle {
+        glm::vec3 a, b, c;
+    };
+
+    static bool sweepTriangle(const Triangle& triangle, const glm::vec3& center, float radius, const glm::vec3& motion,
+        float tMax, Hit& hit);
+
+    // pĵ
+    static glm::vec3 closestPoint(const Triangle& triangle, const glm::vec3& p);
+
+private:
+    std::vector<Triangle> m_triangles;          // BVHҶӵ˳
+    std::vector<collision::BvhNode> m_nodes;
+    glm::vec3 m_boundsMin = glm::vec3(0.0f);
+    glm::vec3 m_boundsMax = glm::vec3(0.0f);
+};
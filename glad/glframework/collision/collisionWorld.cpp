@@ -0,0 +1,211 @@
+#include "collisionWorld.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace {
+    // ͣڽӴ֮ǰľ (뾶)һɨӲص״̬ʼ
+    constexpr float SKIN = 0.01f;
+}
+
+uint32_t CollisionWorld::addBody(std::shared_ptr<const CollisionMesh> mesh, const glm::mat4& modelToWorld) {
+    if (!mesh || mesh->empty()) {
+        return NO_BODY;
+    }
+    Body body;
+    body.modelToWorld = modelToWorld;
+    body.worldToModel = glm::inverse(modelToWorld);
+    glm::vec3 scales(glm::length(glm::vec3(modelToWorld[0])), glm::length(glm::vec3(modelToWorld[1])), glm::length(glm::vec3(modelToWorld[2])));
+    body.scale = scales.x;
+    if (std::abs(scales.y - scales.x) > 1e-3f * scales.x || std::abs(scales.z - scales.x) > 1e-3f * scales.x) {
+        std::cerr << "WARNING: Collision body has a non-uniform scale, sphere queries use the x axis scale." << std::endl;
+    }
+    // ģͰΧ8Ǳ任İΧ
+    body.boundsMin = glm::vec3(std::numeric_limits<float>::max());
+    body.boundsMax = glm::vec3(std::numeric_limits<float>::lowest());
+    for (int corner = 0; corner < 8; ++corner) {
+        glm::vec3 local((corner & 1) ? mesh->getBoundsMax().x : mesh->getBoundsMin().x,
+            (corner & 2) ? mesh->getBoundsMax().y : mesh->getBoundsMin().y,
+            (corner & 4) ? mesh->getBoundsMax().z : mesh->getBoundsMin().z);
+        glm::vec3 world = glm::vec3(modelToWorld * glm::vec4(local, 1.0f));
+        body.boundsMin = glm::min(body.boundsMin, world);
+        body.boundsMax = glm::max(body.boundsMax, world);
+    }
+    m_stats.bodies++;
+    m_stats.triangles += mesh->getTriangleCount();
+    body.mesh = std::move(mesh);
+
+    uint32_t index;
+    if (!m_freeBodies.empty()) {
+        index = m_freeBodies.back();
+        m_freeBodies.pop_back();
+        m_bodies[index] = std::move(body);
+    }
+    else {
+        index = static_cast<uint32_t>(m_bodies.size());
+        m_bodies.push_back(std::move(body));
+    }
+    m_dirty = true;
+    return index;
+}
+
+void CollisionWorld::removeBody(uint32_t body) {
+    if (body >= m_bodies.size() || !m_bodies[body].mesh) {
+        return;
+    }
+    m_stats.bodies--;
+    m_stats.triangles -= m_bodies[body].mesh->getTriangleCount();
+    m_bodies[body] = Body();
+    m_freeBodies.push_back(body);
+    m_dirty = true;
+}
+
+void CollisionWorld::clear() {
+    m_bodies.clear();
+    m_freeBodies.clear();
+    m_nodes.clear();
+    m_order.clear();
+    m_dirty = false;
+    m_stats.bodies = 0;
+    m_stats.triangles = 0;
+}
+
+void CollisionWorld::updateTopLevel() {
+    if (!m_dirty) {
+        return;
+    }
+    m_dirty = false;
+    std::vector<uint32_t> live;
+    std::vector<glm::vec3> boxesMin, boxesMax;
+    for (uint32_t i = 0; i < m_bodies.size(); ++i) {
+        if (m_bodies[i].mesh) {
+            live.push_back(i);
+            boxesMin.push_back(m_bodies[i].boundsMin);
+            boxesMax.push_back(m_bodies[i].boundsMax);
+        }
+    }
+    // ÿҶһʵʵڲԼ
+    collision::buildBvh(boxesMin, boxesMax, 1, m_nodes, m_order);
+    for (uint32_t& index : m_order) {
+        index = live[index];
+    }
+    m_stats.topLevelBuilds++;
+}
+
+void CollisionWorld::toWorld(const Body& body, uint32_t index, const CollisionMesh::Hit& local, Hit& hit) {
+    hit.t = local.t;
+    hit.normal = glm::normalize(glm::mat3(body.modelToWorld) * local.normal);
+    hit.point = glm::vec3(body.modelToWorld * glm::vec4(local.point, 1.0f));
+    hit.body = index;
+}
+
+bool CollisionWorld::raycast(const glm::vec3& origin, const glm::vec3& delta, Hit& hit) {
+    updateTopLevel();
+    float tMax = hit.t;
+    bool found = false;
+    collision::traverseSegment(m_nodes, origin, delta, 0.0f, tMax, [&](uint32_t first, uint32_t count, float& tLimit) {
+        for (uint32_t i = first; i < first + count; ++i) {
+            const Body& body = m_bodies[m_order[i]];
+            CollisionMesh::Hit local;
+            local.t = tLimit;
+            if (body.mesh->raycast(glm::vec3(body.worldToModel * glm::vec4(origin, 1.0f)), glm::mat3(body.worldToModel) * delta, local)) {
+                tLimit = local.t;
+                toWorld(body, m_order[i], local, hit);
+                found = true;
+            }
+        }
+    });
+    return found;
+}
+
+bool CollisionWorld::sweepSphere(const glm::vec3& center, float radius, const glm::vec3& motion, Hit& hit) {
+    updateTopLevel();
+    float tMax = hit.t;
+    bool found = false;
+    collision::traverseSegment(m_nodes, center, motion, radius, tMax, [&](uint32_t first, uint32_t count, float& tLimit) {
+        for (uint32_t i = first; i < first + count; ++i) {
+            const Body& body = m_bodies[m_order[i]];
+            CollisionMesh::Hit local;
+            local.t = tLimit;
+            if (!body.mesh->sweepSphere(glm::vec3(body.worldToModel * glm::vec4(center, 1.0f)), radius / body.scale,
+                glm::mat3(body.worldToModel) * motion, local)) {
+                continue;
+            }
+            Hit candidate;
+            toWorld(body, m_order[i], local, candidate);
+            // ͬʱӴʱCollisionMeshڲһȡ˶Ǹ
+            if (found && candidate.t == tLimit && glm::dot(candidate.normal, motion) >= glm::dot(hit.normal, motion)) {
+                continue;
+            }
+            tLimit = candidate.t;
+            hit = candidate;
+            found = true;
+        }
+    });
+    return found;
+}
+
+CollisionWorld::MoveResult CollisionWorld::moveSphere(const glm::vec3& center, float radius, const glm::vec3& motion, int maxIterations) {
+    updateTopLevel();
+    MoveResult result;
+    result.position = center;
+    float skin = radius * SKIN;
+    auto record = [&](const glm::vec3& normal) {
+        result.blocked = true;
+        result.lastNormal = normal;
+        result.lowestNormalY = std::min(result.lowestNormalY, normal.y);
+        result.highestNormalY = std::max(result.highestNormalY, normal.y);
+    };
+
+    // 1. ص (һ֮֡ģͱƶ) ʱĽӴƳ
+    for (int iteration = 0; iteration < maxIterations; ++iteration) {
+        glm::vec3 deepestNormal(0.0f);
+        float deepest = 0.0f;
+        glm::vec3 boxMin = result.position - glm::vec3(radius), boxMax = result.position + glm::vec3(radius);
+        collision::traverseBox(m_nodes, boxMin, boxMax, [&](uint32_t first, uint32_t count) {
+            for (uint32_t i = first; i < first + count; ++i) {
+                const Body& body = m_bodies[m_order[i]];
+                glm::vec3 normal;
+                float depth = 0.0f;
+                if (body.mesh->findPenetration(glm::vec3(body.worldToModel * glm::vec4(result.position, 1.0f)), radius / body.scale, normal, depth)
+                    && depth * body.scale > deepest) {
+                    deepest = depth * body.scale;
+                    deepestNormal = glm::normalize(glm::mat3(body.modelToWorld) * normal);
+                }
+            }
+        });
+        if (deepest <= 0.0f) {
+            break;
+        }
+        result.position += deepestNormal * (deepest + skin);
+        record(deepestNormal);
+    }
+
+    // 2. ײ
+    glm::vec3 remaining = motion;
+    for (int iteration = 0; iteration < maxIterations; ++iteration) {
+        float length = glm::length(remaining);
+        if (length <= skin * 0.01f) {
+            break;
+        }
+        Hit hit;
+        if (!sweepSphere(result.position, radius, remaining, hit)) {
+            result.position += remaining;
+            break;
+        }
+        // ͣڽӴ֮ǰskinʣλȥָӴķ
+        float travel = std::max(0.0f, hit.t * length - skin);
+        result.position += remaining * (travel / length);
+        record(hit.normal);
+        remaining *= 1.0f - hit.t;
+        remaining -= hit.normal * glm::dot(remaining, hit.normal);
+    }
+    return result;
+}
+
+bool CollisionWorld::findGround(const glm::vec3& position, float maxDrop, Hit& hit) {
+    hit = Hit();
+    return raycast(position, glm::vec3(0.0f, -maxDrop, 0.0f), hit);
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "../core.h"          // glm
+#include "bvh.h"
+#include "collisionMesh.h"
+
+#include <cstddef>            // size_t
+#include <cstdint>            // uint32_t
+#include <memory>             // std::shared_ptrײģͺײ繲ͬ
+#include <vector>             // std::vector
+
+// CollisionWorldнײײ
+// BVHÿCollisionMeshڼʱѾģͿռеBVHײֻʵ ( + ģ;)
+// ʵΧٽһöʽصƬɾʵʱֻҪؽ (һβѯʱ)
+// εĳÿβѯҲֻʼʮڵ㡣
+// ģ;ֻܰƽơת; (ģͿռȻ)
+// κGLֻһ߳ʹ (ѯؽ)
+class CollisionWorld {
+public:
+    static constexpr uint32_t NO_BODY = ~0u;
+
+    // ռеһ
+    struct Hit {
+        float t = 1.0f;                 // ߶/ɨϵı (0 ~ 1)
+        glm::vec3 normal = glm::vec3(0.0f, 1.0f, 0.0f);
+        glm::vec3 point = glm::vec3(0.0f);
+        uint32_t body = NO_BODY;
+    };
+
+    // moveSphereĽ
+    struct MoveResult {
+        glm::vec3 position = glm::vec3(0.0f);   // ĵλ
+        bool blocked = false;                   // Ƿκ
+        glm::vec3 lastNormal = glm::vec3(0.0f); // һײķ
+        float lowestNormalY = 1.0f;             // ײyСֵ (С0ʾ컨)
+        float highestNormalY = -1.0f;           // ײyֵ (ӽ1ʾȵ˵)
+    };
+
+    struct Stats {
+        size_t bodies = 0;
+        size_t triangles = 0;
+        size_t topLevelBuilds = 0;  // ۼ
+    };
+
+    // һʵţmeshΪʱNO_BODY
+    uint32_t addBody(std::shared_ptr<const CollisionMesh> mesh, const glm::mat4& modelToWorld);
+
+    // Ƴʵܱ֮
+    void removeBody(uint32_t body);
+
+    void clear();
+
+    // ߶origin -> origin + delta
+    bool raycast(const glm::vec3& origin, const glm::vec3& delta, Hit& hit);
+
+    // centerɨӵcenter + motionĵһνӴCollisionMesh::sweepSphereͬ
+    bool sweepSphere(const glm::vec3& center, float radius, const glm::vec3& motion, Hit& hit);
+
+    // ײmotionƶʱͣڽӴ֮ǰʣλͶӰӴϼƶ
+    // maxIterations (ǽǡ¥ݱԵ)صʱȰƳ
+    MoveResult moveSphere(const glm::vec3& center, float radius, const glm::vec3& motion, int maxIterations = 4);
+
+    // positionmaxDropߵĵ ()ûʱfalse
+    bool findGround(const glm::vec3& position, float maxDrop, Hit& hit);
+
+    const Stats& getStats() const { return m_stats; }
+
+private:
+    struct Body {
+        std::shared_ptr<const CollisionMesh> mesh;  // Ϊձʾеı
+        glm::mat4 modelToWorld = glm::mat4(1.0f);
+        glm::mat4 worldToModel = glm::mat4(1.0f);
+        float scale = 1.0f;                         // ģ -> ľ
+        glm::vec3 boundsMin = glm::vec3(0.0f);      // Χ
+        glm::vec3 boundsMax = glm::vec3(0.0f);
+    };
+
+    // ʵб仯ʱؽ
+    void updateTopLevel();
+
+    // ģͿռתռ
+    static void toWorld(const Body& body, uint32_t index, const CollisionMesh::Hit& local, Hit& hit);
+
+private:
+    std::vector<Body> m_bodies;
+    std::vector<uint32_t> m_freeBodies;
+    std::vector<collision::BvhNode> m_nodes;    // Ҷm_orderеʵ
+    std::vector<uint32_t> m_order;
+    bool m_dirty = false;
+    Stats m_stats;
+};
@@ -0,0 +1,124 @@
+#include "fileWatcher.h"
+
+#include <filesystem>
+#include <iostream>
+
+#ifdef __linux__
+#include <cerrno>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+FileWatcher::FileWatcher() {
+#ifdef __linux__
+    m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotifyFd < 0) {
+        std::cerr << "ERROR: inotify_init1 failed, file changes will not be detected." << std::endl;
+    }
+#else
+    m_lastScan = Clock::now();
+#endif
+}
+
+FileWatcher::~FileWatcher() {
+#ifdef __linux__
+    if (m_inotifyFd >= 0) {
+        close(m_inotifyFd);
+    }
+#endif
+}
+
+std::string FileWatcher::normalize(const std::string& path) {
+    std::error_code error;
+    fs::path absolutePath = fs::absolute(fs::path(path), error);
+    if (error) {
+        absolutePath = fs::path(path);
+    }
+    return absolutePath.lexically_normal().generic_string();
+}
+
+void FileWatcher::watch(const std::string& path) {
+    std::string file = normalize(path);
+    if (!m_files.insert(file).second) {
+        return;
+    }
+
+#ifdef __linux__
+    // ļڵĿ¼ļʽļỻһinodeֱӼļᶪʧ֮޸
+    std::string directory = fs::path(file).parent_path().generic_string();
+    if (m_inotifyFd < 0 || m_watchedDirectories.count(directory) > 0) {
+        return;
+    }
+    int wd = inotify_add_watch(m_inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (wd < 0) {
+        std::cerr << "ERROR: Could not watch directory: " << directory << std::endl;
+        return;
+    }
+    m_directories[wd] = directory;
+    m_watchedDirectories.insert(directory);
+#else
+    std::error_code error;
+    auto time = fs::last_write_time(fs::path(file), error);
+    m_modifiedTimes[file] = error ? 0 : static_cast<long long>(time.time_since_epoch().count());
+#endif
+}
+
+void FileWatcher::markChanged(const std::string& path, Clock::time_point now) {
+    if (m_files.count(path) > 0) {
+        m_pending[path] = now;
+    }
+}
+
+void FileWatcher::poll(std::vector<std::string>& changedFiles) {
+    Clock::time_point now = Clock::now();
+
+#ifdef __linux__
+    if (m_inotifyFd >= 0) {
+        alignas(inotify_event) char buffer[16 * 1024];
+        for (;;) {
+            ssize_t length = read(m_inotifyFd, buffer, sizeof(buffer));
+            if (length <= 0) {
+                // EAGAIN: ûи¼
+                break;
+            }
+            for (char* p = buffer; p < buffer + length; ) {
+                const inotify_event* event = reinterpret_cast<const inotify_event*>(p);
+                p += sizeof(inotify_event) + event->len;
+                if (event->len == 0) {
+                    continue;
+                }
+                auto it = m_directories.find(event->wd);
+                if (it != m_directories.end()) {
+                    markChanged((fs::path(it->second) / event->name).generic_string(), now);
+                }
+            }
+        }
+    }
+#else
+    if (now - m_lastScan >= POLL_INTERVAL) {
+        m_lastScan = now;
+        for (auto& [file, lastTime] : m_modifiedTimes) {
+            std::error_code error;
+            auto time = fs::last_write_time(fs::path(file), error);
+            long long modified = error ? 0 : static_cast<long long>(time.time_since_epoch().count());
+            if (modified != lastTime) {
+                lastTime = modified;
+                markChanged(file, now);
+            }
+        }
+    }
+#endif
+
+    // һ¼֮ѾƽSETTLE_TIMEļ֪ͨ
+    for (auto it = m_pending.begin(); it != m_pending.end(); ) {
+        if (now - it->second >= SETTLE_TIME) {
+            changedFiles.push_back(it->first);
+            it = m_pending.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
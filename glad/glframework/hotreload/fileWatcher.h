@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>             // ¼ϲʱ
+#include <string>             // std::string
+#include <vector>             // std::vector
+#include <unordered_map>      // ڼ¼ӵļĿ¼
+#include <unordered_set>      // ڼ¼ӵļ
+
+// FileWatcherһļ޸ (ʹ)
+// - LinuxʹinotifyļڵĿ¼û޸ʱpoll()ֻһηread
+//   ͬʱIN_CLOSE_WRITEIN_MOVED_TOֱд"дʱļ"ֱ淽ʽ
+// - ƽ̨˻ΪڱȽļ޸ʱ䡣
+// ༭һļ¼ͬһļ¼SETTLE_TIMEںϲΪһ֪ͨ
+// дһļ
+// ̰߳ȫģֻѭеá
+class FileWatcher {
+public:
+    FileWatcher();
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    // ʼһļظ޸
+    void watch(const std::string& path);
+
+    // ռϴε޸ĵļ (淶·normalize)
+    void poll(std::vector<std::string>& changedFiles);
+
+    // ·תΪԡ淶'/'ָʽڱȽ·Ƿָͬһļ
+    static std::string normalize(const std::string& path);
+
+    // һ¼֮ȴ֪ͨ
+    static constexpr std::chrono::milliseconds SETTLE_TIME{ 20 };
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // ¼һļ޸¼ȴϲ
+    void markChanged(const std::string& path, Clock::time_point now);
+
+private:
+    std::unordered_set<std::string> m_files;                        // ӵļ
+    std::unordered_map<std::string, Clock::time_point> m_pending;   // ȴϲ޸ģļ -> һ¼ʱ
+
+#ifdef __linux__
+    int m_inotifyFd = -1;
+    std::unordered_map<int, std::string> m_directories;             // inotify watch -> Ŀ¼
+    std::unordered_set<std::string> m_watchedDirectories;
+#else
+    // ûinotifyʱѯ޸ʱ
+    static constexpr std::chrono::milliseconds POLL_INTERVAL{ 250 };
+    std::unordered_map<std::string, long long> m_modifiedTimes;     // ļ -> ϴο޸ʱ
+    Clock::time_point m_lastScan;
+#endif
+};
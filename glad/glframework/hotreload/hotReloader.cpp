@@ -0,0 +1,230 @@
+#include "hotReloader.h"
+#include "../asset/assetScheduler.h"
+#include "../resource/resourceManager.h"
+#include "../model.h"
+#include "../shader.h"
+#include "../texture.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+HotReloader* HotReloader::mInstance = nullptr;
+
+namespace {
+    double elapsedMs(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+HotReloader* HotReloader::getInstance() {
+    if (mInstance == nullptr) {
+        mInstance = new HotReloader();
+    }
+    return mInstance;
+}
+
+void HotReloader::watchShader(ShaderHandle shader) {
+    Shader* shaderPtr = ResourceManager::getInstance()->get(shader);
+    if (!shaderPtr) {
+        return;
+    }
+    m_shaders.push_back(shader);
+    m_watcher.watch(shaderPtr->getVertexPath());
+    m_watcher.watch(shaderPtr->getFragmentPath());
+}
+
+void HotReloader::watchModel(Model* model, const std::string& textureBaseDir) {
+    if (!model) {
+        return;
+    }
+    const std::string& filePath = model->getFilePath();
+    std::string objBaseDir = filePath.substr(0, filePath.find_last_of("/\\") + 1);
+
+    WatchedModel entry;
+    entry.model = model;
+    entry.objPath = FileWatcher::normalize(filePath);
+    if (!model->getMtlLibName().empty()) {
+        entry.mtlPath = FileWatcher::normalize(objBaseDir + model->getMtlLibName());
+    }
+    // Model캯ͬԼ
+    entry.textureBaseDir = textureBaseDir.empty() ? objBaseDir + "materials_textures/" : textureBaseDir;
+
+    watchModelFiles(entry);
+    m_models[m_nextModelId++] = std::move(entry);
+}
+
+void HotReloader::unwatchModel(Model* model) {
+    for (auto it = m_models.begin(); it != m_models.end(); ++it) {
+        if (it->second.model == model) {
+            m_models.erase(it);
+            return;
+        }
+    }
+}
+
+void HotReloader::watchModelFiles(const WatchedModel& entry) {
+    m_watcher.watch(entry.objPath);
+    if (!entry.mtlPath.empty()) {
+        m_watcher.watch(entry.mtlPath);
+    }
+    ResourceManager* resourceManager = ResourceManager::getInstance();
+    for (const auto& [name, handle] : entry.model->getMaterials()) {
+        Material* material = resourceManager->get(handle);
+        if (material && !material->m_diffuseTexturePath.empty()) {
+            m_watcher.watch(material->m_diffuseTexturePath);
+        }
+    }
+}
+
+void HotReloader::update() {
+    std::vector<std::string> changedFiles;
+    m_watcher.poll(changedFiles);
+    for (const std::string& file : changedFiles) {
+        dispatch(file);
+    }
+}
+
+void HotReloader::dispatch(const std::string& file) {
+    ResourceManager* resourceManager = ResourceManager::getInstance();
+
+    // ShaderļСֱGL߳±
+    for (ShaderHandle handle : m_shaders) {
+        Shader* shader = resourceManager->get(handle);
+        if (shader && (FileWatcher::normalize(shader->getVertexPath()) == file || FileWatcher::normalize(shader->getFragmentPath()) == file)) {
+            auto start = std::chrono::steady_clock::now();
+            if (shader->reload()) {
+                std::cout << "Hot reload: shader recompiled in " << elapsedMs(start) << " ms." << std::endl;
+            }
+        }
+    }
+    // ѱٵShaderټ
+    m_shaders.erase(std::remove_if(m_shaders.begin(), m_shaders.end(), [&](ShaderHandle handle) {
+        return resourceManager->get(handle) == nullptr;
+    }), m_shaders.end());
+
+    for (auto& [id, entry] : m_models) {
+        if (entry.objPath == file) {
+            spawn(reloadGeometry(id, ++entry.geometryVersion, file));
+        }
+        if (entry.mtlPath == file) {
+            spawn(reloadMaterials(id, ++entry.materialVersion, file, entry.textureBaseDir));
+        }
+    }
+
+    if (!findTextures(file).empty()) {
+        spawn(reloadTexture(file, ++m_textureVersions[file]));
+    }
+}
+
+std::vector<TextureHandle> HotReloader::findTextures(const std::string& path) {
+    ResourceManager* resourceManager = ResourceManager::getInstance();
+    std::vector<TextureHandle> textures;
+    for (const auto& [id, entry] : m_models) {
+        for (const auto& [name, handle] : entry.model->getMaterials()) {
+            Material* material = resourceManager->get(handle);
+            if (!material || !material->m_diffuseTexture || material->m_diffuseTexturePath.empty()) {
+                continue;
+            }
+            if (FileWatcher::normalize(material->m_diffuseTexturePath) == path
+                && std::find(textures.begin(), textures.end(), material->m_diffuseTexture) == textures.end()) {
+                textures.push_back(material->m_diffuseTexture);
+            }
+        }
+    }
+    return textures;
+}
+
+Task<void> HotReloader::reloadGeometry(uint64_t id, uint64_t version, std::string objPath) {
+    AssetScheduler* scheduler = AssetScheduler::getInstance();
+    auto start = std::chrono::steady_clock::now();
+
+    ModelData data;
+    bool ok = false;
+    {
+        // ȡ (I/O߳) ͽ (߳) ռGL߳
+        FileData objFile = co_await scheduler->readFile(objPath);
+        if (objFile.ok) {
+            co_await scheduler->switchToWorker();
+            ok = Model::parseObj(objFile.view(), objPath, data);
+            if (ok) {
+                Model::buildOutlines(data);
+                Model::buildCollisionMesh(data);
+            }
+        }
+    }
+
+    co_await scheduler->nextGLFrame();
+    auto it = m_models.find(id);
+    if (it == m_models.end() || it->second.geometryVersion != version) {
+        co_return; // ģѱƳڼļֱ޸Ĺ
+    }
+    if (!ok) {
+        std::cerr << "ERROR: Hot reload failed, keeping previous geometry: " << objPath << std::endl;
+        co_return;
+    }
+    it->second.model->reloadGeometry(std::move(data));
+    std::cout << "Hot reload: model geometry updated in " << elapsedMs(start) << " ms." << std::endl;
+}
+
+Task<void> HotReloader::reloadMaterials(uint64_t id, uint64_t version, std::string mtlPath, std::string textureBaseDir) {
+    AssetScheduler* scheduler = AssetScheduler::getInstance();
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<MaterialData> materials;
+    bool ok = false;
+    {
+        FileData mtlFile = co_await scheduler->readFile(mtlPath);
+        if (mtlFile.ok) {
+            co_await scheduler->switchToWorker();
+            materials = Material::parseMtl(mtlFile.view(), textureBaseDir);
+            ok = true;
+        }
+    }
+
+    co_await scheduler->nextGLFrame();
+    auto it = m_models.find(id);
+    if (it == m_models.end() || it->second.materialVersion != version) {
+        co_return;
+    }
+    if (!ok) {
+        std::cerr << "ERROR: Hot reload failed, keeping previous materials: " << mtlPath << std::endl;
+        co_return;
+    }
+    // 仯Ĳʻɹ淶 (MeshΪָ¾)еͼֱӹ
+    it->second.model->reloadMaterials(materials);
+    watchModelFiles(it->second);
+    std::cout << "Hot reload: materials updated in " << elapsedMs(start) << " ms." << std::endl;
+}
+
+Task<void> HotReloader::reloadTexture(std::string path, uint64_t version) {
+    AssetScheduler* scheduler = AssetScheduler::getInstance();
+    auto start = std::chrono::steady_clock::now();
+
+    ImageData image;
+    {
+        FileData imageFile = co_await scheduler->readFile(path);
+        if (imageFile.ok) {
+            co_await scheduler->switchToWorker();
+            Texture::decode(reinterpret_cast<const unsigned char*>(imageFile.bytes.data()), imageFile.bytes.size(), image);
+        }
+    }
+
+    co_await scheduler->nextGLFrame();
+    if (m_textureVersions[path] != version) {
+        co_return;
+    }
+    if (image.empty()) {
+        std::cerr << "ERROR: Hot reload failed, keeping previous texture: " << path << std::endl;
+        co_return;
+    }
+    // ²ڼʿѾı
+    ResourceManager* resourceManager = ResourceManager::getInstance();
+    for (TextureHandle handle : findTextures(path)) {
+        Texture* texture = resourceManager->get(handle);
+        if (texture) {
+            texture->reload(image);
+        }
+    }
+    std::cout << "Hot reload: texture updated in " << elapsedMs(start) << " ms." << std::endl;
+}
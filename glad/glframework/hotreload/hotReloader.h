@@ -0,0 +1,73 @@
+#pragma once
+
+#include "fileWatcher.h"
+#include "../asset/task.h"        // ̨ȡͽʹЭ
+#include "../resource/handle.h"   // ShaderTextureִͨ
+
+#include <cstdint>            // uint64_t
+#include <string>             // std::string
+#include <vector>             // std::vector
+#include <unordered_map>      // ڼ¼ӵĶ
+
+class Model;
+
+// HotReloaderԴأȫΨһ
+// ѵǼǵShaderģ (OBJ)ʿ (MTL) ͼļļֻӰԴ
+// - ShaderļGL߳±Shaderʧʱɰ汾
+// - OBJļI/O̶߳ȡ߳̽Ȼֻϴб仯Mesh
+// - MTLļ½ʿ⣬仯ĲʻMaterialCacheеĹ淶 (µĲʾ)ûеͼŻأ
+// - ͼļڹ߳̽룬ȻԭظʹTexture (ߴ粻ʱglTexSubImage2D)
+// 仯Ĳ⣬оGLǰ󱣳ֲ䣬еԴӰ졣
+// ʹǰ᣺ѭÿ֡update() AssetScheduler::getInstance()->pumpGLQueue(...)
+class HotReloader {
+public:
+    ~HotReloader() = default;
+
+    static HotReloader* getInstance();
+
+    // Shadervs/fsļ
+    void watchShader(ShaderHandle shader);
+
+    // ģ͵OBJļMTLļͼļģͱǰunwatchModel
+    // - textureBaseDir: ģʱʹõĿ¼ͬΪʱʹOBJļĿ¼µ "materials_textures/"
+    void watchModel(Model* model, const std::string& textureBaseDir = "");
+    void unwatchModel(Model* model);
+
+    // ļ޸Ĳأÿ֡GL̵߳һ
+    void update();
+
+private:
+    HotReloader() = default;
+
+    struct WatchedModel {
+        Model* model = nullptr;
+        std::string objPath;           // 淶·
+        std::string mtlPath;
+        std::string textureBaseDir;
+        uint64_t geometryVersion = 0;  // ÿηؼ1ֻһصĽᱻӦ
+        uint64_t materialVersion = 0;
+    };
+
+    // Ǽģ͵ǰõļ
+    void watchModelFiles(const WatchedModel& entry);
+
+    // һ޸ĵļַӰԴ
+    void dispatch(const std::string& file);
+
+    // ̨ȡɺGL߳Ӧ (ģidãڼ䱻unwatchģͻᱻ)
+    Task<void> reloadGeometry(uint64_t id, uint64_t version, std::string objPath);
+    Task<void> reloadMaterials(uint64_t id, uint64_t version, std::string mtlPath, std::string textureBaseDir);
+    Task<void> reloadTexture(std::string path, uint64_t version);
+
+    // ռбӵģʹøͼļ
+    std::vector<TextureHandle> findTextures(const std::string& path);
+
+private:
+    static HotReloader* mInstance;
+
+    FileWatcher m_watcher;
+    std::vector<ShaderHandle> m_shaders;
+    std::unordered_map<uint64_t, WatchedModel> m_models;   // Ǽid -> ģ
+    std::unordered_map<std::string, uint64_t> m_textureVersions; // ͼļ -> һصİ汾
+    uint64_t m_nextModelId = 1;
+};
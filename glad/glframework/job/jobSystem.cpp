@@ -0,0 +1,243 @@
+#include "jobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+
+JobSystem* JobSystem::mInstance = nullptr;
+
+namespace {
+    // ÿ̼߳¼ԼJobSystemеĹ߳±
+    thread_local size_t t_workerIndex = ~size_t(0);
+}
+
+JobSystem* JobSystem::getInstance() {
+    if (mInstance == nullptr) {
+        mInstance = new JobSystem();
+    }
+    return mInstance;
+}
+
+JobSystem::JobSystem() {
+    unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    size_t workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+
+    m_queues.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i) {
+        m_queues.push_back(new WorkerQueue());
+    }
+    // ọ֮̈̄߳ȡʱʵδʼĶ
+    m_workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    shutdown();
+}
+
+void JobSystem::shutdown() {
+    if (!m_running.exchange(false)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+    m_sleepCondition.notify_all();
+    for (std::thread& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    m_workers.clear();
+
+    // ˳ǰʣڵǰִ֤߳꣬ڼϵĵȴ߲Զ
+    Task task;
+    while (popHigh(task) || steal(NOT_A_WORKER, task)) {
+        execute(task);
+    }
+    for (WorkerQueue* queue : m_queues) {
+        delete queue;
+    }
+    m_queues.clear();
+}
+
+size_t JobSystem::currentWorkerIndex() {
+    return t_workerIndex;
+}
+
+void JobSystem::run(Job job, JobCounter* counter, JobPriority priority) {
+    if (counter != nullptr) {
+        counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+    }
+    Task task;
+    task.job = std::move(job);
+    task.counter = counter;
+
+    if (m_queues.empty()) {
+        // Ѿshutdownֱڵǰִ߳
+        execute(task);
+        return;
+    }
+    push(std::move(task), priority);
+}
+
+void JobSystem::push(Task task, JobPriority priority) {
+    if (priority == JobPriority::High) {
+        std::lock_guard<std::mutex> lock(m_highPriority.mutex);
+        m_highPriority.tasks.push_back(std::move(task));
+    }
+    else {
+        // ߳ύԼĶУⲿ߳ύ
+        size_t index = currentWorkerIndex();
+        if (index == NOT_A_WORKER) {
+            index = m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+        }
+        std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+        m_queues[index]->tasks.push_back(std::move(task));
+    }
+    m_queuedTasks.fetch_add(1, std::memory_order_release);
+
+    if (m_idleWorkers.load(std::memory_order_acquire) > 0) {
+        m_sleepCondition.notify_one();
+    }
+}
+
+bool JobSystem::popHigh(Task& task) {
+    std::lock_guard<std::mutex> lock(m_highPriority.mutex);
+    if (m_highPriority.tasks.empty()) {
+        return false;
+    }
+    task = std::move(m_highPriority.tasks.front());
+    m_highPriority.tasks.pop_front();
+    m_queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool JobSystem::popLocal(size_t workerIndex, Task& task) {
+    WorkerQueue* queue = m_queues[workerIndex];
+    std::lock_guard<std::mutex> lock(queue->mutex);
+    if (queue->tasks.empty()) {
+        return false;
+    }
+    // ԼĶдӶβȡύݻڻ
+    task = std::move(queue->tasks.back());
+    queue->tasks.pop_back();
+    m_queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool JobSystem::steal(size_t thiefIndex, Task& task) {
+    size_t count = m_queues.size();
+    if (count == 0) {
+        return false;
+    }
+    // ڶпʼѯ߳ͬʱȡͬһ
+    size_t start = thiefIndex == NOT_A_WORKER ? 0 : thiefIndex + 1;
+    for (size_t i = 0; i < count; ++i) {
+        size_t victim = (start + i) % count;
+        if (victim == thiefIndex) {
+            continue;
+        }
+        WorkerQueue* queue = m_queues[victim];
+        std::unique_lock<std::mutex> lock(queue->mutex, std::try_to_lock);
+        if (!lock.owns_lock() || queue->tasks.empty()) {
+            continue;
+        }
+        // ӶȡύͨδϸֵĴ鹤
+        task = std::move(queue->tasks.front());
+        queue->tasks.pop_front();
+        m_queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::execute(Task& task) {
+    if (task.job) {
+        task.job();
+    }
+    if (task.counter != nullptr) {
+        task.counter->m_pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+    task = Task();
+}
+
+bool JobSystem::tryRunOne(size_t selfIndex) {
+    Task task;
+    if (popHigh(task)
+        || (selfIndex != NOT_A_WORKER && popLocal(selfIndex, task))
+        || steal(selfIndex, task)) {
+        execute(task);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::workerLoop(size_t workerIndex) {
+    t_workerIndex = workerIndex;
+
+    while (m_running.load(std::memory_order_acquire)) {
+        if (tryRunOne(workerIndex)) {
+            continue;
+        }
+
+        // ûߣֱύʱ (ʱֲtry_to_lockȡʧܵ)
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_idleWorkers.fetch_add(1, std::memory_order_acq_rel);
+        m_sleepCondition.wait_for(lock, std::chrono::milliseconds(2), [this]() {
+            return !m_running.load(std::memory_order_acquire)
+                || m_queuedTasks.load(std::memory_order_acquire) > 0;
+        });
+        m_idleWorkers.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
+
+void JobSystem::wait(JobCounter& counter) {
+    size_t selfIndex = currentWorkerIndex();
+    while (!counter.isDone()) {
+        if (!tryRunOne(selfIndex)) {
+            // ʣִ߳УóʱƬ
+            std::this_thread::yield();
+        }
+    }
+}
+
+void JobSystem::parallelFor(size_t begin, size_t end, const std::function<void(size_t, size_t)>& body,
+    size_t grainSize, JobPriority priority) {
+    if (begin >= end) {
+        return;
+    }
+    size_t count = end - begin;
+    if (grainSize == 0) {
+        // Ӧȣÿ̴߳Լֵ4飬ڸزʱȡ
+        grainSize = std::max<size_t>(1, count / (getThreadCount() * 4));
+    }
+    if (count <= grainSize || m_queues.empty()) {
+        body(begin, end);
+        return;
+    }
+
+    JobCounter counter;
+    splitRange(begin, end, grainSize, body, counter, priority);
+    wait(counter);
+}
+
+void JobSystem::splitRange(size_t begin, size_t end, size_t grainSize,
+    const std::function<void(size_t, size_t)>& body, JobCounter& counter, JobPriority priority) {
+    // ݹ֣ǰһ뽻 (ɱȡ)һڵǰ̼߳ϸ֡
+    // ̶߳æ (㹻) ʱֹͣϸֱִ֣Уٵȿ
+    while (end - begin > grainSize) {
+        int queued = m_queuedTasks.load(std::memory_order_relaxed);
+        if (queued >= static_cast<int>(getThreadCount() * 2) && end - begin <= grainSize * 4) {
+            break;
+        }
+        size_t middle = begin + (end - begin) / 2;
+        size_t splitBegin = begin;
+        run([this, splitBegin, middle, grainSize, &body, &counter, priority]() {
+            splitRange(splitBegin, middle, grainSize, body, counter, priority);
+        }, &counter, priority);
+        begin = middle;
+    }
+    body(begin, end);
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>             // std::atomic
+#include <functional>         // std::function
+#include <vector>             // std::vector
+#include <deque>              // ÿ̵߳
+#include <thread>             // std::thread
+#include <mutex>              // std::mutex
+#include <condition_variable> // ڿ߳
+#include <cstddef>            // size_t
+
+// JobCounterfork-join
+// ÿύһڸüϵ񣬼һִϣһ
+// JobSystem::wait(counter) һֱֱִ㡣
+// Լͬһύ (Ƕfork-join)
+class JobCounter {
+public:
+    JobCounter() = default;
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+
+    bool isDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<int> m_pending{ 0 };
+};
+
+enum class JobPriority {
+    High,   // ִ (統ǰ֡ҪĹ)
+    Normal  // ͨ (̨)
+};
+
+// JobSystemȫΨһĹȡϵͳ
+// - ÿ߳Լ˫˶У̴߳Ӷβȡ (LIFOѺ)
+//   ̴̵߳߳Ķȡ (FIFOȡͨǽϴ)
+// - ȼڹУ߳ȴ
+// - ǹ߳ (߳) ύ̵߳ĶУ
+// - wait()ڼ̲߳յȣǲִ˿ڲǶwait()
+// ߳ĬΪӲ߳-1 (߳Ҳwaitвִ)
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+
+    ~JobSystem();
+
+    static JobSystem* getInstance();
+
+    // ύһcounterΪʱڸü
+    void run(Job job, JobCounter* counter = nullptr, JobPriority priority = JobPriority::Normal);
+
+    // ȴ㣬ȴڼִ
+    void wait(JobCounter& counter);
+
+    // б[begin, end)body(rangeBegin, rangeEnd)һ䡣
+    // grainSizeΪ0ʱӦ 䳤 / (߳*4) ƣɵݹп߳ʱϸ֡
+    // ִ̻߳Уʱ䶼Ѵꡣ
+    void parallelFor(size_t begin, size_t end, const std::function<void(size_t, size_t)>& body,
+        size_t grainSize = 0, JobPriority priority = JobPriority::Normal);
+
+    // ִ߳ (߳ + ߳)
+    size_t getThreadCount() const { return m_workers.size() + 1; }
+
+    // ֹͣй̣߳˳ǰ
+    void shutdown();
+
+private:
+    JobSystem();
+
+    struct Task {
+        Job job;
+        JobCounter* counter = nullptr;
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void workerLoop(size_t workerIndex);
+
+    // ȡһִУûʱfalse
+    bool tryRunOne(size_t selfIndex);
+    bool popLocal(size_t workerIndex, Task& task);
+    bool popHigh(Task& task);
+    bool steal(size_t thiefIndex, Task& task);
+    void execute(Task& task);
+    void push(Task task, JobPriority priority);
+
+    void splitRange(size_t begin, size_t end, size_t grainSize,
+        const std::function<void(size_t, size_t)>& body, JobCounter& counter, JobPriority priority);
+
+    // ǰ̶߳ӦĹ߳±꣬ǹ߳ΪNOT_A_WORKER
+    static constexpr size_t NOT_A_WORKER = ~size_t(0);
+    static size_t currentWorkerIndex();
+
+private:
+    static JobSystem* mInstance;
+
+    std::vector<std::thread> m_workers;
+    std::vector<WorkerQueue*> m_queues;   // ÿ߳һ
+    WorkerQueue m_highPriority;           // ȼ
+
+    std::atomic<size_t> m_nextQueue{ 0 }; // ⲿ߳ύʱת±
+    std::atomic<int> m_queuedTasks{ 0 };  // жежǷֵüϸֺͻ
+    std::atomic<int> m_idleWorkers{ 0 };
+
+    std::mutex m_sleepMutex;
+    std::condition_variable m_sleepCondition;
+    std::atomic<bool> m_running{ true };
+};
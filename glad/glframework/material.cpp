@@ -5,26 +5,67 @@
 #include <fstream>      // <<< ӴУstd::ifstream
 #include <sstream>      // <<< ӴУstd::stringstream
 #include "shader.h" // ҪShaderuniforms
+#include "resource/resourceManager.h" // ResourceManagerͻ
+#include <utility>
+#include <algorithm>    // std::clamp
 
-// 캯.mtlļ
-Material::Material(const std::string& mtlFilePath, const std::string& baseDir) {
-    loadMtlFile(mtlFilePath, baseDir);
+// 캯ݽõĲݴ
+Material::Material(const MaterialData& data)
+    : m_name(data.name), m_Ks(data.Ks), m_opacity(data.opacity)
+{
+    createDiffuseTexture(data);
+}
+
+Material::Material(const std::string& name, const glm::vec3& Ks, TextureHandle diffuseTexture, float opacity)
+    : m_name(name), m_Ks(Ks), m_opacity(opacity), m_diffuseTexture(diffuseTexture)
+{
+    if (m_diffuseTexture) {
+        ResourceManager::getInstance()->addRef(m_diffuseTexture);
+    }
+}
+
+void Material::createDiffuseTexture(const MaterialData& data) {
+    m_diffuseTexturePath = data.diffuseTexturePath;
+    // 󶨵Ԫ0
+    if (!data.diffuseImage.empty()) {
+        m_diffuseTexture = ResourceManager::getInstance()->create<Texture>(data.diffuseImage, 0);
+    }
+    else if (!data.diffuseTexturePath.empty()) {
+        m_diffuseTexture = ResourceManager::getInstance()->create<Texture>(data.diffuseTexturePath, 0);
+    }
 }
 
 Material::~Material() {
-    // ͷŶ̬
+    // ͷãüResourceManagerͳһ
+    // ƶĶΪգظͷ
     if (m_diffuseTexture) {
-        delete m_diffuseTexture;
-        m_diffuseTexture = nullptr;
+        ResourceManager::getInstance()->release(m_diffuseTexture);
+        m_diffuseTexture = TextureHandle();
+    }
+    if (!m_name.empty()) {
+        std::cout << "Material '" << m_name << "' destroyed." << std::endl;
     }
-    std::cout << "Material '" << m_name << "' destroyed." << std::endl;
+}
+
+Material::Material(Material&& other) noexcept {
+    *this = std::move(other);
+}
+
+Material& Material::operator=(Material&& other) noexcept {
+    std::swap(m_name, other.m_name);
+    std::swap(m_Ks, other.m_Ks);
+    std::swap(m_opacity, other.m_opacity);
+    std::swap(m_diffuseTexture, other.m_diffuseTexture);
+    std::swap(m_diffuseTexturePath, other.m_diffuseTexturePath);
+    return *this;
 }
 
 // ʣʵԣ󶨵ɫ
 void Material::use(Shader& shader) {
     // Ԫ0
-    if (m_diffuseTexture) {
-        m_diffuseTexture->bind(); // Ԫ
+    Texture* diffuseTexture = ResourceManager::getInstance()->get(m_diffuseTexture);
+    if (diffuseTexture) {
+        diffuseTexture->bind(); // Ԫ
         shader.setInt("u_DiffuseSampler", 0); // Ԫ0ݸɫеuniform sampler
     }
     else {
@@ -33,42 +74,72 @@ void Material::use(Shader& shader) {
          GL_CALL(glBindTexture(GL_TEXTURE_2D, 0)); // 
         // shader.setVector3("u_DiffuseColor", m_Kd.x, m_Kd.y, m_Kd.z); // KdɫԴ
     }
+    // ͸ȳ˵Ƭεalphaϣֻ͸ͨпʱ
+    shader.setFloat("opacity", m_opacity);
     // TODO: ԣ羵淴ɫKsҲﴫ
     // shader.setVector3("u_Ks", m_Ks.x, m_Ks.y, m_Ks.z);
 }
 
-// .mtlļزԺ
-void Material::loadMtlFile(const std::string& mtlFilePath, const std::string& baseDir) {
-    std::ifstream file(mtlFilePath);
-    if (!file.is_open()) {
-        std::cerr << "ERROR: Could not open MTL file: " << mtlFilePath << std::endl;
-        return;
-    }
+// .mtlļݣÿnewmtlʼһ²
+std::vector<MaterialData> Material::parseMtl(std::string_view mtlText, const std::string& baseDir) {
+    std::vector<MaterialData> materials;
+
+    size_t lineStart = 0;
+    while (lineStart < mtlText.size()) {
+        size_t lineEnd = mtlText.find('\n', lineStart);
+        if (lineEnd == std::string_view::npos) {
+            lineEnd = mtlText.size();
+        }
+        std::stringstream ss(std::string(mtlText.substr(lineStart, lineEnd - lineStart)));
+        lineStart = lineEnd + 1;
 
-    std::string line;
-    while (std::getline(file, line)) {
-        std::stringstream ss(line);
         std::string type;
         ss >> type;
 
         if (type == "newmtl") {
-            ss >> m_name; // ȡ
-            std::cout << "Loading material: " << m_name << std::endl;
+            materials.emplace_back();
+            ss >> materials.back().name; // ȡ
+            std::cout << "Loading material: " << materials.back().name << std::endl;
+            continue;
+        }
+        if (materials.empty()) {
+            // newmtl֮ǰûʣ
+            continue;
         }
-        else if (type == "map_Kd") { // ͼ
+        MaterialData& material = materials.back();
+        if (type == "map_Kd") { // ͼ
             std::string textureRelativePath;
             ss >> textureRelativePath;
-            // ľ·
-            std::string textureFullPath = baseDir + "/" + textureRelativePath;
-            // 󶨵Ԫ0
-            m_diffuseTexture = new Texture(textureFullPath, 0);
-            std::cout << "  Diffuse texture: " << textureFullPath << std::endl;
+            // ·ͬһظmap_KdʱһΪ׼
+            material.diffuseTexturePath = baseDir + "/" + textureRelativePath;
+            std::cout << "  Diffuse texture: " << material.diffuseTexturePath << std::endl;
         }
         else if (type == "Ks") { // 淴ɫ
-            ss >> m_Ks.x >> m_Ks.y >> m_Ks.z;
-            std::cout << "  Ks: (" << m_Ks.x << ", " << m_Ks.y << ", " << m_Ks.z << ")" << std::endl;
+            ss >> material.Ks.x >> material.Ks.y >> material.Ks.z;
+            std::cout << "  Ks: (" << material.Ks.x << ", " << material.Ks.y << ", " << material.Ks.z << ")" << std::endl;
+        }
+        else if (type == "d") { // ͸
+            ss >> material.opacity;
+            material.opacity = std::clamp(material.opacity, 0.0f, 1.0f);
+        }
+        else if (type == "Tr") { // ͸ (ֵTrd)
+            float transparency = 0.0f;
+            ss >> transparency;
+            material.opacity = std::clamp(1.0f - transparency, 0.0f, 1.0f);
         }
         // TODO: ӶKd, Ka, NsMTLԵĽ
     }
-    file.close();
+    return materials;
+}
+
+// ȡ.mtlļ
+std::vector<MaterialData> Material::loadMtlFile(const std::string& mtlFilePath, const std::string& baseDir) {
+    std::ifstream file(mtlFilePath, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "ERROR: Could not open MTL file: " << mtlFilePath << std::endl;
+        return {};
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return parseMtl(buffer.str(), baseDir);
 }
\ No newline at end of file
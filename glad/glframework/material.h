@@ -4,19 +4,51 @@
 #include "../wrapper/checkError.h" // OpenGL
 #include "texture.h"          // TextureOpenGL
 #include "shader.h"           // ShaderOpenGLɫ
+#include "resource/handle.h"  // ִͨãResourceManager
 #include <string>             // std::string
+#include <string_view>        // ڽڴеMTLı
+#include <vector>             // std::vector
 #include <map>                // std::map洢
 #include <iostream>           // std::cerr, std::coutе
 
+// MaterialData.mtlļһ (CPUݣκGL)
+// ڹ߳Ͻͽ֮GL߳Material
+struct MaterialData {
+    std::string name;                   //  (newmtl)
+    glm::vec3 Ks = glm::vec3(0.333f);   // 淴ɫ (Ks)
+    float opacity = 1.0f;               // ͸ (d1 - Tr)С1Ĳ͸ͨлϻ
+    std::string diffuseTexturePath;     // ͼ (map_Kd) ·Ϊձʾûͼ
+    ImageData diffuseImage;             // ѽͼΪʱMaterialdiffuseTexturePathͬ
+};
+
 // Materialࣺ.mtlļ
 class Material {
 public:
     // 캯
-    // - mtlFilePath: .mtlļ· "assets/models/building.mtl"
-    // - baseDir: ļڵĿ¼ڹͼƬľ·
-    Material(const std::string& mtlFilePath, const std::string& baseDir);
+    // - data: õĲݣͼѽʱֻGLϴ
+    // ҪGLģGL̵߳á
+    explicit Material(const MaterialData& data);
+
+    // 캯ʹѾõ (Դ)Materialһá
+    Material(const std::string& name, const glm::vec3& Ks, TextureHandle diffuseTexture, float opacity = 1.0f);
     ~Material();
 
+    // .mtlļݣһļпԶ (ÿnewmtlʼһ²)
+    // - mtlText: .mtlļȫݡ
+    // - baseDir: ͼƬڵĿ¼ڹͼƬ·
+    // ֻı̵߳á
+    static std::vector<MaterialData> parseMtl(std::string_view mtlText, const std::string& baseDir);
+
+    // ȡ.mtlļļʧʱؿ
+    static std::vector<MaterialData> loadMtlFile(const std::string& mtlFilePath, const std::string& baseDir);
+
+    // ʴResourcePoolĳУֹֻƶ
+    // ƶֵýʵ֣ľԴʱͷá
+    Material(const Material&) = delete;
+    Material& operator=(const Material&) = delete;
+    Material(Material&& other) noexcept;
+    Material& operator=(Material&& other) noexcept;
+
     // ʣ
     // - shader: ǰShader
     // ʵԣ󶨵ɫ
@@ -25,18 +57,21 @@ public:
     // ȡ
     const std::string& getName() const { return m_name; }
 
+    // ǷҪϻ (TransparentQueue)
+    bool isTransparent() const { return m_opacity < 1.0f; }
+
 private:
-    // .mtlļزԺ
-    // - mtlFilePath: .mtlļ·
-    // - baseDir: ͼƬڵĿ¼
-    void loadMtlFile(const std::string& mtlFilePath, const std::string& baseDir);
+    // ݲݴ (ѽʱֻGLϴ·ͬ)
+    void createDiffuseTexture(const MaterialData& data);
 
 public:
     std::string m_name; //  (newmtlָȡ)
     glm::vec3 m_Ks = glm::vec3(0.333f); // 淴ɫ (Ks)Ĭֵ
-    // TODO: ӸԣKd (ɫ), Ka (ɫ), Ns (߹ָ), d (͸) 
+    float m_opacity = 1.0f; // ͸ (d)Ĭϲ͸
+    // TODO: ӸԣKd (ɫ), Ka (ɫ), Ns (߹ָ) 
 
     // ͼĿǰֻͼ (map_Kd)
-    // std::map<std::string, Texture*> m_textures; // Դ洢
-    Texture* m_diffuseTexture = nullptr; //  (map_Kd)
+    // std::map<std::string, TextureHandle> m_textures; // Դ洢
+    TextureHandle m_diffuseTexture; //  (map_Kd)һ
+    std::string m_diffuseTexturePath; // ͼ·ûͼԴʱΪ
 };
\ No newline at end of file
@@ -0,0 +1,91 @@
+#include "allocationTracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<size_t> g_allocationCount{ 0 };
+    std::atomic<size_t> g_currentBytes{ 0 };
+    std::atomic<size_t> g_peakBytes{ 0 };
+
+    thread_local size_t t_allocationCount = 0;
+    thread_local long long t_currentBytes = 0;
+    thread_local long long t_peakBytes = 0;
+}
+
+#ifdef TRACK_ALLOCATIONS
+
+namespace {
+    // ÿڴǰ¼Сͷʱݴ˿ۼǰռ
+    constexpr size_t HEADER_SIZE = alignof(std::max_align_t);
+
+    void* trackedAllocate(size_t size) {
+        void* raw = std::malloc(size + HEADER_SIZE);
+        if (raw == nullptr) {
+            throw std::bad_alloc();
+        }
+        *static_cast<size_t*>(raw) = size;
+
+        g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+        size_t current = g_currentBytes.fetch_add(size, std::memory_order_relaxed) + size;
+        size_t peak = g_peakBytes.load(std::memory_order_relaxed);
+        while (current > peak && !g_peakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+        }
+
+        ++t_allocationCount;
+        t_currentBytes += static_cast<long long>(size);
+        if (t_currentBytes > t_peakBytes) {
+            t_peakBytes = t_currentBytes;
+        }
+        return static_cast<char*>(raw) + HEADER_SIZE;
+    }
+
+    void trackedFree(void* p) {
+        if (p == nullptr) {
+            return;
+        }
+        void* raw = static_cast<char*>(p) - HEADER_SIZE;
+        size_t size = *static_cast<size_t*>(raw);
+        g_currentBytes.fetch_sub(size, std::memory_order_relaxed);
+        t_currentBytes -= static_cast<long long>(size);
+        std::free(raw);
+    }
+}
+
+void* operator new(size_t size) { return trackedAllocate(size); }
+void* operator new[](size_t size) { return trackedAllocate(size); }
+void operator delete(void* p) noexcept { trackedFree(p); }
+void operator delete[](void* p) noexcept { trackedFree(p); }
+void operator delete(void* p, size_t) noexcept { trackedFree(p); }
+void operator delete[](void* p, size_t) noexcept { trackedFree(p); }
+
+#endif
+
+bool AllocationTracker::isEnabled() {
+#ifdef TRACK_ALLOCATIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+AllocationTracker::Snapshot AllocationTracker::snapshot() {
+    Snapshot result;
+    result.allocationCount = g_allocationCount.load(std::memory_order_relaxed);
+    result.currentBytes = g_currentBytes.load(std::memory_order_relaxed);
+    result.peakBytes = g_peakBytes.load(std::memory_order_relaxed);
+    return result;
+}
+
+AllocationTracker::ThreadSnapshot AllocationTracker::threadSnapshot() {
+    ThreadSnapshot result;
+    result.allocationCount = t_allocationCount;
+    result.currentBytes = t_currentBytes;
+    result.peakBytes = t_peakBytes;
+    return result;
+}
+
+void AllocationTracker::resetThreadPeak() {
+    t_peakBytes = t_currentBytes;
+}
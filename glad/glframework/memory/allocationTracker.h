@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>            // size_t
+
+// AllocationTrackerȫֶѷͳ
+// TRACK_ALLOCATIONSʱ滻ȫoperator new/deleteͳƶѷ뵱ǰ/ֵռã
+// δʱͳֵΪ0κο
+// ڱȽģͼصȽ׶Żǰķͷֵڴ档
+class AllocationTracker {
+public:
+    struct Snapshot {
+        size_t allocationCount = 0; // ۼƷ
+        size_t currentBytes = 0;    // ǰռ
+        size_t peakBytes = 0;       // ķֵռ
+    };
+
+    // ̵߳ķͳơڴɱ߳ͷţԵǰռǱ̷߳ȥ߳ͷŵĲֵΪ
+    struct ThreadSnapshot {
+        size_t allocationCount = 0;     // ߳ۼƷ
+        long long currentBytes = 0;     // ̷߳ȥ߳ͷŵֽ
+        long long peakBytes = 0;        // Ա߳ϴresetThreadPeak()currentBytesķֵ
+    };
+
+    static bool isEnabled();
+
+    // ȫͳ
+    static Snapshot snapshot();
+
+    // ǰ̵߳ͳơڹ߳ϲִʱķ̸ֵ߳
+    static ThreadSnapshot threadSnapshot();
+
+    // ѵǰ̵߳ķֵΪǰ̵߳ռãڲĳ׶ڵķֵ
+    static void resetThreadPeak();
+};
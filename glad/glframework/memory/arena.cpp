@@ -0,0 +1,163 @@
+#include "arena.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>                // std::bad_alloc
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace {
+    // ޣ֮ٷ
+    constexpr size_t MAX_BLOCK_SIZE = size_t(64) << 20;
+    // ҳС (x86-64ͨΪ2MB)
+    constexpr size_t HUGE_PAGE_SIZE = size_t(2) << 20;
+
+    size_t alignUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+MonotonicArena::MonotonicArena(size_t initialBlockSize, bool useHugePages)
+    : m_nextBlockSize(initialBlockSize > 0 ? initialBlockSize : 4096),
+    m_useHugePages(useHugePages)
+{
+}
+
+MonotonicArena::~MonotonicArena() {
+    release();
+}
+
+void MonotonicArena::release() {
+    for (const Block& block : m_blocks) {
+        freePages(block);
+    }
+    m_blocks.clear();
+    m_cursor = nullptr;
+    m_end = nullptr;
+}
+
+void* MonotonicArena::do_allocate(size_t bytes, size_t alignment) {
+    // 1. ڵǰжα꣬ռ㹻ֱӷ
+    uintptr_t current = reinterpret_cast<uintptr_t>(m_cursor);
+    uintptr_t aligned = alignUp(current, alignment);
+    if (m_cursor == nullptr || aligned + bytes > reinterpret_cast<uintptr_t>(m_end)) {
+        // 2. ռ䲻㣬¿ (ԤĶռ)
+        addBlock(bytes + alignment);
+        current = reinterpret_cast<uintptr_t>(m_cursor);
+        aligned = alignUp(current, alignment);
+    }
+
+    char* result = reinterpret_cast<char*>(aligned);
+    m_stats.bytesUsed += (aligned - current) + bytes;
+    m_stats.allocationCount++;
+    m_cursor = result + bytes;
+    return result;
+}
+
+void MonotonicArena::do_deallocate(void*, size_t, size_t) {
+    // յڴrelease()ʱͳһ黹
+}
+
+bool MonotonicArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+void MonotonicArena::addBlock(size_t minSize) {
+    size_t size = m_nextBlockSize;
+    while (size < minSize) {
+        size *= 2;
+    }
+    if (m_nextBlockSize < MAX_BLOCK_SIZE) {
+        m_nextBlockSize *= 2;
+    }
+
+    Block block;
+    block.size = size;
+    block.memory = allocatePages(block.size, m_useHugePages, block.hugePages, block.mapped);
+    if (block.memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    m_blocks.push_back(block);
+
+    m_cursor = static_cast<char*>(block.memory);
+    m_end = m_cursor + block.size;
+
+    m_stats.blockCount++;
+    m_stats.bytesReserved += block.size;
+    if (block.hugePages) {
+        m_stats.hugePageBlocks++;
+    }
+}
+
+void* MonotonicArena::allocatePages(size_t& size, bool tryHugePages, bool& gotHugePages, bool& mapped) {
+    gotHugePages = false;
+    mapped = false;
+
+    if (!tryHugePages) {
+        return std::malloc(size);
+    }
+
+#ifdef _WIN32
+    // WindowsҳҪSeLockMemoryPrivilegeȨޣʧʱ˻ͨҳ
+    SIZE_T largePage = GetLargePageMinimum();
+    if (largePage > 0) {
+        size_t hugeSize = alignUp(size, largePage);
+        void* memory = VirtualAlloc(nullptr, hugeSize, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+        if (memory != nullptr) {
+            size = hugeSize;
+            gotHugePages = true;
+            mapped = true;
+            return memory;
+        }
+    }
+    size = alignUp(size, 4096);
+    mapped = true;
+    return VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+    size_t hugeSize = alignUp(size, HUGE_PAGE_SIZE);
+    void* memory = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    // 1. ԤĴҳ (hugetlbfs)Ҫϵͳǰnr_hugepages
+    memory = mmap(nullptr, hugeSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (memory != MAP_FAILED) {
+        size = hugeSize;
+        gotHugePages = true;
+        mapped = true;
+        return memory;
+    }
+#endif
+    // 2. ͨӳ + ͸ҳʾ
+    memory = mmap(nullptr, hugeSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) {
+        return nullptr;
+    }
+#ifdef MADV_HUGEPAGE
+    madvise(memory, hugeSize, MADV_HUGEPAGE);
+#endif
+    size = hugeSize;
+    mapped = true;
+    return memory;
+#endif
+}
+
+void MonotonicArena::freePages(const Block& block) {
+    if (block.memory == nullptr) {
+        return;
+    }
+    if (block.mapped) {
+#ifdef _WIN32
+        VirtualFree(block.memory, 0, MEM_RELEASE);
+#else
+        munmap(block.memory, block.size);
+#endif
+        return;
+    }
+    std::free(block.memory);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <memory_resource>    // std::pmr::memory_resource
+#include <vector>             // ڼ¼ڴ
+#include <cstddef>            // size_t
+
+// MonotonicArenaڴ (Է)
+// ģͼصȽ׶βĴʱ
+// - ֻƶָ룬κβǣdeallocateǿղ
+// - ڴarena (release()) ʱһԹ黹
+// - ѡʹôҳ (Linux: MAP_HUGETLB / THP, Windows: MEM_LARGE_PAGES)TLBȱʧʧʱԶ˻ͨҳ
+// ̳std::pmr::memory_resourceֱstd::pmr::vector / std::pmr::string / std::pmr::unordered_mapʹá
+// ע⣺̰߳ȫģ̼߳ʱÿ߳ʹԼarena
+class MonotonicArena : public std::pmr::memory_resource {
+public:
+    struct Stats {
+        size_t allocationCount = 0; // arenaڲķ ()
+        size_t bytesUsed = 0;       // ѷȥֽ ()
+        size_t bytesReserved = 0;   // ϵͳֽ
+        size_t blockCount = 0;      // ϵͳڴĴ
+        size_t hugePageBlocks = 0;  // гɹʹôҳĿ
+    };
+
+    // - initialBlockSize: һڴĴС鰴2
+    // - useHugePages: Ƿʹôҳ
+    explicit MonotonicArena(size_t initialBlockSize = 1 << 20, bool useHugePages = false);
+    ~MonotonicArena() override;
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    // һԹ黹ڴ飬֮ǰȥָȫʧЧ
+    void release();
+
+    const Stats& getStats() const { return m_stats; }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+private:
+    struct Block {
+        void* memory = nullptr;
+        size_t size = 0;
+        bool hugePages = false;
+        bool mapped = false;    // true: ͨmmap/VirtualAlloc룻false: ͨmalloc
+    };
+
+    // һminSizeֽڵ¿飬ѷαƶ¿
+    void addBlock(size_t minSize);
+    static void* allocatePages(size_t& size, bool tryHugePages, bool& gotHugePages, bool& mapped);
+    static void freePages(const Block& block);
+
+private:
+    std::vector<Block> m_blocks;
+    char* m_cursor = nullptr;
+    char* m_end = nullptr;
+    size_t m_nextBlockSize;
+    bool m_useHugePages;
+    Stats m_stats;
+};
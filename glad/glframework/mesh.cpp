@@ -1,42 +1,255 @@
 #include "mesh.h"
 #include "shader.h" // ҪShaderuniforms
+#include "resource/resourceManager.h" // ͨ
+#include "transparency/transparentQueue.h" // ͸Meshķ˳
+#include "bake/derivedDataCache.h" // ݹϣ
+#include "upload/stagingRing.h" // ־ӳݴϴ
+#include <algorithm> // std::min
+#include <cstring> // std::memcmp
+#include <cstddef> // offsetof
+#include <limits> // ڼΧеĳʼֵ
+#include <utility>
+
+namespace {
+    // 仯֮ͬڴֽʱϲСglBufferSubData
+    constexpr size_t DIFF_MERGE_GAP = 256;
+    // 䳬ʱϲһ (޸ķɢMeshУϴٻ)
+    constexpr size_t DIFF_MAX_RANGES = 64;
+
+    // 4ֽڱȽ¾ (float32λ)ҳͬ
+    void diffRanges(const void* oldData, const void* newData, size_t bytes, std::vector<Mesh::ByteRange>& ranges) {
+        const unsigned char* a = static_cast<const unsigned char*>(oldData);
+        const unsigned char* b = static_cast<const unsigned char*>(newData);
+        size_t offset = 0;
+        while (offset < bytes) {
+            // ͬݣȰȽ
+            size_t block = std::min<size_t>(DIFF_MERGE_GAP, bytes - offset);
+            if (std::memcmp(a + offset, b + offset, block) == 0) {
+                offset += block;
+                continue;
+            }
+            while (std::memcmp(a + offset, b + offset, std::min<size_t>(4, bytes - offset)) == 0) {
+                offset += 4;
+            }
+            // 쵽DIFF_MERGE_GAPֽͬΪֹ
+            size_t begin = offset;
+            size_t end = offset;
+            while (offset < bytes) {
+                size_t word = std::min<size_t>(4, bytes - offset);
+                if (std::memcmp(a + offset, b + offset, word) != 0) {
+                    end = offset + word;
+                }
+                else if (offset - end >= DIFF_MERGE_GAP) {
+                    break;
+                }
+                offset += word;
+            }
+            ranges.push_back({ begin, end - begin });
+        }
+        if (ranges.size() > DIFF_MAX_RANGES) {
+            Mesh::ByteRange merged = { ranges.front().offset, ranges.back().offset + ranges.back().size - ranges.front().offset };
+            ranges.assign(1, merged);
+        }
+    }
+}
+
+Mesh::ContentHash Mesh::hashContent(const void* vertices, size_t vertexBytes, const void* indices, size_t indexBytes) {
+    ContentHash vertexHash, hash;
+    DerivedDataKey::hash128(vertices, vertexBytes, 0, vertexHash.value);
+    DerivedDataKey::hash128(indices, indexBytes, vertexHash.value[0] ^ vertexHash.value[1], hash.value);
+    return hash;
+}
 
 // 캯ʼMeshݲOpenGL
-Mesh::Mesh(const std::vector<float>& vertices, const std::vector<unsigned int>& indices, Material* material)
-    : m_vertices(vertices), m_indices(indices), m_material(material),
-    m_vao(0), m_vbo(0), m_ebo(0)
+Mesh::Mesh(std::vector<float> vertices, std::vector<unsigned int> indices, MaterialHandle material)
+    : m_vertices(std::move(vertices)), m_indices(std::move(indices)),
+    m_vao(0), m_vbo(0), m_ebo(0), m_material(material)
 {
-    setupBuffers(); // OpenGL
-    std::cout << "Mesh created with " << m_vertices.size() / 5 << " vertices and "
-        << m_indices.size() << " indices." << std::endl;
+    m_vertexCount = m_vertices.size() / 5;
+    m_indexCount = m_indices.size();
+    // вʵһãʱͷ
+    ResourceManager::getInstance()->addRef(m_material);
+    setupBuffers(m_vertices.data(), m_indices.data()); // OpenGL
+    std::cout << "Mesh created with " << m_vertexCount << " vertices and "
+        << m_indexCount << " indices." << std::endl;
+}
+
+// 캯 (㿽)ֱӴⲿڴϴCPUั
+Mesh::Mesh(const float* vertices, size_t vertexCount, const unsigned int* indices, size_t indexCount, MaterialHandle material)
+    : m_vertexCount(vertexCount), m_indexCount(indexCount), m_material(material)
+{
+    ResourceManager::getInstance()->addRef(m_material);
+    setupBuffers(vertices, indices);
+    std::cout << "Mesh created with " << m_vertexCount << " vertices and "
+        << m_indexCount << " indices." << std::endl;
+}
+
+// 캯 (ոʽ) + 16/32λ + LODΧ
+Mesh::Mesh(const pack::CompactVertex* vertices, size_t vertexCount, const void* indices, size_t indexCount, size_t indexSize,
+    std::vector<Lod> lods, MaterialHandle material)
+    : m_vertexCount(vertexCount), m_indexCount(indexCount), m_indexSize(indexSize), m_compact(true),
+    m_lods(std::move(lods)), m_material(material)
+{
+    ResourceManager::getInstance()->addRef(m_material);
+    // LODΪ𻵣˻صֻ
+    for (const Lod& lod : m_lods) {
+        if (static_cast<size_t>(lod.firstIndex) + lod.indexCount > m_indexCount) {
+            std::cerr << "WARNING: Mesh LOD range exceeds its index buffer, LODs ignored." << std::endl;
+            m_lods.clear();
+            break;
+        }
+    }
+    setupBuffers(vertices, indices);
+    std::cout << "Mesh created with " << m_vertexCount << " compact vertices, "
+        << m_indexCount << " indices and " << getLodCount() << " LODs." << std::endl;
 }
 
 Mesh::~Mesh() {
+    // ƶĶٳκԴ
+    if (m_vao == 0 && m_vbo == 0 && m_ebo == 0 && m_outlineVao == 0 && !m_material) {
+        return;
+    }
+
     // ͷOpenGLԴ
-    if (m_vao != 0) {
-        GL_CALL(glDeleteVertexArrays(1, &m_vao));
+    releaseBuffers();
+    releaseOutline();
+    // ͷŲãüResourceManagerͳһ
+    ResourceManager::getInstance()->release(m_material);
+    m_material = MaterialHandle();
+    std::cout << "Mesh destroyed." << std::endl;
+}
+
+Mesh::Mesh(Mesh&& other) noexcept {
+    *this = std::move(other);
+}
+
+Mesh& Mesh::operator=(Mesh&& other) noexcept {
+    std::swap(m_vertices, other.m_vertices);
+    std::swap(m_indices, other.m_indices);
+    std::swap(m_vertexCount, other.m_vertexCount);
+    std::swap(m_indexCount, other.m_indexCount);
+    std::swap(m_indexSize, other.m_indexSize);
+    std::swap(m_compact, other.m_compact);
+    std::swap(m_lods, other.m_lods);
+    std::swap(m_lod, other.m_lod);
+    std::swap(m_dataVersion, other.m_dataVersion);
+    std::swap(m_contentHash, other.m_contentHash);
+    std::swap(m_contentHashValid, other.m_contentHashValid);
+    std::swap(m_dirtyVertexRanges, other.m_dirtyVertexRanges);
+    std::swap(m_dirtyIndexRanges, other.m_dirtyIndexRanges);
+    std::swap(m_lastUploadBytes, other.m_lastUploadBytes);
+    std::swap(m_vertexBufferBytes, other.m_vertexBufferBytes);
+    std::swap(m_indexBufferBytes, other.m_indexBufferBytes);
+    std::swap(m_boundsMin, other.m_boundsMin);
+    std::swap(m_boundsMax, other.m_boundsMax);
+    std::swap(m_vao, other.m_vao);
+    std::swap(m_vbo, other.m_vbo);
+    std::swap(m_ebo, other.m_ebo);
+    std::swap(m_sortedVao, other.m_sortedVao);
+    std::swap(m_sortedEbo, other.m_sortedEbo);
+    std::swap(m_outlineVao, other.m_outlineVao);
+    std::swap(m_outlineVbo, other.m_outlineVbo);
+    std::swap(m_outlineVertexCount, other.m_outlineVertexCount);
+    std::swap(m_material, other.m_material);
+    return *this;
+}
+
+void Mesh::setMaterial(MaterialHandle material) {
+    if (material == m_material) {
+        return;
     }
-    if (m_vbo != 0) {
-        GL_CALL(glDeleteBuffers(1, &m_vbo));
+    ResourceManager* resourceManager = ResourceManager::getInstance();
+    resourceManager->addRef(material);
+    resourceManager->release(m_material);
+    m_material = material;
+}
+
+// MeshӲأϣƳٵһαȽʱCPUั
+const Mesh::ContentHash& Mesh::getContentHash() {
+    if (!m_contentHashValid && (!m_vertices.empty() || !m_indices.empty())) {
+        m_contentHash = hashContent(m_vertices.data(), m_vertices.size() * sizeof(float), m_indices.data(), m_indices.size() * sizeof(unsigned int));
+        m_contentHashValid = true;
     }
-    if (m_ebo != 0) {
-        GL_CALL(glDeleteBuffers(1, &m_ebo));
+    return m_contentHash;
+}
+
+// ݸGL󱣳ֲ
+bool Mesh::updateData(std::vector<float> vertices, std::vector<unsigned int> indices) {
+    // ûCPUัʱ޷֪Ƿͬϴ
+    ContentHash hash = hashContent(vertices.data(), vertices.size() * sizeof(float), indices.data(), indices.size() * sizeof(unsigned int));
+    const ContentHash& current = getContentHash();
+    if (m_contentHashValid && hash == current) {
+        return false;
     }
-    // ע⣺m_materialModelLODModelﲻdelete
-    std::cout << "Mesh destroyed." << std::endl;
+    size_t vertexCount = vertices.size() / 5;
+    size_t indexCount = indices.size();
+    m_dirtyVertexRanges.clear();
+    m_dirtyIndexRanges.clear();
+
+    if (m_compact) {
+        // ʽͬVAOеòܸãؽ
+        releaseBuffers();
+        m_compact = false;
+        m_indexSize = sizeof(unsigned int);
+        m_lods.clear();
+        m_lod = 0;
+    }
+
+    if (m_vao == 0) {
+        // ֮ǰûдɹ (Ϊ)
+        m_vertexCount = vertexCount;
+        m_indexCount = indexCount;
+        setupBuffers(vertices.data(), indices.data());
+        m_dirtyVertexRanges.push_back({ 0, m_vertexBufferBytes });
+        m_dirtyIndexRanges.push_back({ 0, m_indexBufferBytes });
+        m_lastUploadBytes = m_vertexBufferBytes + m_indexBufferBytes;
+    }
+    else {
+        // ûCPUั (㿽մӽոʽؽ) ʱֻϴ
+        bool hasCopy = !m_vertices.empty() || !m_indices.empty();
+
+        // EBOİ󶨼¼VAOУȰ󶨱MeshVAOٲEBO
+        GL_CALL(glBindVertexArray(m_vao));
+
+        GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, m_vbo));
+        m_lastUploadBytes = uploadChanges(GL_ARRAY_BUFFER, m_vertexBufferBytes, hasCopy ? m_vertices.data() : nullptr,
+            m_vertices.size() * sizeof(float), vertices.data(), vertices.size() * sizeof(float), m_dirtyVertexRanges);
+
+        GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo));
+        m_lastUploadBytes += uploadChanges(GL_ELEMENT_ARRAY_BUFFER, m_indexBufferBytes, hasCopy ? m_indices.data() : nullptr,
+            m_indices.size() * sizeof(unsigned int), indices.data(), indices.size() * sizeof(unsigned int), m_dirtyIndexRanges);
+
+        GL_CALL(glBindVertexArray(0));
+        GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, 0));
+        m_vertexCount = vertexCount;
+        m_indexCount = indexCount;
+        computeBounds(vertices.data());
+    }
+
+    m_vertices = std::move(vertices);
+    m_indices = std::move(indices);
+    m_contentHash = hash;
+    m_contentHashValid = true;
+    m_dataVersion++;
+    // ˳ɵӦ
+    if (m_sortedVao != 0) {
+        buildDirectionalOrders();
+    }
+    return true;
 }
 
 // MeshVAOʣָ
-void Mesh::draw(Shader& shader) {
+void Mesh::draw(Shader& shader, int direction) {
     // ȷVAOѳɹݿɻ
-    if (m_vao == 0 || m_indices.empty()) {
+    if (m_vao == 0 || m_indexCount == 0) {
         std::cerr << "WARNING: Attempted to draw mesh with uninitialized VAO or empty indices." << std::endl;
         return;
     }
 
     // ʣȣ
-    if (m_material) {
-        m_material->use(shader);
+    Material* material = ResourceManager::getInstance()->get(m_material);
+    if (material) {
+        material->use(shader);
     }
     else {
         // ûвʣһĬɫ
@@ -44,20 +257,133 @@ void Mesh::draw(Shader& shader) {
          GL_CALL(glBindTexture(GL_TEXTURE_2D, 0));
     }
 
+    // ǰLODеķΧ
+    size_t firstIndex = 0, indexCount = 0;
+    getDrawRange(firstIndex, indexCount);
+    GLenum indexType = m_indexSize == sizeof(uint16_t) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    GLuint vao = m_vao;
+    if (direction >= 0 && static_cast<size_t>(direction) < transparency::DIRECTION_COUNT && m_sortedVao != 0) {
+        // Ԥķ˳򣺵directionֻһLOD
+        vao = m_sortedVao;
+        firstIndex = static_cast<size_t>(direction) * m_indexCount;
+        indexCount = m_indexCount;
+    }
+
     // VAO¼жԺͻ
-    GL_CALL(glBindVertexArray(m_vao));
+    GL_CALL(glBindVertexArray(vao));
     // ָʹ
-    GL_CALL(glDrawElements(GL_TRIANGLES, m_indices.size(), GL_UNSIGNED_INT, 0));
+    GL_CALL(glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indexCount), indexType, (void*)(firstIndex * m_indexSize)));
     // VAOֹ޸ĴVAO״̬
     GL_CALL(glBindVertexArray(0));
 }
 
+void Mesh::getDrawRange(size_t& firstIndex, size_t& indexCount) const {
+    firstIndex = 0;
+    indexCount = m_indexCount;
+    if (m_lod < m_lods.size()) {
+        firstIndex = m_lods[m_lod].firstIndex;
+        indexCount = m_lods[m_lod].indexCount;
+    }
+}
+
+// ˳DIRECTION_COUNTеڵEBOУõڶVAOͬһVBO
+bool Mesh::buildDirectionalOrders() {
+    if (m_compact || m_vao == 0 || m_indices.size() != m_indexCount || m_vertices.size() != m_vertexCount * 5) {
+        return false;   // ոʽ㿽MeshûCPUั
+    }
+    std::vector<uint32_t> orders;
+    transparency::buildDirectionalOrders(m_vertices.data(), 5, m_vertexCount, m_indices.data(), m_indexCount, orders);
+
+    if (m_sortedVao == 0) {
+        GL_CALL(glGenBuffers(1, &m_sortedEbo));
+        GL_CALL(glGenVertexArrays(1, &m_sortedVao));
+        GL_CALL(glBindVertexArray(m_sortedVao));
+        GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, m_vbo));
+        configureAttributes();
+    }
+    else {
+        GL_CALL(glBindVertexArray(m_sortedVao));
+    }
+    GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_sortedEbo));
+    GL_CALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, orders.size() * sizeof(uint32_t), orders.data(), GL_STATIC_DRAW));
+    GL_CALL(glBindVertexArray(0));
+    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+    return true;
+}
+
+// ߣ߶ζ˵㵥һVBOУMeshĶʽ޹
+void Mesh::setOutline(const std::vector<outline::EdgeVertex>& vertices) {
+    if (vertices.empty()) {
+        releaseOutline();
+        return;
+    }
+    if (m_outlineVao == 0) {
+        GL_CALL(glGenBuffers(1, &m_outlineVbo));
+        GL_CALL(glGenVertexArrays(1, &m_outlineVao));
+        GL_CALL(glBindVertexArray(m_outlineVao));
+        GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, m_outlineVbo));
+        // λ (location = 0)3floatķ (location = 1, 2)10:10:10:2 snormnormalAw
+        GLsizei stride = static_cast<GLsizei>(sizeof(outline::EdgeVertex));
+        GL_CALL(glEnableVertexAttribArray(0));
+        GL_CALL(glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)offsetof(outline::EdgeVertex, position)));
+        GL_CALL(glEnableVertexAttribArray(1));
+        GL_CALL(glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, (void*)offsetof(outline::EdgeVertex, normalA)));
+        GL_CALL(glEnableVertexAttribArray(2));
+        GL_CALL(glVertexAttribPointer(2, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, (void*)offsetof(outline::EdgeVertex, normalB)));
+        GL_CALL(glBindVertexArray(0));
+    }
+    else {
+        GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, m_outlineVbo));
+    }
+    GL_CALL(glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(outline::EdgeVertex), vertices.data(), GL_STATIC_DRAW));
+    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    m_outlineVertexCount = vertices.size();
+}
+
+// ߣ󶨲ʣShaderֻʹuniformɫ
+void Mesh::drawOutline() {
+    if (m_outlineVao == 0 || m_outlineVertexCount == 0) {
+        return;
+    }
+    GL_CALL(glBindVertexArray(m_outlineVao));
+    GL_CALL(glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(m_outlineVertexCount)));
+    GL_CALL(glBindVertexArray(0));
+}
+
+// ΧУʽÿ5float (PosXYZ + UV)ոʽλΪunorm16
+void Mesh::computeBounds(const void* vertices) {
+    glm::vec3 minCoords(std::numeric_limits<float>::max());
+    glm::vec3 maxCoords(-std::numeric_limits<float>::max());
+    for (size_t i = 0; i < m_vertexCount; ++i) {
+        glm::vec3 position;
+        if (m_compact) {
+            const uint16_t* quantized = static_cast<const pack::CompactVertex*>(vertices)[i].position;
+            position = glm::vec3(quantized[0], quantized[1], quantized[2]) * (1.0f / 65535.0f);
+        }
+        else {
+            const float* p = static_cast<const float*>(vertices) + i * 5;
+            position = glm::vec3(p[0], p[1], p[2]);
+        }
+        minCoords = glm::min(minCoords, position);
+        maxCoords = glm::max(maxCoords, position);
+    }
+    if (m_vertexCount == 0) {
+        minCoords = maxCoords = glm::vec3(0.0f);
+    }
+    m_boundsMin = minCoords;
+    m_boundsMax = maxCoords;
+}
+
 // OpenGLɲVAO, VBO, EBO
-void Mesh::setupBuffers() {
-    if (m_vertices.empty() || m_indices.empty()) {
+void Mesh::setupBuffers(const void* vertices, const void* indices) {
+    if (m_vertexCount == 0 || m_indexCount == 0) {
         std::cerr << "ERROR: No data to setup OpenGL buffers for mesh." << std::endl;
         return;
     }
+    computeBounds(vertices);
+    m_vertexBufferBytes = m_vertexCount * getVertexStride();
+    m_indexBufferBytes = m_indexCount * m_indexSize;
 
     // 1. ɻID
     GL_CALL(glGenBuffers(1, &m_vbo));  // VBO (λ+)
@@ -69,29 +395,111 @@ void Mesh::setupBuffers() {
 
     // 3. 󶨲䶥ݵVBO
     GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, m_vbo));
-    // m_verticesֱӴGPU
-    GL_CALL(glBufferData(GL_ARRAY_BUFFER, m_vertices.size() * sizeof(float), &m_vertices[0], GL_STATIC_DRAW));
+    // ݴϴݴ (Դֱӽѹ) ʱֻGPUϸ
+    StagingRing* stagingRing = StagingRing::getInstance();
+    stagingRing->uploadBuffer(GL_ARRAY_BUFFER, vertices, m_vertexBufferBytes);
 
     // 4. öָ
-    // ÿĲǣλ(vec3) + (vec2) = 5float
-    GLsizei stride = sizeof(float) * 5; // ÿݿܴС
-
-    // λ (layout location = 0): 3float
-    GL_CALL(glEnableVertexAttribArray(0));
-    GL_CALL(glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0));
-
-    //  (layout location = 1): 2float
-    // ƫ3float (λ)
-    GL_CALL(glEnableVertexAttribArray(1));
-    GL_CALL(glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * 3)));
+    configureAttributes();
 
     // 5. 󶨲ݵEBO
     GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo));
-    GL_CALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_indices.size() * sizeof(unsigned int), &m_indices[0], GL_STATIC_DRAW));
+    stagingRing->uploadBuffer(GL_ELEMENT_ARRAY_BUFFER, indices, m_indexBufferBytes);
 
     // 6. VAOɺVAOһϰߡ
     GL_CALL(glBindVertexArray(0));
     // VBOEBOһVAO¼ǵİ󶨺ãVBOEBOͿԽˡ
     GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, 0));
     GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0));
+}
+
+size_t Mesh::uploadChanges(GLenum target, size_t& bufferBytes, const void* oldData, size_t oldBytes,
+    const void* data, size_t bytes, std::vector<ByteRange>& ranges) {
+    if (!oldData || bytes > bufferBytes) {
+        GL_CALL(glBufferData(target, bytes, data, GL_STATIC_DRAW));
+        bufferBytes = bytes;
+        ranges.push_back({ 0, bytes });
+        return bytes;
+    }
+    // ŵ£ֱͬȽϣݶĲд
+    size_t common = std::min(oldBytes, bytes);
+    diffRanges(oldData, data, common, ranges);
+    if (bytes > common) {
+        ranges.push_back({ common, bytes - common });
+    }
+    size_t uploaded = 0;
+    const unsigned char* source = static_cast<const unsigned char*>(data);
+    for (const ByteRange& range : ranges) {
+        GL_CALL(glBufferSubData(target, static_cast<GLintptr>(range.offset), static_cast<GLsizeiptr>(range.size), source + range.offset));
+        uploaded += range.size;
+    }
+    return uploaded;
+}
+
+// öָ룺VAOVBOѰ󶨣ʽm_compact
+void Mesh::configureAttributes() {
+    GLsizei stride = static_cast<GLsizei>(getVertexStride()); // ÿݿܴС
+    if (m_compact) {
+        // ոʽ (16ֽ)λΪ4unorm16 (wδʹ)Ϊ10:10:10:2 snormΪ2half
+        GL_CALL(glEnableVertexAttribArray(0));
+        GL_CALL(glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, stride, (void*)offsetof(pack::CompactVertex, position)));
+        GL_CALL(glEnableVertexAttribArray(1));
+        GL_CALL(glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, (void*)offsetof(pack::CompactVertex, normal)));
+        GL_CALL(glEnableVertexAttribArray(2));
+        GL_CALL(glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, stride, (void*)offsetof(pack::CompactVertex, texCoord)));
+    }
+    else {
+        // ÿĲǣλ(vec3) + (vec2) = 5float
+
+        // λ (layout location = 0): 3float
+        GL_CALL(glEnableVertexAttribArray(0));
+        GL_CALL(glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)0));
+
+        //  (layout location = 2): 2float
+        // ƫ3float (λ)
+        GL_CALL(glEnableVertexAttribArray(2));
+        GL_CALL(glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)(sizeof(float) * 3)));
+    }
+}
+
+void Mesh::releaseBuffers() {
+    // ˳VBO֮һɾ
+    releaseDirectionalOrders();
+    if (m_vao != 0) {
+        GL_CALL(glDeleteVertexArrays(1, &m_vao));
+    }
+    if (m_vbo != 0) {
+        GL_CALL(glDeleteBuffers(1, &m_vbo));
+    }
+    if (m_ebo != 0) {
+        GL_CALL(glDeleteBuffers(1, &m_ebo));
+    }
+    m_vao = 0;
+    m_vbo = 0;
+    m_ebo = 0;
+    m_vertexBufferBytes = 0;
+    m_indexBufferBytes = 0;
+}
+
+void Mesh::releaseDirectionalOrders() {
+    if (m_sortedVao != 0) {
+        GL_CALL(glDeleteVertexArrays(1, &m_sortedVao));
+    }
+    if (m_sortedEbo != 0) {
+        GL_CALL(glDeleteBuffers(1, &m_sortedEbo));
+    }
+    m_sortedVao = 0;
+    m_sortedEbo = 0;
+}
+
+void Mesh::releaseOutline() {
+    if (m_outlineVao != 0) {
+        GL_CALL(glDeleteVertexArrays(1, &m_outlineVao));
+    }
+    if (m_outlineVbo != 0) {
+        GL_CALL(glDeleteBuffers(1, &m_outlineVbo));
+    }
+    m_outlineVao = 0;
+    m_outlineVbo = 0;
+    m_outlineVertexCount = 0;
 }
\ No newline at end of file
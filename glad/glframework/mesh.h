@@ -3,40 +3,204 @@
 #include "core.h"             // GLAD, GLFW, GLMȺĿ
 #include "../wrapper/checkError.h" // OpenGL
 #include "material.h"         // Material
+#include "resource/handle.h"  // ִͨ
+#include "pack/packFormat.h"  // CompactVertex
+#include "outline/featureEdges.h" // ߵ߶ζ˵
+#include "transparency/transparentQueue.h" // ͸Meshķ˳
 
 #include <vector>             // std::vector
 #include <string>             // std::string
 #include <iostream>           // std::cerr, std::coutе
 
 // Meshࣺװ壨ݡOpenGL
+// λã0 = λã1 =  (ֻнոʽṩ)2 = ꣬assets/shaders/vertex.glslһ¡
 class Mesh {
 public:
+    // +ݵ128λϣ (DerivedDataKey::hash128)ʱݴжMeshǷ仯
+    struct ContentHash {
+        uint64_t value[2] = { 0, 0 };
+        bool operator==(const ContentHash& other) const { return value[0] == other.value[0] && value[1] == other.value[1]; }
+        bool operator!=(const ContentHash& other) const { return !(*this == other); }
+    };
+
+    // еһֽ
+    struct ByteRange {
+        size_t offset = 0;
+        size_t size = 0;
+    };
+
+    // һLODеķΧerrorΪüLOD 0ļ (ģͿռ)
+    struct Lod {
+        uint32_t firstIndex = 0;
+        uint32_t indexCount = 0;
+        float error = 0.0f;
+    };
+
     // 캯
     // - vertices: ƽĶ (λx,y,z, u,v)
     // - indices: 
-    // - material: ָMeshʹõĲʶ
-    Mesh(const std::vector<float>& vertices, const std::vector<unsigned int>& indices, Material* material);
+    // - material: MeshʹõĲʾMeshһ
+    // vertices/indicesֵ룬÷std::moveݵĿ
+    Mesh(std::vector<float> vertices, std::vector<unsigned int> indices, MaterialHandle material);
+
+    // 캯 (㿽)
+    // ֱӴⲿڴ (Դڴӳ) ϴMeshCPUั
+    // - vertices: vertexCount * 5 float (PosXYZ + UV)
+    // - indices: indexCount 
+    Mesh(const float* vertices, size_t vertexCount, const unsigned int* indices, size_t indexCount, MaterialHandle material);
+
+    // 캯 (ոʽ㿽)
+    // ϴߺ決 (pack::CompactVertexλΪ[0, 1]Ĺһ꣬ModelĶ任ԭ)
+    // - indices: indexCount indexSizeΪ24ֽڣLOD
+    // - lods: LODΧΪʱΪΨһһ
+    Mesh(const pack::CompactVertex* vertices, size_t vertexCount, const void* indices, size_t indexCount, size_t indexSize,
+        std::vector<Lod> lods, MaterialHandle material);
     ~Mesh();
 
+    // MeshResourcePoolĳУֹֻƶ
+    // ƶֵýʵ֣ľGLԴʱͷš
+    Mesh(const Mesh&) = delete;
+    Mesh& operator=(const Mesh&) = delete;
+    Mesh(Mesh&& other) noexcept;
+    Mesh& operator=(Mesh&& other) noexcept;
+
+    MaterialHandle getMaterial() const { return m_material; }
+    size_t getIndexCount() const { return m_indexCount; }  // LOD
+    size_t getVertexCount() const { return m_vertexCount; }
+    size_t getIndexSize() const { return m_indexSize; }    // 24ֽ
+    bool isCompact() const { return m_compact; }           // ǷΪpack::CompactVertex
+    size_t getVertexStride() const { return m_compact ? sizeof(pack::CompactVertex) : 5 * sizeof(float); }
+
+    // GL (綥ȡʱGPUϸƵGeometryArena)ʧʱΪ0
+    GLuint getVertexBuffer() const { return m_vbo; }
+    GLuint getIndexBuffer() const { return m_ebo; }
+    // ݰ汾ÿupdateDataϴݺһĸݴжǷ
+    uint32_t getDataVersion() const { return m_dataVersion; }
+    // һupdateDataдֽ (Ӱ汾getDataVersion() - 1ǰ汾)֮һ汾ͬ
+    // 仯ʱֻݵķΧݳĲֲʹ
+    const std::vector<ByteRange>& getDirtyVertexRanges() const { return m_dirtyVertexRanges; }
+    const std::vector<ByteRange>& getDirtyIndexRanges() const { return m_dirtyIndexRanges; }
+    // һupdateDataϴֽ ( + )
+    size_t getLastUploadBytes() const { return m_lastUploadBytes; }
+
+    // ǰݵĹϣhashContent()Ƚϼ֪ǷıMesh
+    // ʱ㣬ֻбCPUัMesh () ڵһҪʱɸ㣻ûиʱؿչϣ
+    const ContentHash& getContentHash();
+    static ContentHash hashContent(const void* vertices, size_t vertexBytes, const void* indices, size_t indexBytes);
+
+    // ǰLODеķΧ (Ϊλ)
+    void getDrawRange(size_t& firstIndex, size_t& indexCount) const;
+
+    // Դռ (VBO + EBO + ˳ + ) CPUัռõֽʽصڴԤ㡣
+    // GeometryArenaеĸ (GeometryArena::getResidentBytes)
+    size_t getGpuBytes() const {
+        size_t sortedBytes = m_sortedVao != 0 ? transparency::DIRECTION_COUNT * m_indexCount * sizeof(uint32_t) : 0;
+        return m_vertexBufferBytes + m_indexBufferBytes + sortedBytes
+            + m_outlineVertexCount * sizeof(outline::EdgeVertex);
+    }
+    size_t getCpuBytes() const { return m_vertices.capacity() * sizeof(float) + m_indices.capacity() * sizeof(unsigned int); }
+
+    // µİΧ (ոʽΪ[0, 1])ʱtransformһ޳
+    const glm::vec3& getBoundsMin() const { return m_boundsMin; }
+    const glm::vec3& getBoundsMax() const { return m_boundsMax; }
+
+    // ʣ²ʵһòͷžɲʵ
+    void setMaterial(MaterialHandle material);
+
+    // LODûLODݵMeshֻһsetLodΧʱȡֵһ
+    size_t getLodCount() const { return m_lods.empty() ? 1 : m_lods.size(); }
+    float getLodError(size_t lod) const { return lod < m_lods.size() ? m_lods[lod].error : 0.0f; }
+    size_t getLod() const { return m_lod; }
+    void setLod(size_t lod) { m_lod = lod < getLodCount() ? lod : getLodCount() - 1; }
+
+    // µĶ/ݸGL ()VAO/VBO/EBO󲻱䣺
+    // - ݹϣ뵱ǰͬʱϴfalse (㿽ûCPUัMeshûйϣϴ)
+    // - CPUัݷŵеĻʱֱȽ¾ݣֻglBufferSubDataд仯
+    //   (getDirtyVertexRanges)ϴ޸ĵĴСȣglBufferData·䲢ϴ
+    // MeshݵCPUั´αȽϡGL̵߳á
+    // ոʽMeshؽлظʽLODݱ
+    bool updateData(std::vector<float> vertices, std::vector<unsigned int> indices);
+
     // Mesh
     // - shader: ǰShader
+    // - direction: Ԥ㷽˳ı (transparency::selectDirection)-1ûз˳ʱǰLODơ
     // VAOʣָ
-    void draw(Shader& shader);
+    void draw(Shader& shader, int direction = -1);
+
+    // Ϊ͸MeshԤtransparency::DIRECTION_COUNT˳ (transparency::buildDirectionalOrders)
+    // ϴظʱԶɡҪCPUั (ոʽ㿽Meshfalse)
+    // GL̵߳á
+    bool buildDirectionalOrders();
+    bool hasDirectionalOrders() const { return m_sortedVao != 0; }
+
+    //  (outline::extractFeatureEdges)滻ԭе߶ΣΪʱɾGL̵߳á
+    // ߶ζ˵ģͿռ꣬ոʽĶ任ֻLOD 0ɡ
+    void setOutline(const std::vector<outline::EdgeVertex>& vertices);
+    bool hasOutline() const { return m_outlineVertexCount > 0; }
+
+    // ߣһGL_LINESƣɵ÷Shader (assets/shaders/outlineVertex.glsl)
+    void drawOutline();
 
 private:
     // OpenGL
     // - ɲVAO (Vertex Array Object)
     // - ɲVBO (Vertex Buffer Object) 洢 (λ+)
     // - ɲEBO (Element Buffer Object) 洢
-    void setupBuffers();
+    // - vertices/indices: Ҫϴݣָm_vertices/m_indicesҲָⲿڴStagingRingݴ
+    // ݾStagingRingϴ (ݴʱֻGPUϸ)ݴʱ˻glBufferData
+    // ʽm_compactСm_indexSize
+    void setupBuffers(const void* vertices, const void* indices);
+
+    // ɾVAO/VBO/EBO (˳)
+    void releaseBuffers();
+
+    // ɾ˳VAO/EBO
+    void releaseDirectionalOrders();
+
+    // öָ (VAOVBOѰ)VAOͷ˳VAO
+    void configureAttributes();
+
+    // dataдtargetѰ󶨵ĻܰݱȽʱֻд仯䣬·䡣
+    // oldDataΪnullptrʾûCPUัrangesд䣬ϴֽ
+    static size_t uploadChanges(GLenum target, size_t& bufferBytes, const void* oldData, size_t oldBytes,
+        const void* data, size_t bytes, std::vector<ByteRange>& ranges);
+
+    // ݶݼΧ (ʽm_compact)
+    void computeBounds(const void* vertices);
+
+    // ɾߵVAO/VBO
+    void releaseOutline();
 
 private:
-    std::vector<float> m_vertices;      // ƽĶ (PosXYZ + UV)
-    std::vector<unsigned int> m_indices; // 
+    std::vector<float> m_vertices;      // ƽĶ (PosXYZ + UV)㿽ʱΪ
+    std::vector<unsigned int> m_indices; // ݣ㿽ʱΪ
+    size_t m_vertexCount = 0;           // 
+    size_t m_indexCount = 0;            //  (LOD)
+    size_t m_indexSize = sizeof(unsigned int); // ÿֽ (24)
+    bool m_compact = false;             // ǷΪpack::CompactVertex
+    std::vector<Lod> m_lods;            // Ϊʱ
+    size_t m_lod = 0;                   // ǰƵLOD
+    uint32_t m_dataVersion = 0;         // updateDataĴ
+    ContentHash m_contentHash;          // ǰ+ݵĹϣm_contentHashValidΪfalseʱûм
+    bool m_contentHashValid = false;
+    std::vector<ByteRange> m_dirtyVertexRanges; // һupdateDataд
+    std::vector<ByteRange> m_dirtyIndexRanges;
+    size_t m_lastUploadBytes = 0;       // һupdateDataϴֽ
+    size_t m_vertexBufferBytes = 0;     // VBO/EBOĴССʱ·
+    size_t m_indexBufferBytes = 0;
+    glm::vec3 m_boundsMin = glm::vec3(0.0f); // µİΧ
+    glm::vec3 m_boundsMax = glm::vec3(0.0f);
+
+    GLuint m_vao = 0;   // ID
+    GLuint m_vbo = 0;   // 㻺ID (λú)
+    GLuint m_ebo = 0;   // ԪػID ()
+
+    GLuint m_sortedVao = 0;             // ˳ĶIDm_vaoVBO
+    GLuint m_sortedEbo = 0;             // DIRECTION_COUNTе (32λ)
 
-    GLuint m_vao;       // ID
-    GLuint m_vbo;       // 㻺ID (λú)
-    GLuint m_ebo;       // ԪػID ()
+    GLuint m_outlineVao = 0;            // ߵĶID
+    GLuint m_outlineVbo = 0;            // ߵ߶ζ˵ (outline::EdgeVertex)
+    size_t m_outlineVertexCount = 0;    // ˵ÿһ߶
 
-    Material* m_material; // MeshʹõĲʣӵ
+    MaterialHandle m_material; // MeshʹõĲʣһ
 };
\ No newline at end of file
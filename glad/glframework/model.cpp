@@ -1,9 +1,125 @@
 #include "model.h"
 #include "material.h"
 #include "shader.h" // ҪShaderuniforms
+#include "resource/resourceManager.h" // MeshMaterialResourceManagerͻ
+#include "resource/materialCache.h"   // ͬĲģ֮乲
+#include "memory/arena.h"             // ʱʹõĵڴ
+#include "memory/allocationTracker.h" // ͳƼؽ׶εĶѷͷֵ
+#include "job/jobSystem.h"            // Ͷ任д
+#include "simd/geometryKernels.h"     // ߽Ͷ任ں
+#include "clip/clipSet.h"             // ƽ޳
+#include "transparency/transparentQueue.h" // ͸MeshԶ
+#include "pulling/geometryArena.h"    // ȡĻ·
+#include "collision/collisionWorld.h" // ײǼǵײ
+
+#include <charconv>           // std::from_chars޷ؽ
+#include <cstring>            // memchr
+#include <string_view>        // std::string_view
+
+namespace {
+    // OBJֱļϽΪÿһ/ÿǺŴַ
+
+    // հַ
+    const char* skipSpaces(const char* p, const char* end) {
+        while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+            ++p;
+        }
+        return p;
+    }
+
+    // ȡһԿհ׽βļǺ
+    std::string_view nextToken(const char*& p, const char* end) {
+        p = skipSpaces(p, end);
+        const char* begin = p;
+        while (p < end && *p != ' ' && *p != '\t' && *p != '\r') {
+            ++p;
+        }
+        return std::string_view(begin, p - begin);
+    }
+
+    // ȡһʧʱ0
+    float nextFloat(const char*& p, const char* end) {
+        std::string_view token = nextToken(p, end);
+        float value = 0.0f;
+        std::from_chars(token.data(), token.data() + token.size(), value);
+        return value;
+    }
+
+    // ȡһ˫ȸʧʱ0
+    double nextDouble(const char*& p, const char* end) {
+        std::string_view token = nextToken(p, end);
+        double value = 0.0;
+        std::from_chars(token.data(), token.data() + token.size(), value);
+        return value;
+    }
+
+    // ̶СĿȡļÿһеfn(lineBegin, lineEnd)[lineBegin, lineEnd)з
+    // İлᱻᵽͷһƴӣСлᱻضϡ
+    template<typename Fn>
+    void forEachLine(std::ifstream& file, char* buffer, size_t bufferSize, Fn&& fn) {
+        size_t carried = 0;
+        while (true) {
+            file.read(buffer + carried, bufferSize - carried);
+            size_t filled = carried + static_cast<size_t>(file.gcount());
+            const char* cursor = buffer;
+            const char* end = buffer + filled;
+
+            const char* lineEnd;
+            while ((lineEnd = static_cast<const char*>(memchr(cursor, '\n', end - cursor))) != nullptr) {
+                fn(cursor, lineEnd);
+                cursor = lineEnd + 1;
+            }
+
+            carried = end - cursor;
+            if (!file) {
+                // ļѶ꣬һпûлз
+                if (carried > 0) {
+                    fn(cursor, end);
+                }
+                break;
+            }
+            if (carried == bufferSize) {
+                // гСضϴ
+                fn(cursor, end);
+                carried = 0;
+                continue;
+            }
+            memmove(buffer, cursor, carried);
+        }
+    }
+
+    // ڴеıеfn(lineBegin, lineEnd)[lineBegin, lineEnd)з
+    template<typename Fn>
+    void forEachLineInMemory(std::string_view text, Fn&& fn) {
+        const char* cursor = text.data();
+        const char* end = text.data() + text.size();
+        const char* lineEnd;
+        while ((lineEnd = static_cast<const char*>(memchr(cursor, '\n', end - cursor))) != nullptr) {
+            fn(cursor, lineEnd);
+            cursor = lineEnd + 1;
+        }
+        if (cursor < end) {
+            fn(cursor, end);
+        }
+    }
+
+    // OBJOBJ1ʼʾڵǰѶȡݵĩβ
+    // ش0ʼ±ꣻַΪջ޷ʱfallback
+    unsigned int parseIndex(std::string_view token, size_t count, unsigned int fallback) {
+        long value = 0;
+        auto result = std::from_chars(token.data(), token.data() + token.size(), value);
+        if (token.empty() || result.ec != std::errc()) {
+            return fallback;
+        }
+        if (value < 0) {
+            return static_cast<unsigned int>(static_cast<long>(count) + value);
+        }
+        return static_cast<unsigned int>(value - 1);
+    }
+}
 
 // 캯ģݣOpenGL
-Model::Model(const std::string & filePath)
+Model::Model(const std::string & filePath, const std::string & textureBaseDir)
 // ʼԱ
     : m_filePath(filePath),
     m_modelMatrix(1.0f), m_viewMatrix(1.0f), m_projectionMatrix(1.0f),
@@ -13,38 +129,260 @@ Model::Model(const std::string & filePath)
 {
     // ȡOBJļڵĿ¼ڼMTLļ
     std::string objBaseDir = filePath.substr(0, filePath.find_last_of("/\\") + 1);
+    // ûָĿ¼ʱԼOBJĿ¼µmaterials_texturesĿ¼
+    std::string texDir = textureBaseDir.empty() ? objBaseDir + "materials_textures/" : textureBaseDir;
 
-    // 1. ԭʼݣOBJļȡ㡢
-    RawObjData rawData = loadRawData(filePath);
-
-    // Ƿɹ
-    if (rawData.positions.empty() || rawData.faces.empty()) {
+    // 1. ز (Ļ׼šȥ)
+    ModelData data;
+    if (!loadObjFile(filePath, data)) {
         std::cerr << "ERROR: Model could not be loaded or is empty: " << filePath << std::endl;
         return;
     }
+    buildOutlines(data);
+    buildCollisionMesh(data);
 
-    // 2. ģ͵ı߽ȷģ͵С
-    calculateBoundingBox(rawData.positions);
+    // 2. ʿ⣬ڴMaterialʱͬ
+    std::vector<MaterialData> materials;
+    if (!data.mtlLibName.empty()) {
+        materials = Material::loadMtlFile(objBaseDir + data.mtlLibName, texDir);
+    }
 
-    // 3. ݣԭʼݽĻͱ׼ţMeshMaterial
-    processData(rawData, objBaseDir);
+    // 3. MaterialMeshϴOpenGL
+    createResources(data, materials);
 
     // 4. ʼģ;
     updateModelMatrix();
     std::cout << "Model '" << filePath << "' loaded successfully." << std::endl;
 }
 
+// 캯CPU׼õݴģֻͣGLԴĴϴ
+Model::Model(const std::string& name, ModelData data, std::vector<MaterialData> materials)
+    : m_filePath(name),
+    m_modelMatrix(1.0f), m_viewMatrix(1.0f), m_projectionMatrix(1.0f),
+    m_currentPosition(0.0f),
+    m_currentRotation(1.0f, 0.0f, 0.0f, 0.0f),
+    m_currentScale(1.0f)
+{
+    createResources(data, materials);
+    updateModelMatrix();
+}
+
+// 캯ģͣⲿ
+Model::Model(const std::string& name, const glm::vec3& minCoords, const glm::vec3& maxCoords, const glm::dvec3& sourceOrigin)
+    : m_filePath(name),
+    m_modelMatrix(1.0f), m_viewMatrix(1.0f), m_projectionMatrix(1.0f),
+    m_currentPosition(0.0f),
+    m_currentRotation(1.0f, 0.0f, 0.0f, 0.0f),
+    m_currentScale(1.0f),
+    m_minCoords(minCoords), m_maxCoords(maxCoords), m_sourceOrigin(sourceOrigin)
+{
+    m_localCenter = (m_minCoords + m_maxCoords) / 2.0f;
+    updateModelMatrix();
+}
+
+void Model::addMaterial(const std::string& name, MaterialHandle material) {
+    if (m_materials.count(name) > 0) {
+        ResourceManager::getInstance()->release(material);
+        return;
+    }
+    m_materials[name] = material;
+}
+
+void Model::addMesh(MeshHandle mesh) {
+    m_meshes.push_back(mesh);
+}
+
+MaterialHandle Model::getDefaultMaterial() {
+    auto it = m_materials.find("default");
+    if (it != m_materials.end()) {
+        return it->second;
+    }
+    // һΪ"default"Ĭϲʣ (ģ͵Ĭϲͬһ淶)
+    MaterialData defaultMaterial;
+    defaultMaterial.name = "default";
+    MaterialHandle handle = MaterialCache::getInstance()->acquire(defaultMaterial);
+    m_materials["default"] = handle;
+    return handle;
+}
+
+// أµļԭظMesh
+size_t Model::reloadGeometry(ModelData data) {
+    m_minCoords = data.minCoords;
+    m_maxCoords = data.maxCoords;
+    m_sourceOrigin = data.origin;
+    m_localCenter = (m_minCoords + m_maxCoords) / 2.0f;
+    updateModelMatrix();
+
+    ResourceManager* resourceManager = ResourceManager::getInstance();
+    MaterialHandle defaultMaterial = getDefaultMaterial();
+    auto findMaterial = [&](const std::string& name) {
+        auto it = m_materials.find(name);
+        return it != m_materials.end() ? it->second : defaultMaterial;
+    };
+
+    size_t uploaded = 0;
+    size_t uploadedBytes = 0;
+    size_t keptCount = std::min(m_meshes.size(), data.meshes.size());
+    for (size_t i = 0; i < keptCount; ++i) {
+        Mesh* mesh = resourceManager->get(m_meshes[i]);
+        if (!mesh) {
+            continue;
+        }
+        mesh->setMaterial(findMaterial(data.meshes[i].materialName));
+        if (mesh->updateData(std::move(data.meshes[i].vertices), std::move(data.meshes[i].indices))) {
+            mesh->setOutline(data.meshes[i].outlineVertices);
+            uploaded++;
+            uploadedBytes += mesh->getLastUploadBytes();
+        }
+        prepareTransparency(*mesh);
+    }
+    // Ĳ
+    for (size_t i = keptCount; i < data.meshes.size(); ++i) {
+        MeshData& meshData = data.meshes[i];
+        MeshHandle handle = resourceManager->create<Mesh>(std::move(meshData.vertices), std::move(meshData.indices), findMaterial(meshData.materialName));
+        if (Mesh* mesh = resourceManager->get(handle)) {
+            mesh->setOutline(meshData.outlineVertices);
+            prepareTransparency(*mesh);
+            uploadedBytes += mesh->getGpuBytes();
+        }
+        m_meshes.push_back(handle);
+        uploaded++;
+    }
+    // ɾĲ
+    for (size_t i = keptCount; i < m_meshes.size(); ++i) {
+        resourceManager->release(m_meshes[i]);
+    }
+    m_meshes.resize(data.meshes.size());
+
+    m_mtlLibName = data.mtlLibName;
+    if (data.collisionMesh) {
+        m_collisionMesh = std::move(data.collisionMesh);
+    }
+    // ײеʵ廹þɵĴģ; (ֲĿѾ仯)
+    setCollisionWorld(m_collisionWorld);
+    std::cout << "Model '" << m_filePath << "' geometry reloaded: " << uploaded << " of " << m_meshes.size() << " meshes uploaded ("
+        << uploadedBytes / 1024 << " KB)." << std::endl;
+    return uploaded;
+}
+
+// أʿģ͹ԭ޸ģ仯ĲʻɶӦĹ淶ʣǼ²
+void Model::reloadMaterials(const std::vector<MaterialData>& materials) {
+    ResourceManager* resourceManager = ResourceManager::getInstance();
+    MaterialCache* materialCache = MaterialCache::getInstance();
+    for (const MaterialData& materialData : materials) {
+        if (materialData.name.empty()) {
+            continue;
+        }
+        MaterialHandle handle = materialCache->acquire(materialData);
+        auto it = m_materials.find(materialData.name);
+        if (it == m_materials.end()) {
+            m_materials[materialData.name] = handle;
+            continue;
+        }
+        MaterialHandle previous = it->second;
+        if (handle == previous) {
+            resourceManager->release(handle);
+            continue;
+        }
+        for (MeshHandle meshHandle : m_meshes) {
+            Mesh* mesh = resourceManager->get(meshHandle);
+            if (mesh && mesh->getMaterial() == previous) {
+                mesh->setMaterial(handle);
+                // ͸ȿܱ仯͸MeshҪ˳
+                prepareTransparency(*mesh);
+            }
+        }
+        it->second = handle;
+        resourceManager->release(previous);
+    }
+    std::cout << "Model '" << m_filePath << "' materials reloaded." << std::endl;
+}
+
+void Model::getMemoryUsage(size_t& cpuBytes, size_t& gpuBytes) const {
+    ResourceManager* resourceManager = ResourceManager::getInstance();
+    cpuBytes = 0;
+    gpuBytes = 0;
+    for (MeshHandle handle : m_meshes) {
+        const Mesh* mesh = resourceManager->get(handle);
+        if (mesh) {
+            cpuBytes += mesh->getCpuBytes();
+            gpuBytes += mesh->getGpuBytes();
+            // drawͬύȡ·Meshڹлһ
+            if (m_geometryArena && (!m_transparentQueue || !isTransparent(*mesh))) {
+                gpuBytes += GeometryArena::getResidentBytes(*mesh);
+            }
+        }
+    }
+    if (m_collisionMesh) {
+        cpuBytes += m_collisionMesh->getMemoryBytes();
+    }
+    std::vector<TextureHandle> textures;
+    for (auto const& [name, handle] : m_materials) {
+        const Material* material = resourceManager->get(handle);
+        if (!material || !material->m_diffuseTexture
+            || std::find(textures.begin(), textures.end(), material->m_diffuseTexture) != textures.end()) {
+            continue;
+        }
+        textures.push_back(material->m_diffuseTexture);
+        const Texture* texture = resourceManager->get(material->m_diffuseTexture);
+        if (texture) {
+            gpuBytes += texture->getGpuBytes();
+        }
+    }
+}
+
+void Model::placeAtSourceCoordinates(const glm::dvec3& origin) {
+    // buildModelDataеinitialTransform棺Żԭʼߴ磬ƽƻԭʼġ
+    // ԭܴܶȰ˫תfloat
+    glm::vec3 extent = m_maxCoords - m_minCoords;
+    float maxDim = std::max({ extent.x, extent.y, extent.z });
+    m_currentPosition = glm::vec3(glm::dvec3((m_minCoords + m_maxCoords) / 2.0f) + (m_sourceOrigin - origin));
+    m_currentRotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    m_currentScale = glm::vec3(maxDim > 0.0f ? maxDim / 2.0f : 1.0f);
+    updateModelMatrix();
+}
+
+void Model::appendSourceGeometry(const ModelData& data, std::vector<glm::vec3>& positions, std::vector<uint32_t>& indices, const glm::dvec3& origin) {
+    // placeAtSourceCoordinatesͬ任
+    glm::vec3 center = glm::vec3(glm::dvec3((data.minCoords + data.maxCoords) / 2.0f) + (data.origin - origin));
+    glm::vec3 extent = data.maxCoords - data.minCoords;
+    float maxDim = std::max({ extent.x, extent.y, extent.z });
+    float inverseScale = maxDim > 0.0f ? maxDim / 2.0f : 1.0f;
+
+    for (const MeshData& mesh : data.meshes) {
+        uint32_t base = static_cast<uint32_t>(positions.size());
+        // ʽλ(3) + (2)
+        for (size_t v = 0; v + 4 < mesh.vertices.size(); v += 5) {
+            positions.push_back(glm::vec3(mesh.vertices[v], mesh.vertices[v + 1], mesh.vertices[v + 2]) * inverseScale + center);
+        }
+        for (unsigned int index : mesh.indices) {
+            indices.push_back(base + index);
+        }
+    }
+}
+
+void Model::setCollisionWorld(CollisionWorld* world) {
+    if (m_collisionWorld && m_collisionBody != CollisionWorld::NO_BODY) {
+        m_collisionWorld->removeBody(m_collisionBody);
+    }
+    m_collisionWorld = world;
+    m_collisionBody = world ? world->addBody(m_collisionMesh, m_modelMatrix) : CollisionWorld::NO_BODY;
+}
+
 // ͷMeshMaterialԴ
 Model::~Model() {
-    // ͷMesh
-    for (Mesh* mesh : m_meshes) {
-        delete mesh;
+    setCollisionWorld(nullptr);
+    ResourceManager* resourceManager = ResourceManager::getInstance();
+
+    // ͷMesh
+    for (MeshHandle mesh : m_meshes) {
+        resourceManager->release(mesh);
     }
     m_meshes.clear();
 
-    // ͷMaterial
+    // ͷMaterial (MeshҲвãʻһMeshٺ)
     for (auto const& [key, val] : m_materials) {
-        delete val;
+        resourceManager->release(val);
     }
     m_materials.clear();
     std::cout << "Model '" << m_filePath << "' destroyed." << std::endl;
@@ -66,7 +404,8 @@ void Model::draw(Shader& shader) {
     // 1. Model Matrix (ģ;): ģʹֲռתռ䡣
     //    ƽ (m_currentPosition), ת (m_currentRotation),  (m_currentScale) ϶ɡ
     //    updateModelMatrix()м㡣
-    shader.setMatrix4x4("transform", m_modelMatrix);
+    //    ոʽMeshȾm_vertexTransform껹ԭģͿռ䡣
+    shader.setMatrix4x4("transform", m_modelMatrix * m_vertexTransform);
 
     // 2. View Matrix (ͼ): ռеת۲ߣռ䡣
     //    ⲿͨCameraࣩ㣬setViewMatrix()롣
@@ -76,12 +415,95 @@ void Model::draw(Shader& shader) {
     //    ⲿͨCameraࣩ㣬setProjectionMatrix()롣
     shader.setMatrix4x4("projectionMatrix", m_projectionMatrix);
 
-    // Mesh
-    for (Mesh* mesh : m_meshes) {
-        mesh->draw(shader);
+    // 4. ţרɫʱƬɫɫ (NO_OBJECTתΪ-1)
+    shader.setInt("objectId", static_cast<int>(m_objectId));
+
+    selectLods();
+
+    // MeshȫƽеMeshύƣ
+    // ͸ͨʱ͸MeshֻϢύв͸廭ͳһϻƣ
+    // ˶ȡʱMeshύɵ÷ͳһflush
+    ResourcePool<Mesh>& meshPool = ResourceManager::getInstance()->meshes();
+    glm::mat4 vertexToWorld = m_modelMatrix * m_vertexTransform;
+    uint32_t transparentTransform = 0;
+    bool hasTransparent = false;
+    uint32_t pulledTransform = 0;
+    bool hasPulled = false;
+    glm::vec3 cameraPosition(0.0f);
+    for (MeshHandle handle : m_meshes) {
+        Mesh* mesh = meshPool.get(handle);
+        if (!mesh || isClipped(*mesh, vertexToWorld)) {
+            continue;
+        }
+        if (!m_transparentQueue || !isTransparent(*mesh)) {
+            if (m_geometryArena) {
+                if (!hasPulled) {
+                    hasPulled = true;
+                    pulledTransform = m_geometryArena->addTransform(vertexToWorld, m_objectId);
+                }
+                if (m_geometryArena->submit(pulledTransform, handle, *mesh)) {
+                    continue;
+                }
+            }
+            mesh->draw(shader);
+            continue;
+        }
+        if (!hasTransparent) {
+            hasTransparent = true;
+            transparentTransform = m_transparentQueue->addTransform(vertexToWorld, m_objectId);
+            cameraPosition = glm::vec3(glm::inverse(m_viewMatrix)[3]);
+        }
+        glm::vec3 center = glm::vec3(vertexToWorld * glm::vec4((mesh->getBoundsMin() + mesh->getBoundsMax()) * 0.5f, 1.0f));
+        float viewDepth = -(m_viewMatrix * glm::vec4(center, 1.0f)).z;
+        int direction = -1;
+        if (mesh->hasDirectionalOrders()) {
+            // ռ߷Ӧµtranspose(M) * v (ͶӰ򣬷ǾʱҲ)
+            glm::vec3 viewDirection = glm::transpose(glm::mat3(vertexToWorld)) * (center - cameraPosition);
+            direction = transparency::selectDirection(viewDirection);
+        }
+        m_transparentQueue->submit(transparentTransform, handle, viewDepth, direction);
+    }
+}
+
+// ߣ߶ζ˵ģͿռֻ꣬Ӧģ; (ոʽĶ任)
+void Model::drawOutlines(Shader& shader) {
+    updateModelMatrix();
+    shader.setMatrix4x4("transform", m_modelMatrix);
+    shader.setMatrix4x4("viewMatrix", m_viewMatrix);
+    shader.setMatrix4x4("projectionMatrix", m_projectionMatrix);
+    // 淨߱任ռ (ǾʱҪת)
+    shader.setMatrix3x3("normalMatrix", glm::transpose(glm::inverse(glm::mat3(m_modelMatrix))));
+    glm::vec3 cameraPosition = glm::vec3(glm::inverse(m_viewMatrix)[3]);
+    shader.setVector3("cameraPosition", cameraPosition.x, cameraPosition.y, cameraPosition.z);
+
+    // MeshİΧڶ£жdrawͬ
+    ResourcePool<Mesh>& meshPool = ResourceManager::getInstance()->meshes();
+    glm::mat4 vertexToWorld = m_modelMatrix * m_vertexTransform;
+    for (MeshHandle handle : m_meshes) {
+        Mesh* mesh = meshPool.get(handle);
+        if (mesh && !isClipped(*mesh, vertexToWorld)) {
+            mesh->drawOutline();
+        }
+    }
+}
+
+bool Model::isTransparent(const Mesh& mesh) {
+    Material* material = ResourceManager::getInstance()->get(mesh.getMaterial());
+    return material && material->isTransparent();
+}
+
+void Model::prepareTransparency(Mesh& mesh) {
+    if (!mesh.hasDirectionalOrders() && isTransparent(mesh)
+        && mesh.getIndexCount() / 3 >= TransparentQueue::DIRECTIONAL_ORDER_MIN_TRIANGLES) {
+        mesh.buildDirectionalOrders();
     }
 }
 
+// MeshİΧȫλĳƽ
+bool Model::isClipped(const Mesh& mesh, const glm::mat4& vertexToWorld) const {
+    return m_clipSet && m_clipSet->classify(mesh.getBoundsMin(), mesh.getBoundsMax(), vertexToWorld) == ClipSet::Classification::Clipped;
+}
+
 // ģռеƽ
 // ÿú󣬻¼ģ;
 void Model::setPosition(const glm::vec3& pos) {
@@ -118,6 +540,44 @@ void Model::setProjectionMatrix(const glm::mat4& proj) {
     m_projectionMatrix = proj;
 }
 
+// ðĻռѡLODĲ
+void Model::setLodSelection(float viewportHeight, float pixelThreshold) {
+    m_lodViewportHeight = viewportHeight;
+    m_lodPixelThreshold = pixelThreshold;
+}
+
+// ĻռѡLOD
+void Model::selectLods() {
+    if (m_lodViewportHeight <= 0.0f) {
+        return;
+    }
+    // λãͼƽƲ
+    glm::vec3 cameraPosition = glm::vec3(glm::inverse(m_viewMatrix)[3]);
+    // Ļͱ׼ŵ[-1, 1]ģͿռԭ㼴ģģΧ뾶Ϊsqrt(3)
+    float worldScale = std::max({ glm::length(glm::vec3(m_modelMatrix[0])), glm::length(glm::vec3(m_modelMatrix[1])),
+        glm::length(glm::vec3(m_modelMatrix[2])) });
+    float radius = std::sqrt(3.0f) * worldScale;
+    // Χľ룬ڰΧʱʹϸLOD
+    float distance = glm::length(glm::vec3(m_modelMatrix[3]) - cameraPosition) - radius;
+    // ͸ͶӰ£dΪe߶ĻԼΪ e * P[1][1] * (viewportHeight / 2) / d 
+    float pixelsPerUnit = distance > 0.0f ? m_projectionMatrix[1][1] * m_lodViewportHeight * 0.5f / distance : 0.0f;
+
+    ResourcePool<Mesh>& meshPool = ResourceManager::getInstance()->meshes();
+    for (MeshHandle handle : m_meshes) {
+        Mesh* mesh = meshPool.get(handle);
+        if (!mesh || mesh->getLodCount() <= 1) {
+            continue;
+        }
+        size_t lod = 0;
+        if (pixelsPerUnit > 0.0f) {
+            while (lod + 1 < mesh->getLodCount() && mesh->getLodError(lod + 1) * worldScale * pixelsPerUnit <= m_lodPixelThreshold) {
+                ++lod;
+            }
+        }
+        mesh->setLod(lod);
+    }
+}
+
 // ȡģ͵ռĵ㣬LOD
 glm::vec3 Model::getWorldCenter() const {
     // ģ͵ռĵ = ģ; * ֲĵ
@@ -139,77 +599,174 @@ void Model::updateModelMatrix() {
     m_modelMatrix = translationMatrix * rotationMatrix * scaleMatrix;
 }
 
-// OBJļԭʼλ(v)(vt)(f)
-// úֻļκμδ
-Model::RawObjData Model::loadRawData(const std::string& filePath) {
-    RawObjData rawData;
-
-    std::ifstream file(filePath); // OBJļ
+// ȡOBJļ
+// ļarenaеĹ̶ԭؽΪÿһдstringstream
+bool Model::loadObjFile(const std::string& filePath, ModelData& data) {
+    std::ifstream file(filePath, std::ios::binary); // OBJļ
     if (!file.is_open()) {
         std::cerr << "ERROR: Could not open OBJ file: " << filePath << std::endl;
-        return rawData; // ļʧܣؿյrawData
+        return false;
     }
+    return loadModelData([&](std::pmr::memory_resource* arena) {
+        const size_t CHUNK_SIZE = 1 << 20;
+        char* chunk = static_cast<char*>(arena->allocate(CHUNK_SIZE, 1));
+        return parseRawData([&](auto&& fn) {
+            // ÿһ鶼ļͷ¶ȡ
+            file.clear();
+            file.seekg(0);
+            forEachLine(file, chunk, CHUNK_SIZE, fn);
+        }, filePath, arena);
+    }, filePath, data);
+}
+
+// ڴеOBJļ (AssetPipelineI/O̶߳)
+bool Model::parseObj(std::string_view objText, const std::string& sourceName, ModelData& data) {
+    return loadModelData([&](std::pmr::memory_resource* arena) {
+        return parseRawData([&](auto&& fn) {
+            forEachLineInMemory(objText, fn);
+        }, sourceName, arena);
+    }, sourceName, data);
+}
+
+std::string Model::scanMtlLibName(std::string_view objText) {
+    std::string mtlLibName;
+    forEachLineInMemory(objText, [&](const char* lineBegin, const char* lineEnd) {
+        const char* p = lineBegin;
+        if (nextToken(p, lineEnd) == "mtllib") {
+            mtlLibName = nextToken(p, lineEnd);
+        }
+    });
+    return mtlLibName;
+}
+
+template<typename LoadRaw>
+bool Model::loadModelData(LoadRaw&& loadRaw, const std::string& sourceName, ModelData& data) {
+    // ڼʱ (ļݡ/) ȫarena䣬
+    // ʱarenaһͷţarenaʹôҳ
+    // ڹ߳ϲִУֻͳƱ̵߳ķ
+    AllocationTracker::resetThreadPeak();
+    AllocationTracker::ThreadSnapshot heapBefore = AllocationTracker::threadSnapshot();
+    MonotonicArena arena(1 << 20, true);
+
+    // 1. ԭʼݣȡ㡢
+    RawObjData rawData = loadRaw(&arena);
+
+    // Ƿɹ
+    if (rawData.positions.empty() || rawData.faceVertices.empty()) {
+        std::cerr << "ERROR: No vertices or faces found in OBJ file: " << sourceName << std::endl;
+        return false;
+    }
+
+    // 2. ģ͵ı߽ȷģ͵С
+    data.origin = rawData.origin;
+    calculateBoundingBox(rawData.positions, data.minCoords, data.maxCoords);
+
+    // 3. ݣԭʼݽĻͱ׼ţɶ/
+    buildModelData(rawData, data);
+
+    // 4. ؽ׶εڴʹ
+    const MonotonicArena::Stats& arenaStats = arena.getStats();
+    std::cout << "Loader arena (" << sourceName << "): " << arenaStats.allocationCount << " allocations in "
+        << arenaStats.blockCount << " blocks (" << arenaStats.hugePageBlocks << " huge-page), "
+        << arenaStats.bytesUsed / 1024 << " KB used / " << arenaStats.bytesReserved / 1024 << " KB reserved." << std::endl;
+    if (AllocationTracker::isEnabled()) {
+        AllocationTracker::ThreadSnapshot heapAfter = AllocationTracker::threadSnapshot();
+        long long peakDelta = std::max(heapAfter.peakBytes - heapBefore.currentBytes, 0LL);
+        std::cout << "Loader heap: " << heapAfter.allocationCount - heapBefore.allocationCount << " allocations, peak +"
+            << peakDelta / 1024 << " KB." << std::endl;
+    }
+    return !data.empty();
+}
+
+// OBJıеԭʼλ(v)(vt)(f)
+// úֻıκμδ
+template<typename ForEachLine>
+Model::RawObjData Model::parseRawData(ForEachLine&& forEachLine, const std::string& sourceName, std::pmr::memory_resource* arena) {
+    RawObjData rawData(arena);
+
+    // һ飺ͳv/vt/fǰreserve
+    // arenaյvectorµľɻһֱռõؽҪݣ
+    // ɨһļ (ͨҳ) ˷ѵڴ˵öࡣ
+    size_t positionCount = 0, texCoordCount = 0, faceCount = 0;
+    forEachLine([&](const char* line, const char* lineEnd) {
+        if (lineEnd - line < 2) {
+            return;
+        }
+        if (line[0] == 'v') {
+            positionCount += (line[1] == ' ' || line[1] == '\t');
+            texCoordCount += (line[1] == 't');
+        }
+        else if (line[0] == 'f') {
+            faceCount += (line[1] == ' ' || line[1] == '\t');
+        }
+    });
+    rawData.positions.reserve(positionCount);
+    rawData.texCoords.reserve(texCoordCount);
+    rawData.faceVertices.reserve(faceCount * 3);
 
-    std::string line;
-    std::string currentMaterialName = "default"; // Ĭϲ
-    rawData.meshGroups.push_back({ currentMaterialName, {} }); // Ĭϲ
+    std::pmr::string currentMaterialName("default", arena); // Ĭϲ
+    rawData.meshGroups.push_back({ currentMaterialName, std::pmr::vector<unsigned int>(arena) }); // Ĭϲ
 
-    while (std::getline(file, line)) {
-        std::stringstream ss(line);
-        std::string type;
-        ss >> type;
+    // ڶ飺
+    forEachLine([&](const char* lineBegin, const char* lineEnd) {
+        const char* p = lineBegin;
+        std::string_view type = nextToken(p, lineEnd);
 
         if (type == "v") { // λ
-            glm::vec3 pos;
-            ss >> pos.x >> pos.y >> pos.z;
-            rawData.positions.push_back(pos);
+            // ˫Ƚȥԭٴfloat (ʮ) ֱӴfloatʱֻʣ׼
+            glm::dvec3 pos;
+            pos.x = nextDouble(p, lineEnd);
+            pos.y = nextDouble(p, lineEnd);
+            pos.z = nextDouble(p, lineEnd);
+            if (rawData.positions.empty()) {
+                rawData.origin = glm::round(pos / SOURCE_ORIGIN_GRID) * SOURCE_ORIGIN_GRID;
+            }
+            rawData.positions.push_back(glm::vec3(pos - rawData.origin));
         }
         else if (type == "vt") { // 
             glm::vec2 uv;
-            ss >> uv.x >> uv.y;
+            uv.x = nextFloat(p, lineEnd);
+            uv.y = nextFloat(p, lineEnd);
             rawData.texCoords.push_back(uv);
         }
         else if (type == "f") { // 
-            RawObjData::Face face;
-            std::string vertexStr;
-            while (ss >> vertexStr) {
+            // ΰǻ (0)OBJг͹ı/
+            RawObjData::VertexIndices first, previous;
+            size_t vertexCount = 0;
+            std::string_view vertexStr;
+            while (!(vertexStr = nextToken(p, lineEnd)).empty()) {
+                //  "v", "v/vt", "v/vt/vn", "v//vn" ʽ
                 RawObjData::VertexIndices vi;
-                //  "v/vt" ʽ
                 size_t posSlash = vertexStr.find('/');
-                size_t texCoordSlash = std::string::npos; // ûзߣֻһб
-
-                if (posSlash != std::string::npos) {
-                    vi.posIndex = std::stoul(vertexStr.substr(0, posSlash)) - 1;
-                    texCoordSlash = vertexStr.find('/', posSlash + 1); // ҵڶб
-                    if (texCoordSlash != std::string::npos) { // еڶбܣ˵зߣ
-                        vi.texCoordIndex = std::stoul(vertexStr.substr(posSlash + 1, texCoordSlash - (posSlash + 1))) - 1;
-                    }
-                    else { // ֻv/vt
-                        vi.texCoordIndex = std::stoul(vertexStr.substr(posSlash + 1)) - 1;
-                    }
+                vi.posIndex = parseIndex(vertexStr.substr(0, posSlash), rawData.positions.size(), 0);
+                vi.texCoordIndex = 0; // ĬЧ
+                if (posSlash != std::string_view::npos) {
+                    std::string_view rest = vertexStr.substr(posSlash + 1);
+                    vi.texCoordIndex = parseIndex(rest.substr(0, rest.find('/')), rawData.texCoords.size(), 0);
                 }
-                else { // ֻv
-                    vi.posIndex = std::stoul(vertexStr) - 1;
-                    vi.texCoordIndex = 0; // ĬЧ
+                if (vertexCount == 0) {
+                    first = vi;
                 }
-                face.vertices.push_back(vi);
-            }
-            // ȷ (ǣҪǻΪֻ)
-            if (face.vertices.size() == 3) {
-                rawData.faces.push_back(face);
-                // ǰӵǰ
-                rawData.meshGroups.back().faceIndices.push_back(rawData.faces.size() - 1);
+                else if (vertexCount >= 2) {
+                    RawObjData::VertexIndices triangle[3] = { first, previous, vi };
+                    rawData.faceVertices.insert(rawData.faceVertices.end(), triangle, triangle + 3);
+                    // ǰӵǰ
+                    rawData.meshGroups.back().faceIndices.push_back(static_cast<unsigned int>(rawData.faceCount() - 1));
+                }
+                previous = vi;
+                vertexCount++;
             }
-            else {
-                std::cerr << "WARNING: Skipping non-triangle face in OBJ file: " << line << std::endl;
+            if (vertexCount < 3) {
+                std::cerr << "WARNING: Skipping degenerate face in OBJ file: "
+                    << std::string_view(lineBegin, lineEnd - lineBegin) << std::endl;
             }
         }
         else if (type == "mtllib") { // ʿļ
-            ss >> rawData.mtlLibName;
+            rawData.mtlLibName = nextToken(p, lineEnd);
             std::cout << "MTL Lib: " << rawData.mtlLibName << std::endl;
         }
         else if (type == "usemtl") { // ʹò
-            ss >> currentMaterialName;
+            currentMaterialName = nextToken(p, lineEnd);
             // Ƿд˲飬û򴴽µ
             bool found = false;
             for (const auto& group : rawData.meshGroups) {
@@ -219,63 +776,55 @@ Model::RawObjData Model::loadRawData(const std::string& filePath) {
                 }
             }
             if (!found) {
-                rawData.meshGroups.push_back({ currentMaterialName, {} });
+                rawData.meshGroups.push_back({ currentMaterialName, std::pmr::vector<unsigned int>(arena) });
             }
             // ȷ currentMaterialName һ meshGroup  materialName
             // һ򻯴usemtlлµmeshGroup
             // ʵʿҪӵ߼usemtlָͬһʵ
             // ֱӴһµmeshGroupmaterialNameΪcurrentMaterialName
             if (rawData.meshGroups.back().materialName != currentMaterialName) {
-                rawData.meshGroups.push_back({ currentMaterialName, {} });
+                rawData.meshGroups.push_back({ currentMaterialName, std::pmr::vector<unsigned int>(arena) });
             }
         }
-    }
-    file.close();
+    });
 
     std::cout << "Loaded " << rawData.positions.size() << " raw vertices, "
         << rawData.texCoords.size() << " raw texture coordinates, and "
-        << rawData.faces.size() << " faces from " << filePath << std::endl;
+        << rawData.faceCount() << " faces from " << sourceName << std::endl;
 
     return rawData;
 }
 
 // ģ͵ı߽min_coordsmax_coords
 // ߽ںĻͱ׼š
-void Model::calculateBoundingBox(const std::vector<glm::vec3>& rawPositions) {
+void Model::calculateBoundingBox(const std::pmr::vector<glm::vec3>& rawPositions, glm::vec3& minCoords, glm::vec3& maxCoords) {
     // ʼСΪ󸡵ΪС
-    m_minCoords = glm::vec3(std::numeric_limits<float>::max());
-    m_maxCoords = glm::vec3(std::numeric_limits<float>::lowest());
+    minCoords = glm::vec3(std::numeric_limits<float>::max());
+    maxCoords = glm::vec3(std::numeric_limits<float>::lowest());
 
     if (rawPositions.empty()) {
         std::cerr << "WARNING: No raw positions to calculate bounding box." << std::endl;
         return;
     }
 
-    // ԭʼλãС
-    for (const auto& pos : rawPositions) {
-        m_minCoords.x = std::min(m_minCoords.x, pos.x);
-        m_minCoords.y = std::min(m_minCoords.y, pos.y);
-        m_minCoords.z = std::min(m_minCoords.z, pos.z);
-        m_maxCoords.x = std::max(m_maxCoords.x, pos.x);
-        m_maxCoords.y = std::max(m_maxCoords.y, pos.y);
-        m_maxCoords.z = std::max(m_maxCoords.z, pos.z);
-    }
-    m_localCenter = (m_minCoords + m_maxCoords) / 2.0f; // ֲĵ
-    std::cout << "Bounding Box: Min(" << m_minCoords.x << ", " << m_minCoords.y << ", " << m_minCoords.z << ") "
-        << "Max(" << m_maxCoords.x << ", " << m_maxCoords.y << ", " << m_maxCoords.z << ")" << std::endl;
+    // ںˣģͷֿJobSystemϲйԼ
+    geometry::computeBoundsParallel(rawPositions.data(), rawPositions.size(), minCoords, maxCoords);
+    std::cout << "Bounding Box: Min(" << minCoords.x << ", " << minCoords.y << ", " << minCoords.z << ") "
+        << "Max(" << maxCoords.x << ", " << maxCoords.y << ", " << maxCoords.z << ")" << std::endl;
 }
 
-// ԭʼݣĻ׼ţMeshMaterial
-void Model::processData(const RawObjData& rawData, const std::string& objBaseDir) {
+// ԭʼݣĻ׼ţMeshݡ
+void Model::buildModelData(const RawObjData& rawData, ModelData& data) {
     if (rawData.positions.empty()) {
         std::cerr << "WARNING: No raw positions to process." << std::endl;
         return;
     }
+    data.mtlLibName = std::string(rawData.mtlLibName);
 
     // ģ͵ĵ
-    glm::vec3 center = (m_minCoords + m_maxCoords) / 2.0f;
+    glm::vec3 center = (data.minCoords + data.maxCoords) / 2.0f;
     // ģ͵ķΧϵĳȣ
-    glm::vec3 extent = m_maxCoords - m_minCoords;
+    glm::vec3 extent = data.maxCoords - data.minCoords;
     // ҳģά
     float max_dim = std::max({ extent.x, extent.y, extent.z });
     // ӣʹģάԼΪ2λģʹ[-1, 1]ķΧڣ۲
@@ -287,88 +836,188 @@ void Model::processData(const RawObjData& rawData, const std::string& objBaseDir
     initialTransform = glm::scale(initialTransform, glm::vec3(scale_factor)); // 
     initialTransform = glm::translate(initialTransform, -center);             // ƽƵԭ
 
-    // --- 1. ز ---
-    if (!rawData.mtlLibName.empty()) {
-        std::string mtlFilePath = objBaseDir + rawData.mtlLibName;
-        // һMTLļֻһʣҲmtlļеnewmtlһ
-        // ʵʿҪMTLļȡвʶ
-        Material* mat = new Material(mtlFilePath, objBaseDir + "materials_textures/"); // Ŀ¼
-        if (!mat->getName().empty()) {
-            m_materials[mat->getName()] = mat;
+    // Mesh
+    // ֮以ȥغͶ任ϵͳϲнУÿĽдԼĲλ
+    std::vector<MeshData> groupMeshes(rawData.meshGroups.size());
+    JobSystem::getInstance()->parallelFor(0, rawData.meshGroups.size(), [&](size_t groupBegin, size_t groupEnd) {
+        for (size_t groupIndex = groupBegin; groupIndex < groupEnd; ++groupIndex) {
+            const auto& meshGroup = rawData.meshGroups[groupIndex];
+            groupMeshes[groupIndex].materialName = std::string(meshGroup.materialName);
+            buildGroupGeometry(rawData, meshGroup, initialTransform,
+                groupMeshes[groupIndex].vertices, groupMeshes[groupIndex].indices);
         }
-        else {
-            delete mat; // û֣ɾ
+    }, 1);
+
+    // յĲ (ûĬ)ԭ˳
+    data.meshes.reserve(groupMeshes.size());
+    for (MeshData& mesh : groupMeshes) {
+        if (!mesh.vertices.empty() && !mesh.indices.empty()) {
+            data.meshes.push_back(std::move(mesh));
         }
     }
-    // ûMTLļʼʧܣһĬϲ
-    if (m_materials.empty()) {
-        std::cout << "No materials loaded, creating default material." << std::endl;
-        // һΪ"default"Ĭϲʣ
-        Material* defaultMat = new Material("", ""); // ·ļ
-        defaultMat->m_name = "default"; // ֶ
-        m_materials["default"] = defaultMat;
+}
+
+// ȡߣģݵĶĻͱ׼ţģͿռһ
+void Model::buildOutlines(ModelData& data, const outline::FeatureEdgeOptions& options) {
+    std::vector<outline::SourceMesh> sources(data.meshes.size());
+    for (size_t i = 0; i < data.meshes.size(); ++i) {
+        const MeshData& mesh = data.meshes[i];
+        sources[i].positions = mesh.vertices.data();
+        sources[i].stride = 5; // PosXYZ + UV
+        sources[i].vertexCount = mesh.vertices.size() / 5;
+        sources[i].indices = mesh.indices.data();
+        sources[i].indexCount = mesh.indices.size();
+    }
+    std::vector<std::vector<outline::EdgeVertex>> lines;
+    outline::FeatureEdgeStats stats;
+    outline::extractFeatureEdges(sources, options, lines, &stats);
+    for (size_t i = 0; i < data.meshes.size(); ++i) {
+        data.meshes[i].outlineVertices = std::move(lines[i]);
     }
+    std::cout << "Outline edges: " << stats.creases << " creases, " << stats.materialBorders << " material borders, "
+        << stats.boundaries << " boundaries, " << stats.smoothEdges << " silhouette candidates." << std::endl;
+}
 
+// ײģݵĶĻͱ׼ţģͿռһ
+void Model::buildCollisionMesh(ModelData& data) {
+    std::vector<glm::vec3> positions;
+    std::vector<uint32_t> indices;
+    for (const MeshData& mesh : data.meshes) {
+        uint32_t base = static_cast<uint32_t>(positions.size());
+        // ʽλ(3) + (2)
+        for (size_t v = 0; v + 4 < mesh.vertices.size(); v += 5) {
+            positions.push_back(glm::vec3(mesh.vertices[v], mesh.vertices[v + 1], mesh.vertices[v + 2]));
+        }
+        for (unsigned int index : mesh.indices) {
+            indices.push_back(base + index);
+        }
+    }
+    data.collisionMesh = createCollisionMesh(positions, indices, data.minCoords, data.maxCoords);
+}
 
-    // --- 2. ݲ鴴Mesh ---
-    for (const auto& meshGroup : rawData.meshGroups) {
-        std::vector<float> meshVertices; // 洢ǰMeshĶ (PosXYZ + UV)
-        std::vector<unsigned int> meshIndices; // 洢ǰMesh
-
-        // ڽOBJv/vtӳ䵽Meshıƽ
-        // key: (pos_idx, tex_idx) -> value: new_flat_vertex_idx
-        std::map<std::pair<unsigned int, unsigned int>, unsigned int> uniqueVertices;
-        unsigned int currentVertexCount = 0;
-
-        // ڵǰ
-        for (unsigned int faceIdx : meshGroup.faceIndices) {
-            const auto& face = rawData.faces[faceIdx];
-            // еÿ
-            for (const auto& vi : face.vertices) {
-                std::pair<unsigned int, unsigned int> key = { vi.posIndex, vi.texCoordIndex };
-
-                if (uniqueVertices.find(key) == uniqueVertices.end()) {
-                    // ¶㣬
-                    uniqueVertices[key] = currentVertexCount++;
-
-                    // ȡԭʼλòӦóʼ任
-                    glm::vec4 transformed_pos = initialTransform * glm::vec4(rawData.positions[vi.posIndex], 1.0f);
-                    meshVertices.push_back(transformed_pos.x);
-                    meshVertices.push_back(transformed_pos.y);
-                    meshVertices.push_back(transformed_pos.z);
-
-                    // ȡԭʼ
-                    if (vi.texCoordIndex < rawData.texCoords.size()) {
-                        meshVertices.push_back(rawData.texCoords[vi.texCoordIndex].x);
-                        meshVertices.push_back(rawData.texCoords[vi.texCoordIndex].y);
-                    }
-                    else {
-                        // ЧʹĬֵ
-                        meshVertices.push_back(0.0f);
-                        meshVertices.push_back(0.0f);
-                    }
-                }
-                // Mesh
-                meshIndices.push_back(uniqueVertices[key]);
-            }
+std::shared_ptr<CollisionMesh> Model::createCollisionMesh(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices,
+    const glm::vec3& minCoords, const glm::vec3& maxCoords) {
+    // ģͿռΪ2 (buildModelData)ԭʼ1λӦ2 / maxDim
+    // 4096ڣܴģ () ľ
+    glm::vec3 extent = maxCoords - minCoords;
+    float maxDim = std::max({ extent.x, extent.y, extent.z });
+    float cellSize = maxDim > 0.0f ? std::max(COLLISION_CELL_SIZE, maxDim / 4096.0f) * 2.0f / maxDim : 0.0f;
+    auto collisionMesh = std::make_shared<CollisionMesh>();
+    collisionMesh->build(positions, indices, cellSize);
+    std::cout << "Collision proxy: " << indices.size() / 3 << " -> " << collisionMesh->getTriangleCount() << " triangles, "
+        << collisionMesh->getNodeCount() << " BVH nodes." << std::endl;
+    return collisionMesh;
+}
+
+// CPUݴMaterialMeshԴ
+void Model::createResources(ModelData& data, std::vector<MaterialData>& materials) {
+    m_mtlLibName = data.mtlLibName;
+    m_collisionMesh = std::move(data.collisionMesh);
+    m_minCoords = data.minCoords;
+    m_maxCoords = data.maxCoords;
+    m_sourceOrigin = data.origin;
+    m_localCenter = (m_minCoords + m_maxCoords) / 2.0f; // ֲĵ
+
+    ResourceManager* resourceManager = ResourceManager::getInstance();
+
+    // --- 1.  ---
+    // һMTLļпԶʣƼ¼ʱԵһΪ׼
+    // ͼͬĲ (ģе) ͬһ淶ʡ
+    MaterialCache* materialCache = MaterialCache::getInstance();
+    for (const MaterialData& materialData : materials) {
+        if (materialData.name.empty() || m_materials.count(materialData.name) > 0) {
+            continue;
         }
+        m_materials[materialData.name] = materialCache->acquire(materialData);
+    }
+    // ȷһ"default"ʣδҵʵMeshʹ
+    if (m_materials.empty()) {
+        std::cout << "No materials loaded, creating default material." << std::endl;
+    }
+    getDefaultMaterial();
 
+    // --- 2. ݲ鴴Mesh ---
+    // MeshĴ漰ResourceManagerOpenGLãڵǰ̰߳˳
+    for (MeshData& meshData : data.meshes) {
         // ȡǰMeshĲ
-        Material* meshMaterial = nullptr;
-        if (m_materials.count(meshGroup.materialName)) {
-            meshMaterial = m_materials[meshGroup.materialName];
+        MaterialHandle meshMaterial;
+        auto materialIt = m_materials.find(meshData.materialName);
+        if (materialIt != m_materials.end()) {
+            meshMaterial = materialIt->second;
         }
         else {
             // δҵʹĬϲ
             meshMaterial = m_materials["default"];
-            std::cerr << "WARNING: Material '" << meshGroup.materialName << "' not found for mesh group, using 'default'." << std::endl;
+            std::cerr << "WARNING: Material '" << meshData.materialName << "' not found for mesh group, using 'default'." << std::endl;
         }
 
-        // Meshӵб
-        if (!meshVertices.empty() && !meshIndices.empty()) {
-            m_meshes.push_back(new Mesh(meshVertices, meshIndices, meshMaterial));
+        // /ֱƶMeshٿ
+        MeshHandle handle = resourceManager->create<Mesh>(std::move(meshData.vertices), std::move(meshData.indices), meshMaterial);
+        if (Mesh* mesh = resourceManager->get(handle)) {
+            mesh->setOutline(meshData.outlineVertices);
+            // 鲣͸MeshڼʱԤεķ˳
+            prepareTransparency(*mesh);
         }
+        m_meshes.push_back(handle);
     }
 
     std::cout << "Model processed into " << m_meshes.size() << " meshes." << std::endl;
-}
\ No newline at end of file
+}
+
+// ΪһȥغĶ顣
+// ϵͳĹִ߳УֻrawDataʱȥرʹñԼڴ棬ʹarena
+void Model::buildGroupGeometry(const RawObjData& rawData, const RawObjData::MeshGroup& meshGroup, const glm::mat4& initialTransform,
+    std::vector<float>& meshVertices, std::vector<unsigned int>& meshIndices) {
+    if (meshGroup.faceIndices.empty()) {
+        return;
+    }
+    size_t cornerCount = meshGroup.faceIndices.size() * 3;
+    meshIndices.reserve(cornerCount);
+
+    // ڽOBJv/vtӳ䵽Meshıƽ
+    // ʹÿѰַıƽϣ (̽)std::mapΪÿһڵ㡣
+    // key: (pos_idx << 32 | tex_idx) -> value: new_flat_vertex_idx
+    size_t tableSize = 16;
+    while (tableSize < cornerCount * 2) {
+        tableSize *= 2; // ȡ2ݣӲ0.5
+    }
+    const uint64_t EMPTY_KEY = ~uint64_t(0);
+    const size_t tableMask = tableSize - 1;
+    std::vector<uint64_t> tableKeys(tableSize, EMPTY_KEY);
+    std::vector<unsigned int> tableValues(tableSize);
+    // ˳¼¶(v, vt)ȥؽһ԰׼ȷС䶥飬
+    std::vector<RawObjData::VertexIndices> uniqueCorners;
+    uniqueCorners.reserve(cornerCount);
+
+    // ڵǰ
+    for (unsigned int faceIdx : meshGroup.faceIndices) {
+        // еÿ
+        for (size_t corner = 0; corner < 3; ++corner) {
+            const auto& vi = rawData.faceVertices[faceIdx * 3 + corner];
+            uint64_t key = (static_cast<uint64_t>(vi.posIndex) << 32) | vi.texCoordIndex;
+
+            // ̽key
+            size_t slot = static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & tableMask;
+            while (tableKeys[slot] != EMPTY_KEY && tableKeys[slot] != key) {
+                slot = (slot + 1) & tableMask;
+            }
+
+            if (tableKeys[slot] == EMPTY_KEY) {
+                // ¶㣬
+                tableKeys[slot] = key;
+                tableValues[slot] = static_cast<unsigned int>(uniqueCorners.size());
+                uniqueCorners.push_back(vi);
+            }
+            // Mesh
+            meshIndices.push_back(tableValues[slot]);
+        }
+    }
+
+    // ׼ȷĶ䶥ݣ֮以Ĳٲָ߳
+    meshVertices.resize(uniqueCorners.size() * 5);
+    // 任λòUVдںɣЧд(0, 0)
+    JobSystem::getInstance()->parallelFor(0, uniqueCorners.size(), [&](size_t begin, size_t end) {
+        geometry::transformInterleaved(initialTransform, rawData.positions.data(), rawData.texCoords.data(), rawData.texCoords.size(),
+            uniqueCorners.data() + begin, end - begin, meshVertices.data() + begin * 5);
+    }, VERTEX_GRAIN_SIZE);
+}
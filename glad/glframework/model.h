@@ -4,6 +4,10 @@
 #include "../wrapper/checkError.h" // OpenGL
 #include "mesh.h"             // Mesh
 #include "material.h"         // Material
+#include "resource/handle.h"  // MeshMaterialִͨ
+#include "simd/geometryKernels.h" // ں˹ͬһṹ
+#include "outline/featureEdges.h" // ߵȡ
+#include "collision/collisionMesh.h" // ײõļ򻯴
 
 #include <string>             // std::string
 #include <vector>             // std::vector
@@ -12,30 +16,103 @@
 #include <limits>             // std::numeric_limitsڼ߽ʱʹ
 #include <algorithm>          // std::min, std::max
 #include <map>                // ڴ洢
+#include <memory>             // std::shared_ptrײCollisionWorld
 #include <iostream>           // std::cerr, std::coutе
+#include <memory_resource>    // std::pmrʱݴarena
+#include <string_view>        // ڽڴеOBJı
 
 // ǰ Shader 
 class Shader;
 class Camera; // ǰCamera࣬LOD
+class ClipSet; // ǰClipSet࣬޳
+class TransparentQueue; // ǰTransparentQueue࣬͸MeshӺϻ
+class GeometryArena; // ǰGeometryArena࣬ȡĻ·
+class CollisionWorld; // ǰCollisionWorld࣬ģ͵ײǼ
+
+// MeshDataһļ (CPU࣬κGL)
+struct MeshData {
+    std::string materialName;          // ʹõĲ (usemtl)
+    std::vector<float> vertices;       // ƽĶ (PosXYZ + UV)Ļͱ׼
+    std::vector<unsigned int> indices; // 
+    std::vector<outline::EdgeVertex> outlineVertices; // ߵ߶ζ˵ (Model::buildOutlines)Ϊʱû
+};
+
+// ModelDataOBJļģ (CPU)
+// ڹ߳ɣ֮GL߳Model
+struct ModelData {
+    std::string mtlLibName;            // .mtlļ (OBJĿ¼)
+    // ʱ (˫) ԭʼмȥԭ㣬ȡModel::SOURCE_ORIGIN_GRID
+    // µĽֻмȥܴ֮floatʧȣԭ㸽ģΪ0
+    glm::dvec3 origin = glm::dvec3(0.0);
+    glm::vec3 minCoords = glm::vec3(0.0f); // ԭʼ (ȥorigin) µı߽
+    glm::vec3 maxCoords = glm::vec3(0.0f);
+    std::vector<MeshData> meshes;      // ÿǿղһ
+    std::shared_ptr<CollisionMesh> collisionMesh; // ײ (Model::buildCollisionMesh)Ϊʱû
+
+    bool empty() const { return meshes.empty(); }
+};
 
 // ModelࣺOBJļv, vt, fݣݣMeshMaterial
 // װģͱ任
 class Model {
 public:
+    static constexpr uint32_t NO_OBJECT = ~0u; // ûнţAttributeTable::NO_ROWͬ
+
     // 캯
     // - filePath: OBJģļ· "assets/models/building.obj"
+    // - textureBaseDir: ͼƬĿ¼ΪʱʹOBJļĿ¼µ "materials_textures/"
     // ڹʱģ͵ļءݴOpenGLá
-    Model(const std::string& filePath);
+    Model(const std::string& filePath, const std::string& textureBaseDir = "");
+
+    // 캯ѾCPU׼õݴģ (AssetPipeline)
+    // - name: ģƣͨΪOBJļ·
+    // - data: õļݣ/ᱻƶMesh
+    // - materials: õĲʣͼѽʱֻGLϴ
+    // ֻGLԴĴϴGL̵߳á
+    Model(const std::string& name, ModelData data, std::vector<MaterialData> materials);
+
+    // 캯һģ֮ͣⲿ (AssetPack) ͨaddMaterial/addMesh䡣
+    // - minCoords/maxCoords: ԭʼ (ȥsourceOrigin) µı߽
+    // - sourceOrigin: ModelData::origin
+    Model(const std::string& name, const glm::vec3& minCoords, const glm::vec3& maxCoords,
+        const glm::dvec3& sourceOrigin = glm::dvec3(0.0));
 
     // 
-    // ͷMeshMaterialԴ
+    // ͷŶMeshMaterialãԴResourceManagercollectGarbage()ͳһ١
     ~Model();
 
+    // ģͳԴãֹ
+    Model(const Model&) = delete;
+    Model& operator=(const Model&) = delete;
+
     // ģͣ
     // - shader: Ⱦǰģ͵Shader
     // ڴ˺ڲģ;󣬲MVP䵽ɫȻMesh
     void draw(Shader& shader);
 
+    //  (ÿߵMeshһGL_LINES)
+    // - shader: ѼShader (assets/shaders/outlineVertex.glsl)
+    // ñ任󡢷߾λã⻬ǷΪɶɫжϡӦdraw֮á
+    void drawOutlines(Shader& shader);
+
+    // ƽ (ClipSet)nullptrʾСʱΧȫеMeshֱ
+    // MeshGPUü (ShaderclipPlanesɵ÷ͨClipSet::apply)Ȩ
+    void setClipSet(const ClipSet* clipSet) { m_clipSet = clipSet; }
+
+    // ͸ͨ (TransparentQueue)nullptrʾ͸MeshMeshһֱӻ (ڵģ)
+    // údrawֻƲ͸Mesh͸MeshͬӿռȺͷ˳һύСȨ
+    void setTransparentQueue(TransparentQueue* queue) { m_transparentQueue = queue; }
+
+    // öȡĻ· (GeometryArena)nullptrʾÿMeshԼVAOֱӻơ
+    // údrawֱӻMeshǰѵǰLODύarenaɵ÷ģύ֮ͳһflush
+    // ޷빲MeshȻֱӻơȨ
+    void setGeometryArena(GeometryArena* arena) { m_geometryArena = arena; }
+
+    // ýţԱек (AttributeTable)NO_OBJECTʾûԡ
+    // ʱShader (objectId)רɫɫ
+    void setObjectId(uint32_t objectId) { m_objectId = objectId; }
+    uint32_t getObjectId() const { return m_objectId; }
+
     // ģռеƽ
     void setPosition(const glm::vec3& pos);
 
@@ -51,6 +128,14 @@ public:
     // ͶӰͨCameramain㲢룩
     void setProjectionMatrix(const glm::mat4& proj);
 
+    // ö任ոʽ (pack::CompactVertex) Ķλ[0, 1]꣬
+    // ʱȾ˱任ԭģͿռ䣬Ӧģ;ĬΪλ
+    void setVertexTransform(const glm::mat4& transform) { m_vertexTransform = transform; }
+
+    // ĻռѡLODʱÿLODݵMeshѡ񼸺ͶӰĻ
+    // pixelThresholdصһviewportHeightΪӿڸ߶ ()Ϊ0ʱر (LOD 0)
+    void setLodSelection(float viewportHeight, float pixelThreshold = 1.0f);
+
     // ȡģ͵ռĵ㣬LOD
     glm::vec3 getWorldCenter() const;
 
@@ -61,62 +146,192 @@ public:
     // ȡǰͶӰ
     const glm::mat4& getProjectionMatrix() const { return m_projectionMatrix; }
 
+    // ȡģ (ͨΪOBJļ·)
+    const std::string& getFilePath() const { return m_filePath; }
+    // ȡ.mtlļ (OBJĿ¼)ûвʿʱΪ
+    const std::string& getMtlLibName() const { return m_mtlLibName; }
+    // ȡģ͵Ĳʿ
+    const std::map<std::string, MaterialHandle>& getMaterials() const { return m_materials; }
+
+    // ԭʼ (OBJļеȥgetSourceOrigin()) µı߽
+    const glm::vec3& getMinCoords() const { return m_minCoords; }
+    const glm::vec3& getMaxCoords() const { return m_maxCoords; }
+    const glm::dvec3& getSourceOrigin() const { return m_sourceOrigin; }
+
+    // ײ (ģͿռ)ΪʱģͲײgetModelMatrix()setCollisionWorldCollisionWorld
+    const std::shared_ptr<const CollisionMesh>& getCollisionMesh() const { return m_collisionMesh; }
+    void setCollisionMesh(std::shared_ptr<const CollisionMesh> collisionMesh) { m_collisionMesh = std::move(collisionMesh); }
+
+    // õǰģ;ײǼǵworld (ΪʱƳ)غµǼǣʱƳ
+    // Լģ (TileStreamerеǼƬ)worldģͻþãǼ֮Ҫ޸ģͱ任
+    void setCollisionWorld(CollisionWorld* world);
+
+    // ͳģռõCPUڴԴ (Mesh +  + ײͬһֻһ)
+    // ˶ȡʱ͸MeshGeometryArenaеĸҲԴ (ǰsetGeometryArena/setTransparentQueue)
+    void getMemoryUsage(size_t& cpuBytes, size_t& gpuBytes) const;
+
+    // ģͷŻOBJļеԭʼ꣺ʱĻͱ׼ģ;
+    // ڰڷŵĽ (ʽصƬ)תá
+    // - origin: ԭʼмȥԭ㣬ʹĳԭ㸽Ⱦģԭ֮˫ȼ㡣
+    void placeAtSourceCoordinates(const glm::dvec3& origin = glm::dvec3(0.0));
+
+    // ½ļݸģ ()GL̵߳ã
+    // - iMeshõiݸ£ûб仯Meshϴ
+    // - ʱMeshʱͷŶMesh
+    // ʲ¼أ³ֵĲʹ"default"ʡϴMesh
+    // dataײʱ滻ԭĴ (ѼCollisionWorldʵʹþɴҪ¼)
+    size_t reloadGeometry(ModelData data);
+
+    // ½Ĳʿ² ()GL̵߳ã
+    // ÿʴMaterialCacheacquire淶ʱ仯ʱʹþɲʵMeshΪָ²ʲͷžɲʣ
+    // µĲʱǼǡ
+    void reloadMaterials(const std::vector<MaterialData>& materials);
+
+    // Ǽһʣģͽӹܵ÷еãͬѴʱֱͷŸ
+    void addMaterial(const std::string& name, MaterialHandle material);
+
+    // ǼһMeshģͽӹܵ÷е
+    void addMesh(MeshHandle mesh);
+
+    // ȡ"default"ʣʱһĬϲ
+    MaterialHandle getDefaultMaterial();
+
+    // ȡOBJļCPUģݣκGL
+    // ʧܻģΪʱfalse
+    static bool loadObjFile(const std::string& filePath, ModelData& data);
+
+    // ڴеOBJļݣCPUģݣκGL
+    // - objText: OBJļȫݡ
+    // - sourceName: ־ơ
+    static bool parseObj(std::string_view objText, const std::string& sourceName, ModelData& data);
+
+    // ֻOBJļеmtllib (жʱһȡһ)ݡ
+    // ߹ڽ֮ǰȷMTLļ
+    static std::string scanMtlLibName(std::string_view objText);
+
+    // ΪģݵÿMeshȡ (outline::extractFeatureEdges)MeshData::outlineVertices
+    // κGLڽģ͵Ĺ߳ϵãModelʱϴ
+    static void buildOutlines(ModelData& data, const outline::FeatureEdgeOptions& options = outline::FeatureEdgeOptions());
+
+    // ײĶӴС (ԭʼ굥λͨΪ)Сϸ (߽) ѹƽ
+    static constexpr float COLLISION_CELL_SIZE = 0.1f;
+
+    // ʱԭȡλ (ModelData::origin)һԭ㲻ʱԭΪ0
+    // ȡĸӵ㣬ļĳ߶
+    static constexpr double SOURCE_ORIGIN_GRID = 1024.0;
+
+    // ģݵײModelData::collisionMesh
+    // κGLڽģ͵Ĺ߳ϵá
+    static void buildCollisionMesh(ModelData& data);
+
+    // ģͿռײӴСԭʼµı߽ΪCOLLISION_CELL_SIZE
+    static std::shared_ptr<CollisionMesh> createCollisionMesh(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices,
+        const glm::vec3& minCoords, const glm::vec3& maxCoords);
+
+    // ģеλԭOBJļеԭʼ (ȥoriginֵ˫ȼ) ׷ӵpositions/indices
+    // ߹еļδ (HLOD򻯡ɼԼ)
+    static void appendSourceGeometry(const ModelData& data, std::vector<glm::vec3>& positions, std::vector<uint32_t>& indices,
+        const glm::dvec3& origin = glm::dvec3(0.0));
+
 private:
-    // OBJļмԭʼλ(v)(vt)(f)
-    // filePath: OBJģļ·
-    // ֵһԭʼݵĽṹ塣
+    // OBJļеԭʼλ(v)(vt)(f)
+    // ڴ涼Ӽڼarena䣬ؽһͷš
     struct RawObjData {
-        std::vector<glm::vec3> positions; // ԭʼλ
-        std::vector<glm::vec2> texCoords; // ԭʼ
+        explicit RawObjData(std::pmr::memory_resource* arena)
+            : positions(arena), texCoords(arena), faceVertices(arena), meshGroups(arena), mtlLibName(arena) {}
+
+        glm::dvec3 origin = glm::dvec3(0.0);   // ModelData::origin
+        std::pmr::vector<glm::vec3> positions; // ԭʼλ (ȥorigin)
+        std::pmr::vector<glm::vec2> texCoords; // ԭʼ
         // OBJļеݣÿԪشһе
         // 磺f v1/vt1/vn1 v2/vt2/vn2 v3/vt3/vn3
         // ֻ v/vt
-        struct VertexIndices {
-            unsigned int posIndex;
-            unsigned int texCoordIndex;
-        };
-        struct Face {
-            std::vector<VertexIndices> vertices; // ͨ34
-        };
-        std::vector<Face> faces; // 
+        using VertexIndices = geometry::VertexIndices;
+        // ĶãֻΣiӦfaceVertices[3i, 3i+3)
+        // ƽ洢ÿ浥һvector
+        std::pmr::vector<VertexIndices> faceVertices;
+        size_t faceCount() const { return faceVertices.size() / 3; }
 
         // ڴ洢 (usemtl)
         struct MeshGroup {
-            std::string materialName;
-            std::vector<unsigned int> faceIndices; // ڴ˲
+            std::pmr::string materialName;
+            std::pmr::vector<unsigned int> faceIndices; // ڴ˲
         };
-        std::vector<MeshGroup> meshGroups;
-        std::string mtlLibName; // .mtlļ
+        std::pmr::vector<MeshGroup> meshGroups;
+        std::pmr::string mtlLibName; // .mtlļ
     };
-    RawObjData loadRawData(const std::string& filePath);
 
-    // ԭʼݼģ͵ı߽С꣩
-    void calculateBoundingBox(const std::vector<glm::vec3>& rawPositions);
+    // OBJıforEachLine(fn)Ҫļеÿһеһfn(lineBegin, lineEnd)
+    // ʱ (һͳreserveڶ)
+    template<typename ForEachLine>
+    static RawObjData parseRawData(ForEachLine&& forEachLine, const std::string& sourceName, std::pmr::memory_resource* arena);
+
+    // ԭʼı߽С꣩
+    static void calculateBoundingBox(const std::pmr::vector<glm::vec3>& rawPositions, glm::vec3& minCoords, glm::vec3& maxCoords);
 
     // ԭʼݣ
     // - ģͽĻʹλھֲϵԭ㣩
     // - ģͽб׼ţʹߴһΧڣ
-    // - ݲ鴴Mesh
-    // rawData: OBJļصԭʼݡ
-    // objBaseDir: OBJļڵĿ¼ڼMTLļ
-    void processData(const RawObjData& rawData, const std::string& objBaseDir);
+    // - ȥغĶ/飬JobSystemϲд
+    static void buildModelData(const RawObjData& rawData, ModelData& data);
+
+    // arenaϼԭʼݲModelDataloadObjFileparseObjãͬʱؽ׶εڴͳ
+    template<typename LoadRaw>
+    static bool loadModelData(LoadRaw&& loadRaw, const std::string& sourceName, ModelData& data);
+
+    // CPUݴMaterialMeshԴ (GL߳)
+    void createResources(ModelData& data, std::vector<MaterialData>& materials);
+
+    // Ϊһȥض㲢ɶ (PosXYZ + UVӦinitialTransform) 顣
+    // ֻrawDataڶ߳϶Բͬͬʱá
+    static void buildGroupGeometry(const RawObjData& rawData, const RawObjData::MeshGroup& meshGroup, const glm::mat4& initialTransform,
+        std::vector<float>& meshVertices, std::vector<unsigned int>& meshIndices);
+
+    // 㼶ѭСȣСڴĶ㲻ֵòֳɶ
+    static constexpr size_t VERTEX_GRAIN_SIZE = 16384;
 
     // ģ;
     // m_currentPosition, m_currentRotation, m_currentScale¼m_modelMatrix
     void updateModelMatrix();
 
+    // ͼ/ͶӰΪÿMeshѡLOD (setLodSelection)
+    void selectLods();
+
+    // Meshȫƽеʱtrue (ûClipSetʱfalse)
+    bool isClipped(const Mesh& mesh, const glm::mat4& vertexToWorld) const;
+
+    // MeshĲҪϻ
+    static bool isTransparent(const Mesh& mesh);
+
+    // ͸㹻MeshԤ㷽˳ (Mesh::buildDirectionalOrders)ʱظ
+    static void prepareTransparency(Mesh& mesh);
+
 private:
     std::string m_filePath; // OBJļ·
+    std::string m_mtlLibName; // .mtlļ
 
-    // ģ͵Ķ岿
-    std::vector<Mesh*> m_meshes;
-    // ģ͵Ĳʿ
-    std::map<std::string, Material*> m_materials;
+    // ģ͵Ķ岿 (ÿһ)
+    std::vector<MeshHandle> m_meshes;
+    // ģ͵Ĳʿ (ÿһ)
+    std::map<std::string, MaterialHandle> m_materials;
 
     // 任
     glm::mat4 m_modelMatrix;      // ģ; (Model Matrix)
     glm::mat4 m_viewMatrix;       // ͼ (View Matrix)
     glm::mat4 m_projectionMatrix; // ͶӰ (Projection Matrix)
+    glm::mat4 m_vertexTransform = glm::mat4(1.0f); // 任 (ոʽķ)
+
+    // LODѡ
+    float m_lodViewportHeight = 0.0f; // ӿڸ߶ ()Ϊ0ʱѡLOD
+    float m_lodPixelThreshold = 1.0f; // Ļռ ()
+
+    const ClipSet* m_clipSet = nullptr; // ƽ棬Ϊʱ
+    TransparentQueue* m_transparentQueue = nullptr; // ͸ͨΪʱ͸Meshֱӻ
+    GeometryArena* m_geometryArena = nullptr; // ȡĻ·Ϊʱֱӻ
+    uint32_t m_objectId = NO_OBJECT; //  (Աек)
+    std::shared_ptr<const CollisionMesh> m_collisionMesh; // ײΪʱײ
+    CollisionWorld* m_collisionWorld = nullptr; // ײǼǵ磬ΪʱûеǼ
+    uint32_t m_collisionBody = ~0u; // m_collisionWorldеʵ (CollisionWorld::NO_BODY)
 
     // ģͱ任ɲ֣ڷ޸ģ;
     glm::vec3 m_currentPosition; // ģռеƽ
@@ -126,5 +341,6 @@ private:
     // ģ͵ԭʼ߽ڳʼĻͱ׼С
     glm::vec3 m_minCoords; // ģ͵С
     glm::vec3 m_maxCoords; // ģ͵
+    glm::dvec3 m_sourceOrigin = glm::dvec3(0.0); // ԭʼбȥԭ (ModelData::origin)
     glm::vec3 m_localCenter; // ģھֲϵеĵ
 };
\ No newline at end of file
@@ -0,0 +1,234 @@
+#include "featureEdges.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace outline {
+    namespace {
+        // õλüλȽ (-0.0Ϊ0.0)ͬһԴ㾭ͬ任õλȫͬ
+        uint32_t floatKey(float value) {
+            if (value == 0.0f) {
+                value = 0.0f;
+            }
+            uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        uint64_t hashPosition(const uint32_t key[3]) {
+            uint64_t hash = 1469598103934665603ull;
+            for (int i = 0; i < 3; ++i) {
+                hash = (hash ^ key[i]) * 1099511628211ull;
+            }
+            return hash ^ (hash >> 29);
+        }
+
+        // һһеĳ
+        struct EdgeUse {
+            uint64_t key;       // Ӻ󶥵ıţСڸλ
+            uint32_t face;
+        };
+    }
+
+    uint32_t packNormal(const glm::vec3& normal, int w) {
+        auto snorm10 = [](float value) {
+            int quantized = static_cast<int>(std::lround(std::clamp(value, -1.0f, 1.0f) * 511.0f));
+            return static_cast<uint32_t>(quantized) & 0x3FFu;
+        };
+        return snorm10(normal.x) | (snorm10(normal.y) << 10) | (snorm10(normal.z) << 20)
+            | ((static_cast<uint32_t>(std::clamp(w, -1, 1)) & 0x3u) << 30);
+    }
+
+    void extractFeatureEdges(const std::vector<SourceMesh>& meshes, const FeatureEdgeOptions& options,
+        std::vector<std::vector<EdgeVertex>>& out, FeatureEdgeStats* stats) {
+        out.assign(meshes.size(), std::vector<EdgeVertex>());
+        FeatureEdgeStats counts;
+
+        // 1. λúMeshĶ (Ѱַϣ̽)
+        size_t totalVertices = 0;
+        for (const SourceMesh& mesh : meshes) {
+            totalVertices += mesh.vertexCount;
+        }
+        size_t tableSize = 16;
+        while (tableSize < totalVertices * 2) {
+            tableSize *= 2;
+        }
+        const uint32_t EMPTY = ~uint32_t(0);
+        const size_t tableMask = tableSize - 1;
+        std::vector<uint32_t> table(tableSize, EMPTY);
+        std::vector<glm::vec3> positions;       // ӺĶ
+        positions.reserve(totalVertices);
+        std::vector<uint32_t> weldedIds(totalVertices);
+        std::vector<size_t> firstVertex(meshes.size());
+        size_t vertexBase = 0;
+        for (size_t m = 0; m < meshes.size(); ++m) {
+            const SourceMesh& mesh = meshes[m];
+            firstVertex[m] = vertexBase;
+            for (size_t i = 0; i < mesh.vertexCount; ++i) {
+                const float* p = mesh.positions + i * mesh.stride;
+                uint32_t key[3] = { floatKey(p[0]), floatKey(p[1]), floatKey(p[2]) };
+                size_t slot = static_cast<size_t>(hashPosition(key)) & tableMask;
+                while (table[slot] != EMPTY) {
+                    const glm::vec3& existing = positions[table[slot]];
+                    if (floatKey(existing.x) == key[0] && floatKey(existing.y) == key[1] && floatKey(existing.z) == key[2]) {
+                        break;
+                    }
+                    slot = (slot + 1) & tableMask;
+                }
+                if (table[slot] == EMPTY) {
+                    table[slot] = static_cast<uint32_t>(positions.size());
+                    positions.emplace_back(p[0], p[1], p[2]);
+                }
+                weldedIds[vertexBase + i] = table[slot];
+            }
+            vertexBase += mesh.vertexCount;
+        }
+        table.clear();
+        table.shrink_to_fit();
+
+        // 2. 淨ߺÿ
+        std::vector<glm::vec3> faceNormals;
+        std::vector<uint32_t> faceMeshes;
+        std::vector<EdgeUse> uses;
+        size_t totalTriangles = 0;
+        for (const SourceMesh& mesh : meshes) {
+            totalTriangles += mesh.indexCount / 3;
+        }
+        std::vector<uint32_t> packedNormals;   // wΪ0λ
+        faceNormals.reserve(totalTriangles);
+        packedNormals.reserve(totalTriangles);
+        faceMeshes.reserve(totalTriangles);
+        uses.reserve(totalTriangles * 3);
+        for (size_t m = 0; m < meshes.size(); ++m) {
+            const SourceMesh& mesh = meshes[m];
+            for (size_t t = 0; t + 2 < mesh.indexCount; t += 3) {
+                uint32_t ids[3];
+                bool valid = true;
+                for (int corner = 0; corner < 3; ++corner) {
+                    uint32_t index = mesh.indices[t + corner];
+                    valid = valid && index < mesh.vertexCount;
+                    ids[corner] = valid ? weldedIds[firstVertex[m] + index] : 0;
+                }
+                if (!valid || ids[0] == ids[1] || ids[1] == ids[2] || ids[0] == ids[2]) {
+                    continue;   // Խ˻
+                }
+                glm::vec3 normal = glm::cross(positions[ids[1]] - positions[ids[0]], positions[ids[2]] - positions[ids[0]]);
+                float length = glm::length(normal);
+                if (!(length > 0.0f)) {
+                    continue;
+                }
+                uint32_t face = static_cast<uint32_t>(faceNormals.size());
+                faceNormals.push_back(normal / length);
+                packedNormals.push_back(packNormal(faceNormals.back()));
+                faceMeshes.push_back(static_cast<uint32_t>(m));
+                for (int edge = 0; edge < 3; ++edge) {
+                    uint32_t a = ids[edge], b = ids[(edge + 1) % 3];
+                    uint64_t key = (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+                    uses.push_back({ key, face });
+                }
+            }
+        }
+
+        // 3. СĶŷͰ (ȶ)ͬһߵгͬһͰУ
+        //    ͰڰһͰֻͨмԪ
+        std::vector<uint32_t> bucketStart(positions.size() + 1, 0);
+        for (const EdgeUse& use : uses) {
+            bucketStart[(use.key >> 32) + 1]++;
+        }
+        for (size_t i = 1; i < bucketStart.size(); ++i) {
+            bucketStart[i] += bucketStart[i - 1];
+        }
+        struct BucketEntry {
+            uint32_t other;     // ߵһ (ϴ) 
+            uint32_t face;
+        };
+        std::vector<BucketEntry> buckets(uses.size());
+        {
+            std::vector<uint32_t> cursor(bucketStart.begin(), bucketStart.end() - 1);
+            for (const EdgeUse& use : uses) {
+                buckets[cursor[use.key >> 32]++] = { static_cast<uint32_t>(use.key), use.face };
+            }
+        }
+        uses.clear();
+        uses.shrink_to_fit();
+        auto entryLess = [](const BucketEntry& x, const BucketEntry& y) {
+            return x.other != y.other ? x.other < y.other : x.face < y.face;
+        };
+        for (size_t vertex = 0; vertex + 1 < bucketStart.size(); ++vertex) {
+            // 
+            BucketEntry* begin = buckets.data() + bucketStart[vertex];
+            BucketEntry* end = buckets.data() + bucketStart[vertex + 1];
+            for (BucketEntry* i = begin + 1; i < end; ++i) {
+                BucketEntry entry = *i;
+                BucketEntry* j = i;
+                for (; j > begin && entryLess(entry, j[-1]); --j) {
+                    *j = j[-1];
+                }
+                *j = entry;
+            }
+        }
+
+        // 4. ÿ߷࣬fn(A, B, a, b, Ƿ)ҪƵı (ű߽BAͬ)
+        //    ȱһͳÿMesh߶׼ȷСٱһд
+        float creaseCos = std::cos(glm::radians(options.creaseAngle));
+        const float COPLANAR_COS = 0.9999f;
+        auto forEachLine = [&](auto&& fn, FeatureEdgeStats& counts) {
+            for (uint32_t vertex = 0; vertex + 1 < bucketStart.size(); ++vertex) {
+                const BucketEntry* end = buckets.data() + bucketStart[vertex + 1];
+                for (const BucketEntry* group = buckets.data() + bucketStart[vertex]; group < end;) {
+                    const BucketEntry* groupEnd = group + 1;
+                    while (groupEnd < end && groupEnd->other == group->other) {
+                        groupEnd++;
+                    }
+                    uint32_t first = group->face;
+                    if (groupEnd - group != 2) {
+                        // ű߽α
+                        fn(first, groupEnd - group == 1 ? first : group[1].face, vertex, group->other, true);
+                        counts.boundaries++;
+                    }
+                    else {
+                        uint32_t second = group[1].face;
+                        float cosine = glm::dot(faceNormals[first], faceNormals[second]);
+                        if (options.materialBorders && faceMeshes[first] != faceMeshes[second]) {
+                            fn(first, second, vertex, group->other, true);
+                            counts.materialBorders++;
+                        }
+                        else if (cosine < creaseCos) {
+                            fn(first, second, vertex, group->other, true);
+                            counts.creases++;
+                        }
+                        else if (options.silhouettes && cosine < COPLANAR_COS) {
+                            fn(first, second, vertex, group->other, false);
+                            counts.smoothEdges++;
+                        }
+                    }
+                    group = groupEnd;
+                }
+            }
+        };
+
+        std::vector<size_t> lineCounts(meshes.size(), 0);
+        FeatureEdgeStats ignored;
+        forEachLine([&](uint32_t faceA, uint32_t, uint32_t, uint32_t, bool) {
+            lineCounts[faceMeshes[faceA]]++;
+        }, ignored);
+        for (size_t m = 0; m < meshes.size(); ++m) {
+            out[m].reserve(lineCounts[m] * 2);
+        }
+        const uint32_t FEATURE_BIT = 1u << 30;  // w = 1
+        forEachLine([&](uint32_t faceA, uint32_t faceB, uint32_t a, uint32_t b, bool feature) {
+            uint32_t normalA = packedNormals[faceA] | (feature ? FEATURE_BIT : 0u);
+            uint32_t normalB = packedNormals[faceB];
+            std::vector<EdgeVertex>& lines = out[faceMeshes[faceA]];
+            const glm::vec3& pa = positions[a];
+            const glm::vec3& pb = positions[b];
+            lines.push_back({ { pa.x, pa.y, pa.z }, normalA, normalB });
+            lines.push_back({ { pb.x, pb.y, pb.z }, normalA, normalB });
+        }, counts);
+
+        if (stats) {
+            *stats = counts;
+        }
+    }
+}
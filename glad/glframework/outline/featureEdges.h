@@ -0,0 +1,54 @@
+#pragma once
+
+#include "../core.h"          // glm
+
+#include <cstddef>            // size_t
+#include <cstdint>            // uint32_t
+#include <vector>             // std::vector
+
+// ȡʱΪģ͵ÿMeshһ߶λڻƽ
+// -  (ǻ)нǳۺ۽ǵıߡʲͬıߡֻһĿű߽ (Լα)
+// - ⻬ (ֻ)淨߲ͬнСۺ۽ǵıߡÿߴķߣ
+//   ɶɫжǷһ泯һ汳ıGPUϲõ
+// - ıԶΪֱӶ (ǽ桢ǻڲ)
+// 㰴λúӺٽߵڽӹϵӷ졢ʷ𿪵Ķ㲻ᱻΪű߽硣
+// ֻ룬ڹ߳ϵá
+namespace outline {
+    // ߶εһ˵ (20ֽ)ÿ˵㣬GL_LINESֱӻ
+    struct EdgeVertex {
+        float position[3];          // ģͿռλ
+        uint32_t normalA;           // ķߣ10:10:10:2 зŹһwΪ1ʾ
+        uint32_t normalB;           // һķ (ű߽normalAͬ)
+    };
+    static_assert(sizeof(EdgeVertex) == 20, "EdgeVertex must stay 20 bytes");
+
+    struct FeatureEdgeOptions {
+        float creaseAngle = 30.0f;      // 淨߼нǳ˽Ƕ () ıΪۺ
+        bool materialBorders = true;    //  (Mesh) ͬıΪ
+        bool silhouettes = true;        // ⻬GPU
+    };
+
+    // һMesh (λñͬһģ͵Meshͬһռ)
+    struct SourceMesh {
+        const float* positions = nullptr;   // iλΪpositions[i * stride]ʼ3float
+        size_t stride = 3;                  // ڶfloat
+        size_t vertexCount = 0;
+        const uint32_t* indices = nullptr;
+        size_t indexCount = 0;
+    };
+
+    struct FeatureEdgeStats {
+        size_t creases = 0;
+        size_t materialBorders = 0;
+        size_t boundaries = 0;          // ű߽ͷα
+        size_t smoothEdges = 0;         // ֻƵı
+    };
+
+    // ȡһģMeshߣout[i]Ϊmeshes[i]߶ζ˵㡣
+    // Mesh֮Ĳʱֻ߽һMeshظơ
+    void extractFeatureEdges(const std::vector<SourceMesh>& meshes, const FeatureEdgeOptions& options,
+        std::vector<std::vector<EdgeVertex>>& out, FeatureEdgeStats* stats = nullptr);
+
+    // ѵλΪ10:10:10:2 зŹһwΪ-101
+    uint32_t packNormal(const glm::vec3& normal, int w = 0);
+}
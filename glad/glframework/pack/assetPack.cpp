@@ -0,0 +1,674 @@
+#include "assetPack.h"
+#include "lzCodec.h"
+#include "../model.h"
+#include "../resource/resourceManager.h"
+#include "../resource/materialCache.h"
+#include "../bake/textureBaker.h"
+#include "../upload/stagingRing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // Ƿ֧BC1-1ʾûвѯ (ԣа)
+    std::atomic<int> g_bc1Supported{ -1 };
+
+    // УCompressedTextureĿȡmipmapķΧЧʱnullptr
+    const pack::CompressedTextureHeader* parseCompressedTexture(const AssetPack::EntryData& data, std::vector<Texture::MipLevel>& mips) {
+        using namespace pack;
+        if (data.size < sizeof(CompressedTextureHeader)) {
+            return nullptr;
+        }
+        const CompressedTextureHeader* header = reinterpret_cast<const CompressedTextureHeader*>(data.data);
+        if ((header->format != TextureFormat::Rgba8 && header->format != TextureFormat::Bc1) || header->width == 0 || header->height == 0) {
+            return nullptr;
+        }
+        uint64_t offset = sizeof(CompressedTextureHeader);
+        uint32_t width = header->width, height = header->height;
+        for (uint32_t level = 0; level < header->mipCount && level < 32; ++level) {
+            uint64_t size = mipSize(header->format, width, height);
+            if (size > data.size - offset) {
+                return nullptr;
+            }
+            mips.push_back({ data.data + offset, static_cast<size_t>(size) });
+            offset += size;
+            width = width > 1 ? width / 2 : 1;
+            height = height > 1 ? height / 2 : 1;
+        }
+        return mips.empty() ? nullptr : header;
+    }
+
+    // BC1ĸmipmap𼶽ѹΪRGBA8
+    void decodeBc1Mips(const pack::CompressedTextureHeader& header, const std::vector<Texture::MipLevel>& mips, std::vector<std::vector<uint8_t>>& decoded) {
+        decoded.resize(mips.size());
+        uint32_t width = header.width, height = header.height;
+        for (size_t level = 0; level < mips.size(); ++level) {
+            decoded[level].resize(static_cast<size_t>(width) * height * 4);
+            bake::decompressBc1(mips[level].data, static_cast<int>(width), static_cast<int>(height), decoded[level].data());
+            width = width > 1 ? width / 2 : 1;
+            height = height > 1 ? height / 2 : 1;
+        }
+    }
+
+    // ģĿвʱλ (ModelCompactModelĲֲͬ)ĿΧʱnullptr
+    const pack::BakedMaterial* findMaterialTable(pack::EntryType type, const AssetPack::EntryData& data, uint32_t& count) {
+        using namespace pack;
+        uint64_t headerSize = type == EntryType::CompactModel ? sizeof(CompactModelHeader) : sizeof(BakedModelHeader);
+        if (data.size < headerSize) {
+            return nullptr;
+        }
+        // ͷĿͷmeshCountmaterialCount
+        uint32_t meshCount = reinterpret_cast<const BakedModelHeader*>(data.data)->meshCount;
+        count = reinterpret_cast<const BakedModelHeader*>(data.data)->materialCount;
+        uint64_t meshSize = type == EntryType::CompactModel ? sizeof(CompactMesh) : sizeof(BakedMesh);
+        if (headerSize + sizeof(BakedMaterial) * uint64_t(count) + meshSize * uint64_t(meshCount) > data.size) {
+            return nullptr;
+        }
+        uint64_t offset = type == EntryType::CompactModel ? headerSize + meshSize * uint64_t(meshCount) : headerSize;
+        return reinterpret_cast<const BakedMaterial*>(data.data + offset);
+    }
+
+    // ģĿиMeshLOD 0ģͿռеΣȡߺײ (ж)
+    // ModelֱָĿݣCompactModelλȻԭͳһΪ32λpositions/indices
+    struct ModelGeometry {
+        std::vector<uint32_t> meshes;               // ΧЧMeshMeshе±
+        std::vector<outline::SourceMesh> sources;   // meshesһһӦ
+        std::vector<std::vector<float>> positions;
+        std::vector<std::vector<uint32_t>> indices;
+    };
+
+    // УģĿĸÿMeshķΧռΣΧЧMeshЧʱfalse
+    bool collectGeometry(pack::EntryType type, const AssetPack::EntryData& data, ModelGeometry& geometry) {
+        using namespace pack;
+        uint32_t materialCount = 0;
+        if (findMaterialTable(type, data, materialCount) == nullptr) {
+            return false;
+        }
+        auto inRange = [&](uint64_t offset, uint64_t size) {
+            return offset <= data.size && size <= data.size - offset;
+        };
+        uint32_t meshCount = reinterpret_cast<const BakedModelHeader*>(data.data)->meshCount;
+        if (type == EntryType::Model) {
+            const BakedMesh* meshes = reinterpret_cast<const BakedMesh*>(data.data + sizeof(BakedModelHeader)
+                + sizeof(BakedMaterial) * static_cast<uint64_t>(materialCount));
+            for (uint32_t i = 0; i < meshCount; ++i) {
+                const BakedMesh& baked = meshes[i];
+                if (!inRange(baked.vertexOffset, static_cast<uint64_t>(baked.vertexCount) * 5 * sizeof(float))
+                    || !inRange(baked.indexOffset, static_cast<uint64_t>(baked.indexCount) * sizeof(unsigned int))) {
+                    continue;
+                }
+                outline::SourceMesh source;
+                source.positions = reinterpret_cast<const float*>(data.data + baked.vertexOffset);
+                source.stride = 5; // PosXYZ + UV
+                source.vertexCount = baked.vertexCount;
+                source.indices = reinterpret_cast<const uint32_t*>(data.data + baked.indexOffset);
+                source.indexCount = baked.indexCount;
+                geometry.meshes.push_back(i);
+                geometry.sources.push_back(source);
+            }
+            return true;
+        }
+
+        const CompactModelHeader* header = reinterpret_cast<const CompactModelHeader*>(data.data);
+        const CompactMesh* meshes = reinterpret_cast<const CompactMesh*>(data.data + sizeof(CompactModelHeader));
+        for (uint32_t i = 0; i < meshCount; ++i) {
+            const CompactMesh& compact = meshes[i];
+            if ((compact.indexSize != 2 && compact.indexSize != 4) || compact.lodCount > MAX_LODS
+                || !inRange(compact.vertexOffset, static_cast<uint64_t>(compact.vertexCount) * sizeof(CompactVertex))
+                || !inRange(compact.indexOffset, static_cast<uint64_t>(compact.indexCount) * compact.indexSize)) {
+                continue;
+            }
+            // [0, 1] -> ģͿռ
+            const CompactVertex* vertices = reinterpret_cast<const CompactVertex*>(data.data + compact.vertexOffset);
+            std::vector<float> positions(static_cast<size_t>(compact.vertexCount) * 3);
+            for (size_t v = 0; v < compact.vertexCount; ++v) {
+                for (int axis = 0; axis < 3; ++axis) {
+                    positions[v * 3 + axis] = header->quantizeOffset[axis] + vertices[v].position[axis] / 65535.0f * header->quantizeScale[axis];
+                }
+            }
+            size_t indexCount = static_cast<size_t>(compact.indexCount);
+            size_t lod0First = compact.lodCount == 0 ? 0 : std::min(static_cast<size_t>(compact.lods[0].firstIndex), indexCount);
+            size_t lod0Count = compact.lodCount == 0 ? indexCount : std::min(static_cast<size_t>(compact.lods[0].indexCount), indexCount - lod0First);
+            std::vector<uint32_t> indices(lod0Count);
+            const uint8_t* indexData = data.data + compact.indexOffset;
+            for (size_t k = 0; k < indices.size(); ++k) {
+                if (compact.indexSize == 2) {
+                    uint16_t index;
+                    std::memcpy(&index, indexData + (lod0First + k) * 2, sizeof(index));
+                    indices[k] = index;
+                }
+                else {
+                    std::memcpy(&indices[k], indexData + (lod0First + k) * 4, sizeof(uint32_t));
+                }
+            }
+            // ƶvectorıݵĵַSourceMeshֱָ
+            outline::SourceMesh source;
+            source.positions = positions.data();
+            source.vertexCount = compact.vertexCount;
+            source.indices = indices.data();
+            source.indexCount = indices.size();
+            geometry.meshes.push_back(i);
+            geometry.sources.push_back(source);
+            geometry.positions.push_back(std::move(positions));
+            geometry.indices.push_back(std::move(indices));
+        }
+        return true;
+    }
+
+    // ͬģͿռײ
+    std::shared_ptr<CollisionMesh> buildCollisionMesh(const std::vector<outline::SourceMesh>& sources, const glm::vec3& minCoords, const glm::vec3& maxCoords) {
+        std::vector<glm::vec3> positions;
+        std::vector<uint32_t> indices;
+        for (const outline::SourceMesh& source : sources) {
+            uint32_t base = static_cast<uint32_t>(positions.size());
+            for (size_t v = 0; v < source.vertexCount; ++v) {
+                const float* position = source.positions + v * source.stride;
+                positions.push_back(glm::vec3(position[0], position[1], position[2]));
+            }
+            for (size_t k = 0; k < source.indexCount; ++k) {
+                indices.push_back(base + source.indices[k]);
+            }
+        }
+        return Model::createCollisionMesh(positions, indices, minCoords, maxCoords);
+    }
+}
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+bool AssetPack::open(const std::string& path) {
+    close();
+    m_path = path;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "ERROR: Could not open asset pack: " << path << std::endl;
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(file, &fileSize);
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* base = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (base == nullptr) {
+        std::cerr << "ERROR: Could not map asset pack: " << path << std::endl;
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        CloseHandle(file);
+        return false;
+    }
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "ERROR: Could not open asset pack: " << path << std::endl;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        std::cerr << "ERROR: Could not stat asset pack: " << path << std::endl;
+        ::close(fd);
+        return false;
+    }
+    void* base = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // ӳ佨ļͲҪ
+    ::close(fd);
+    if (base == MAP_FAILED) {
+        std::cerr << "ERROR: Could not map asset pack: " << path << std::endl;
+        return false;
+    }
+    m_size = static_cast<size_t>(info.st_size);
+#endif
+    m_base = static_cast<const uint8_t*>(base);
+
+    if (!validate(m_size)) {
+        std::cerr << "ERROR: Invalid asset pack: " << path << std::endl;
+        close();
+        return false;
+    }
+    std::cout << "Asset pack '" << path << "' opened: " << m_entryCount << " entries, " << m_size / 1024 << " KB." << std::endl;
+    return true;
+}
+
+void AssetPack::close() {
+    if (m_base == nullptr) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(m_base);
+    CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+    CloseHandle(static_cast<HANDLE>(m_fileHandle));
+    m_mappingHandle = nullptr;
+    m_fileHandle = nullptr;
+#else
+    munmap(const_cast<uint8_t*>(m_base), m_size);
+#endif
+    m_base = nullptr;
+    m_size = 0;
+    m_toc = nullptr;
+    m_entryCount = 0;
+    m_names = nullptr;
+}
+
+bool AssetPack::validate(size_t fileSize) {
+    using namespace pack;
+    if (fileSize < sizeof(PackHeader)) {
+        return false;
+    }
+    const PackHeader* header = reinterpret_cast<const PackHeader*>(m_base);
+    if (header->magic != PACK_MAGIC || header->version != PACK_VERSION) {
+        return false;
+    }
+    if (header->tocOffset % alignof(PackEntry) != 0
+        || header->tocOffset > fileSize
+        || header->entryCount > (fileSize - header->tocOffset) / sizeof(PackEntry)
+        || header->namesOffset > fileSize
+        || header->namesSize > fileSize - header->namesOffset) {
+        return false;
+    }
+    m_toc = reinterpret_cast<const PackEntry*>(m_base + header->tocOffset);
+    m_entryCount = header->entryCount;
+    m_names = reinterpret_cast<const char*>(m_base + header->namesOffset);
+
+    // ÿĿķΧ֮ȡʱظ
+    for (size_t i = 0; i < m_entryCount; ++i) {
+        const PackEntry& entry = m_toc[i];
+        if (entry.offset > fileSize || entry.storedSize > fileSize - entry.offset
+            || static_cast<uint64_t>(entry.nameOffset) + entry.nameLength > header->namesSize) {
+            return false;
+        }
+        if (entry.compression == Compression::None && entry.storedSize != entry.rawSize) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string_view AssetPack::getName(const pack::PackEntry& entry) const {
+    return std::string_view(m_names + entry.nameOffset, entry.nameLength);
+}
+
+const pack::PackEntry* AssetPack::find(std::string_view name) const {
+    if (m_toc == nullptr) {
+        return nullptr;
+    }
+    uint64_t hash = pack::hashName(name);
+    const pack::PackEntry* end = m_toc + m_entryCount;
+    const pack::PackEntry* it = std::lower_bound(m_toc, end, hash, [](const pack::PackEntry& entry, uint64_t value) {
+        return entry.nameHash < value;
+    });
+    for (; it != end && it->nameHash == hash; ++it) {
+        if (getName(*it) == name) {
+            return it;
+        }
+    }
+    return nullptr;
+}
+
+const pack::PackEntry* AssetPack::findFirst(pack::EntryType type) const {
+    for (size_t i = 0; i < m_entryCount; ++i) {
+        if (m_toc[i].type == type) {
+            return &m_toc[i];
+        }
+    }
+    return nullptr;
+}
+
+bool AssetPack::read(const pack::PackEntry& entry, EntryData& out, std::vector<uint8_t>& scratch, bool stage) {
+    const uint8_t* stored = m_base + entry.offset;
+    if (entry.compression == pack::Compression::None) {
+        out.data = stored;
+        out.size = static_cast<size_t>(entry.storedSize);
+        out.zeroCopy = true;
+        m_stats.zeroCopyReads++;
+        return true;
+    }
+    if (entry.compression != pack::Compression::Lz) {
+        std::cerr << "ERROR: Unknown compression in asset pack entry: " << getName(entry) << std::endl;
+        return false;
+    }
+    size_t rawSize = static_cast<size_t>(entry.rawSize);
+    StagingRing::Allocation allocation;
+    if (stage) {
+        allocation = StagingRing::getInstance()->allocate(rawSize);
+    }
+    uint8_t* target = allocation ? allocation.data : nullptr;
+    if (target == nullptr) {
+        scratch.resize(rawSize);
+        target = scratch.data();
+    }
+    if (!lz::decompress(stored, static_cast<size_t>(entry.storedSize), target, rawSize)) {
+        std::cerr << "ERROR: Corrupt asset pack entry: " << getName(entry) << std::endl;
+        return false;
+    }
+    out.data = target;
+    out.size = rawSize;
+    out.zeroCopy = false;
+    out.staged = static_cast<bool>(allocation);
+    m_stats.decompressedReads++;
+    m_stats.decompressedBytes += rawSize;
+    if (out.staged) {
+        StagingRing::getInstance()->recordDecoded(rawSize);
+        m_stats.stagedReads++;
+    }
+    return true;
+}
+
+TextureHandle AssetPack::loadTexture(std::string_view name, unsigned int unit) {
+    PreparedTexture texture;
+    if (!prepareTexture(name, texture)) {
+        return TextureHandle();
+    }
+    return createTexture(name, texture, unit);
+}
+
+void AssetPack::queryDriverSupport() {
+    if (g_bc1Supported.load(std::memory_order_acquire) >= 0) {
+        return;
+    }
+    bool supported = Texture::isCompressedFormatSupported(GL_COMPRESSED_RGB_S3TC_DXT1_EXT);
+    if (!supported) {
+        std::cerr << "WARNING: BC1 textures are not supported by the driver, decompressing to RGBA8." << std::endl;
+    }
+    g_bc1Supported.store(supported ? 1 : 0, std::memory_order_release);
+}
+
+bool AssetPack::isDriverSupportKnown() {
+    return g_bc1Supported.load(std::memory_order_acquire) >= 0;
+}
+
+bool AssetPack::prepareTexture(std::string_view name, PreparedTexture& out) {
+    const pack::PackEntry* entry = find(name);
+    if (entry == nullptr || (entry->type != pack::EntryType::Texture && entry->type != pack::EntryType::CompressedTexture)) {
+        std::cerr << "ERROR: Texture not found in asset pack: " << name << std::endl;
+        return false;
+    }
+    out.type = entry->type;
+    if (!read(*entry, out.data, out.scratch)) {
+        return false;
+    }
+    // ֪֧BC1ʱ룬GLֻ߳ʣϴ
+    if (entry->type == pack::EntryType::CompressedTexture && g_bc1Supported.load(std::memory_order_acquire) == 0) {
+        std::vector<Texture::MipLevel> mips;
+        const pack::CompressedTextureHeader* header = parseCompressedTexture(out.data, mips);
+        if (header != nullptr && header->format == pack::TextureFormat::Bc1) {
+            decodeBc1Mips(*header, mips, out.decodedMips);
+        }
+    }
+    return true;
+}
+
+TextureHandle AssetPack::createTexture(std::string_view name, PreparedTexture& texture, unsigned int unit) {
+    if (texture.type == pack::EntryType::CompressedTexture) {
+        return createCompressedTexture(name, texture, unit);
+    }
+    const EntryData& data = texture.data;
+    if (data.size < sizeof(pack::BakedTextureHeader)) {
+        return TextureHandle();
+    }
+    const pack::BakedTextureHeader* header = reinterpret_cast<const pack::BakedTextureHeader*>(data.data);
+    if (header->channels != 4 || static_cast<uint64_t>(header->width) * header->height * 4 > data.size - sizeof(pack::BakedTextureHeader)) {
+        std::cerr << "ERROR: Invalid texture entry in asset pack: " << name << std::endl;
+        return TextureHandle();
+    }
+    // ֱӴӳڴ (ѹ) ϴ
+    const unsigned char* pixels = data.data + sizeof(pack::BakedTextureHeader);
+    return ResourceManager::getInstance()->create<Texture>(pixels, static_cast<int>(header->width), static_cast<int>(header->height), unit);
+}
+
+TextureHandle AssetPack::createCompressedTexture(std::string_view name, PreparedTexture& texture, unsigned int unit) {
+    using namespace pack;
+
+    // mipmapķΧ
+    std::vector<Texture::MipLevel> mips;
+    const CompressedTextureHeader* header = parseCompressedTexture(texture.data, mips);
+    if (header == nullptr) {
+        std::cerr << "ERROR: Invalid texture entry in asset pack: " << name << std::endl;
+        return TextureHandle();
+    }
+
+    ResourceManager* resourceManager = ResourceManager::getInstance();
+    int textureWidth = static_cast<int>(header->width), textureHeight = static_cast<int>(header->height);
+    if (header->format == TextureFormat::Rgba8) {
+        return resourceManager->create<Texture>(mips, textureWidth, textureHeight, GLenum(0), unit);
+    }
+
+    queryDriverSupport();
+    if (g_bc1Supported.load(std::memory_order_acquire) == 1) {
+        // ѹֱӴӳڴϴ
+        return resourceManager->create<Texture>(mips, textureWidth, textureHeight, GLenum(GL_COMPRESSED_RGB_S3TC_DXT1_EXT), unit);
+    }
+
+    // ˣϴ𼶽ѹRGBA8prepareTextureʱֻ֧δ֪Ĳѹ
+    if (texture.decodedMips.empty()) {
+        decodeBc1Mips(*header, mips, texture.decodedMips);
+    }
+    for (size_t level = 0; level < mips.size(); ++level) {
+        mips[level] = { texture.decodedMips[level].data(), texture.decodedMips[level].size() };
+    }
+    return resourceManager->create<Texture>(mips, textureWidth, textureHeight, GLenum(0), unit);
+}
+
+std::vector<MaterialHandle> AssetPack::acquireMaterials(Model* model, PreparedModel& prepared, const pack::BakedMaterial* materials, uint32_t count) {
+    const EntryData& data = prepared.data;
+    auto stringAt = [&](uint32_t offset, uint32_t length) {
+        return offset <= data.size && length <= data.size - offset
+            ? std::string_view(reinterpret_cast<const char*>(data.data) + offset, length)
+            : std::string_view();
+    };
+
+    // ʺͼͨMaterialCache淶ͼͬĲ (ģе) ͬһ
+    // ͼ "·:Ŀ" ʶʱٴӰм
+    ResourceManager* resourceManager = ResourceManager::getInstance();
+    MaterialCache* materialCache = MaterialCache::getInstance();
+    std::vector<MaterialHandle> materialHandles(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        const pack::BakedMaterial& baked = materials[i];
+        std::string_view textureName = stringAt(baked.textureNameOffset, baked.textureNameLength);
+        std::string textureKey = textureName.empty() ? std::string() : m_path + ":" + std::string(textureName);
+        std::string materialName(stringAt(baked.nameOffset, baked.nameLength));
+        materialHandles[i] = materialCache->acquire(materialName, glm::vec3(baked.Ks[0], baked.Ks[1], baked.Ks[2]), baked.opacity, textureKey,
+            [&]() {
+                auto texture = prepared.textures.find(std::string(textureName));
+                return texture != prepared.textures.end() ? createTexture(textureName, texture->second, 0) : loadTexture(textureName, 0);
+            });
+        // ģͳвʵãʻᱻaddMaterialͷţʱȵǼǵǸ
+        resourceManager->addRef(materialHandles[i]);
+        model->addMaterial(materialName, materialHandles[i]);
+    }
+    if (count == 0) {
+        model->getDefaultMaterial();
+    }
+    return materialHandles;
+}
+
+Model* AssetPack::createCompactModel(PreparedModel& prepared) {
+    using namespace pack;
+
+    std::string_view name = prepared.name;
+    const EntryData& data = prepared.data;
+
+    if (data.size < sizeof(CompactModelHeader)) {
+        return nullptr;
+    }
+    const CompactModelHeader* header = reinterpret_cast<const CompactModelHeader*>(data.data);
+    uint64_t tablesSize = sizeof(CompactModelHeader)
+        + sizeof(BakedMaterial) * static_cast<uint64_t>(header->materialCount)
+        + sizeof(CompactMesh) * static_cast<uint64_t>(header->meshCount);
+    if (tablesSize > data.size) {
+        std::cerr << "ERROR: Invalid model entry in asset pack: " << name << std::endl;
+        return nullptr;
+    }
+    const CompactMesh* meshes = reinterpret_cast<const CompactMesh*>(data.data + sizeof(CompactModelHeader));
+    const BakedMaterial* materials = reinterpret_cast<const BakedMaterial*>(meshes + header->meshCount);
+
+    ResourceManager* resourceManager = ResourceManager::getInstance();
+    Model* model = new Model(std::string(name),
+        glm::vec3(header->minCoords[0], header->minCoords[1], header->minCoords[2]),
+        glm::vec3(header->maxCoords[0], header->maxCoords[1], header->maxCoords[2]),
+        glm::dvec3(header->origin[0], header->origin[1], header->origin[2]));
+    // [0, 1] -> ģͿռ
+    glm::vec3 quantizeOffset(header->quantizeOffset[0], header->quantizeOffset[1], header->quantizeOffset[2]);
+    glm::vec3 quantizeScale(header->quantizeScale[0], header->quantizeScale[1], header->quantizeScale[2]);
+    model->setVertexTransform(glm::scale(glm::translate(glm::mat4(1.0f), quantizeOffset), quantizeScale));
+
+    std::vector<MaterialHandle> materialHandles = acquireMaterials(model, prepared, materials, header->materialCount);
+
+    // ֱӴӳڴϴMeshķΧprepareModelд
+    for (size_t k = 0; k < prepared.meshes.size(); ++k) {
+        const CompactMesh& compact = meshes[prepared.meshes[k]];
+        std::vector<Mesh::Lod> lods(compact.lodCount);
+        for (uint32_t lod = 0; lod < compact.lodCount; ++lod) {
+            lods[lod] = { compact.lods[lod].firstIndex, compact.lods[lod].indexCount, compact.lods[lod].error };
+        }
+        MaterialHandle material = compact.materialIndex < header->materialCount
+            ? materialHandles[compact.materialIndex]
+            : model->getDefaultMaterial();
+        MeshHandle handle = resourceManager->create<Mesh>(
+            reinterpret_cast<const CompactVertex*>(data.data + compact.vertexOffset), static_cast<size_t>(compact.vertexCount),
+            static_cast<const void*>(data.data + compact.indexOffset), static_cast<size_t>(compact.indexCount),
+            static_cast<size_t>(compact.indexSize), std::move(lods), material);
+        model->addMesh(handle);
+        if (Mesh* mesh = resourceManager->get(handle)) {
+            mesh->setOutline(prepared.outlines[k]);
+        }
+    }
+    model->setCollisionMesh(std::move(prepared.collisionMesh));
+
+    for (MaterialHandle material : materialHandles) {
+        resourceManager->release(material);
+    }
+    std::cout << "Compact model '" << name << "' loaded from asset pack (" << (data.zeroCopy ? "zero-copy" : data.staged ? "decompressed to staging" : "decompressed") << ")." << std::endl;
+    return model;
+}
+
+Model* AssetPack::loadModel(std::string_view name) {
+    // GL߳ͬʱѹݴMeshʱֻGPUϸ
+    PreparedModel prepared;
+    if (!prepareModel(name, prepared, true)) {
+        return nullptr;
+    }
+    return createModel(prepared);
+}
+
+bool AssetPack::prepareModel(std::string_view name, PreparedModel& out, bool stage) {
+    using namespace pack;
+
+    const PackEntry* entry = find(name);
+    if (entry == nullptr || (entry->type != EntryType::Model && entry->type != EntryType::CompactModel)) {
+        std::cerr << "ERROR: Model not found in asset pack: " << name << std::endl;
+        return false;
+    }
+    out.name = std::string(name);
+    out.type = entry->type;
+    if (!read(*entry, out.data, out.scratch, stage)) {
+        return false;
+    }
+
+    // УMeshķΧģͿռȡMesh߲ײ
+    ModelGeometry geometry;
+    if (!collectGeometry(entry->type, out.data, geometry)) {
+        std::cerr << "ERROR: Invalid model entry in asset pack: " << name << std::endl;
+        return false;
+    }
+    if (geometry.meshes.size() < reinterpret_cast<const BakedModelHeader*>(out.data.data)->meshCount) {
+        std::cerr << "ERROR: Invalid mesh in asset pack model: " << name << std::endl;
+    }
+    out.meshes = geometry.meshes;
+    outline::extractFeatureEdges(geometry.sources, outline::FeatureEdgeOptions(), out.outlines);
+    // ͷĿͷmeshCountmaterialCountͰΧ
+    const BakedModelHeader* header = reinterpret_cast<const BakedModelHeader*>(out.data.data);
+    out.collisionMesh = buildCollisionMesh(geometry.sources, glm::vec3(header->minCoords[0], header->minCoords[1], header->minCoords[2]),
+        glm::vec3(header->maxCoords[0], header->maxCoords[1], header->maxCoords[2]));
+
+    // õͼ
+    uint32_t materialCount = 0;
+    const BakedMaterial* materials = findMaterialTable(entry->type, out.data, materialCount);
+    for (uint32_t i = 0; materials != nullptr && i < materialCount; ++i) {
+        uint64_t offset = materials[i].textureNameOffset, length = materials[i].textureNameLength;
+        if (length == 0 || offset > out.data.size || length > out.data.size - offset) {
+            continue;
+        }
+        std::string textureName(reinterpret_cast<const char*>(out.data.data) + offset, static_cast<size_t>(length));
+        if (out.textures.count(textureName) == 0 && !prepareTexture(textureName, out.textures[textureName])) {
+            out.textures.erase(textureName);
+        }
+    }
+    return true;
+}
+
+Model* AssetPack::createModel(PreparedModel& prepared) {
+    using namespace pack;
+
+    if (prepared.type == EntryType::CompactModel) {
+        return createCompactModel(prepared);
+    }
+    std::string_view name = prepared.name;
+    const EntryData& data = prepared.data;
+    if (data.size < sizeof(BakedModelHeader)) {
+        return nullptr;
+    }
+
+    // УķΧ
+    const BakedModelHeader* header = reinterpret_cast<const BakedModelHeader*>(data.data);
+    uint64_t tablesSize = sizeof(BakedModelHeader)
+        + sizeof(BakedMaterial) * static_cast<uint64_t>(header->materialCount)
+        + sizeof(BakedMesh) * static_cast<uint64_t>(header->meshCount);
+    if (tablesSize > data.size) {
+        std::cerr << "ERROR: Invalid model entry in asset pack: " << name << std::endl;
+        return nullptr;
+    }
+    const BakedMaterial* materials = reinterpret_cast<const BakedMaterial*>(data.data + sizeof(BakedModelHeader));
+    const BakedMesh* meshes = reinterpret_cast<const BakedMesh*>(materials + header->materialCount);
+
+    ResourceManager* resourceManager = ResourceManager::getInstance();
+    Model* model = new Model(std::string(name),
+        glm::vec3(header->minCoords[0], header->minCoords[1], header->minCoords[2]),
+        glm::vec3(header->maxCoords[0], header->maxCoords[1], header->maxCoords[2]),
+        glm::dvec3(header->origin[0], header->origin[1], header->origin[2]));
+
+    // 1. ʺͼ
+    std::vector<MaterialHandle> materialHandles = acquireMaterials(model, prepared, materials, header->materialCount);
+
+    // 2. MeshֱӴӳڴϴΧprepareModelд
+    for (size_t k = 0; k < prepared.meshes.size(); ++k) {
+        const BakedMesh& baked = meshes[prepared.meshes[k]];
+        MaterialHandle material = baked.materialIndex < header->materialCount
+            ? materialHandles[baked.materialIndex]
+            : model->getDefaultMaterial();
+        MeshHandle handle = resourceManager->create<Mesh>(
+            reinterpret_cast<const float*>(data.data + baked.vertexOffset), baked.vertexCount,
+            reinterpret_cast<const unsigned int*>(data.data + baked.indexOffset), baked.indexCount,
+            material);
+        model->addMesh(handle);
+        if (Mesh* mesh = resourceManager->get(handle)) {
+            mesh->setOutline(prepared.outlines[k]);
+        }
+    }
+    // 3. ײ (prepareModelй)
+    model->setCollisionMesh(std::move(prepared.collisionMesh));
+    // ͷűμسеĲã֮ģͺMesh
+    for (MaterialHandle material : materialHandles) {
+        resourceManager->release(material);
+    }
+    std::cout << "Model '" << name << "' loaded from asset pack (" << (data.zeroCopy ? "zero-copy" : data.staged ? "decompressed to staging" : "decompressed") << ")." << std::endl;
+    return model;
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "packFormat.h"
+#include "../resource/handle.h" // ִͨ
+#include "../outline/featureEdges.h" // ڹ߳ȡ
+
+#include <cstdint>            // uint8_t
+#include <memory>             // std::shared_ptrײ
+#include <string>             // std::string
+#include <string_view>        // std::string_view
+#include <unordered_map>      // ڰƼ¼׼õͼ
+#include <vector>             // std::vector
+
+class Model;
+class CollisionMesh;
+
+// AssetPackڴӳ䷽ʽ򿪵Դ (packFormat.h)
+// - ʱֻȡͷĿ¼Ŀڷʱɲϵͳҳ룻
+// - ĿڰƹϣĿ¼϶ֲңϣͬʱٱȽϴ洢ƣļϵͳ
+// - δѹĿֱӷӳڴеָ룬ģͶ/شӳڴֱϴOpenGLûм俽
+// - ѹĿѹ÷ṩĻУͬʱģĿֱӽѹStagingRingĳ־ӳݴ
+//   MeshʱGPUϴݴƣϵĻ
+// - 첽ط׶ΣprepareModelڹ߳϶ȡѹģͺõͼȡߡײ
+//   createModelGLֻ߳Դ
+// джȡָʹ֮ǰ뱣ִ򿪡
+class AssetPack {
+public:
+    // һĿ
+    struct EntryData {
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+        bool zeroCopy = false;  // true: ָӳڴ棻false: ָѹ
+        bool staged = false;    // ѹλStagingRingݴ
+    };
+
+    struct Stats {
+        size_t zeroCopyReads = 0;       // 㿽ȡĿ
+        size_t decompressedReads = 0;   // ҪѹĿ
+        size_t decompressedBytes = 0;   // ѹֽ
+        size_t stagedReads = 0;         // ֱӽѹݴĿ
+    };
+
+    // prepareModel׼õһͼ
+    struct PreparedTexture {
+        pack::EntryType type = pack::EntryType::Texture;
+        EntryData data;
+        std::vector<uint8_t> scratch;
+        std::vector<std::vector<uint8_t>> decodedMips; // ֧BC1ʱѽRGBA8 mipmap
+    };
+
+    // ģ͵CPU׶εĽѹģĿõͼ (Ŀ)ȡõߺײ
+    struct PreparedModel {
+        std::string name;
+        pack::EntryType type = pack::EntryType::Model;
+        EntryData data;
+        std::vector<uint8_t> scratch;
+        std::unordered_map<std::string, PreparedTexture> textures;
+        std::vector<uint32_t> meshes;                           // ΧЧMeshMeshе±
+        std::vector<std::vector<outline::EdgeVertex>> outlines; // meshesһһӦ
+        std::shared_ptr<CollisionMesh> collisionMesh;
+    };
+
+    AssetPack() = default;
+    ~AssetPack();
+
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    // 򿪲ӳļУͷĿ¼ʧʱfalse
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return m_base != nullptr; }
+
+    // Ŀ (ϣͻʱ)ʱnullptr
+    const pack::PackEntry* find(std::string_view name) const;
+
+    // Ŀ¼˳򷵻صһָ͵Ŀʱnullptr (modelConverterɵĵģͰ)
+    const pack::PackEntry* findFirst(pack::EntryType type) const;
+
+    size_t getEntryCount() const { return m_entryCount; }
+    const pack::PackEntry& getEntry(size_t index) const { return m_toc[index]; }
+    std::string_view getName(const pack::PackEntry& entry) const;
+
+    // ȡĿݣδѹʱ㿽ѹʱѹscratchС
+    // stageΪtrueʱѹĿΪѹStagingRingݴ (ݴʱscratch)
+    // һStagingRing::commit֮ǰЧֻGL߳ʹ
+    bool read(const pack::PackEntry& entry, EntryData& out, std::vector<uint8_t>& scratch, bool stage = false);
+
+    // ӰмԤõģ (EntryType::ModelCompactModel)GLԴGL̵߳á
+    // ͨMaterialCacheģ͹õͼͬһмأѾعͼظ
+    // CompactModelģ͵Ķ任ԭMeshLODʧʱnullptr
+    // ȼprepareModel(name, prepared, true) + createModel(prepared)
+    Model* loadModel(std::string_view name);
+
+    // ģ͵CPU׶ΣȡѹģĿĲõͼ֧BC1ʱ (queryDriverSupport)
+    // ͬʱBC1ͼΪRGBA8Meshߺģ͵ײҲɡstageΪfalseʱʹStagingRing̵߳ (ͬһܲʹ)
+    // еͼcreateModelʱʹãǰѹΪGL߳ϲκνѹ
+    bool prepareModel(std::string_view name, PreparedModel& out, bool stage = false);
+
+    // ģ͵GL׶ΣprepareModelĽģͣGL̵߳áʧʱnullptr
+    Model* createModel(PreparedModel& prepared);
+
+    // ӰмGL̵߳áʧʱؿվ
+    // - EntryType::Texture: ԤRGBA8mipmap
+    // - EntryType::CompressedTexture: Ԥɵmipmap֧BC1ʱѹΪRGBA8ϴ
+    TextureHandle loadTexture(std::string_view name, unsigned int unit = 0);
+
+    // ѯǷ֧BC1 (ȫֹ)GL̵߳ãѯ֮prepareModelŻڹ߳ϽBC1ͼ
+    static void queryDriverSupport();
+    static bool isDriverSupportKnown();
+
+    const Stats& getStats() const { return m_stats; }
+
+private:
+    bool validate(size_t fileSize);
+
+    // ģ͵Ĳʱ (ModelCompactModel)صľһãɵ÷ͷţ
+    // ͼʹprepared׼õ
+    std::vector<MaterialHandle> acquireMaterials(Model* model, PreparedModel& prepared, const pack::BakedMaterial* materials, uint32_t count);
+
+    Model* createCompactModel(PreparedModel& prepared);
+
+    // ȡ (Ҫʱ) һͼGL
+    bool prepareTexture(std::string_view name, PreparedTexture& out);
+    TextureHandle createTexture(std::string_view name, PreparedTexture& texture, unsigned int unit);
+    TextureHandle createCompressedTexture(std::string_view name, PreparedTexture& texture, unsigned int unit);
+
+private:
+    std::string m_path;
+    const uint8_t* m_base = nullptr;    // ӳʼַ
+    size_t m_size = 0;
+    const pack::PackEntry* m_toc = nullptr;
+    size_t m_entryCount = 0;
+    const char* m_names = nullptr;
+    Stats m_stats;
+
+#ifdef _WIN32
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+#endif
+};
@@ -0,0 +1,160 @@
+#include "lzCodec.h"
+
+#include <cstring>
+
+namespace {
+    constexpr size_t MIN_MATCH = 4;
+    constexpr size_t MAX_OFFSET = 65535;
+    constexpr int HASH_BITS = 16;
+    // ĩβֽ֤ƥչʱԽȡ
+    constexpr size_t END_LITERALS = 5;
+    constexpr uint32_t EMPTY_SLOT = 0xFFFFFFFFu;
+
+    uint32_t read32(const uint8_t* p) {
+        uint32_t value;
+        memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    uint32_t hash4(uint32_t sequence) {
+        return (sequence * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    // дչȣÿ255ۼӣһֽС255
+    void writeLength(std::vector<uint8_t>& out, size_t length) {
+        while (length >= 255) {
+            out.push_back(255);
+            length -= 255;
+        }
+        out.push_back(static_cast<uint8_t>(length));
+    }
+
+    void writeSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literalLength, size_t offset, size_t matchLength) {
+        size_t matchCode = matchLength >= MIN_MATCH ? matchLength - MIN_MATCH : 0;
+        uint8_t token = static_cast<uint8_t>((literalLength < 15 ? literalLength : 15) << 4);
+        if (matchLength >= MIN_MATCH) {
+            token |= static_cast<uint8_t>(matchCode < 15 ? matchCode : 15);
+        }
+        out.push_back(token);
+        if (literalLength >= 15) {
+            writeLength(out, literalLength - 15);
+        }
+        out.insert(out.end(), literals, literals + literalLength);
+
+        if (matchLength < MIN_MATCH) {
+            return; // һֻ
+        }
+        out.push_back(static_cast<uint8_t>(offset & 0xFF));
+        out.push_back(static_cast<uint8_t>(offset >> 8));
+        if (matchCode >= 15) {
+            writeLength(out, matchCode - 15);
+        }
+    }
+
+    // ȡչȣԽʱfalse
+    bool readLength(const uint8_t*& ip, const uint8_t* end, size_t& length) {
+        uint8_t byte;
+        do {
+            if (ip >= end) {
+                return false;
+            }
+            byte = *ip++;
+            length += byte;
+        } while (byte == 255);
+        return true;
+    }
+}
+
+namespace lz {
+
+    size_t compress(const uint8_t* src, size_t size, std::vector<uint8_t>& out) {
+        size_t startSize = out.size();
+        out.reserve(out.size() + size + size / 255 + 16);
+
+        std::vector<uint32_t> table(size_t(1) << HASH_BITS, EMPTY_SLOT);
+        size_t anchor = 0;
+        size_t i = 0;
+        while (size >= END_LITERALS + MIN_MATCH && i + MIN_MATCH + END_LITERALS <= size) {
+            uint32_t sequence = read32(src + i);
+            uint32_t& slot = table[hash4(sequence)];
+            size_t candidate = slot;
+            slot = static_cast<uint32_t>(i);
+
+            if (candidate == EMPTY_SLOT || i - candidate > MAX_OFFSET || read32(src + candidate) != sequence) {
+                ++i;
+                continue;
+            }
+
+            // չƥ
+            size_t matchLength = MIN_MATCH;
+            size_t limit = size - END_LITERALS;
+            while (i + matchLength < limit && src[candidate + matchLength] == src[i + matchLength]) {
+                ++matchLength;
+            }
+
+            writeSequence(out, src + anchor, i - anchor, i - candidate, matchLength);
+            i += matchLength;
+            anchor = i;
+        }
+        writeSequence(out, src + anchor, size - anchor, 0, 0);
+        return out.size() - startSize;
+    }
+
+    bool decompress(const uint8_t* src, size_t size, uint8_t* dst, size_t rawSize) {
+        const uint8_t* ip = src;
+        const uint8_t* end = src + size;
+        uint8_t* op = dst;
+        uint8_t* outEnd = dst + rawSize;
+
+        while (ip < end) {
+            uint8_t token = *ip++;
+
+            // 
+            size_t literalLength = token >> 4;
+            if (literalLength == 15 && !readLength(ip, end, literalLength)) {
+                return false;
+            }
+            if (literalLength > static_cast<size_t>(end - ip) || literalLength > static_cast<size_t>(outEnd - op)) {
+                return false;
+            }
+            memcpy(op, ip, literalLength);
+            ip += literalLength;
+            op += literalLength;
+
+            if (ip == end) {
+                break; // һ
+            }
+
+            // ƥ
+            if (end - ip < 2) {
+                return false;
+            }
+            size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+            ip += 2;
+            if (offset == 0 || offset > static_cast<size_t>(op - dst)) {
+                return false;
+            }
+            size_t matchLength = token & 15;
+            if (matchLength == 15 && !readLength(ip, end, matchLength)) {
+                return false;
+            }
+            matchLength += MIN_MATCH;
+            if (matchLength > static_cast<size_t>(outEnd - op)) {
+                return false;
+            }
+
+            const uint8_t* match = op - offset;
+            if (offset >= matchLength) {
+                memcpy(op, match, matchLength);
+                op += matchLength;
+            }
+            else {
+                // ԴĿص (ظģʽ)ֽڸ
+                for (size_t k = 0; k < matchLength; ++k) {
+                    *op++ = *match++;
+                }
+            }
+        }
+        return op == outEnd;
+    }
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>            // uint8_t
+#include <cstddef>            // size_t
+#include <vector>             // std::vector
+
+// 򵥵LZ77ֽѹ (LZ4ʽͬб)
+// ÿУ
+//   token (4λ: , 4λ: ƥ䳤-4)һΪ15ʱչֽ (ÿ255ۼӣֱС255)
+//   
+//   2ֽСƥƫ (1..65535)һֻûƥ
+// ѹٶԶڴ̶ȡٶȣѹʶ/һ1.5~3
+namespace lz {
+
+    // ѹsrc׷ӵoutĩβѹֽ
+    size_t compress(const uint8_t* src, size_t size, std::vector<uint8_t>& out);
+
+    // ѹdstdstrawSizeֽڣ𻵻Сʱfalse
+    bool decompress(const uint8_t* src, size_t size, uint8_t* dst, size_t rawSize);
+}
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <cstdint>            // ڹ̶
+#include <cstddef>            // size_t
+#include <string_view>        // std::string_view
+
+// Դ (.pak) ļʽ
+// ֵΪСнṹֶֻΣֱӴڴӳжȡ
+//
+//   [PackHeader]
+//   [ݿ ...]          ÿĿݣʼλðPACK_ALIGNMENT
+//   [PackEntry * N]       Ŀ¼ (TOC)nameHashУʼλðPACK_ALIGNMENT
+//   [ַ]        Ŀδţ'\0'β
+//
+// ĿڴĿ¼·ͳһʹ'/'ָ ( "buildings/a/lod3.obj")
+// ĿݿԭʼļҲԤȴõģ/ (·Baked*ṹ)
+// δѹĿֱӰӳڴ潻OpenGLκм俽
+
+namespace pack {
+
+    constexpr uint32_t PACK_MAGIC = 0x4B415047;   // "GPAK"
+    constexpr uint32_t PACK_VERSION = 3;        // 2: BakedMaterialӲ͸ȣ3: ģͷԭʼԭ
+    constexpr uint64_t PACK_ALIGNMENT = 64;       // ݿĿ¼Ķ ()
+
+    enum class EntryType : uint32_t {
+        Raw = 0,        // ԭʼļ
+        Model = 1,      // Ԥõģ (BakedModelHeader)
+        Texture = 2,    // ԤRGBA8 (BakedTextureHeader)
+        CompactModel = 3,       // tools/modelConverterŻģ (CompactModelHeader)
+        CompressedTexture = 4   // mipmapѹʽ (CompressedTextureHeader)
+    };
+
+    enum class Compression : uint32_t {
+        None = 0,
+        Lz = 1          // lzCodec.h
+    };
+
+    struct PackHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t entryCount;
+        uint32_t reserved;
+        uint64_t tocOffset;         // Ŀ¼ļƫ
+        uint64_t namesOffset;       // ַļƫ
+        uint64_t namesSize;
+    };
+
+    struct PackEntry {
+        uint64_t nameHash;          // ƵFNV-1aϣڶֲ
+        uint32_t nameOffset;        // ַеƫ
+        uint32_t nameLength;
+        EntryType type;
+        Compression compression;
+        uint64_t offset;            // ݵļƫ
+        uint64_t storedSize;        // ļдŵֽ (ѹ)
+        uint64_t rawSize;           // ѹֽ
+    };
+
+    // --- EntryType::Model ݲ ---
+    //   [BakedModelHeader]
+    //   [BakedMaterial * materialCount]
+    //   [BakedMesh * meshCount]
+    //   [ַ]
+    //   [MeshĶ/ݣ16ֽڶ]
+    // ƫƶڸĿݵʼλá
+
+    constexpr uint32_t NO_MATERIAL = 0xFFFFFFFFu;
+
+    struct BakedModelHeader {
+        uint32_t meshCount;
+        uint32_t materialCount;
+        float minCoords[3];         // ԭʼ (ȥorigin) µı߽
+        float maxCoords[3];
+        double origin[3];           // ʱԭʼмȥԭ (ModelData::origin)
+    };
+
+    struct BakedMaterial {
+        uint32_t nameOffset;
+        uint32_t nameLength;
+        float Ks[3];
+        uint32_t textureNameOffset; // ͼڰеĿƣΪ0ʾûͼ
+        uint32_t textureNameLength;
+        float opacity;              // ͸ (MTLеd)
+        uint32_t reserved;
+    };
+
+    struct BakedMesh {
+        uint32_t materialIndex;     // NO_MATERIALʾʹĬϲ
+        uint32_t vertexCount;       // ÿ5float (PosXYZ + UV)
+        uint32_t indexCount;
+        uint32_t reserved;
+        uint64_t vertexOffset;
+        uint64_t indexOffset;
+    };
+
+    // --- EntryType::Texture ݲ ---
+    //   [BakedTextureHeader]
+    //   [width * height * 4 ֽRGBA8أѰOpenGLϰ߷תy]
+
+    struct BakedTextureHeader {
+        uint32_t width;
+        uint32_t height;
+        uint32_t channels;          // Ŀǰ4
+        uint32_t reserved;
+    };
+
+    // --- EntryType::CompactModel ݲ ---
+    //   [CompactModelHeader]
+    //   [CompactMesh * meshCount]         (ͷ֮󣬱֤8ֽڶ)
+    //   [BakedMaterial * materialCount]   (EntryType::Modelͬ)
+    //   [ַ]
+    //   [MeshĶ/ݣ16ֽڶ]
+    // ΪCompactVertex (16ֽ)
+    //   λãģ͵Χڹһuint16pos = quantizeOffset + q / 65535 * quantizeScale
+    //         (ģͿռ䣬EntryType::ModelһĻͱ׼)
+    //   ߣGL_INT_2_10_10_10_REVһ
+    //   UVhalf float
+    // indexSizeΪ24ֽڡһMeshLODͬһ飬
+    // LOD iΪ [lods[i].firstIndex, lods[i].firstIndex + lods[i].indexCount)LOD 0Ϊȡ
+    // Ѿ㻺/ȻŻУ㰴״ʹõ˳С
+
+    constexpr uint32_t MAX_LODS = 4;
+
+    struct CompactModelHeader {
+        uint32_t meshCount;
+        uint32_t materialCount;
+        float minCoords[3];         // ԭʼ (ȥorigin) µı߽
+        float maxCoords[3];
+        float quantizeOffset[3];    // λõΧ (ģͿռ)
+        float quantizeScale[3];
+        double origin[3];           // ʱԭʼмȥԭ (ModelData::origin)
+    };
+
+    struct CompactVertex {
+        uint16_t position[4];       // xyz + 
+        uint32_t normal;            // 10:10:10:2 зŹһ
+        uint16_t texCoord[2];       // half float
+    };
+    static_assert(sizeof(CompactVertex) == 16, "CompactVertex must stay 16 bytes");
+
+    struct CompactLod {
+        uint32_t firstIndex;
+        uint32_t indexCount;
+        float error;                // LOD 0ļ (ģͿռ)
+        uint32_t reserved;
+    };
+
+    static_assert(sizeof(CompactModelHeader) % 8 == 0, "CompactMesh table must stay 8-byte aligned");
+
+    struct CompactMesh {
+        uint32_t materialIndex;     // NO_MATERIALʾʹĬϲ
+        uint32_t vertexCount;
+        uint32_t indexCount;        // LOD
+        uint32_t indexSize;         // 2 (vertexCount <= 65536)  4
+        uint32_t lodCount;          // 1..MAX_LODS
+        uint32_t reserved;
+        uint64_t vertexOffset;
+        uint64_t indexOffset;
+        CompactLod lods[MAX_LODS];
+    };
+
+    // --- EntryType::CompressedTexture ݲ ---
+    //   [CompressedTextureHeader]
+    //   [mip 0][mip 1]...[mip mipCount-1]   νУÿСmipSize()ѰOpenGLϰ߷תy
+
+    enum class TextureFormat : uint32_t {
+        Rgba8 = 0,      // δѹ (͸ͼ)
+        Bc1 = 1         // BC1/DXT1ÿ4x48ֽڣ͸
+    };
+
+    struct CompressedTextureHeader {
+        uint32_t width;
+        uint32_t height;
+        TextureFormat format;
+        uint32_t mipCount;
+    };
+
+    inline uint64_t mipSize(TextureFormat format, uint32_t width, uint32_t height) {
+        if (format == TextureFormat::Bc1) {
+            return static_cast<uint64_t>((width + 3) / 4) * ((height + 3) / 4) * 8;
+        }
+        return static_cast<uint64_t>(width) * height * 4;
+    }
+
+    // ĿƵĹϣ
+    inline uint64_t hashName(std::string_view name) {
+        uint64_t hash = 1469598103934665603ull;
+        for (char c : name) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    inline uint64_t alignUp(uint64_t value, uint64_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+}
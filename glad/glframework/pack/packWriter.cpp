@@ -0,0 +1,390 @@
+#include "packWriter.h"
+#include "lzCodec.h"
+#include "../job/jobSystem.h"
+#include "../bake/meshBaker.h"
+#include "../bake/textureBaker.h"
+#include "../spatial/spaceFillingCurve.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+
+namespace {
+    // Ҫĩβ0
+    void padTo(std::vector<uint8_t>& out, uint64_t alignment) {
+        out.resize(static_cast<size_t>(pack::alignUp(out.size(), alignment)), 0);
+    }
+
+    // ַƺͼĿδ (ModelCompactModel)
+    std::string buildMaterialStrings(const std::vector<MaterialData>& materials) {
+        std::string strings;
+        for (const MaterialData& material : materials) {
+            strings += material.name;
+            strings += material.diffuseTexturePath;
+        }
+        return strings;
+    }
+
+    // дʱַַλĿݵstringsOffset
+    void writeMaterialTable(std::vector<uint8_t>& out, uint64_t tableOffset, uint64_t stringsOffset, const std::vector<MaterialData>& materials) {
+        pack::BakedMaterial* bakedMaterials = reinterpret_cast<pack::BakedMaterial*>(out.data() + tableOffset);
+        uint64_t offset = stringsOffset;
+        for (size_t i = 0; i < materials.size(); ++i) {
+            pack::BakedMaterial& baked = bakedMaterials[i];
+            baked.nameOffset = static_cast<uint32_t>(offset);
+            baked.nameLength = static_cast<uint32_t>(materials[i].name.size());
+            offset += baked.nameLength;
+            baked.Ks[0] = materials[i].Ks.x;
+            baked.Ks[1] = materials[i].Ks.y;
+            baked.Ks[2] = materials[i].Ks.z;
+            baked.opacity = materials[i].opacity;
+            baked.textureNameOffset = static_cast<uint32_t>(offset);
+            baked.textureNameLength = static_cast<uint32_t>(materials[i].diffuseTexturePath.size());
+            offset += baked.textureNameLength;
+        }
+        std::string strings = buildMaterialStrings(materials);
+        memcpy(out.data() + stringsOffset, strings.data(), strings.size());
+    }
+
+    // ģĿ (Model/CompactModel) İΧ (ԭʼ) ͲõͼĿƣĿfalse
+    bool readModelPlacement(pack::EntryType type, const std::vector<uint8_t>& data, glm::vec3& center, std::vector<std::string>& textures) {
+        using namespace pack;
+        const float* minCoords = nullptr;
+        const float* maxCoords = nullptr;
+        const double* origin = nullptr;
+        uint64_t materialsOffset = 0;
+        uint32_t materialCount = 0;
+        if (type == EntryType::Model && data.size() >= sizeof(BakedModelHeader)) {
+            const BakedModelHeader* header = reinterpret_cast<const BakedModelHeader*>(data.data());
+            minCoords = header->minCoords;
+            maxCoords = header->maxCoords;
+            origin = header->origin;
+            materialsOffset = sizeof(BakedModelHeader);
+            materialCount = header->materialCount;
+        }
+        else if (type == EntryType::CompactModel && data.size() >= sizeof(CompactModelHeader)) {
+            const CompactModelHeader* header = reinterpret_cast<const CompactModelHeader*>(data.data());
+            minCoords = header->minCoords;
+            maxCoords = header->maxCoords;
+            origin = header->origin;
+            materialsOffset = sizeof(CompactModelHeader) + sizeof(CompactMesh) * uint64_t(header->meshCount);
+            materialCount = header->materialCount;
+        }
+        else {
+            return false;
+        }
+        center = (glm::vec3(minCoords[0], minCoords[1], minCoords[2]) + glm::vec3(maxCoords[0], maxCoords[1], maxCoords[2])) * 0.5f;
+        center = glm::vec3(glm::dvec3(center) + glm::dvec3(origin[0], origin[1], origin[2]));
+        if (materialsOffset + sizeof(BakedMaterial) * uint64_t(materialCount) > data.size()) {
+            return true;
+        }
+        const BakedMaterial* materials = reinterpret_cast<const BakedMaterial*>(data.data() + materialsOffset);
+        for (uint32_t m = 0; m < materialCount; ++m) {
+            uint64_t end = uint64_t(materials[m].textureNameOffset) + materials[m].textureNameLength;
+            if (materials[m].textureNameLength > 0 && end <= data.size()) {
+                textures.emplace_back(reinterpret_cast<const char*>(data.data() + materials[m].textureNameOffset), materials[m].textureNameLength);
+            }
+        }
+        return true;
+    }
+
+    uint32_t findMaterialIndex(const std::vector<MaterialData>& materials, const std::string& name) {
+        for (size_t m = 0; m < materials.size(); ++m) {
+            if (materials[m].name == name) {
+                return static_cast<uint32_t>(m);
+            }
+        }
+        return pack::NO_MATERIAL;
+    }
+}
+
+PackWriter::PackWriter(bool compress)
+    : m_compress(compress)
+{
+}
+
+bool PackWriter::addEntry(const std::string& name, pack::EntryType type, std::vector<uint8_t> data) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_names.insert(name).second) {
+        std::cerr << "WARNING: Duplicate pack entry ignored: " << name << std::endl;
+        return false;
+    }
+    m_entries.push_back({ name, type, std::move(data), {} });
+    return true;
+}
+
+std::vector<uint8_t> PackWriter::bakeModel(const ModelData& model, const std::vector<MaterialData>& materials) {
+    using namespace pack;
+
+    // 1. ͷʱַ
+    std::string strings = buildMaterialStrings(materials);
+    size_t headerSize = sizeof(BakedModelHeader)
+        + sizeof(BakedMaterial) * materials.size()
+        + sizeof(BakedMesh) * model.meshes.size();
+    uint64_t stringsOffset = headerSize;
+    uint64_t dataOffset = alignUp(stringsOffset + strings.size(), 16);
+
+    std::vector<uint8_t> out;
+    out.reserve(static_cast<size_t>(dataOffset));
+    out.resize(static_cast<size_t>(dataOffset), 0);
+
+    BakedModelHeader* header = reinterpret_cast<BakedModelHeader*>(out.data());
+    header->meshCount = static_cast<uint32_t>(model.meshes.size());
+    header->materialCount = static_cast<uint32_t>(materials.size());
+    for (int axis = 0; axis < 3; ++axis) {
+        header->minCoords[axis] = model.minCoords[axis];
+        header->maxCoords[axis] = model.maxCoords[axis];
+        header->origin[axis] = model.origin[axis];
+    }
+
+    // 2. ʱ
+    writeMaterialTable(out, sizeof(BakedModelHeader), stringsOffset, materials);
+
+    // 3. MeshͶ/
+    std::vector<BakedMesh> bakedMeshes(model.meshes.size());
+    for (size_t i = 0; i < model.meshes.size(); ++i) {
+        const MeshData& mesh = model.meshes[i];
+        BakedMesh& baked = bakedMeshes[i];
+        baked.materialIndex = findMaterialIndex(materials, mesh.materialName);
+        baked.vertexCount = static_cast<uint32_t>(mesh.vertices.size() / 5);
+        baked.indexCount = static_cast<uint32_t>(mesh.indices.size());
+
+        padTo(out, 16);
+        baked.vertexOffset = out.size();
+        out.insert(out.end(), reinterpret_cast<const uint8_t*>(mesh.vertices.data()),
+            reinterpret_cast<const uint8_t*>(mesh.vertices.data() + mesh.vertices.size()));
+        padTo(out, 16);
+        baked.indexOffset = out.size();
+        out.insert(out.end(), reinterpret_cast<const uint8_t*>(mesh.indices.data()),
+            reinterpret_cast<const uint8_t*>(mesh.indices.data() + mesh.indices.size()));
+    }
+    // outѾ·䣬дMesh
+    memcpy(out.data() + sizeof(BakedModelHeader) + sizeof(BakedMaterial) * materials.size(),
+        bakedMeshes.data(), sizeof(BakedMesh) * bakedMeshes.size());
+    return out;
+}
+
+std::vector<uint8_t> PackWriter::bakeCompactModel(const bake::CompactModelData& model, const std::vector<MaterialData>& materials) {
+    using namespace pack;
+
+    // 1. ͷʱַ (bakeModelͬ)
+    std::string strings = buildMaterialStrings(materials);
+    size_t headerSize = sizeof(CompactModelHeader)
+        + sizeof(BakedMaterial) * materials.size()
+        + sizeof(CompactMesh) * model.meshes.size();
+    uint64_t stringsOffset = headerSize;
+    uint64_t dataOffset = alignUp(stringsOffset + strings.size(), 16);
+
+    std::vector<uint8_t> out;
+    out.resize(static_cast<size_t>(dataOffset), 0);
+
+    CompactModelHeader* header = reinterpret_cast<CompactModelHeader*>(out.data());
+    header->meshCount = static_cast<uint32_t>(model.meshes.size());
+    header->materialCount = static_cast<uint32_t>(materials.size());
+    for (int axis = 0; axis < 3; ++axis) {
+        header->minCoords[axis] = model.minCoords[axis];
+        header->maxCoords[axis] = model.maxCoords[axis];
+        header->quantizeOffset[axis] = model.quantizeOffset[axis];
+        header->quantizeScale[axis] = model.quantizeScale[axis];
+        header->origin[axis] = model.origin[axis];
+    }
+    writeMaterialTable(out, sizeof(CompactModelHeader) + sizeof(CompactMesh) * model.meshes.size(), stringsOffset, materials);
+
+    // 2. MeshͶ/ݣ㲻65536ʱΪ16λ
+    std::vector<CompactMesh> compactMeshes(model.meshes.size());
+    for (size_t i = 0; i < model.meshes.size(); ++i) {
+        const bake::CompactMeshData& mesh = model.meshes[i];
+        CompactMesh& compact = compactMeshes[i];
+        compact.materialIndex = findMaterialIndex(materials, mesh.materialName);
+        compact.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+        compact.indexCount = static_cast<uint32_t>(mesh.indices.size());
+        compact.indexSize = mesh.vertices.size() <= 65536 ? 2 : 4;
+        compact.lodCount = static_cast<uint32_t>(std::min<size_t>(mesh.lods.size(), MAX_LODS));
+        for (uint32_t lod = 0; lod < compact.lodCount; ++lod) {
+            compact.lods[lod].firstIndex = mesh.lods[lod].firstIndex;
+            compact.lods[lod].indexCount = mesh.lods[lod].indexCount;
+            compact.lods[lod].error = mesh.lods[lod].error;
+        }
+
+        padTo(out, 16);
+        compact.vertexOffset = out.size();
+        out.insert(out.end(), reinterpret_cast<const uint8_t*>(mesh.vertices.data()),
+            reinterpret_cast<const uint8_t*>(mesh.vertices.data() + mesh.vertices.size()));
+        padTo(out, 16);
+        compact.indexOffset = out.size();
+        if (compact.indexSize == 2) {
+            for (uint32_t index : mesh.indices) {
+                uint16_t shortIndex = static_cast<uint16_t>(index);
+                out.insert(out.end(), reinterpret_cast<const uint8_t*>(&shortIndex), reinterpret_cast<const uint8_t*>(&shortIndex + 1));
+            }
+        }
+        else {
+            out.insert(out.end(), reinterpret_cast<const uint8_t*>(mesh.indices.data()),
+                reinterpret_cast<const uint8_t*>(mesh.indices.data() + mesh.indices.size()));
+        }
+    }
+    memcpy(out.data() + sizeof(CompactModelHeader), compactMeshes.data(), sizeof(CompactMesh) * compactMeshes.size());
+    return out;
+}
+
+std::vector<uint8_t> PackWriter::bakeCompressedTexture(const bake::BakedTexture& texture) {
+    pack::CompressedTextureHeader header{};
+    header.width = texture.width;
+    header.height = texture.height;
+    header.format = texture.format;
+    header.mipCount = texture.mipCount;
+    std::vector<uint8_t> out(sizeof(header));
+    std::memcpy(out.data(), &header, sizeof header);
+    out.insert(out.end(), texture.data.begin(), texture.data.end());
+    return out;
+}
+
+std::vector<uint8_t> PackWriter::bakeTexture(const ImageData& image) {
+    pack::BakedTextureHeader header{};
+    header.width = static_cast<uint32_t>(image.width);
+    header.height = static_cast<uint32_t>(image.height);
+    header.channels = 4;
+    std::vector<uint8_t> out(sizeof(header));
+    std::memcpy(out.data(), &header, sizeof header);
+    out.insert(out.end(), image.pixels.begin(), image.pixels.end());
+    return out;
+}
+
+std::vector<size_t> PackWriter::computeLayout() const {
+    // ĿǲӵģȰ򣬱֤ͬͬİ
+    std::vector<size_t> byName(m_entries.size());
+    for (size_t i = 0; i < byName.size(); ++i) {
+        byName[i] = i;
+    }
+    std::sort(byName.begin(), byName.end(), [&](size_t a, size_t b) { return m_entries[a].name < m_entries[b].name; });
+    std::unordered_map<std::string, size_t> nameToEntry;
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        nameToEntry.emplace(m_entries[i].name, i);
+    }
+
+    // ģͰΧĵHilbert˳Уÿģõͼڵһģ֮
+    std::vector<size_t> models;
+    std::vector<glm::vec3> centers;
+    std::vector<std::vector<std::string>> textures;
+    for (size_t entry : byName) {
+        glm::vec3 center;
+        std::vector<std::string> modelTextures;
+        if (readModelPlacement(m_entries[entry].type, m_entries[entry].data, center, modelTextures)) {
+            models.push_back(entry);
+            centers.push_back(center);
+            textures.push_back(std::move(modelTextures));
+        }
+    }
+
+    std::vector<size_t> layout;
+    layout.reserve(m_entries.size());
+    std::vector<bool> placed(m_entries.size(), false);
+    auto place = [&](size_t entry) {
+        if (!placed[entry]) {
+            placed[entry] = true;
+            layout.push_back(entry);
+        }
+    };
+    for (uint32_t model : spatial::curveOrder(centers, spatial::Curve::Hilbert)) {
+        place(models[model]);
+        for (const std::string& texture : textures[model]) {
+            auto it = nameToEntry.find(texture);
+            if (it != nameToEntry.end()) {
+                place(it->second);
+            }
+        }
+    }
+    // Ŀ (MTLɫûбģõͼƬ) Ʒ
+    for (size_t entry : byName) {
+        place(entry);
+    }
+    return layout;
+}
+
+bool PackWriter::write(const std::string& path) {
+    using namespace pack;
+
+    // 1. ѹĿн
+    if (m_compress) {
+        JobSystem::getInstance()->parallelFor(0, m_entries.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                PendingEntry& entry = m_entries[i];
+                lz::compress(entry.data.data(), entry.data.size(), entry.compressed);
+                // ѹ̫Сʱδѹʱ㿽
+                if (entry.compressed.size() > entry.data.size() / 8 * 7) {
+                    entry.compressed.clear();
+                    entry.compressed.shrink_to_fit();
+                }
+            }
+        }, 1);
+    }
+
+    // 2. ֣ͷݿ (computeLayout˳)Ŀ¼
+    std::vector<size_t> layout = computeLayout();
+    std::vector<PackEntry> toc(m_entries.size());
+    std::string names;
+    uint64_t offset = alignUp(sizeof(PackHeader), PACK_ALIGNMENT);
+    for (size_t i : layout) {
+        const PendingEntry& pending = m_entries[i];
+        PackEntry& entry = toc[i];
+        entry.nameHash = hashName(pending.name);
+        entry.nameOffset = static_cast<uint32_t>(names.size());
+        entry.nameLength = static_cast<uint32_t>(pending.name.size());
+        entry.type = pending.type;
+        entry.compression = pending.compressed.empty() ? Compression::None : Compression::Lz;
+        entry.offset = offset;
+        entry.storedSize = pending.compressed.empty() ? pending.data.size() : pending.compressed.size();
+        entry.rawSize = pending.data.size();
+        names += pending.name;
+        offset = alignUp(offset + entry.storedSize, PACK_ALIGNMENT);
+    }
+
+    PackHeader header = {};
+    header.magic = PACK_MAGIC;
+    header.version = PACK_VERSION;
+    header.entryCount = static_cast<uint32_t>(toc.size());
+    header.tocOffset = offset;
+    header.namesOffset = offset + sizeof(PackEntry) * toc.size();
+    header.namesSize = names.size();
+
+    // Ŀ¼ƹϣʱֲҡ
+    // ϣͻĿһAssetPack::findȽϴ洢 (ƱaddEntryȥ)
+    std::vector<PackEntry> sortedToc = toc;
+    std::sort(sortedToc.begin(), sortedToc.end(), [](const PackEntry& a, const PackEntry& b) {
+        return a.nameHash < b.nameHash;
+    });
+
+    // 3. д
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "ERROR: Could not create pack file: " << path << std::endl;
+        return false;
+    }
+    static const char zeros[PACK_ALIGNMENT] = {};
+    uint64_t written = 0;
+    auto writeBytes = [&](const void* data, uint64_t size) {
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        written += size;
+    };
+    auto padFile = [&](uint64_t target) {
+        writeBytes(zeros, target - written);
+    };
+
+    writeBytes(&header, sizeof(header));
+    for (size_t i : layout) {
+        padFile(toc[i].offset);
+        const std::vector<uint8_t>& stored = m_entries[i].compressed.empty() ? m_entries[i].data : m_entries[i].compressed;
+        writeBytes(stored.data(), stored.size());
+    }
+    padFile(header.tocOffset);
+    writeBytes(sortedToc.data(), sizeof(PackEntry) * sortedToc.size());
+    writeBytes(names.data(), names.size());
+
+    if (!file) {
+        std::cerr << "ERROR: Failed to write pack file: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
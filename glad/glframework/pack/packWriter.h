@@ -0,0 +1,64 @@
+#pragma once
+
+#include "packFormat.h"
+#include "../model.h"         // ModelData
+#include "../material.h"      // MaterialData
+#include "../texture.h"       // ImageData
+
+#include <string>             // std::string
+#include <vector>             // std::vector
+#include <mutex>              // ڲĿ
+#include <unordered_set>      // ڼĿ
+
+namespace bake {
+    struct CompactModelData;
+    struct BakedTexture;
+}
+
+// PackWriterԴļ (ʹãʱҪ)
+// ÷addEntry()Ŀ (ڶ߳ͬʱ)write()һд
+// ѹʱÿĿѹֻѹ󲻳ԭС7/8Ŀѹʽţ
+// Ŀδѹʱ㿽ȡ
+// ݿ鰴ռ˳ (computeLayout)ʽڽʱ԰ļĶȡӽ˳
+class PackWriter {
+public:
+    explicit PackWriter(bool compress);
+
+    // һĿظʱԲfalse
+    bool addEntry(const std::string& name, pack::EntryType type, std::vector<uint8_t> data);
+
+    // ģлΪEntryType::Modelݡ
+    // materialsеdiffuseTexturePathѾǰڵĿ (Ϊ)
+    static std::vector<uint8_t> bakeModel(const ModelData& model, const std::vector<MaterialData>& materials);
+
+    // ѽͼƬлΪEntryType::Texture
+    static std::vector<uint8_t> bakeTexture(const ImageData& image);
+
+    // Żģ (bake::bakeModel) лΪEntryType::CompactModelݣҪͬbakeModel
+    static std::vector<uint8_t> bakeCompactModel(const bake::CompactModelData& model, const std::vector<MaterialData>& materials);
+
+    // Ѵmipmap (bake::bakeTexture) лΪEntryType::CompressedTexture
+    static std::vector<uint8_t> bakeCompressedTexture(const bake::BakedTexture& texture);
+
+    // ѹ (ѡJobSystemϲ) дļ
+    bool write(const std::string& path);
+
+    size_t getEntryCount() const { return m_entries.size(); }
+
+private:
+    // ݿ˳ (m_entries±)ģͰΧĵHilbert˳ (spatial::curveOrder)
+    // ģõͼڵһģ֮ĿĿ¼԰ƹϣ
+    std::vector<size_t> computeLayout() const;
+
+    struct PendingEntry {
+        std::string name;
+        pack::EntryType type;
+        std::vector<uint8_t> data;       // ԭʼ
+        std::vector<uint8_t> compressed; // ѹݣΪձʾѹ
+    };
+
+    bool m_compress;
+    std::mutex m_mutex;
+    std::vector<PendingEntry> m_entries;
+    std::unordered_set<std::string> m_names;
+};
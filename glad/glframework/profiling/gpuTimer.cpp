@@ -0,0 +1,44 @@
+#include "gpuTimer.h"
+#include "../../wrapper/checkError.h"
+
+GpuTimer::~GpuTimer() {
+    if (m_queries[0] != 0) {
+        GL_CALL(glDeleteQueries(LATENCY, m_queries));
+    }
+}
+
+void GpuTimer::begin() {
+    if (m_running) {
+        return;
+    }
+    if (m_queries[0] == 0) {
+        GL_CALL(glGenQueries(LATENCY, m_queries));
+    }
+
+    // ֮ǰȶѯһεĽ (LATENCY֮֡ǰһѾ)
+    if (m_pending[m_next]) {
+        GLuint64 elapsed = 0;
+        GL_CALL(glGetQueryObjectui64v(m_queries[m_next], GL_QUERY_RESULT, &elapsed));
+        m_pending[m_next] = false;
+        m_lastMs = static_cast<double>(elapsed) / 1.0e6;
+        m_totalMs += m_lastMs;
+        m_samples++;
+    }
+    GL_CALL(glBeginQuery(GL_TIME_ELAPSED, m_queries[m_next]));
+    m_running = true;
+}
+
+void GpuTimer::end() {
+    if (!m_running) {
+        return;
+    }
+    GL_CALL(glEndQuery(GL_TIME_ELAPSED));
+    m_pending[m_next] = true;
+    m_next = (m_next + 1) % LATENCY;
+    m_running = false;
+}
+
+void GpuTimer::resetAverage() {
+    m_totalMs = 0.0;
+    m_samples = 0;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "../core.h"          // GLAD
+
+#include <cstdint>            // uint64_t
+
+// GpuTimerGL_TIME_ELAPSEDѯһGLGPUϵĺʱ
+// ѯʹãȡLATENCY֮֡ǰĽͨѾCPUȴGPU
+// ͬһʱֻһGL_TIME_ELAPSEDѯڻ״̬GpuTimer֮䲻Ƕס
+// ֻGL߳ʹá
+class GpuTimer {
+public:
+    // ѯڲӳ֡
+    static constexpr int LATENCY = 4;
+
+    GpuTimer() = default;
+    ~GpuTimer();
+
+    // GLѯ󣬽ֹ
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+
+    // ΧҪGLÿ֡һ
+    void begin();
+    void end();
+
+    // һζصĺʱ ()
+    double getLastMs() const { return m_lastMs; }
+
+    // ϴresetAverageصĲƽʱ () ͸
+    double getAverageMs() const { return m_samples > 0 ? m_totalMs / m_samples : 0.0; }
+    uint64_t getSampleCount() const { return m_samples; }
+    void resetAverage();
+
+private:
+    GLuint m_queries[LATENCY] = {};
+    bool m_pending[LATENCY] = {};   // ѷδ
+    int m_next = 0;                 // һbeginʹõĲѯ
+    bool m_running = false;
+    double m_lastMs = 0.0;
+    double m_totalMs = 0.0;
+    uint64_t m_samples = 0;
+};
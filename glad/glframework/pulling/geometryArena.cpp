@@ -0,0 +1,417 @@
+#include "geometryArena.h"
+#include "../mesh.h"
+#include "../shader.h"
+#include "../material.h"
+#include "../resource/resourceManager.h"
+#include "visibilityBuffer.h"
+#include "../../wrapper/checkError.h"
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+
+namespace {
+    // ĳʼ ()֮2
+    constexpr uint32_t INITIAL_VERTEX_WORDS = 1u << 20;
+    constexpr uint32_t INITIAL_INDEX_WORDS = 1u << 19;
+    // ÿٴflushһѱٵMesh
+    constexpr uint32_t COLLECT_INTERVAL = 64;
+}
+
+uint32_t GeometryArena::RangeAllocator::allocate(uint32_t words) {
+    for (auto it = m_free.begin(); it != m_free.end(); ++it) {
+        if (it->second < words) {
+            continue;
+        }
+        uint32_t offset = it->first;
+        uint32_t remaining = it->second - words;
+        m_free.erase(it);
+        if (remaining > 0) {
+            m_free.emplace(offset + words, remaining);
+        }
+        m_used += words;
+        return offset;
+    }
+    return INVALID;
+}
+
+void GeometryArena::RangeAllocator::free(uint32_t offset, uint32_t words) {
+    if (words == 0) {
+        return;
+    }
+    m_used -= words;
+    auto next = m_free.lower_bound(offset);
+    // һʱϲ
+    if (next != m_free.end() && offset + words == next->first) {
+        words += next->second;
+        next = m_free.erase(next);
+    }
+    // ǰһʱϲ
+    if (next != m_free.begin()) {
+        auto previous = std::prev(next);
+        if (previous->first + previous->second == offset) {
+            previous->second += words;
+            return;
+        }
+    }
+    m_free.emplace(offset, words);
+}
+
+void GeometryArena::RangeAllocator::grow(uint32_t capacity) {
+    if (capacity <= m_capacity) {
+        return;
+    }
+    uint32_t oldCapacity = m_capacity;
+    m_capacity = capacity;
+    // freeϲĩβĿ (freem_usedмȥȼӻ)
+    m_used += capacity - oldCapacity;
+    free(oldCapacity, capacity - oldCapacity);
+}
+
+GeometryArena::~GeometryArena() {
+    GLuint buffers[] = { m_vertexBuffer, m_indexBuffer, m_recordBuffer, m_transformBuffer, m_indirectBuffer, m_drawIndexBuffer };
+    for (GLuint buffer : buffers) {
+        if (buffer != 0) {
+            GL_CALL(glDeleteBuffers(1, &buffer));
+        }
+    }
+    if (m_vao != 0) {
+        GL_CALL(glDeleteVertexArrays(1, &m_vao));
+    }
+}
+
+uint32_t GeometryArena::addTransform(const glm::mat4& vertexToWorld, uint32_t objectId) {
+    m_transforms.push_back(vertexToWorld);
+    m_objectIds.push_back(objectId);
+    return static_cast<uint32_t>(m_transforms.size() - 1);
+}
+
+bool GeometryArena::submit(uint32_t transform, MeshHandle handle, Mesh& mesh) {
+    const Allocation* allocation = makeResident(handle, mesh);
+    if (!allocation) {
+        return false;
+    }
+    size_t first = 0, count = 0;
+    mesh.getDrawRange(first, count);
+    Item item;
+    item.material = mesh.getMaterial();
+    item.transform = transform;
+    item.first = static_cast<uint32_t>(first);
+    item.count = static_cast<uint32_t>(count);
+    item.record = {};
+    item.record.vertexOffset = allocation->vertexOffset;
+    item.record.indexOffset = allocation->indexOffset;
+    item.record.format = allocation->format;
+    item.record.transform = transform;
+    item.record.objectId = m_objectIds[transform];
+    m_items.push_back(item);
+    return true;
+}
+
+GeometryArena::Allocation GeometryArena::measure(const Mesh& mesh) {
+    size_t vertexBytes = mesh.getVertexCount() * mesh.getVertexStride();
+    size_t indexBytes = mesh.getIndexCount() * mesh.getIndexSize();
+    // ֶʽĴС4ֽڵ16λΪʱ뵽
+    Allocation allocation;
+    allocation.vertexWords = static_cast<uint32_t>(vertexBytes / 4);
+    allocation.indexWords = static_cast<uint32_t>((indexBytes + 3) / 4);
+    allocation.format = (mesh.isCompact() ? FORMAT_COMPACT : 0u) | (mesh.getIndexSize() == sizeof(uint16_t) ? FORMAT_INDEX16 : 0u);
+    allocation.dataVersion = mesh.getDataVersion();
+    return allocation;
+}
+
+size_t GeometryArena::getResidentBytes(const Mesh& mesh) {
+    Allocation allocation = measure(mesh);
+    return (static_cast<size_t>(allocation.vertexWords) + allocation.indexWords) * 4;
+}
+
+const GeometryArena::Allocation* GeometryArena::makeResident(MeshHandle handle, Mesh& mesh) {
+    if (mesh.getVertexBuffer() == 0 || mesh.getIndexBuffer() == 0) {
+        return nullptr;
+    }
+    auto it = m_allocations.find(handle);
+    if (it != m_allocations.end()) {
+        if (it->second.dataVersion == mesh.getDataVersion() || updateInPlace(it->second, mesh)) {
+            return &it->second;
+        }
+        // غС͸ʽܱ仯黹·
+        m_vertexAllocator.free(it->second.vertexOffset, it->second.vertexWords);
+        m_indexAllocator.free(it->second.indexOffset, it->second.indexWords);
+        m_allocations.erase(it);
+    }
+
+    size_t vertexBytes = mesh.getVertexCount() * mesh.getVertexStride();
+    size_t indexBytes = mesh.getIndexCount() * mesh.getIndexSize();
+    Allocation allocation = measure(mesh);
+    allocation.vertexOffset = allocate(m_vertexBuffer, m_vertexAllocator, allocation.vertexWords);
+    if (allocation.vertexOffset == RangeAllocator::INVALID) {
+        return nullptr;
+    }
+    allocation.indexOffset = allocate(m_indexBuffer, m_indexAllocator, allocation.indexWords);
+    if (allocation.indexOffset == RangeAllocator::INVALID) {
+        m_vertexAllocator.free(allocation.vertexOffset, allocation.vertexWords);
+        return nullptr;
+    }
+
+    // GPUϴMeshԼĻƣҪCPUั
+    GL_CALL(glBindBuffer(GL_COPY_READ_BUFFER, mesh.getVertexBuffer()));
+    GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, m_vertexBuffer));
+    GL_CALL(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, static_cast<GLintptr>(allocation.vertexOffset) * 4, vertexBytes));
+    GL_CALL(glBindBuffer(GL_COPY_READ_BUFFER, mesh.getIndexBuffer()));
+    GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, m_indexBuffer));
+    GL_CALL(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, static_cast<GLintptr>(allocation.indexOffset) * 4, indexBytes));
+    GL_CALL(glBindBuffer(GL_COPY_READ_BUFFER, 0));
+    GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+
+    return &m_allocations.emplace(handle, allocation).first->second;
+}
+
+bool GeometryArena::updateInPlace(Allocation& allocation, Mesh& mesh) {
+    uint32_t format = measure(mesh).format;
+    size_t vertexBytes = mesh.getVertexCount() * mesh.getVertexStride();
+    size_t indexBytes = mesh.getIndexCount() * mesh.getIndexSize();
+    if (mesh.getDataVersion() != allocation.dataVersion + 1 || format != allocation.format
+        || vertexBytes > static_cast<size_t>(allocation.vertexWords) * 4 || indexBytes > static_cast<size_t>(allocation.indexWords) * 4) {
+        return false;
+    }
+    copyRanges(mesh.getVertexBuffer(), m_vertexBuffer, allocation.vertexOffset, mesh.getDirtyVertexRanges());
+    copyRanges(mesh.getIndexBuffer(), m_indexBuffer, allocation.indexOffset, mesh.getDirtyIndexRanges());
+    allocation.dataVersion = mesh.getDataVersion();
+    return true;
+}
+
+void GeometryArena::copyRanges(GLuint source, GLuint target, uint32_t wordOffset, const std::vector<Mesh::ByteRange>& ranges) {
+    if (ranges.empty()) {
+        return;
+    }
+    GL_CALL(glBindBuffer(GL_COPY_READ_BUFFER, source));
+    GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, target));
+    for (const Mesh::ByteRange& range : ranges) {
+        GL_CALL(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(range.offset),
+            static_cast<GLintptr>(wordOffset) * 4 + static_cast<GLintptr>(range.offset), static_cast<GLsizeiptr>(range.size)));
+    }
+    GL_CALL(glBindBuffer(GL_COPY_READ_BUFFER, 0));
+    GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+}
+
+uint32_t GeometryArena::allocate(GLuint& buffer, RangeAllocator& allocator, uint32_t words) {
+    uint32_t offset = allocator.allocate(words);
+    if (offset != RangeAllocator::INVALID) {
+        return offset;
+    }
+
+    // 㣺½һĻԭ
+    uint64_t capacity = std::max<uint64_t>(allocator.getCapacity(), &allocator == &m_vertexAllocator ? INITIAL_VERTEX_WORDS : INITIAL_INDEX_WORDS);
+    // ĩβĿϲҪܷ
+    while (capacity < static_cast<uint64_t>(allocator.getCapacity()) + words || capacity == allocator.getCapacity()) {
+        capacity *= 2;
+    }
+    GLint64 maxBytes = 0;
+    GL_CALL(glGetInteger64v(GL_MAX_SHADER_STORAGE_BLOCK_SIZE, &maxBytes));
+    if (capacity * 4 > static_cast<uint64_t>(maxBytes) || capacity > RangeAllocator::INVALID) {
+        std::cerr << "WARNING: GeometryArena exceeds GL_MAX_SHADER_STORAGE_BLOCK_SIZE (" << maxBytes << " bytes), mesh drawn without vertex pulling." << std::endl;
+        return RangeAllocator::INVALID;
+    }
+
+    GLuint grown = 0;
+    GL_CALL(glGenBuffers(1, &grown));
+    GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, grown));
+    GL_CALL(glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(capacity * 4), nullptr, GL_STATIC_DRAW));
+    if (buffer != 0) {
+        GL_CALL(glBindBuffer(GL_COPY_READ_BUFFER, buffer));
+        GL_CALL(glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, static_cast<GLsizeiptr>(allocator.getCapacity()) * 4));
+        GL_CALL(glBindBuffer(GL_COPY_READ_BUFFER, 0));
+        GL_CALL(glDeleteBuffers(1, &buffer));
+    }
+    GL_CALL(glBindBuffer(GL_COPY_WRITE_BUFFER, 0));
+    buffer = grown;
+    allocator.grow(static_cast<uint32_t>(capacity));
+    return allocator.allocate(words);
+}
+
+void GeometryArena::collectStale() {
+    ResourcePool<Mesh>& meshPool = ResourceManager::getInstance()->meshes();
+    for (auto it = m_allocations.begin(); it != m_allocations.end();) {
+        if (meshPool.isAlive(it->first)) {
+            ++it;
+            continue;
+        }
+        m_vertexAllocator.free(it->second.vertexOffset, it->second.vertexWords);
+        m_indexAllocator.free(it->second.indexOffset, it->second.indexWords);
+        it = m_allocations.erase(it);
+    }
+}
+
+void GeometryArena::upload(GLuint& buffer, GLenum target, size_t& capacity, const void* data, size_t bytes) {
+    if (buffer == 0) {
+        GL_CALL(glGenBuffers(1, &buffer));
+    }
+    GL_CALL(glBindBuffer(target, buffer));
+    if (bytes > capacity) {
+        capacity = std::max(bytes, capacity * 2);
+        GL_CALL(glBufferData(target, static_cast<GLsizeiptr>(capacity), nullptr, GL_STREAM_DRAW));
+    }
+    GL_CALL(glBufferSubData(target, 0, static_cast<GLsizeiptr>(bytes), data));
+}
+
+bool GeometryArena::prepareFrame() {
+    if (++m_frame % COLLECT_INTERVAL == 0) {
+        collectStale();
+    }
+    m_stats.draws = m_items.size();
+    m_stats.batches = 0;
+    m_stats.residentMeshes = m_allocations.size();
+    m_stats.vertexBytes = static_cast<size_t>(m_vertexAllocator.getUsed()) * 4;
+    m_stats.indexBytes = static_cast<size_t>(m_indexAllocator.getUsed()) * 4;
+    m_groups.clear();
+    if (m_items.empty()) {
+        return false;
+    }
+
+    // 1.  (ͬһڱύ˳)ÿʵڼӻ
+    m_order.resize(m_items.size());
+    std::iota(m_order.begin(), m_order.end(), 0u);
+    std::stable_sort(m_order.begin(), m_order.end(), [this](uint32_t a, uint32_t b) {
+        return m_items[a].material < m_items[b].material;
+    });
+    m_records.resize(m_items.size());
+    m_commands.resize(m_items.size());
+    for (size_t i = 0; i < m_order.size(); ++i) {
+        const Item& item = m_items[m_order[i]];
+        if (m_groups.empty() || m_groups.back().material != item.material) {
+            m_groups.push_back({ item.material, static_cast<uint32_t>(i), 0u });
+        }
+        m_groups.back().count++;
+        m_records[i] = item.record;
+        m_records[i].firstIndex = item.first;
+        m_records[i].material = static_cast<uint32_t>(m_groups.size() - 1);
+        // baseInstanceƱţͨÿʵԴShader
+        m_commands[i] = { item.count, 1u, item.first, static_cast<uint32_t>(i) };
+    }
+
+    // 2. ϴÿ֡ݣƼ¼任
+    upload(m_recordBuffer, GL_SHADER_STORAGE_BUFFER, m_recordCapacity, m_records.data(), m_records.size() * sizeof(DrawRecord));
+    upload(m_transformBuffer, GL_SHADER_STORAGE_BUFFER, m_transformCapacity, m_transforms.data(), m_transforms.size() * sizeof(glm::mat4));
+    upload(m_indirectBuffer, GL_DRAW_INDIRECT_BUFFER, m_indirectCapacity, m_commands.data(), m_commands.size() * sizeof(DrawArraysIndirectCommand));
+    GL_CALL(glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0));
+
+    // 3. ΨһVAOƱΪÿʵ (divisor = 1)iƶֵΪbaseInstance = i
+    if (m_vao == 0) {
+        GL_CALL(glGenVertexArrays(1, &m_vao));
+        GL_CALL(glGenBuffers(1, &m_drawIndexBuffer));
+    }
+    GL_CALL(glBindVertexArray(m_vao));
+    if (m_drawIndexCount < m_items.size()) {
+        m_drawIndexCount = std::max(static_cast<uint32_t>(m_items.size()), m_drawIndexCount * 2);
+        std::vector<uint32_t> drawIndices(m_drawIndexCount);
+        std::iota(drawIndices.begin(), drawIndices.end(), 0u);
+        GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, m_drawIndexBuffer));
+        GL_CALL(glBufferData(GL_ARRAY_BUFFER, drawIndices.size() * sizeof(uint32_t), drawIndices.data(), GL_STATIC_DRAW));
+        GL_CALL(glEnableVertexAttribArray(0));
+        GL_CALL(glVertexAttribIPointer(0, 1, GL_UNSIGNED_INT, sizeof(uint32_t), (void*)0));
+        GL_CALL(glVertexAttribDivisor(0, 1));
+        GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, 0));
+    }
+    GL_CALL(glBindVertexArray(0));
+
+    // 4. 󶨹 (ƺͽʹ)
+    bindStorage();
+    return true;
+}
+
+void GeometryArena::bindStorage() {
+    GL_CALL(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_vertexBuffer));
+    GL_CALL(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, m_indexBuffer));
+    GL_CALL(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, m_recordBuffer));
+    GL_CALL(glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, m_transformBuffer));
+}
+
+void GeometryArena::useMaterial(Shader& shader, MaterialHandle handle) {
+    Material* material = ResourceManager::getInstance()->get(handle);
+    if (material) {
+        material->use(shader);
+    }
+    else {
+        GL_CALL(glBindTexture(GL_TEXTURE_2D, 0));
+    }
+}
+
+void GeometryArena::flush(Shader& shader, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) {
+    if (!prepareFrame()) {
+        clear();
+        return;
+    }
+
+    // ÿһζؼӻ
+    shader.setMatrix4x4("viewMatrix", viewMatrix);
+    shader.setMatrix4x4("projectionMatrix", projectionMatrix);
+    GL_CALL(glBindVertexArray(m_vao));
+    GL_CALL(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirectBuffer));
+    for (const MaterialGroup& group : m_groups) {
+        useMaterial(shader, group.material);
+        GL_CALL(glMultiDrawArraysIndirect(GL_TRIANGLES, (void*)(group.first * sizeof(DrawArraysIndirectCommand)),
+            static_cast<GLsizei>(group.count), 0));
+        m_stats.batches++;
+    }
+
+    GL_CALL(glBindVertexArray(0));
+    GL_CALL(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0));
+    clear();
+}
+
+bool GeometryArena::drawVisibility(Shader& shader, VisibilityBuffer& target, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) {
+    if (!prepareFrame() || !target.beginVisibility()) {
+        clear();
+        return false;
+    }
+    if (m_groups.size() > VisibilityBuffer::MAX_MATERIAL_GROUPS) {
+        std::cerr << "WARNING: Too many materials for the visibility buffer (" << m_groups.size() << ")." << std::endl;
+        target.endVisibility();
+        clear();
+        return false;
+    }
+
+    // Ҫʣһζؼӻ
+    shader.setMatrix4x4("viewMatrix", viewMatrix);
+    shader.setMatrix4x4("projectionMatrix", projectionMatrix);
+    GL_CALL(glBindVertexArray(m_vao));
+    GL_CALL(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirectBuffer));
+    GL_CALL(glMultiDrawArraysIndirect(GL_TRIANGLES, nullptr, static_cast<GLsizei>(m_commands.size()), 0));
+    m_stats.batches = 1;
+    GL_CALL(glBindVertexArray(0));
+    GL_CALL(glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0));
+
+    target.endVisibility();
+    return true;
+}
+
+void GeometryArena::resolveVisibility(Shader& classifyShader, Shader& shader, Shader& compositeShader, VisibilityBuffer& target,
+    const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) {
+    if (m_groups.empty()) {
+        clear();
+        return;
+    }
+
+    // ȰѲдɲȣÿʵȫֻȵɫرearly-Z޳
+    bindStorage();
+    target.classify(classifyShader);
+    shader.begin();
+    target.beginResolve(shader);
+    shader.setMatrix4x4("viewMatrix", viewMatrix);
+    shader.setMatrix4x4("projectionMatrix", projectionMatrix);
+    for (size_t g = 0; g < m_groups.size(); ++g) {
+        useMaterial(shader, m_groups[g].material);
+        shader.setFloat("materialDepth", VisibilityBuffer::materialDepth(static_cast<uint32_t>(g)));
+        target.drawFullScreen();
+    }
+    target.endResolve();
+    shader.end();
+    target.composite(compositeShader);
+    clear();
+}
+
+void GeometryArena::clear() {
+    m_items.clear();
+    m_transforms.clear();
+    m_objectIds.clear();
+}
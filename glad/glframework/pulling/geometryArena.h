@@ -0,0 +1,205 @@
+#pragma once
+
+#include "../core.h"          // GLAD, glm
+#include "../resource/handle.h" // MeshHandle, MaterialHandle
+#include "../mesh.h"          // Mesh::ByteRange
+
+#include <cstddef>            // size_t
+#include <cstdint>            // uint32_t
+#include <map>                // ڿ
+#include <unordered_map>      // Mesh -> еλ
+#include <vector>             // std::vector
+
+class Shader;
+class VisibilityBuffer;
+
+// GeometryArenaɱ̶ȡ (programmable vertex pulling) Ļ·
+// MeshĶƵSSBO (32λѰַ)ɫ
+// (assets/shaders/pullingVertex.glsl) gl_VertexIDÿƵƫԼȡٶȡ붥㣺
+// - ʽ (PosXYZ + UV) ͽոʽ (pack::CompactVertex16/32λ) ͬһShaderн룬
+//   ֻһûжʽVAO֮䲻лVAOл/
+// - ͸MeshModel::drawֻύ (Model::setGeometryArena)flush()ʷ飬
+//   ÿһglMultiDrawArraysIndirect
+// - ƱͨbaseInstance + ÿʵԴShadergl_DrawIDMesa (llvmpipe) ͬá
+// MeshһύʱGPUglCopyBufferSubDataƵ (㿽MeshҲ)
+// ظݺֻMeshд (Mesh::getDirtyVertexRangesСԭʱ·䲢)
+// Meshٺ֮flushлգʱ2
+// ҲdrawVisibility + resolveVisibility߿ɼԻ (visibilityBuffer.h)ݺύʽͬ
+// ֻGL߳ʹãÿ֡flush (resolveVisibility) ֮ύбΪա
+class GeometryArena {
+public:
+    struct Stats {
+        size_t draws = 0;           // һflushĻƸ
+        size_t batches = 0;         // һflushglMultiDrawArraysIndirectô (ʸɼͨΪ1)
+        size_t residentMeshes = 0;  // еMesh
+        size_t vertexBytes = 0;     // ʹõֽ
+        size_t indexBytes = 0;
+    };
+
+    GeometryArena() = default;
+    ~GeometryArena();
+
+    // GL󣬽ֹ
+    GeometryArena(const GeometryArena&) = delete;
+    GeometryArena& operator=(const GeometryArena&) = delete;
+
+    // Ǽһ任 (굽)ظsubmitʹõıţͬһģ͵Meshһ
+    // objectIdΪģ͵Ľ (Model::setObjectId)дÿƵDrawRecord
+    uint32_t addTransform(const glm::mat4& vertexToWorld, uint32_t objectId);
+
+    // ύһMeshĵǰLODҪʱȰƵʧʱfalse÷ӦֱӻƸMesh
+    bool submit(uint32_t transform, MeshHandle handle, Mesh& mesh);
+
+    // ʷύMeshȻύбshader (assets/shaders/pullingVertex.glsl +
+    // ͨ·ͬƬɫ) ɵ÷ (ƽҲɵ÷)
+    void flush(Shader& shader, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix);
+
+    // ɼͨһζؼӻƵtargetֻдźȡ
+    // shader (pullingVertex.glsl + visibilityFragment.glsl) ɵ÷ʧʱύбfalse
+    bool drawVisibility(Shader& shader, VisibilityBuffer& target, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix);
+
+    // ͨdrawVisibilityɹ֮áͨдȣÿһGL_EQUALԵȫΣ
+    // ɫȺϳɵǰ֡壬Ȼύб (VisibilityBuffer)Shaderɱ
+    // classifyShader (oitCompositeVertex.glsl + visibilityClassifyFragment.glsl)
+    // shader (visibilityResolveVertex.glsl + visibilityResolveFragment.glslרɫuniformɵ÷Ԥ)
+    // compositeShader (oitCompositeVertex.glsl + visibilityCompositeFragment.glsl)
+    void resolveVisibility(Shader& classifyShader, Shader& shader, Shader& compositeShader, VisibilityBuffer& target,
+        const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix);
+
+    // ύMesh (еݱ)
+    void clear();
+
+    size_t size() const { return m_items.size(); }
+    const Stats& getStats() const { return m_stats; }
+
+    // meshĶڹռõֽ (ǷѾ)MeshԼVBO/EBO֮һԴ棬
+    // Mesh::getGpuBytesModel::getMemoryUsage·
+    static size_t getResidentBytes(const Mesh& mesh);
+
+private:
+    // еһ32λ
+    class RangeAllocator {
+    public:
+        static constexpr uint32_t INVALID = ~0u;
+
+        // ״䣬ʧʱINVALID
+        uint32_t allocate(uint32_t words);
+        // 黹䣬ڵĿϲ
+        void free(uint32_t offset, uint32_t words);
+        // ӵcapacityֳΪ
+        void grow(uint32_t capacity);
+
+        uint32_t getCapacity() const { return m_capacity; }
+        uint32_t getUsed() const { return m_used; }
+
+    private:
+        std::map<uint32_t, uint32_t> m_free;    //  -> 
+        uint32_t m_capacity = 0;
+        uint32_t m_used = 0;
+    };
+
+    // һMeshڹеλ
+    struct Allocation {
+        uint32_t vertexOffset = 0;  // ƫ
+        uint32_t vertexWords = 0;   // ĴСԭظºܴMeshʵ
+        uint32_t indexOffset = 0;
+        uint32_t indexWords = 0;
+        uint32_t format = 0;        // FORMAT_*Shaderһ
+        uint32_t dataVersion = 0;   // ʱMeshݰ汾汾仯ʱ¸
+    };
+
+    // assets/shaders/pullingVertex.glslvisibilityResolveFragment.glslеDrawRecordһ (std430)
+    struct DrawRecord {
+        uint32_t vertexOffset;
+        uint32_t indexOffset;
+        uint32_t format;
+        uint32_t transform;
+        uint32_t firstIndex;        // ǰLODĵһ (ͨͼԪŻԭ)
+        uint32_t material;          // ֡Ĳ
+        uint32_t objectId;          //  (רɫ)~0uʾû
+        uint32_t reserved;
+    };
+
+    // glMultiDrawArraysIndirectʽ
+    struct DrawArraysIndirectCommand {
+        uint32_t count;
+        uint32_t instanceCount;
+        uint32_t first;
+        uint32_t baseInstance;
+    };
+
+    // ֡ͬһʵĻƣڼӻ
+    struct MaterialGroup {
+        MaterialHandle material;
+        uint32_t first;
+        uint32_t count;
+    };
+
+    struct Item {
+        MaterialHandle material;
+        uint32_t transform;
+        uint32_t first;             // ǰLODMeshеķΧ
+        uint32_t count;
+        DrawRecord record;
+    };
+
+    static constexpr uint32_t FORMAT_COMPACT = 1u;  // Ϊpack::CompactVertex (4)Ϊ5float
+    static constexpr uint32_t FORMAT_INDEX16 = 2u;  // 16λΪ32λ
+
+    // ϴ֡ĻݣVAO󶨹ûύʱfalse
+    bool prepareFrame();
+
+    // ѹ󶨵SSBO binding 0 ~ 3
+    void bindStorage();
+
+    static void useMaterial(Shader& shader, MaterialHandle handle);
+
+    // meshڹҪС () ͸ʽ
+    static Allocation measure(const Mesh& mesh);
+
+    // ֤Meshڹµ
+    const Allocation* makeResident(MeshHandle handle, Mesh& mesh);
+
+    // Meshֻallocationһ汾ݷŵԭʱGPUֻƸд䡣ɹʱtrue
+    bool updateInPlace(Allocation& allocation, Mesh& mesh);
+
+    // sourceranges (ֽ) targetwordOffsetʼλ
+    static void copyRanges(GLuint source, GLuint target, uint32_t wordOffset, const std::vector<Mesh::ByteRange>& ranges);
+
+    // allocatorwords֣ʱbuffer (ԭ)
+    uint32_t allocate(GLuint& buffer, RangeAllocator& allocator, uint32_t words);
+
+    // ѱٵMesh
+    void collectStale();
+
+    // dataϴbufferʱ· (ÿ֡Ļ)
+    static void upload(GLuint& buffer, GLenum target, size_t& capacity, const void* data, size_t bytes);
+
+private:
+    std::unordered_map<MeshHandle, Allocation> m_allocations;
+    RangeAllocator m_vertexAllocator;
+    RangeAllocator m_indexAllocator;
+
+    std::vector<Item> m_items;
+    std::vector<glm::mat4> m_transforms;
+    std::vector<uint32_t> m_objectIds;  // m_transformsһһӦ
+    // flushõʱݣ֡
+    std::vector<uint32_t> m_order;
+    std::vector<DrawRecord> m_records;
+    std::vector<DrawArraysIndirectCommand> m_commands;
+    std::vector<MaterialGroup> m_groups;
+    uint32_t m_frame = 0;
+
+    GLuint m_vao = 0;               // ֻһÿʵ (Ʊ)
+    GLuint m_vertexBuffer = 0;      // SSBO binding 0
+    GLuint m_indexBuffer = 0;       // SSBO binding 1
+    GLuint m_recordBuffer = 0;      // SSBO binding 2
+    GLuint m_transformBuffer = 0;   // SSBO binding 3
+    GLuint m_indirectBuffer = 0;
+    GLuint m_drawIndexBuffer = 0;   // 0, 1, 2, ... ÿʵԵ
+    size_t m_recordCapacity = 0;    // ÿֽ֡
+    size_t m_transformCapacity = 0;
+    size_t m_indirectCapacity = 0;
+    uint32_t m_drawIndexCount = 0;
+    Stats m_stats;
+};
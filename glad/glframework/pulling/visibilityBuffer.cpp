@@ -0,0 +1,198 @@
+#include "visibilityBuffer.h"
+#include "../shader.h"
+#include "../../wrapper/checkError.h"
+
+#include <iostream>
+
+VisibilityBuffer::~VisibilityBuffer() {
+    releaseTargets();
+    if (m_emptyVao != 0) {
+        GL_CALL(glDeleteVertexArrays(1, &m_emptyVao));
+        m_emptyVao = 0;
+    }
+}
+
+bool VisibilityBuffer::ensureTargets(int width, int height) {
+    if (m_fbo != 0 && width == m_width && height == m_height) {
+        return true;
+    }
+    releaseTargets();
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+    m_width = width;
+    m_height = height;
+
+    // ֻtexelFetchȡҪ
+    GL_CALL(glGenTextures(1, &m_ids));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, m_ids));
+    GL_CALL(glTexStorage2D(GL_TEXTURE_2D, 1, GL_RG32UI, width, height));
+    GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+    GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+    GL_CALL(glGenTextures(1, &m_depth));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, m_depth));
+    GL_CALL(glTexStorage2D(GL_TEXTURE_2D, 1, GL_DEPTH_COMPONENT32F, width, height));
+    GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+    GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+    // Ĭ֡ĸʽֻͬȲԣҪȡ
+    GL_CALL(glGenTextures(1, &m_color));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, m_color));
+    GL_CALL(glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, width, height));
+    GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+    GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, 0));
+    GL_CALL(glGenRenderbuffers(1, &m_materialDepth));
+    GL_CALL(glBindRenderbuffer(GL_RENDERBUFFER, m_materialDepth));
+    GL_CALL(glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT32F, width, height));
+    GL_CALL(glBindRenderbuffer(GL_RENDERBUFFER, 0));
+
+    GL_CALL(glGenFramebuffers(1, &m_fbo));
+    GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, m_fbo));
+    GL_CALL(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_ids, 0));
+    GL_CALL(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_depth, 0));
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    const char* incomplete = status != GL_FRAMEBUFFER_COMPLETE ? "framebuffer" : nullptr;
+    if (!incomplete) {
+        GL_CALL(glGenFramebuffers(1, &m_resolveFbo));
+        GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, m_resolveFbo));
+        GL_CALL(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_color, 0));
+        GL_CALL(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_materialDepth));
+        status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        incomplete = status != GL_FRAMEBUFFER_COMPLETE ? "resolve framebuffer" : nullptr;
+    }
+    GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+    if (incomplete) {
+        std::cerr << "ERROR: Visibility buffer " << incomplete << " incomplete (status 0x" << std::hex << status << std::dec << ")." << std::endl;
+        releaseTargets();
+        return false;
+    }
+    return true;
+}
+
+void VisibilityBuffer::releaseTargets() {
+    if (m_fbo != 0) {
+        GL_CALL(glDeleteFramebuffers(1, &m_fbo));
+        m_fbo = 0;
+    }
+    if (m_ids != 0) {
+        GL_CALL(glDeleteTextures(1, &m_ids));
+        m_ids = 0;
+    }
+    if (m_depth != 0) {
+        GL_CALL(glDeleteTextures(1, &m_depth));
+        m_depth = 0;
+    }
+    if (m_resolveFbo != 0) {
+        GL_CALL(glDeleteFramebuffers(1, &m_resolveFbo));
+        m_resolveFbo = 0;
+    }
+    if (m_color != 0) {
+        GL_CALL(glDeleteTextures(1, &m_color));
+        m_color = 0;
+    }
+    if (m_materialDepth != 0) {
+        GL_CALL(glDeleteRenderbuffers(1, &m_materialDepth));
+        m_materialDepth = 0;
+    }
+    m_width = 0;
+    m_height = 0;
+}
+
+bool VisibilityBuffer::beginVisibility() {
+    // ӿǴ (0, 0) ʼ (main.cppOnResize)
+    GLint viewport[4];
+    GL_CALL(glGetIntegerv(GL_VIEWPORT, viewport));
+    if (!ensureTargets(viewport[2], viewport[3])) {
+        return false;
+    }
+    GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, m_fbo));
+    const GLuint noGeometry[4] = { 0, 0, 0, 0 };
+    const GLfloat farDepth = 1.0f;
+    GL_CALL(glClearBufferuiv(GL_COLOR, 0, noGeometry));
+    GL_CALL(glClearBufferfv(GL_DEPTH, 0, &farDepth));
+    return true;
+}
+
+void VisibilityBuffer::endVisibility() {
+    GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
+
+void VisibilityBuffer::classify(Shader& shader) {
+    if (m_emptyVao == 0) {
+        GL_CALL(glGenVertexArrays(1, &m_emptyVao));
+    }
+    // ֻд (Ϊ1)ÿдһΣҪȽ
+    GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, m_resolveFbo));
+    const GLfloat farDepth = 1.0f;
+    GL_CALL(glClearBufferfv(GL_DEPTH, 0, &farDepth));
+    GL_CALL(glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE));
+    GL_CALL(glDepthFunc(GL_ALWAYS));
+
+    shader.begin();
+    GL_CALL(glActiveTexture(GL_TEXTURE0 + ID_TEXTURE_UNIT));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, m_ids));
+    GL_CALL(glActiveTexture(GL_TEXTURE0));
+    shader.setInt("visibilityIds", ID_TEXTURE_UNIT);
+    GL_CALL(glBindVertexArray(m_emptyVao));
+    drawFullScreen();
+    GL_CALL(glBindVertexArray(0));
+    shader.end();
+
+    GL_CALL(glDepthFunc(GL_LESS));
+    GL_CALL(glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE));
+}
+
+void VisibilityBuffer::beginResolve(Shader& shader) {
+    if (m_emptyVao == 0) {
+        GL_CALL(glGenVertexArrays(1, &m_emptyVao));
+    }
+    // ÿʵȫֻͨȵ
+    GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, m_resolveFbo));
+    GL_CALL(glDepthFunc(GL_EQUAL));
+    GL_CALL(glDepthMask(GL_FALSE));
+    GL_CALL(glActiveTexture(GL_TEXTURE0 + ID_TEXTURE_UNIT));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, m_ids));
+    GL_CALL(glActiveTexture(GL_TEXTURE0));
+    shader.setInt("visibilityIds", ID_TEXTURE_UNIT);
+    GL_CALL(glBindVertexArray(m_emptyVao));
+}
+
+void VisibilityBuffer::drawFullScreen() {
+    GL_CALL(glDrawArrays(GL_TRIANGLES, 0, 3));
+}
+
+void VisibilityBuffer::endResolve() {
+    GL_CALL(glBindVertexArray(0));
+    GL_CALL(glDepthMask(GL_TRUE));
+    GL_CALL(glDepthFunc(GL_LESS));
+    GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+    GL_CALL(glActiveTexture(GL_TEXTURE0 + ID_TEXTURE_UNIT));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, 0));
+    GL_CALL(glActiveTexture(GL_TEXTURE0));
+}
+
+void VisibilityBuffer::composite(Shader& shader) {
+    // ֻһдgl_FragDepth֮ǰֱӻƵMeshȲ
+    shader.begin();
+    GL_CALL(glActiveTexture(GL_TEXTURE0 + ID_TEXTURE_UNIT));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, m_ids));
+    GL_CALL(glActiveTexture(GL_TEXTURE0 + DEPTH_TEXTURE_UNIT));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, m_depth));
+    GL_CALL(glActiveTexture(GL_TEXTURE0 + COLOR_TEXTURE_UNIT));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, m_color));
+    GL_CALL(glActiveTexture(GL_TEXTURE0));
+    shader.setInt("visibilityIds", ID_TEXTURE_UNIT);
+    shader.setInt("visibilityDepth", DEPTH_TEXTURE_UNIT);
+    shader.setInt("resolvedColor", COLOR_TEXTURE_UNIT);
+    GL_CALL(glBindVertexArray(m_emptyVao));
+    drawFullScreen();
+    GL_CALL(glBindVertexArray(0));
+    GL_CALL(glActiveTexture(GL_TEXTURE0 + ID_TEXTURE_UNIT));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, 0));
+    GL_CALL(glActiveTexture(GL_TEXTURE0 + DEPTH_TEXTURE_UNIT));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, 0));
+    GL_CALL(glActiveTexture(GL_TEXTURE0 + COLOR_TEXTURE_UNIT));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, 0));
+    GL_CALL(glActiveTexture(GL_TEXTURE0));
+    shader.end();
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "../core.h"          // GLAD
+
+#include <cstdint>            // uint32_t
+
+class Shader;
+
+// VisibilityBufferɼԻȾĿ
+// ܼLOD3УɫڹȻƺԲֵ˷ѴɼԻѻƷֳɼ
+// - ɼͨв͸Meshһζؼӻд (Ʊ + 1, ͼԪ) ȣ
+//   Ƭɫֻд (assets/shaders/visibilityFragment.glsl)
+// - ͨһȫΰÿصĲдɲ (materialDepth
+//   assets/shaders/visibilityClassifyFragment.glsl)
+// - ͨÿʻһȺΪòȵȫΣȲΪGL_EQUALҲдȣ
+//   ʵǰȲ (early-Z) б޳Ƭɫ
+//   ذŴGeometryArenaĹȡΣؽ͸У (mipmap)
+//   ɫдɫ (assets/shaders/visibilityResolveFragment.glsl)
+//   ÿɼֻһβɫܶȺͲʸ޹أ
+// - ϳɣһȫΰɫͿɼͨдصǰ֡ (assets/shaders/visibilityCompositeFragment.glsl)
+//   ֮ڡߺ͸ͨճȲԡ
+// GeometryArena::drawVisibility / resolveVisibility
+// ֻGL߳ʹãȾĿڵһʹúӿڴС仯ʱ () 
+class VisibilityBuffer {
+public:
+    // ShaderпɼʹõԪ (Ԫ0ͼ)
+    static constexpr int ID_TEXTURE_UNIT = 1;
+    static constexpr int DEPTH_TEXTURE_UNIT = 2;
+    static constexpr int COLOR_TEXTURE_UNIT = 3;
+
+    // һ֡Ĳ2^-20Ϊ32λпԾȷʾҶСڱ1
+    static constexpr uint32_t MAX_MATERIAL_GROUPS = (1u << 20) - 2u;
+
+    // groupĲȣvisibilityClassifyFragment.glslһ
+    static float materialDepth(uint32_t group) { return static_cast<float>(group + 1u) * (1.0f / static_cast<float>(1u << 20)); }
+
+    VisibilityBuffer() = default;
+    ~VisibilityBuffer();
+
+    // GL󣬽ֹ
+    VisibilityBuffer(const VisibilityBuffer&) = delete;
+    VisibilityBuffer& operator=(const VisibilityBuffer&) = delete;
+
+    // ʼɼͨǰӿ׼ȾĿ꣬󶨲 (Ϊ0ʾûм)ʧʱfalse
+    bool beginVisibility();
+
+    // ɼָͨĬ֡
+    void endVisibility();
+
+    // ͨѲдõȻ塣DrawRecordɵ÷󶨵SSBO binding 2
+    // shader (oitCompositeVertex.glsl + visibilityClassifyFragment.glsl) ɱ
+    void classify(Shader& shader);
+
+    // ʼͨɫͲȣȲΪGL_EQUALҲдȣѱ󶨵ID_TEXTURE_UNIT
+    // õshader (visibilityResolveVertex.glsl + visibilityResolveFragment.glslɵ÷)
+    // ֮ÿһmaterialDepthdrawFullScreen
+    void beginResolve(Shader& shader);
+
+    // һĻ
+    void drawFullScreen();
+
+    // ָͨĬ֡״̬
+    void endResolve();
+
+    // ѽͿɼͨȺϳɵǰ֡ (Ȳ)
+    // shader (oitCompositeVertex.glsl + visibilityCompositeFragment.glsl) ɱ
+    void composite(Shader& shader);
+
+private:
+    // ӿڴС仯ʱؽȾĿ꣬ʧʱfalse
+    bool ensureTargets(int width, int height);
+    void releaseTargets();
+
+    GLuint m_fbo = 0;               // ɼͨ + 
+    GLuint m_ids = 0;               // RG32UIx = Ʊ + 1 (0ʾ)y = ڵͼԪ
+    GLuint m_depth = 0;             // 32λϳʱдgl_FragDepth
+    GLuint m_resolveFbo = 0;        // ͽͨɫ + 
+    GLuint m_color = 0;             // RGBA8ͨɫ
+    GLuint m_materialDepth = 0;     // 32λȻ壬ÿصĲ (Ϊ1)
+    GLuint m_emptyVao = 0;          // ȫεĶgl_VertexID
+    int m_width = 0;
+    int m_height = 0;
+};
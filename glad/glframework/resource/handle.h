@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+// Handle32λִResourcePoolеԴ
+// - 20λλ± (Լ100ͬԴ)
+// - 12λλĴλÿͷһδһ
+// Դٺ󣬾ɾĴλһ£ʱֱӷnullptrڴ档
+// 1ʼֵ0Զʾվ
+template<typename T>
+class Handle {
+public:
+    static constexpr uint32_t INDEX_BITS = 20;
+    static constexpr uint32_t GENERATION_BITS = 12;
+    static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+    static constexpr uint32_t GENERATION_MASK = (1u << GENERATION_BITS) - 1;
+    static constexpr uint32_t MAX_INDEX = INDEX_MASK;
+
+    Handle() = default;
+    Handle(uint32_t index, uint32_t generation)
+        : m_value((index & INDEX_MASK) | ((generation & GENERATION_MASK) << INDEX_BITS)) {}
+
+    uint32_t getIndex() const { return m_value & INDEX_MASK; }
+    uint32_t getGeneration() const { return (m_value >> INDEX_BITS) & GENERATION_MASK; }
+    uint32_t getValue() const { return m_value; }
+
+    // վ (δָκԴ)ע⣺ǿվҲѾڣҪͨResourcePoolж
+    bool isNull() const { return m_value == 0; }
+    explicit operator bool() const { return m_value != 0; }
+
+    bool operator==(const Handle& other) const { return m_value == other.m_value; }
+    bool operator!=(const Handle& other) const { return m_value != other.m_value; }
+    bool operator<(const Handle& other) const { return m_value < other.m_value; }
+
+private:
+    uint32_t m_value = 0;
+};
+
+// Ϊunordered_mapļ
+namespace std {
+    template<typename T>
+    struct hash<Handle<T>> {
+        size_t operator()(const Handle<T>& handle) const { return std::hash<uint32_t>()(handle.getValue()); }
+    };
+}
+
+class Mesh;
+class Material;
+class Texture;
+class Shader;
+
+using MeshHandle = Handle<Mesh>;
+using MaterialHandle = Handle<Material>;
+using TextureHandle = Handle<Texture>;
+using ShaderHandle = Handle<Shader>;
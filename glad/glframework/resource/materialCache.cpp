@@ -0,0 +1,116 @@
+#include "materialCache.h"
+#include "resourceManager.h"
+
+#include <cstring>
+#include <filesystem>
+
+MaterialCache* MaterialCache::mInstance = nullptr;
+MaterialCache* MaterialCache::getInstance() {
+    if (mInstance == nullptr) {
+        mInstance = new MaterialCache();
+    }
+    return mInstance;
+}
+
+MaterialCache::MaterialCache() {
+    // ԴʱƳӦĿ⻺
+    ResourceManager* resourceManager = ResourceManager::getInstance();
+    resourceManager->materials().addReleaseHook([this](MaterialHandle handle, Material&) {
+        for (auto it = m_materials.begin(); it != m_materials.end(); ++it) {
+            if (it->second == handle) {
+                m_materials.erase(it);
+                break;
+            }
+        }
+    });
+    resourceManager->textures().addReleaseHook([this](TextureHandle handle, Texture&) {
+        for (auto it = m_textures.begin(); it != m_textures.end(); ++it) {
+            if (it->second == handle) {
+                m_textures.erase(it);
+                break;
+            }
+        }
+    });
+}
+
+size_t MaterialCache::MaterialKeyHash::operator()(const MaterialKey& key) const {
+    // KsͲ͸Ȱλϣ0.0f-0+0operator==Ƚϱһ
+    size_t hash = std::hash<std::string>()(key.textureKey);
+    const float components[4] = { key.Ks.x, key.Ks.y, key.Ks.z, key.opacity };
+    for (float value : components) {
+        float component = value + 0.0f;
+        uint32_t bits;
+        memcpy(&bits, &component, sizeof(bits));
+        hash ^= std::hash<uint32_t>()(bits) + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+MaterialHandle MaterialCache::acquire(const MaterialData& data) {
+    // ͬһļԲͬд ("a/../b.png""a\\b.png")
+    std::string textureKey = data.diffuseTexturePath.empty()
+        ? std::string()
+        : std::filesystem::path(data.diffuseTexturePath).lexically_normal().generic_string();
+    return acquire(data.name, MaterialKey{ data.Ks, data.opacity, textureKey }, data.diffuseTexturePath, [&]() {
+        ResourceManager* resourceManager = ResourceManager::getInstance();
+        // ѽʱֻGLϴ·ͬ
+        return !data.diffuseImage.empty()
+            ? resourceManager->create<Texture>(data.diffuseImage, 0)
+            : resourceManager->create<Texture>(data.diffuseTexturePath, 0);
+    });
+}
+
+MaterialHandle MaterialCache::acquire(const std::string& name, const glm::vec3& Ks, float opacity, const std::string& textureKey,
+    const std::function<TextureHandle()>& loadTexture) {
+    return acquire(name, MaterialKey{ Ks, opacity, textureKey }, std::string(), loadTexture);
+}
+
+MaterialHandle MaterialCache::acquire(const std::string& name, const MaterialKey& key, const std::string& texturePath,
+    const std::function<TextureHandle()>& loadTexture) {
+    ResourceManager* resourceManager = ResourceManager::getInstance();
+    m_stats.requests++;
+
+    auto it = m_materials.find(key);
+    if (it != m_materials.end() && resourceManager->materials().isAlive(it->second)) {
+        resourceManager->addRef(it->second);
+        return it->second;
+    }
+
+    // ͼȸеģ򴴽 (صڲʳԼúͷ)
+    TextureHandle texture;
+    bool ownsTextureRef = false;
+    if (!key.textureKey.empty()) {
+        auto textureIt = m_textures.find(key.textureKey);
+        if (textureIt != m_textures.end() && resourceManager->textures().isAlive(textureIt->second)) {
+            texture = textureIt->second;
+            m_stats.texturesShared++;
+        }
+        else {
+            texture = loadTexture();
+            ownsTextureRef = true;
+            if (texture) {
+                m_textures[key.textureKey] = texture;
+            }
+        }
+    }
+
+    MaterialHandle handle = resourceManager->create<Material>(name, key.Ks, texture, key.opacity);
+    if (ownsTextureRef && texture) {
+        resourceManager->release(texture);
+    }
+    Material* material = resourceManager->get(handle);
+    if (material) {
+        // ذ·ͼ
+        material->m_diffuseTexturePath = texturePath;
+    }
+    m_materials[key] = handle;
+    m_stats.materialsCreated++;
+    return handle;
+}
+
+void MaterialCache::logStats(const std::string& sceneName) const {
+    double ratio = m_stats.materialsCreated > 0 ? static_cast<double>(m_stats.requests) / static_cast<double>(m_stats.materialsCreated) : 1.0;
+    std::cout << "Material dedup '" << sceneName << "': " << m_stats.requests << " material references -> "
+        << m_stats.materialsCreated << " materials created (merge ratio " << ratio << ":1), "
+        << m_stats.texturesShared << " textures shared, " << m_materials.size() << " unique materials alive." << std::endl;
+}
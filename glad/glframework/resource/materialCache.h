@@ -0,0 +1,70 @@
+#pragma once
+
+#include "handle.h"
+#include "../core.h"          // glm
+#include "../material.h"      // MaterialData
+
+#include <functional>         // ͼӳٴ
+#include <string>             // std::string
+#include <unordered_map>      // ڰݹϣҲ
+
+// MaterialCacheȫΨһĲʹ淶
+// ͬģ (Լͬһģвͬ) ĲֻҪͼͬ͹ͬһMaterial
+// Ӷͬһʾ/ʱͬһλá
+// - Ϊʲ (Ks͸) ͼʶ (ͼļ·ԴеĿ) ĹϣƲȽϣ
+// - ͬͼʶͼҲֻһΣʹʲͬ
+// - 治ãʺͼʹߵüResourceManagerպ󻺴ĿԶʧЧ
+// - Ĳʲԭ޸ģ仯ʱacquireõһ淶ʡ
+// GLԴֻGL߳ʹá
+class MaterialCache {
+public:
+    struct Stats {
+        size_t requests = 0;        // acquire (ȥʱᴴĲʸ)
+        size_t materialsCreated = 0;
+        size_t texturesShared = 0;  // ²ʸͼĴ
+    };
+
+    static MaterialCache* getInstance();
+
+    // dataͼͬĹ淶ʣʱصľһá
+    MaterialHandle acquire(const MaterialData& data);
+
+    // ͬϣͼɵ߰贴 (Դ)
+    // - textureKey: ͼΨһʶΪձʾûͼ
+    // - loadTexture: ûиͼʱãسһõͼʴɻͷš
+    MaterialHandle acquire(const std::string& name, const glm::vec3& Ks, float opacity, const std::string& textureKey,
+        const std::function<TextureHandle()>& loadTexture);
+
+    // ǰĹ淶ʸ
+    size_t getMaterialCount() const { return m_materials.size(); }
+    const Stats& getStats() const { return m_stats; }
+    void resetStats() { m_stats = Stats(); }
+
+    // һȥͳƣʵʴĲͺϲ
+    void logStats(const std::string& sceneName) const;
+
+private:
+    MaterialCache();
+
+    struct MaterialKey {
+        glm::vec3 Ks;
+        float opacity;
+        std::string textureKey;
+        bool operator==(const MaterialKey& other) const {
+            return Ks == other.Ks && opacity == other.opacity && textureKey == other.textureKey;
+        }
+    };
+    struct MaterialKeyHash {
+        size_t operator()(const MaterialKey& key) const;
+    };
+
+    MaterialHandle acquire(const std::string& name, const MaterialKey& key, const std::string& texturePath,
+        const std::function<TextureHandle()>& loadTexture);
+
+private:
+    static MaterialCache* mInstance;
+
+    std::unordered_map<MaterialKey, MaterialHandle, MaterialKeyHash> m_materials;
+    std::unordered_map<std::string, TextureHandle> m_textures;  // ͼʶ -> ͼ
+    Stats m_stats;
+};
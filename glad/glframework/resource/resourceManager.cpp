@@ -0,0 +1,40 @@
+#include "resourceManager.h"
+
+// ʼResourceManagerľ̬
+ResourceManager* ResourceManager::mInstance = nullptr;
+ResourceManager* ResourceManager::getInstance() {
+    if (mInstance == nullptr) {
+        mInstance = new ResourceManager();
+    }
+    return mInstance;
+}
+
+ResourceManager::ResourceManager() {
+
+}
+
+ResourceManager::~ResourceManager() {
+
+}
+
+size_t ResourceManager::collectGarbage() {
+    size_t destroyed = 0;
+    destroyed += m_meshes.collect();
+    destroyed += m_materials.collect();
+    destroyed += m_textures.collect();
+    destroyed += m_shaders.collect();
+    return destroyed;
+}
+
+void ResourceManager::shutdown() {
+    size_t destroyed = collectGarbage();
+
+    // ȻԴ˵оûбreleaseй©
+    size_t leaked = m_meshes.size() + m_materials.size() + m_textures.size() + m_shaders.size();
+    if (leaked > 0) {
+        std::cerr << "WARNING: ResourceManager shutdown with " << leaked << " live resources ("
+            << m_meshes.size() << " meshes, " << m_materials.size() << " materials, "
+            << m_textures.size() << " textures, " << m_shaders.size() << " shaders)." << std::endl;
+    }
+    std::cout << "ResourceManager shutdown, " << destroyed << " resources released." << std::endl;
+}
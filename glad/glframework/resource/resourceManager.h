@@ -0,0 +1,63 @@
+#pragma once
+
+#include "resourcePool.h"
+#include "../mesh.h"
+#include "../material.h"
+#include "../texture.h"
+#include "../shader.h"
+
+// ResourceManagerȫΨһԴ
+// ͳMesh/Material/Texture/ShaderĳԴأԴִͨá
+// - create*Դصľһã
+// - addRef/releaseüԴӳٵcollectGarbage()٣
+// - collectGarbageÿ֡ʱGL̵߳һΣͳһͷGL
+class ResourceManager {
+public:
+    ~ResourceManager();
+
+    static ResourceManager* getInstance();
+
+    // ȡԴ
+    ResourcePool<Mesh>& meshes() { return m_meshes; }
+    ResourcePool<Material>& materials() { return m_materials; }
+    ResourcePool<Texture>& textures() { return m_textures; }
+    ResourcePool<Shader>& shaders() { return m_shaders; }
+
+    template<typename T> ResourcePool<T>& pool();
+
+    template<typename T, typename... Args>
+    Handle<T> create(Args&&... args) { return pool<T>().create(std::forward<Args>(args)...); }
+
+    template<typename T>
+    T* get(Handle<T> handle) { return pool<T>().get(handle); }
+
+    template<typename T>
+    void addRef(Handle<T> handle) { pool<T>().addRef(handle); }
+
+    template<typename T>
+    void release(Handle<T> handle) { pool<T>().release(handle); }
+
+    // üΪ0Դ
+    // ˳Mesh -> Material -> Texture -> ShaderϲԴʱͷŵ²Դͬһεбա
+    // رٵԴ
+    size_t collectGarbage();
+
+    // ˳ǰ (GLȻЧʱ)дͷԴй©Դ
+    void shutdown();
+
+private:
+    ResourceManager();
+
+private:
+    static ResourceManager* mInstance;
+
+    ResourcePool<Mesh> m_meshes;
+    ResourcePool<Material> m_materials;
+    ResourcePool<Texture> m_textures;
+    ResourcePool<Shader> m_shaders;
+};
+
+template<> inline ResourcePool<Mesh>& ResourceManager::pool<Mesh>() { return m_meshes; }
+template<> inline ResourcePool<Material>& ResourceManager::pool<Material>() { return m_materials; }
+template<> inline ResourcePool<Texture>& ResourceManager::pool<Texture>() { return m_textures; }
+template<> inline ResourcePool<Shader>& ResourceManager::pool<Shader>() { return m_shaders; }
@@ -0,0 +1,192 @@
+#pragma once
+
+#include "handle.h"
+
+#include <vector>             // std::vector
+#include <functional>         // std::function
+#include <utility>            // std::move, std::forward
+#include <iostream>           // std::cerrе
+
+// ResourcePoolͬһԴĳܴ洢
+// - Դm_denseУʱҪ׷ָ룻
+// - ͨλ(m_slots)ҵеλãɾʱĩβԪذᵽն
+// - ÿλüԴͷбcollect()ͳһٲͷŻص
+// ע⣺create()/collect()ƶеԪأget()صָ벻ҪԽñ档
+template<typename T>
+class ResourcePool {
+public:
+    using HandleType = Handle<T>;
+    using ReleaseHook = std::function<void(HandleType, T&)>;
+
+    ResourcePool() = default;
+    ~ResourcePool() = default;
+
+    ResourcePool(const ResourcePool&) = delete;
+    ResourcePool& operator=(const ResourcePool&) = delete;
+
+    // ԭعһԴʼüΪ1 (ɴ߳)
+    template<typename... Args>
+    HandleType create(Args&&... args) {
+        uint32_t slotIndex;
+        if (!m_freeSlots.empty()) {
+            slotIndex = m_freeSlots.back();
+            m_freeSlots.pop_back();
+        }
+        else {
+            if (m_slots.size() > HandleType::MAX_INDEX) {
+                std::cerr << "ERROR: ResourcePool exhausted, too many live resources." << std::endl;
+                return HandleType();
+            }
+            slotIndex = static_cast<uint32_t>(m_slots.size());
+            m_slots.push_back(Slot());
+        }
+
+        Slot& slot = m_slots[slotIndex];
+        slot.denseIndex = static_cast<uint32_t>(m_dense.size());
+        slot.refCount = 1;
+        slot.pendingRelease = false;
+
+        m_dense.emplace_back(std::forward<Args>(args)...);
+        m_denseToSlot.push_back(slotIndex);
+        return HandleType(slotIndex, slot.generation);
+    }
+
+    // þΪջѹʱnullptr
+    T* get(HandleType handle) {
+        const Slot* slot = findSlot(handle);
+        return slot ? &m_dense[slot->denseIndex] : nullptr;
+    }
+    const T* get(HandleType handle) const {
+        const Slot* slot = findSlot(handle);
+        return slot ? &m_dense[slot->denseIndex] : nullptr;
+    }
+
+    bool isAlive(HandleType handle) const { return findSlot(handle) != nullptr; }
+
+    // һ
+    void addRef(HandleType handle) {
+        Slot* slot = findSlot(handle);
+        if (slot) {
+            slot->refCount++;
+        }
+    }
+
+    // ͷһãʱ٣ǽͷб
+    // collect()ڰȫʱ (һ֡GLЧʱ) ͳһ١
+    void release(HandleType handle) {
+        Slot* slot = findSlot(handle);
+        if (!slot || slot->refCount == 0) {
+            return;
+        }
+        slot->refCount--;
+        if (slot->refCount == 0 && !slot->pendingRelease) {
+            slot->pendingRelease = true;
+            m_pending.push_back(handle);
+        }
+    }
+
+    uint32_t getRefCount(HandleType handle) const {
+        const Slot* slot = findSlot(handle);
+        return slot ? slot->refCount : 0;
+    }
+
+    // עͷŻصԴ֮ǰ
+    void addReleaseHook(ReleaseHook hook) { m_releaseHooks.push_back(std::move(hook)); }
+
+    // üΪ0Դٵĸ
+    size_t collect() {
+        size_t destroyed = 0;
+        // ͷŻصпܻͷͬصԴѭֱбΪ
+        while (!m_pending.empty()) {
+            std::vector<HandleType> pending;
+            pending.swap(m_pending);
+
+            for (HandleType handle : pending) {
+                Slot* slot = findSlot(handle);
+                if (!slot || !slot->pendingRelease) {
+                    continue;
+                }
+                slot->pendingRelease = false;
+                if (slot->refCount > 0) {
+                    continue; // ͷбֱ֮
+                }
+
+                T& resource = m_dense[slot->denseIndex];
+                for (auto& hook : m_releaseHooks) {
+                    hook(handle, resource);
+                }
+                destroy(handle.getIndex());
+                destroyed++;
+            }
+        }
+        return destroyed;
+    }
+
+    // ʣ·ֱԱдԴ
+    size_t size() const { return m_dense.size(); }
+    T* data() { return m_dense.data(); }
+    typename std::vector<T>::iterator begin() { return m_dense.begin(); }
+    typename std::vector<T>::iterator end() { return m_dense.end(); }
+
+    // denseIndexԪضӦľ
+    HandleType handleAt(size_t denseIndex) const {
+        uint32_t slotIndex = m_denseToSlot[denseIndex];
+        return HandleType(slotIndex, m_slots[slotIndex].generation);
+    }
+
+private:
+    struct Slot {
+        uint32_t denseIndex = 0;
+        uint32_t generation = 1;  // 1ʼ֤ЧֵΪ0
+        uint32_t refCount = 0;
+        bool pendingRelease = false;
+    };
+
+    Slot* findSlot(HandleType handle) {
+        return const_cast<Slot*>(static_cast<const ResourcePool*>(this)->findSlot(handle));
+    }
+    const Slot* findSlot(HandleType handle) const {
+        if (handle.isNull()) {
+            return nullptr;
+        }
+        uint32_t index = handle.getIndex();
+        if (index >= m_slots.size()) {
+            return nullptr;
+        }
+        const Slot& slot = m_slots[index];
+        if (slot.generation != handle.getGeneration() || (slot.refCount == 0 && !slot.pendingRelease)) {
+            return nullptr;
+        }
+        return &slot;
+    }
+
+    // ٲλӦԴѳĩβԪƶնִ洢
+    void destroy(uint32_t slotIndex) {
+        Slot& slot = m_slots[slotIndex];
+        uint32_t hole = slot.denseIndex;
+        uint32_t last = static_cast<uint32_t>(m_dense.size() - 1);
+        if (hole != last) {
+            m_dense[hole] = std::move(m_dense[last]);
+            m_denseToSlot[hole] = m_denseToSlot[last];
+            m_slots[m_denseToSlot[hole]].denseIndex = hole;
+        }
+        m_dense.pop_back();
+        m_denseToSlot.pop_back();
+
+        // һʹоɾʧЧ0ֵ֤Ϊ0
+        slot.generation = (slot.generation + 1) & HandleType::GENERATION_MASK;
+        if (slot.generation == 0) {
+            slot.generation = 1;
+        }
+        slot.refCount = 0;
+        m_freeSlots.push_back(slotIndex);
+    }
+
+private:
+    std::vector<T> m_dense;                 // 洢Դ
+    std::vector<uint32_t> m_denseToSlot;    // ± -> λ±
+    std::vector<Slot> m_slots;              // λ (±)
+    std::vector<uint32_t> m_freeSlots;      // ɸõĲλ
+    std::vector<HandleType> m_pending;      // ü㡢ȴٵԴ
+    std::vector<ReleaseHook> m_releaseHooks;
+};
@@ -5,41 +5,73 @@
 #include<fstream>
 #include<sstream>
 #include<iostream>
+#include<utility>
 
-Shader::Shader(const char* vertexPath, const char* fragmentPath) {
+Shader::Shader(const char* vertexPath, const char* fragmentPath)
+	: mVertexPath(vertexPath), mFragmentPath(fragmentPath) {
 	//װshaderַstring
 	std::string vertexCode;
 	std::string fragmentCode;
+	readSource(mVertexPath, vertexCode);
+	readSource(mFragmentPath, fragmentCode);
 
-	//ڶȡvsfsļinFileStream
-	std::ifstream vShaderFile;
-	std::ifstream fShaderFile;
+	bool success = false;
+	mProgram = createProgram(vertexCode, fragmentCode, success);
+}
+
+bool Shader::reload() {
+	std::string vertexCode;
+	std::string fragmentCode;
+	if (!readSource(mVertexPath, vertexCode) || !readSource(mFragmentPath, fragmentCode)) {
+		return false;
+	}
+
+	bool success = false;
+	GLuint program = createProgram(vertexCode, fragmentCode, success);
+	if (!success) {
+		//ɵprogramʹһγɹİ汾
+		glDeleteProgram(program);
+		std::cout << "WARNING: Shader reload failed, keeping previous program: " << mVertexPath << ", " << mFragmentPath << std::endl;
+		return false;
+	}
+
+	//uniform locationÿζƲѯ滻programҪ⴦
+	if (mProgram != 0) {
+		glDeleteProgram(mProgram);
+	}
+	mProgram = program;
+	std::cout << "Shader reloaded: " << mVertexPath << ", " << mFragmentPath << std::endl;
+	return true;
+}
+
+bool Shader::readSource(const std::string& path, std::string& code) {
+	//ڶȡshaderļinFileStream
+	std::ifstream shaderFile;
 
 	//֤ifstreamʱ׳쳣
-	vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-	fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+	shaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
 	try {
 		//1 ļ
-		vShaderFile.open(vertexPath);
-		fShaderFile.open(fragmentPath);
-		
+		shaderFile.open(path);
+
 		//2 ļеַ뵽stringStream
-		std::stringstream vShaderStream, fShaderStream;
-		vShaderStream << vShaderFile.rdbuf();
-		fShaderStream << fShaderFile.rdbuf();
+		std::stringstream shaderStream;
+		shaderStream << shaderFile.rdbuf();
 
 		//3 رļ
-		vShaderFile.close();
-		fShaderFile.close();
+		shaderFile.close();
 
 		//4 ַstringStreamжȡתcode String
-		vertexCode = vShaderStream.str();
-		fragmentCode = fShaderStream.str();
+		code = shaderStream.str();
 	}
 	catch (std::ifstream::failure& e) {
-		std::cout << "ERROR: Shader File Error: " << e.what() << std::endl;
+		std::cout << "ERROR: Shader File Error: " << path << " " << e.what() << std::endl;
+		return false;
 	}
+	return true;
+}
 
+GLuint Shader::createProgram(const std::string& vertexCode, const std::string& fragmentCode, bool& success) {
 	const char* vertexShaderSource = vertexCode.c_str();
 	const char* fragmentShaderSource = fragmentCode.c_str();
 	//1 Shadervsfs
@@ -54,31 +86,45 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath) {
 	//3 ִshader 
 	glCompileShader(vertex);
 	//vertex
-	checkShaderErrors(vertex, "COMPILE");
+	success = checkShaderErrors(vertex, "COMPILE");
 	
 	glCompileShader(fragment);
 	//fragment
-	checkShaderErrors(fragment, "COMPILE");
+	success = checkShaderErrors(fragment, "COMPILE") && success;
 	
 	//4 һProgram
-	mProgram = glCreateProgram();
+	GLuint program = glCreateProgram();
 
 	//6 vsfsõĽŵprogram
-	glAttachShader(mProgram, vertex);
-	glAttachShader(mProgram, fragment);
+	glAttachShader(program, vertex);
+	glAttachShader(program, fragment);
 
 	//7 ִprogramӲγտִshader
-	glLinkProgram(mProgram);
+	glLinkProgram(program);
 
 	//Ӵ
-	checkShaderErrors(mProgram, "LINK");
+	success = checkShaderErrors(program, "LINK") && success;
 
 	//
 	glDeleteShader(vertex);
 	glDeleteShader(fragment);
+	return program;
 }
 Shader::~Shader() {
+	if (mProgram != 0) {
+		glDeleteProgram(mProgram);
+	}
+}
+
+Shader::Shader(Shader&& other) noexcept {
+	*this = std::move(other);
+}
 
+Shader& Shader::operator=(Shader&& other) noexcept {
+	std::swap(mProgram, other.mProgram);
+	std::swap(mVertexPath, other.mVertexPath);
+	std::swap(mFragmentPath, other.mFragmentPath);
+	return *this;
 }
 
 void Shader::begin() {
@@ -115,6 +161,12 @@ void Shader::setVector3(const std::string& name, const float* values) {
 	GL_CALL(glUniform3fv(location, 1, values));
 }
 
+void Shader::setVector4(const std::string& name, const float* values, int count) {
+	//uniformõ0Ԫصλãһθcountvec4
+	GLint location = GL_CALL(glGetUniformLocation(mProgram, name.c_str()));
+	GL_CALL(glUniform4fv(location, count, values));
+}
+
 void Shader::setInt(const std::string& name, int value) {
 	//1 ͨõUniformλLocation
 	GLint location = GL_CALL(glGetUniformLocation(mProgram, name.c_str()));
@@ -132,11 +184,19 @@ void Shader::setMatrix4x4(const std::string& name, glm::mat4 value) {
 	glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
 }
 
+void Shader::setMatrix3x3(const std::string& name, glm::mat3 value) {
+	//1 ͨõUniformλLocation
+	GLint location = GL_CALL(glGetUniformLocation(mProgram, name.c_str()));
+
+	//2 ͨLocationUniformֵ
+	GL_CALL(glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(value)));
+}
+
 
 
 
 
-void Shader::checkShaderErrors(GLuint target, std::string type) {
+bool Shader::checkShaderErrors(GLuint target, std::string type) {
 	int success = 0;
 	char infoLog[1024];
 
@@ -157,4 +217,5 @@ void Shader::checkShaderErrors(GLuint target, std::string type) {
 	else {
 		std::cout << "Error: Check shader errors Type is wrong" << std::endl;
 	}
+	return success != 0;
 }
\ No newline at end of file
@@ -7,6 +7,19 @@ class Shader {
 public:
 	Shader(const char* vertexPath, const char* fragmentPath);
 	~Shader();
+
+	//ֹֻƶƶֵýʵ֣
+	Shader(const Shader&) = delete;
+	Shader& operator=(const Shader&) = delete;
+	Shader(Shader&& other) noexcept;
+	Shader& operator=(Shader&& other) noexcept;
+	
+	//¶ȡvs/fsļأGL̵߳
+	//ʧʱԭprogramfalse治Ϊһдshaderж
+	bool reload();
+
+	const std::string& getVertexPath() const { return mVertexPath; }
+	const std::string& getFragmentPath() const { return mFragmentPath; }
 	
 	void begin();//ʼʹõǰShader
 
@@ -17,14 +30,28 @@ public:
 	void setVector3(const std::string& name, float x, float y, float z);
 	void setVector3(const std::string& name, const float* values);
 
+	//countuniformvec4ʱһθµԪظ
+	void setVector4(const std::string& name, const float* values, int count = 1);
+
 	void setInt(const std::string& name, int value);
 
 	void setMatrix4x4(const std::string& name, glm::mat4 value);
+
+	void setMatrix3x3(const std::string& name, glm::mat3 value);
 private:
+	//ȡshaderļȫݣʧʱfalse
+	static bool readSource(const std::string& path, std::string& code);
+
+	//vs/fsӳprogramsuccessرǷ񶼳ɹ
+	GLuint createProgram(const std::string& vertexCode, const std::string& fragmentCode, bool& success);
+
 	//shader program
 	//type:COMPILE LINK
-	void checkShaderErrors(GLuint target,std::string type);
+	//ؼǷͨ
+	bool checkShaderErrors(GLuint target,std::string type);
 
 private:
 	GLuint mProgram{ 0 };
+	std::string mVertexPath;
+	std::string mFragmentPath;
 };
@@ -0,0 +1,353 @@
+#include "geometryKernels.h"
+#include "../job/jobSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define GEOMETRY_KERNELS_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+// MSVCҪѡͿʹAVX2ڽ
+#define TARGET_AVX2
+#else
+// GCC/ClangֻЩAVX2룬Ȼڲ֧AVX2CPU
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace geometry {
+namespace {
+    constexpr float FLOAT_MAX = std::numeric_limits<float>::max();
+    constexpr float FLOAT_LOWEST = std::numeric_limits<float>::lowest();
+
+    // ---------------- ʵ ----------------
+
+    void boundsScalar(const float* p, size_t count, float* minOut, float* maxOut) {
+        float minX = FLOAT_MAX, minY = FLOAT_MAX, minZ = FLOAT_MAX;
+        float maxX = FLOAT_LOWEST, maxY = FLOAT_LOWEST, maxZ = FLOAT_LOWEST;
+        for (size_t i = 0; i < count; ++i, p += 3) {
+            minX = std::min(minX, p[0]); maxX = std::max(maxX, p[0]);
+            minY = std::min(minY, p[1]); maxY = std::max(maxY, p[1]);
+            minZ = std::min(minZ, p[2]); maxZ = std::max(maxZ, p[2]);
+        }
+        minOut[0] = std::min(minOut[0], minX); maxOut[0] = std::max(maxOut[0], maxX);
+        minOut[1] = std::min(minOut[1], minY); maxOut[1] = std::max(maxOut[1], maxY);
+        minOut[2] = std::min(minOut[2], minZ); maxOut[2] = std::max(maxOut[2], maxZ);
+    }
+
+    float maxDistanceSquaredScalar(const float* p, size_t count, const float* center) {
+        float result = 0.0f;
+        for (size_t i = 0; i < count; ++i, p += 3) {
+            float dx = p[0] - center[0];
+            float dy = p[1] - center[1];
+            float dz = p[2] - center[2];
+            result = std::max(result, dx * dx + dy * dy + dz * dz);
+        }
+        return result;
+    }
+
+    // glmmat4 * vec4ͬ˳(c0*x + c1*y) + (c2*z + c3*1)
+    void transformScalar(const float* m, const float* positions, const float* texCoords, size_t texCoordCount,
+        const VertexIndices* vertices, size_t count, float* out) {
+        for (size_t i = 0; i < count; ++i, out += 5) {
+            const float* p = positions + size_t(vertices[i].posIndex) * 3;
+            for (int row = 0; row < 3; ++row) {
+                out[row] = (m[row] * p[0] + m[4 + row] * p[1]) + (m[8 + row] * p[2] + m[12 + row]);
+            }
+            uint32_t t = vertices[i].texCoordIndex;
+            out[3] = t < texCoordCount ? texCoords[size_t(t) * 2] : 0.0f;
+            out[4] = t < texCoordCount ? texCoords[size_t(t) * 2 + 1] : 0.0f;
+        }
+    }
+
+#ifdef GEOMETRY_KERNELS_X86
+    // ÿԪе±3ȡķ (AoSxyz)ۼ󰴷Լ
+    void reduceLanes(const float* lanes, size_t laneCount, float* out, bool isMax) {
+        for (size_t i = 0; i < laneCount; ++i) {
+            float& target = out[i % 3];
+            target = isMax ? std::max(target, lanes[i]) : std::min(target, lanes[i]);
+        }
+    }
+
+    // 4 (12float) AoSתΪSoAa = x0 y0 z0 x1, b = y1 z1 x2 y2, c = z2 x3 y3 z3
+    inline void transposeSse(__m128 a, __m128 b, __m128 c, __m128& x, __m128& y, __m128& z) {
+        x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+        y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+        z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), c, _MM_SHUFFLE(3, 0, 2, 0));
+    }
+
+    // ---------------- SSE2 ----------------
+
+    void boundsSse2(const float* p, size_t count, float* minOut, float* maxOut) {
+        __m128 min0 = _mm_set1_ps(FLOAT_MAX), min1 = min0, min2 = min0;
+        __m128 max0 = _mm_set1_ps(FLOAT_LOWEST), max1 = max0, max2 = max0;
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4, p += 12) {
+            __m128 a = _mm_loadu_ps(p), b = _mm_loadu_ps(p + 4), c = _mm_loadu_ps(p + 8);
+            min0 = _mm_min_ps(min0, a); max0 = _mm_max_ps(max0, a);
+            min1 = _mm_min_ps(min1, b); max1 = _mm_max_ps(max1, b);
+            min2 = _mm_min_ps(min2, c); max2 = _mm_max_ps(max2, c);
+        }
+        float lanes[12];
+        _mm_storeu_ps(lanes, min0); _mm_storeu_ps(lanes + 4, min1); _mm_storeu_ps(lanes + 8, min2);
+        reduceLanes(lanes, 12, minOut, false);
+        _mm_storeu_ps(lanes, max0); _mm_storeu_ps(lanes + 4, max1); _mm_storeu_ps(lanes + 8, max2);
+        reduceLanes(lanes, 12, maxOut, true);
+        boundsScalar(p, count - i, minOut, maxOut);
+    }
+
+    float maxDistanceSquaredSse2(const float* p, size_t count, const float* center) {
+        __m128 cx = _mm_set1_ps(center[0]), cy = _mm_set1_ps(center[1]), cz = _mm_set1_ps(center[2]);
+        __m128 result = _mm_setzero_ps();
+        size_t i = 0;
+        for (; i + 4 <= count; i += 4, p += 12) {
+            __m128 x, y, z;
+            transposeSse(_mm_loadu_ps(p), _mm_loadu_ps(p + 4), _mm_loadu_ps(p + 8), x, y, z);
+            __m128 dx = _mm_sub_ps(x, cx), dy = _mm_sub_ps(y, cy), dz = _mm_sub_ps(z, cz);
+            __m128 d2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+            result = _mm_max_ps(result, d2);
+        }
+        float lanes[4];
+        _mm_storeu_ps(lanes, result);
+        float tail = maxDistanceSquaredScalar(p, count - i, center);
+        return std::max({ lanes[0], lanes[1], lanes[2], lanes[3], tail });
+    }
+
+    // ÿһ㣬4Ĵһгһд4float4ٱU (ÿ5floatԽ)
+    void transformSse2(const float* m, const float* positions, const float* texCoords, size_t texCoordCount,
+        const VertexIndices* vertices, size_t count, float* out) {
+        __m128 c0 = _mm_loadu_ps(m), c1 = _mm_loadu_ps(m + 4), c2 = _mm_loadu_ps(m + 8), c3 = _mm_loadu_ps(m + 12);
+        for (size_t i = 0; i < count; ++i, out += 5) {
+            const float* p = positions + size_t(vertices[i].posIndex) * 3;
+            __m128 xy = _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(p[0])), _mm_mul_ps(c1, _mm_set1_ps(p[1])));
+            __m128 zw = _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(p[2])), c3);
+            _mm_storeu_ps(out, _mm_add_ps(xy, zw));
+            uint32_t t = vertices[i].texCoordIndex;
+            out[3] = t < texCoordCount ? texCoords[size_t(t) * 2] : 0.0f;
+            out[4] = t < texCoordCount ? texCoords[size_t(t) * 2 + 1] : 0.0f;
+        }
+    }
+
+    // ---------------- AVX2 ----------------
+
+    TARGET_AVX2 void boundsAvx2(const float* p, size_t count, float* minOut, float* maxOut) {
+        // 83256λĴ
+        __m256 min0 = _mm256_set1_ps(FLOAT_MAX), min1 = min0, min2 = min0;
+        __m256 max0 = _mm256_set1_ps(FLOAT_LOWEST), max1 = max0, max2 = max0;
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8, p += 24) {
+            __m256 a = _mm256_loadu_ps(p), b = _mm256_loadu_ps(p + 8), c = _mm256_loadu_ps(p + 16);
+            min0 = _mm256_min_ps(min0, a); max0 = _mm256_max_ps(max0, a);
+            min1 = _mm256_min_ps(min1, b); max1 = _mm256_max_ps(max1, b);
+            min2 = _mm256_min_ps(min2, c); max2 = _mm256_max_ps(max2, c);
+        }
+        float lanes[24];
+        _mm256_storeu_ps(lanes, min0); _mm256_storeu_ps(lanes + 8, min1); _mm256_storeu_ps(lanes + 16, min2);
+        reduceLanes(lanes, 24, minOut, false);
+        _mm256_storeu_ps(lanes, max0); _mm256_storeu_ps(lanes + 8, max1); _mm256_storeu_ps(lanes + 16, max2);
+        reduceLanes(lanes, 24, maxOut, true);
+        boundsSse2(p, count - i, minOut, maxOut);
+    }
+
+    TARGET_AVX2 inline __m256 loadTwoAvx2(const float* low, const float* high) {
+        return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(low)), _mm_loadu_ps(high), 1);
+    }
+
+    TARGET_AVX2 float maxDistanceSquaredAvx2(const float* p, size_t count, const float* center) {
+        __m256 cx = _mm256_set1_ps(center[0]), cy = _mm256_set1_ps(center[1]), cz = _mm256_set1_ps(center[2]);
+        __m256 result = _mm256_setzero_ps();
+        size_t i = 0;
+        for (; i + 8 <= count; i += 8, p += 24) {
+            // 128λǶ0-3128λǶ4-7shuffleиtransposeSseͬת
+            __m256 a = loadTwoAvx2(p, p + 12), b = loadTwoAvx2(p + 4, p + 16), c = loadTwoAvx2(p + 8, p + 20);
+            __m256 x = _mm256_shuffle_ps(a, _mm256_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+            __m256 y = _mm256_shuffle_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+            __m256 z = _mm256_shuffle_ps(_mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), c, _MM_SHUFFLE(3, 0, 2, 0));
+            __m256 dx = _mm256_sub_ps(x, cx), dy = _mm256_sub_ps(y, cy), dz = _mm256_sub_ps(z, cz);
+            __m256 d2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz));
+            result = _mm256_max_ps(result, d2);
+        }
+        float lanes[8];
+        _mm256_storeu_ps(lanes, result);
+        float tail = maxDistanceSquaredSse2(p, count - i, center);
+        return std::max({ lanes[0], lanes[1], lanes[2], lanes[3], lanes[4], lanes[5], lanes[6], lanes[7], tail });
+    }
+
+    SimdLevel detectSimdLevel() {
+#ifdef _MSC_VER
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] >= 7) {
+            __cpuid(info, 1);
+            bool osxsave = (info[2] & (1 << 27)) != 0;
+            bool avx = (info[2] & (1 << 28)) != 0;
+            // ϵͳҪYMMĴ (XCR0ĵ12λ)
+            if (osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+                __cpuidex(info, 7, 0);
+                if (info[1] & (1 << 5)) {
+                    return SimdLevel::Avx2;
+                }
+            }
+        }
+        return SimdLevel::Sse2;
+#else
+        // °汾GCC/ClangͬʱϵͳǷ񱣴YMMĴ
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx2") ? SimdLevel::Avx2 : SimdLevel::Sse2;
+#endif
+    }
+#else
+    SimdLevel detectSimdLevel() {
+        return SimdLevel::Scalar;
+    }
+#endif
+
+    SimdLevel supportedLevel() {
+        static const SimdLevel level = detectSimdLevel();
+        return level;
+    }
+
+    std::atomic<int> forcedLevel{ -1 };
+
+    SimdLevel activeLevel() {
+        int forced = forcedLevel.load(std::memory_order_relaxed);
+        return forced < 0 ? supportedLevel() : static_cast<SimdLevel>(forced);
+    }
+
+    void boundsDispatch(const float* p, size_t count, float* minOut, float* maxOut) {
+        switch (activeLevel()) {
+#ifdef GEOMETRY_KERNELS_X86
+        case SimdLevel::Avx2: boundsAvx2(p, count, minOut, maxOut); return;
+        case SimdLevel::Sse2: boundsSse2(p, count, minOut, maxOut); return;
+#endif
+        default: boundsScalar(p, count, minOut, maxOut); return;
+        }
+    }
+
+    float maxDistanceSquaredDispatch(const float* p, size_t count, const float* center) {
+        switch (activeLevel()) {
+#ifdef GEOMETRY_KERNELS_X86
+        case SimdLevel::Avx2: return maxDistanceSquaredAvx2(p, count, center);
+        case SimdLevel::Sse2: return maxDistanceSquaredSse2(p, count, center);
+#endif
+        default: return maxDistanceSquaredScalar(p, count, center);
+        }
+    }
+
+    // [0, count)PARALLEL_GRAIN_SIZEֿ飬ÿѽдԼĲλҪ
+    template<typename Result, typename ChunkFn>
+    std::vector<Result> reduceChunks(size_t count, const Result& initial, ChunkFn&& chunkFn) {
+        size_t chunkCount = (count + PARALLEL_GRAIN_SIZE - 1) / PARALLEL_GRAIN_SIZE;
+        std::vector<Result> results(chunkCount, initial);
+        JobSystem::getInstance()->parallelFor(0, chunkCount, [&](size_t begin, size_t end) {
+            for (size_t chunk = begin; chunk < end; ++chunk) {
+                size_t first = chunk * PARALLEL_GRAIN_SIZE;
+                chunkFn(first, std::min(count, first + PARALLEL_GRAIN_SIZE), results[chunk]);
+            }
+        }, 1);
+        return results;
+    }
+
+    struct BoundsResult {
+        float minCoords[3];
+        float maxCoords[3];
+    };
+}
+
+SimdLevel getSupportedSimdLevel() {
+    return supportedLevel();
+}
+
+SimdLevel getSimdLevel() {
+    return activeLevel();
+}
+
+SimdLevel setSimdLevel(SimdLevel level) {
+    SimdLevel applied = std::min(level, supportedLevel());
+    forcedLevel.store(static_cast<int>(applied), std::memory_order_relaxed);
+    return applied;
+}
+
+const char* getSimdLevelName(SimdLevel level) {
+    switch (level) {
+    case SimdLevel::Sse2: return "SSE2";
+    case SimdLevel::Avx2: return "AVX2";
+    default: return "Scalar";
+    }
+}
+
+void computeBounds(const glm::vec3* positions, size_t count, glm::vec3& minCoords, glm::vec3& maxCoords) {
+    float minOut[3] = { FLOAT_MAX, FLOAT_MAX, FLOAT_MAX };
+    float maxOut[3] = { FLOAT_LOWEST, FLOAT_LOWEST, FLOAT_LOWEST };
+    boundsDispatch(reinterpret_cast<const float*>(positions), count, minOut, maxOut);
+    minCoords = glm::vec3(minOut[0], minOut[1], minOut[2]);
+    maxCoords = glm::vec3(maxOut[0], maxOut[1], maxOut[2]);
+}
+
+void computeBoundsParallel(const glm::vec3* positions, size_t count, glm::vec3& minCoords, glm::vec3& maxCoords) {
+    if (count <= PARALLEL_GRAIN_SIZE) {
+        computeBounds(positions, count, minCoords, maxCoords);
+        return;
+    }
+    const float* p = reinterpret_cast<const float*>(positions);
+    BoundsResult initial = { { FLOAT_MAX, FLOAT_MAX, FLOAT_MAX }, { FLOAT_LOWEST, FLOAT_LOWEST, FLOAT_LOWEST } };
+    std::vector<BoundsResult> chunks = reduceChunks(count, initial, [&](size_t begin, size_t end, BoundsResult& result) {
+        boundsDispatch(p + begin * 3, end - begin, result.minCoords, result.maxCoords);
+    });
+    minCoords = glm::vec3(FLOAT_MAX);
+    maxCoords = glm::vec3(FLOAT_LOWEST);
+    for (const BoundsResult& chunk : chunks) {
+        minCoords = glm::min(minCoords, glm::vec3(chunk.minCoords[0], chunk.minCoords[1], chunk.minCoords[2]));
+        maxCoords = glm::max(maxCoords, glm::vec3(chunk.maxCoords[0], chunk.maxCoords[1], chunk.maxCoords[2]));
+    }
+}
+
+void computeBoundingSphere(const glm::vec3* positions, size_t count, glm::vec3& center, float& radius) {
+    center = glm::vec3(0.0f);
+    radius = 0.0f;
+    if (count == 0) {
+        return;
+    }
+    glm::vec3 minCoords, maxCoords;
+    computeBounds(positions, count, minCoords, maxCoords);
+    center = (minCoords + maxCoords) * 0.5f;
+    float c[3] = { center.x, center.y, center.z };
+    radius = std::sqrt(maxDistanceSquaredDispatch(reinterpret_cast<const float*>(positions), count, c));
+}
+
+void computeBoundingSphereParallel(const glm::vec3* positions, size_t count, glm::vec3& center, float& radius) {
+    if (count <= PARALLEL_GRAIN_SIZE) {
+        computeBoundingSphere(positions, count, center, radius);
+        return;
+    }
+    glm::vec3 minCoords, maxCoords;
+    computeBoundsParallel(positions, count, minCoords, maxCoords);
+    center = (minCoords + maxCoords) * 0.5f;
+    float c[3] = { center.x, center.y, center.z };
+    const float* p = reinterpret_cast<const float*>(positions);
+    std::vector<float> chunks = reduceChunks(count, 0.0f, [&](size_t begin, size_t end, float& result) {
+        result = maxDistanceSquaredDispatch(p + begin * 3, end - begin, c);
+    });
+    radius = std::sqrt(*std::max_element(chunks.begin(), chunks.end()));
+}
+
+void transformInterleaved(const glm::mat4& matrix, const glm::vec3* positions, const glm::vec2* texCoords, size_t texCoordCount,
+    const VertexIndices* vertices, size_t count, float* out) {
+    const float* m = &matrix[0][0];
+    const float* p = reinterpret_cast<const float*>(positions);
+    const float* t = reinterpret_cast<const float*>(texCoords);
+    switch (activeLevel()) {
+#ifdef GEOMETRY_KERNELS_X86
+    // 任ܰλúͽдڴƣAVX2汾 (gatherһ) ʵⲻSSE2죬ֱSSE2
+    case SimdLevel::Avx2:
+    case SimdLevel::Sse2: transformSse2(m, p, t, texCoordCount, vertices, count, out); return;
+#endif
+    default: transformScalar(m, p, t, texCoordCount, vertices, count, out); return;
+    }
+}
+}
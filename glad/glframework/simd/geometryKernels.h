@@ -0,0 +1,52 @@
+#pragma once
+
+#include "../core.h"          // glm
+
+#include <cstddef>            // size_t
+#include <cstdint>            // uint32_t
+
+// ݵںˣ߽򡢰Χ򡢱任λòUVд
+// - һεʱCPUֵָ֧ ( / SSE2 / AVX2)֮ĵֱ߶Ӧʵ֣
+//   x86ƽֻ̨бʵ֣
+// - ʹFMA任ļӷ˳glmmat4 * vec4ͬԸı任λһ£
+//   決ͻϣΪеĻͬ仯
+// - Parallel׺İ汾Ѵֿ齻JobSystemԼСPARALLEL_GRAIN_SIZEֱڵǰ̼߳㡣
+namespace geometry {
+    enum class SimdLevel : uint8_t {
+        Scalar,
+        Sse2,
+        Avx2,   // 256λĴ
+    };
+
+    // ǰCPUͲϵͳֵ֧߼
+    SimdLevel getSupportedSimdLevel();
+    // ںʵʹõļĬϵgetSupportedSimdLevel()
+    SimdLevel getSimdLevel();
+    // ǿʹýϵ͵ļ (ڻ׼ԺͶԱȽ)CPUֵ֧ļʱضϡʵЧļ
+    // Ҫ߳ڵںʱ޸ġ
+    SimdLevel setSimdLevel(SimdLevel level);
+    const char* getSimdLevelName(SimdLevel level);
+
+    // һλ (OBJе v/vt)
+    struct VertexIndices {
+        uint32_t posIndex;
+        uint32_t texCoordIndex;
+    };
+
+    // ֿԼʱÿĶ
+    constexpr size_t PARALLEL_GRAIN_SIZE = 65536;
+
+    // ߽countΪ0ʱminCoordsΪfloatֵmaxCoordsΪfloatСֵ
+    void computeBounds(const glm::vec3* positions, size_t count, glm::vec3& minCoords, glm::vec3& maxCoords);
+    void computeBoundsParallel(const glm::vec3* positions, size_t count, glm::vec3& minCoords, glm::vec3& maxCoords);
+
+    // Χȡ߽ģ뾶Ϊ㵽ĵԶ롣
+    // СΧ (sqrt(3))ֻҪɨ衣countΪ0ʱ뾶Ϊ0
+    void computeBoundingSphere(const glm::vec3* positions, size_t count, glm::vec3& center, float& radius);
+    void computeBoundingSphereParallel(const glm::vec3* positions, size_t count, glm::vec3& center, float& radius);
+
+    // count㣺out[5i, 5i+5) = (matrix * vec4(positions[posIndex], 1)).xyz, texCoords[texCoordIndex]
+    // texCoordIndexСtexCoordCountʱUVд0posIndex飬λ鲻ܳ2^31/3Ԫء
+    void transformInterleaved(const glm::mat4& matrix, const glm::vec3* positions, const glm::vec2* texCoords, size_t texCoordCount,
+        const VertexIndices* vertices, size_t count, float* out);
+}
@@ -0,0 +1,97 @@
+#include "spaceFillingCurve.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace spatial {
+    namespace {
+        constexpr uint32_t MORTON_BITS = 21;
+        constexpr uint32_t HILBERT_BITS = 16;
+
+        // 21λÿһλֿм0
+        uint64_t spreadBits(uint32_t value) {
+            uint64_t x = value & 0x1FFFFFu;
+            x = (x | (x << 32)) & 0x001F00000000FFFFull;
+            x = (x | (x << 16)) & 0x001F0000FF0000FFull;
+            x = (x | (x << 8)) & 0x100F00F00F00F00Full;
+            x = (x | (x << 4)) & 0x10C30C30C30C30C3ull;
+            x = (x | (x << 2)) & 0x1249249249249249ull;
+            return x;
+        }
+
+        // [0, 2^bits - 1]
+        uint32_t quantize(float value, float minValue, float scale, uint32_t bits) {
+            float maxCell = static_cast<float>((1u << bits) - 1);
+            return static_cast<uint32_t>(std::clamp((value - minValue) * scale, 0.0f, maxCell));
+        }
+    }
+
+    uint64_t mortonCode(uint32_t x, uint32_t y, uint32_t z) {
+        return spreadBits(x) | (spreadBits(y) << 1) | (spreadBits(z) << 2);
+    }
+
+    uint32_t hilbertCode(uint32_t x, uint32_t y) {
+        uint32_t code = 0;
+        for (uint32_t s = 1u << (HILBERT_BITS - 1); s > 0; s >>= 1) {
+            uint32_t rx = (x & s) > 0 ? 1 : 0;
+            uint32_t ry = (y & s) > 0 ? 1 : 0;
+            code += s * s * ((3 * rx) ^ ry);
+            // תޣʹߵںͳ븸
+            if (ry == 0) {
+                if (rx == 1) {
+                    x = s - 1 - (x & (s - 1));
+                    y = s - 1 - (y & (s - 1));
+                }
+                std::swap(x, y);
+            }
+            x &= s - 1;
+            y &= s - 1;
+        }
+        return code;
+    }
+
+    std::vector<uint32_t> curveOrder(const std::vector<glm::vec3>& points, Curve curve) {
+        std::vector<uint32_t> order(points.size());
+        if (points.empty()) {
+            return order;
+        }
+        glm::vec3 minBounds(std::numeric_limits<float>::max());
+        glm::vec3 maxBounds(std::numeric_limits<float>::lowest());
+        for (const glm::vec3& p : points) {
+            minBounds = glm::min(minBounds, p);
+            maxBounds = glm::max(maxBounds, p);
+        }
+        uint32_t bits = curve == Curve::Morton ? MORTON_BITS : HILBERT_BITS;
+        // ͳһţֿռ (ϸĳڶϱϸ)
+        glm::vec3 extent = maxBounds - minBounds;
+        float maxExtent = curve == Curve::Morton ? std::max({ extent.x, extent.y, extent.z }) : std::max(extent.x, extent.z);
+        float scale = maxExtent > 0.0f ? static_cast<float>((1u << bits) - 1) / maxExtent : 0.0f;
+
+        if (curve == Curve::Hilbert) {
+            // 32λź32λ±ƴһֱͬʱ±
+            std::vector<uint64_t> keys(points.size());
+            for (size_t i = 0; i < points.size(); ++i) {
+                uint32_t code = hilbertCode(quantize(points[i].x, minBounds.x, scale, bits), quantize(points[i].z, minBounds.z, scale, bits));
+                keys[i] = (static_cast<uint64_t>(code) << 32) | static_cast<uint64_t>(i);
+            }
+            std::sort(keys.begin(), keys.end());
+            for (size_t i = 0; i < keys.size(); ++i) {
+                order[i] = static_cast<uint32_t>(keys[i]);
+            }
+            return order;
+        }
+
+        std::vector<std::pair<uint64_t, uint32_t>> keys(points.size());
+        for (size_t i = 0; i < points.size(); ++i) {
+            keys[i].first = mortonCode(quantize(points[i].x, minBounds.x, scale, bits), quantize(points[i].y, minBounds.y, scale, bits),
+                quantize(points[i].z, minBounds.z, scale, bits));
+            keys[i].second = static_cast<uint32_t>(i);
+        }
+        std::sort(keys.begin(), keys.end());
+        for (size_t i = 0; i < keys.size(); ++i) {
+            order[i] = keys[i].second;
+        }
+        return order;
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "../core.h"          // glm
+
+#include <cstdint>            // uint32_t, uint64_t
+#include <vector>             // std::vector
+
+// ռߣѿռڵĶŵ/ļڵλ
+// Ĭϰļ˳ŽΣռڵĶڴԴļǷɢģ
+// ˳ź޳BVHʽȡͻύӽ˳ʡ
+// - Morton (Z)άÿ21λֻҪλʺܴͼԪ (ΡBVH)
+// - Hilbertά (XZ棬Y)ÿ16λڱڿռһڣûZĳԾ
+//   ʺϳг߶ȵĶ (ƬԴеģ)߶ȶ˳û塣
+// ȰеİΧԽֻȡڵ֮λá
+namespace spatial {
+    enum class Curve : uint8_t {
+        Morton,     // άZ
+        Hilbert,    // XZƽϵHilbert
+    };
+
+    // 21λλ (xλ)
+    uint64_t mortonCode(uint32_t x, uint32_t y, uint32_t z);
+
+    // 2^16 x 2^16ϵHilbert߱
+    uint32_t hilbertCode(uint32_t x, uint32_t y);
+
+    // ˳еĵ±꣺result[i]Ϊipointsеλá
+    // ͬĵ㱣ԭ˳ͬǵõͬ
+    std::vector<uint32_t> curveOrder(const std::vector<glm::vec3>& points, Curve curve);
+
+    // order飺result[i] = values[order[i]]
+    template<typename T>
+    std::vector<T> permute(const std::vector<T>& values, const std::vector<uint32_t>& order) {
+        std::vector<T> result;
+        result.reserve(order.size());
+        for (uint32_t index : order) {
+            result.push_back(values[index]);
+        }
+        return result;
+    }
+}
@@ -0,0 +1,563 @@
+#include "tileStreamer.h"
+#include "../model.h"
+#include "../shader.h"
+#include "../asset/assetPipeline.h"
+#include "tilesetFormat.h"
+#include "../visibility/potentiallyVisibleSet.h"
+#include "../clip/clipSet.h"
+#include "../attributes/attributeTable.h"
+#include "../collision/collisionWorld.h"
+#include "../spatial/spaceFillingCurve.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    // ׶6ƽ (ax + by + cz + d >= 0 Ϊڲ)viewProjectionȡ
+    struct Frustum {
+        glm::vec4 planes[6];
+
+        explicit Frustum(const glm::mat4& m) {
+            // glmΪ򣺵iΪ (m[0][i], m[1][i], m[2][i], m[3][i])
+            glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+            glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+            glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+            glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+            planes[0] = row3 + row0;
+            planes[1] = row3 - row0;
+            planes[2] = row3 + row1;
+            planes[3] = row3 - row1;
+            planes[4] = row3 + row2;
+            planes[5] = row3 - row2;
+        }
+
+        // Χ׶ཻ (ж)ֻҪΧĳƽȫͲɼ
+        bool intersects(const glm::vec3& minBounds, const glm::vec3& maxBounds) const {
+            for (const glm::vec4& plane : planes) {
+                // ȡƽ淨߷ԶĽǵ
+                glm::vec3 farthest(plane.x >= 0.0f ? maxBounds.x : minBounds.x,
+                    plane.y >= 0.0f ? maxBounds.y : minBounds.y,
+                    plane.z >= 0.0f ? maxBounds.z : minBounds.z);
+                if (glm::dot(glm::vec3(plane), farthest) + plane.w < 0.0f) {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    // 㵽Χеľ룬ڰΧʱΪ0
+    float distanceToBox(const glm::vec3& point, const glm::vec3& minBounds, const glm::vec3& maxBounds) {
+        glm::vec3 closest = glm::clamp(point, minBounds, maxBounds);
+        return glm::length(point - closest);
+    }
+}
+
+TileStreamer::TileStreamer()
+    : TileStreamer(Settings())
+{
+}
+
+TileStreamer::TileStreamer(const Settings& settings)
+    : m_settings(settings), m_self(std::make_shared<TileStreamer*>(this))
+{
+}
+
+TileStreamer::~TileStreamer() {
+    m_self.reset();
+    clear();
+}
+
+size_t TileStreamer::addTile(TileDesc desc) {
+    Tile tile;
+    tile.center = (desc.minBounds + desc.maxBounds) / 2.0f;
+    tile.radius = glm::length(desc.maxBounds - desc.minBounds) / 2.0f;
+    tile.desc = std::move(desc);
+    m_tiles.push_back(std::move(tile));
+    return m_tiles.size() - 1;
+}
+
+bool TileStreamer::loadManifest(const std::string& manifestPath) {
+    std::ifstream file(manifestPath);
+    if (!file.is_open()) {
+        std::cerr << "ERROR: Could not open tile manifest: " << manifestPath << std::endl;
+        return false;
+    }
+    std::string baseDir = manifestPath.substr(0, manifestPath.find_last_of("/\\") + 1);
+    auto resolve = [&](const std::string& path) {
+        bool absolute = !path.empty() && (path[0] == '/' || path[0] == '\\' || (path.size() > 1 && path[1] == ':'));
+        return absolute ? path : baseDir + path;
+    };
+
+    std::vector<TileDesc> tiles;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        std::istringstream iss(line);
+        std::string prefix;
+        if (!(iss >> prefix) || prefix[0] == '#') {
+            continue;
+        }
+        if (prefix == "tile") {
+            TileDesc tile;
+            if (!(iss >> tile.minBounds.x >> tile.minBounds.y >> tile.minBounds.z >> tile.maxBounds.x >> tile.maxBounds.y >> tile.maxBounds.z)) {
+                std::cerr << "ERROR: Invalid tile bounds in manifest " << manifestPath << " at line " << lineNumber << std::endl;
+                return false;
+            }
+            tiles.push_back(std::move(tile));
+        }
+        else if (prefix == "model") {
+            TileModel model;
+            if (tiles.empty() || !(iss >> model.objPath)) {
+                std::cerr << "ERROR: Invalid model entry in manifest " << manifestPath << " at line " << lineNumber << std::endl;
+                return false;
+            }
+            model.objPath = resolve(model.objPath);
+            if (iss >> model.textureBaseDir) {
+                model.textureBaseDir = resolve(model.textureBaseDir);
+            }
+            tiles.back().models.push_back(std::move(model));
+        }
+        else {
+            std::cerr << "WARNING: Unknown manifest entry '" << prefix << "' at line " << lineNumber << std::endl;
+        }
+    }
+
+    // 嵥еƬĵHilbert˳ӣÿ֡±ƬʱռڵƬҲ
+    std::vector<glm::vec3> centers;
+    for (const TileDesc& tile : tiles) {
+        centers.push_back((tile.minBounds + tile.maxBounds) * 0.5f);
+    }
+    for (uint32_t index : spatial::curveOrder(centers, spatial::Curve::Hilbert)) {
+        addTile(std::move(tiles[index]));
+    }
+    std::cout << "Tile manifest '" << manifestPath << "' loaded: " << tiles.size() << " tiles." << std::endl;
+    return true;
+}
+
+bool TileStreamer::loadTileset(const std::string& tilesetPath) {
+    using namespace tileset;
+
+    std::ifstream file(tilesetPath, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        std::cerr << "ERROR: Could not open tileset: " << tilesetPath << std::endl;
+        return false;
+    }
+    std::vector<char> bytes(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+
+    // Уͷ͸ķΧ
+    if (!file || bytes.size() < sizeof(TilesetHeader)) {
+        std::cerr << "ERROR: Invalid tileset: " << tilesetPath << std::endl;
+        return false;
+    }
+    const TilesetHeader* header = reinterpret_cast<const TilesetHeader*>(bytes.data());
+    uint64_t nodesOffset = sizeof(TilesetHeader);
+    uint64_t contentsOffset = nodesOffset + sizeof(TileNode) * static_cast<uint64_t>(header->nodeCount);
+    uint64_t stringsOffset = contentsOffset + sizeof(TileContent) * static_cast<uint64_t>(header->contentCount);
+    if (header->magic != TILESET_MAGIC || header->version != TILESET_VERSION
+        || stringsOffset > bytes.size() || header->stringsSize > bytes.size() - stringsOffset) {
+        std::cerr << "ERROR: Invalid tileset: " << tilesetPath << std::endl;
+        return false;
+    }
+    const TileNode* nodes = reinterpret_cast<const TileNode*>(bytes.data() + nodesOffset);
+    const TileContent* contents = reinterpret_cast<const TileContent*>(bytes.data() + contentsOffset);
+    const char* strings = bytes.data() + stringsOffset;
+
+    std::string baseDir = tilesetPath.substr(0, tilesetPath.find_last_of("/\\") + 1);
+    auto contentPath = [&](uint32_t index, std::string& path) {
+        if (index >= header->contentCount
+            || static_cast<uint64_t>(contents[index].pathOffset) + contents[index].pathLength > header->stringsSize) {
+            return false;
+        }
+        path = baseDir + std::string(strings + contents[index].pathOffset, contents[index].pathLength);
+        return true;
+    };
+
+    // 1. ÿڵһƬHLODĽڵټһHLODƬ
+    size_t firstTile = m_tiles.size();
+    std::vector<size_t> nodeTiles(header->nodeCount);
+    for (uint32_t i = 0; i < header->nodeCount; ++i) {
+        const TileNode& node = nodes[i];
+        TileDesc desc;
+        desc.minBounds = glm::vec3(node.minBounds[0], node.minBounds[1], node.minBounds[2]);
+        desc.maxBounds = glm::vec3(node.maxBounds[0], node.maxBounds[1], node.maxBounds[2]);
+        if (node.contentCount > header->contentCount || node.firstContent > header->contentCount - node.contentCount) {
+            std::cerr << "ERROR: Invalid tileset node " << i << " in " << tilesetPath << std::endl;
+            m_tiles.resize(firstTile);
+            return false;
+        }
+        for (uint32_t c = 0; c < node.contentCount; ++c) {
+            TileModel model;
+            if (!contentPath(node.firstContent + c, model.objPath)) {
+                std::cerr << "ERROR: Invalid tileset content in " << tilesetPath << std::endl;
+                m_tiles.resize(firstTile);
+                return false;
+            }
+            desc.models.push_back(std::move(model));
+        }
+        TileDesc hlodDesc;
+        bool hasHlod = node.hlodContent != NO_INDEX;
+        if (hasHlod) {
+            hlodDesc.minBounds = desc.minBounds;
+            hlodDesc.maxBounds = desc.maxBounds;
+            TileModel model;
+            if (!contentPath(node.hlodContent, model.objPath)) {
+                std::cerr << "ERROR: Invalid tileset content in " << tilesetPath << std::endl;
+                m_tiles.resize(firstTile);
+                return false;
+            }
+            hlodDesc.models.push_back(std::move(model));
+        }
+
+        nodeTiles[i] = addTile(std::move(desc));
+        m_tiles[nodeTiles[i]].geometricError = node.geometricError;
+        for (uint32_t c = 0; c < node.contentCount; ++c) {
+            m_tiles[nodeTiles[i]].contents.push_back(node.firstContent + c);
+        }
+        if (hasHlod) {
+            size_t hlodTile = addTile(std::move(hlodDesc));
+            m_tiles[hlodTile].isRoot = false;
+            m_tiles[hlodTile].isHlod = true;
+            m_tiles[hlodTile].contents.push_back(node.hlodContent);
+            m_tiles[nodeTiles[i]].hlod = hlodTile;
+        }
+    }
+
+    // 2. ӹϵ
+    for (uint32_t i = 0; i < header->nodeCount; ++i) {
+        const TileNode& node = nodes[i];
+        if (node.childCount > header->nodeCount || node.firstChild > header->nodeCount - node.childCount) {
+            std::cerr << "ERROR: Invalid tileset node " << i << " in " << tilesetPath << std::endl;
+            m_tiles.resize(firstTile);
+            return false;
+        }
+        for (uint32_t c = 0; c < node.childCount; ++c) {
+            size_t child = nodeTiles[node.firstChild + c];
+            m_tiles[nodeTiles[i]].children.push_back(child);
+            m_tiles[child].isRoot = false;
+        }
+    }
+
+    m_origin = glm::dvec3(header->origin[0], header->origin[1], header->origin[2]);
+    std::cout << "Tileset '" << tilesetPath << "' loaded: " << header->nodeCount << " nodes, "
+        << header->contentCount << " models." << std::endl;
+    return true;
+}
+
+void TileStreamer::update(const ViewState& view) {
+    m_frame++;
+
+    Frustum frustum(view.viewProjection);
+    glm::vec3 predicted = view.position + view.velocity * m_settings.prefetchSeconds;
+    bool moving = glm::length(view.velocity) > 0.0f;
+    // Ϊ1ʱ뾶Ϊ1ͶӰĻϵֱ ()
+    float projectionScale = view.viewportHeight / std::tan(view.fovY * 0.5f);
+
+    // 1. 㼶ѡ嵥еƬûӽڵĸǱѡ
+    for (Tile& tile : m_tiles) {
+        tile.selected = false;
+    }
+    for (size_t i = 0; i < m_tiles.size(); ++i) {
+        if (m_tiles[i].isRoot) {
+            selectTile(i, view.position, predicted, projectionScale);
+        }
+    }
+
+    // 2. ɼԺȼ׶ڣ (Ǳڿɼʱ) ڵԪɼ
+    const std::vector<uint64_t>* visibleSet = m_pvs ? m_pvs->getVisibleSet(view.position) : nullptr;
+    std::vector<size_t> candidates;
+    m_stats.visibleTiles = 0;
+    m_stats.pvsCulledTiles = 0;
+    for (size_t i = 0; i < m_tiles.size(); ++i) {
+        Tile& tile = m_tiles[i];
+        tile.visible = frustum.intersects(tile.desc.minBounds, tile.desc.maxBounds);
+        if (tile.visible && visibleSet && !potentiallyVisible(tile, *visibleSet)) {
+            tile.visible = false;
+            m_stats.pvsCulledTiles++;
+        }
+        if (tile.visible) {
+            tile.lastVisibleFrame = m_frame;
+            m_stats.visibleTiles++;
+        }
+
+        // ǰλãĻߴԽԽȣҰڵƬӱ
+        tile.priority = 0.0f;
+        float distance = distanceToBox(view.position, tile.desc.minBounds, tile.desc.maxBounds);
+        if (distance <= m_settings.maxLoadDistance) {
+            float screenSize = tile.radius * projectionScale / std::max(distance, 1.0f);
+            if (screenSize >= m_settings.minScreenSize) {
+                tile.priority = screenSize * (tile.visible ? 2.0f : 1.0f);
+            }
+        }
+        // ԤλãǰؼҪƬȼڵǰҰڵƬ
+        if (moving) {
+            float predictedDistance = distanceToBox(predicted, tile.desc.minBounds, tile.desc.maxBounds);
+            if (predictedDistance <= m_settings.maxLoadDistance) {
+                float screenSize = tile.radius * projectionScale / std::max(predictedDistance, 1.0f);
+                if (screenSize >= m_settings.minScreenSize) {
+                    tile.priority = std::max(tile.priority, screenSize);
+                }
+            }
+        }
+
+        if (!tile.selected) {
+            tile.priority = 0.0f;
+        }
+        if (tile.state == TileState::Unloaded && tile.priority > 0.0f) {
+            candidates.push_back(i);
+        }
+    }
+
+    // 3. Ԥʱڳռ
+    evictOverBudget();
+
+    // 4. ȼ
+    std::sort(candidates.begin(), candidates.end(), [&](size_t a, size_t b) {
+        return m_tiles[a].priority > m_tiles[b].priority;
+    });
+    // ҰƬ (Ԥȡ) ֻʹԤǰ3/4ձжصƬһֱ֡ػ
+    for (size_t index : candidates) {
+        if (m_stats.loadingTiles >= m_settings.maxConcurrentLoads || overBudget()) {
+            break;
+        }
+        if (!m_tiles[index].visible && overBudget(3, 4)) {
+            continue;
+        }
+        startLoad(index);
+    }
+}
+
+void TileStreamer::draw(Shader& shader, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) {
+    for (Tile& tile : m_tiles) {
+        if (!tile.visible || !tile.selected || isClipped(tile)) {
+            continue;
+        }
+        // еƬѾģ
+        for (Model* model : tile.models) {
+            model->setViewMatrix(viewMatrix);
+            model->setProjectionMatrix(projectionMatrix);
+            model->setClipSet(m_clipSet);
+            model->setTransparentQueue(m_transparentQueue);
+            model->setGeometryArena(m_geometryArena);
+            model->draw(shader);
+        }
+    }
+}
+
+void TileStreamer::drawOutlines(Shader& shader, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) {
+    for (Tile& tile : m_tiles) {
+        if (!tile.visible || !tile.selected || isClipped(tile)) {
+            continue;
+        }
+        for (Model* model : tile.models) {
+            model->setViewMatrix(viewMatrix);
+            model->setProjectionMatrix(projectionMatrix);
+            model->setClipSet(m_clipSet);
+            model->drawOutlines(shader);
+        }
+    }
+}
+
+bool TileStreamer::isClipped(const Tile& tile) const {
+    return m_clipSet && m_clipSet->classify(tile.desc.minBounds, tile.desc.maxBounds) == ClipSet::Classification::Clipped;
+}
+
+void TileStreamer::selectTile(size_t tileIndex, const glm::vec3& position, const glm::vec3& predicted, float projectionScale) {
+    Tile& tile = m_tiles[tileIndex];
+    tile.selected = true;
+    if (tile.children.empty()) {
+        return;
+    }
+
+    // ǰλúԤλнϽһϸ֣ƶϵƬǰϸ
+    float distance = std::min(distanceToBox(position, tile.desc.minBounds, tile.desc.maxBounds),
+        distanceToBox(predicted, tile.desc.minBounds, tile.desc.maxBounds));
+    float screenSpaceError = tile.geometricError * projectionScale / std::max(distance, 1.0f);
+    if (screenSpaceError <= m_settings.maxScreenSpaceError) {
+        if (tile.hlod != NO_TILE) {
+            m_tiles[tile.hlod].selected = true;
+        }
+        return;
+    }
+
+    for (size_t child : tile.children) {
+        selectTile(child, position, predicted, projectionScale);
+    }
+    // ӽڵ֮ǰHLOD
+    if (tile.hlod != NO_TILE && !childrenReady(tile)) {
+        m_tiles[tile.hlod].selected = true;
+    }
+}
+
+bool TileStreamer::childrenReady(const Tile& tile) const {
+    for (size_t child : tile.children) {
+        const Tile& childTile = m_tiles[child];
+        if (childTile.state != TileState::Resident) {
+            return false;
+        }
+        // ӽڵûϸʱHLODӽڵ
+        if (childTile.hlod != NO_TILE && m_tiles[childTile.hlod].selected && m_tiles[childTile.hlod].state != TileState::Resident) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool TileStreamer::potentiallyVisible(const Tile& tile, const std::vector<uint64_t>& visibleSet) {
+    if (tile.contents.empty()) {
+        return true;
+    }
+    for (uint32_t content : tile.contents) {
+        if (PotentiallyVisibleSet::isVisible(visibleSet, content)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void TileStreamer::clear() {
+    for (Tile& tile : m_tiles) {
+        unloadTile(tile);
+    }
+}
+
+void TileStreamer::startLoad(size_t tileIndex) {
+    Tile& tile = m_tiles[tileIndex];
+    tile.state = TileState::Loading;
+    tile.generation++;
+    tile.pendingModels = tile.desc.models.size();
+    m_stats.loadingTiles++;
+    m_stats.loadsStarted++;
+
+    if (tile.pendingModels == 0) {
+        tile.state = TileState::Resident;
+        m_stats.loadingTiles--;
+        m_stats.residentTiles++;
+        return;
+    }
+
+    std::weak_ptr<TileStreamer*> self = m_self;
+    uint64_t generation = tile.generation;
+    for (const TileModel& model : tile.desc.models) {
+        AssetPipeline::getInstance()->load(model.objPath, model.textureBaseDir, [self, tileIndex, generation](Model* loaded) {
+            std::shared_ptr<TileStreamer*> streamer = self.lock();
+            if (!streamer) {
+                delete loaded;
+                return;
+            }
+            (*streamer)->onModelLoaded(tileIndex, generation, loaded);
+        });
+    }
+}
+
+void TileStreamer::onModelLoaded(size_t tileIndex, uint64_t generation, Model* model) {
+    Tile& tile = m_tiles[tileIndex];
+    if (tile.generation != generation || tile.state != TileState::Loading) {
+        // ƬڼڼѾж
+        delete model;
+        return;
+    }
+
+    if (model) {
+        // HLODģļtilerɣѾȥԭ
+        model->placeAtSourceCoordinates(tile.isHlod ? glm::dvec3(0.0) : m_origin);
+        if (m_attributes) {
+            model->setObjectId(m_attributes->findRow(AttributeTable::buildingIdFromPath(model->getFilePath())));
+        }
+        if (m_collisionWorld && !tile.isHlod && model->getCollisionMesh()) {
+            uint32_t body = m_collisionWorld->addBody(model->getCollisionMesh(), model->getModelMatrix());
+            if (body != CollisionWorld::NO_BODY) {
+                tile.collisionBodies.push_back(body);
+            }
+        }
+        // ·ͳԴ棺͸Meshύȡ·ʱеĸҲԤ
+        model->setTransparentQueue(m_transparentQueue);
+        model->setGeometryArena(m_geometryArena);
+        size_t cpuBytes = 0, gpuBytes = 0;
+        model->getMemoryUsage(cpuBytes, gpuBytes);
+        tile.cpuBytes += cpuBytes;
+        tile.gpuBytes += gpuBytes;
+        m_stats.cpuBytes += cpuBytes;
+        m_stats.gpuBytes += gpuBytes;
+        tile.models.push_back(model);
+    }
+
+    if (--tile.pendingModels == 0) {
+        tile.state = TileState::Resident;
+        m_stats.loadingTiles--;
+        m_stats.residentTiles++;
+    }
+}
+
+void TileStreamer::unloadTile(Tile& tile) {
+    if (tile.state == TileState::Unloaded) {
+        return;
+    }
+    if (tile.state == TileState::Loading) {
+        m_stats.loadingTiles--;
+    }
+    else {
+        m_stats.residentTiles--;
+    }
+    // GLԴڱ֡ResourceManager::collectGarbage()ͳһ
+    for (Model* model : tile.models) {
+        delete model;
+    }
+    tile.models.clear();
+    if (m_collisionWorld) {
+        for (uint32_t body : tile.collisionBodies) {
+            m_collisionWorld->removeBody(body);
+        }
+    }
+    tile.collisionBodies.clear();
+    m_stats.cpuBytes -= tile.cpuBytes;
+    m_stats.gpuBytes -= tile.gpuBytes;
+    tile.cpuBytes = 0;
+    tile.gpuBytes = 0;
+    tile.pendingModels = 0;
+    tile.generation++;
+    tile.state = TileState::Unloaded;
+}
+
+bool TileStreamer::overBudget(size_t numerator, size_t denominator) const {
+    return m_stats.cpuBytes > m_settings.cpuBudgetBytes / denominator * numerator
+        || m_stats.gpuBytes > m_settings.gpuBudgetBytes / denominator * numerator;
+}
+
+void TileStreamer::evictOverBudget() {
+    if (!overBudget()) {
+        return;
+    }
+    // жѾҪƬ (ȼΪ0)ٰɼ֡ŴӾɵжأͬһ֡ɼģжȼ͵
+    std::vector<size_t> residents;
+    for (size_t i = 0; i < m_tiles.size(); ++i) {
+        const Tile& tile = m_tiles[i];
+        if (tile.state == TileState::Resident && !tile.visible) {
+            residents.push_back(i);
+        }
+    }
+    std::sort(residents.begin(), residents.end(), [&](size_t a, size_t b) {
+        const Tile& tileA = m_tiles[a];
+        const Tile& tileB = m_tiles[b];
+        if ((tileA.priority > 0.0f) != (tileB.priority > 0.0f)) {
+            return tileA.priority <= 0.0f;
+        }
+        if (tileA.lastVisibleFrame != tileB.lastVisibleFrame) {
+            return tileA.lastVisibleFrame < tileB.lastVisibleFrame;
+        }
+        return tileA.priority < tileB.priority;
+    });
+    for (size_t index : residents) {
+        if (!overBudget()) {
+            break;
+        }
+        unloadTile(m_tiles[index]);
+        m_stats.evictions++;
+    }
+}
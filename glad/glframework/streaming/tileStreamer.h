@@ -0,0 +1,202 @@
+#pragma once
+
+#include "../core.h"          // glm
+
+#include <cstdint>            // uint64_t
+#include <memory>             // std::shared_ptr첽صʽǷȻ
+#include <string>             // std::string
+#include <vector>             // std::vector
+
+class Model;
+class Shader;
+class PotentiallyVisibleSet;
+class ClipSet;
+class TransparentQueue;
+class GeometryArena;
+class AttributeTable;
+class CollisionWorld;
+
+// TileStreamerΪĵƬʽ
+// 类ΪƬÿƬһΧкһ齨ģ͡ÿ֡update()
+// - ƬľͶӰĻϵĴСȼҰڵƬȣ
+//   ĻߴﵽminScreenSizemaxLoadDistanceڵƬҪפ (ӽǱ仯ļذ뾶)
+// - ٶȷԤprefetchSecondsλãҪƬǰأ
+// - ͨAssetPipeline첽 (ȡں̨GLϴpumpGLQueueÿ֡Ԥ)
+//   ͬʱеļزmaxConcurrentLoadsԶȴأ
+// - CPUڴԴ泬ԤʱжûгҰеƬ (LRU)ǰɼƬᱻжء
+// Ӳ㼶 (loadTileset) صƬĲڵĻռmaxScreenSpaceErrorʱ
+// ýڵHLODȫӽڵ㣬ϸֵӽڵ㣻ӽڵδȫʱƸڵHLOD治ֿն
+// Ǳڿɼ (setPotentiallyVisibleSet) ʱڵԪвɼĲ㼶ƬҰڴ
+// ֻGL߳ʹáʹǰ᣺ѭÿ֡ AssetScheduler::getInstance()->pumpGLQueue(...)
+class TileStreamer {
+public:
+    struct Settings {
+        size_t cpuBudgetBytes = size_t(512) << 20;  // CPUڴԤ (MeshĶ/)
+        size_t gpuBudgetBytes = size_t(1024) << 20; // ԴԤ (/䶥ȡ + )
+        float maxLoadDistance = 2000.0f;            // ˾Ƭ
+        float minScreenSize = 24.0f;                // ƬΧͶӰֱСڴʱ
+        float prefetchSeconds = 2.0f;               // ٶȷԤʱ
+        size_t maxConcurrentLoads = 4;              // ͬʱصƬ
+        float maxScreenSpaceError = 16.0f;          // 㼶ƬHLODļͶӰĻϳʱϸ
+    };
+
+    // Ƭеһģ
+    struct TileModel {
+        std::string objPath;
+        std::string textureBaseDir;     // ΪʱʹOBJļĿ¼µ "materials_textures/"
+    };
+
+    // Ƭ
+    struct TileDesc {
+        glm::vec3 minBounds = glm::vec3(0.0f);  // µİΧ
+        glm::vec3 maxBounds = glm::vec3(0.0f);
+        std::vector<TileModel> models;
+    };
+
+    // ÿ֡״̬
+    struct ViewState {
+        glm::vec3 position = glm::vec3(0.0f);
+        glm::vec3 velocity = glm::vec3(0.0f);   // 絥λ/룬CameraControl::getVelocity
+        glm::mat4 viewProjection = glm::mat4(1.0f);
+        float fovY = glm::radians(60.0f);       // ֱҰ ()
+        float viewportHeight = 600.0f;          // ӿڸ߶ ()
+    };
+
+    struct Stats {
+        size_t residentTiles = 0;
+        size_t loadingTiles = 0;
+        size_t visibleTiles = 0;
+        size_t pvsCulledTiles = 0;  // ׶ڵǱڿɼ޳
+        size_t cpuBytes = 0;
+        size_t gpuBytes = 0;
+        size_t loadsStarted = 0;    // ۼ
+        size_t evictions = 0;       // ۼ
+    };
+
+    TileStreamer();
+    explicit TileStreamer(const Settings& settings);
+    // жƬڽеļɺģͻᱻֱӶ
+    ~TileStreamer();
+
+    TileStreamer(const TileStreamer&) = delete;
+    TileStreamer& operator=(const TileStreamer&) = delete;
+
+    // һƬƬ
+    size_t addTile(TileDesc tile);
+
+    // ȡıʽƬ嵥·嵥Ŀ¼
+    //   # ע
+    //   tile <minX> <minY> <minZ> <maxX> <maxY> <maxZ>
+    //   model <objPath> [textureBaseDir]
+    // ʧʱfalse
+    bool loadManifest(const std::string& manifestPath);
+
+    // ȡ߹tools/tilerɵĶƲ㼶 (tilesetFormat.h)ʧʱfalse
+    // һʽֻܼһ㼶 (Ƭеԭ)
+    bool loadTileset(const std::string& tilesetPath);
+
+    // 㼶ӦǱڿɼ (tools/pvsBuilderɣΪ㼶еݱ)nullptrʾʹá
+    // Ȩpvsʽʹڼ䱣Ч
+    void setPotentiallyVisibleSet(PotentiallyVisibleSet* pvs) { m_pvs = pvs; }
+
+    // ƽ棬nullptrʾСΧȫеƬƣƬеģͰMesh޳ (Model::setClipSet)
+    // Ȩ
+    void setClipSet(const ClipSet* clipSet) { m_clipSet = clipSet; }
+
+    // ͸ͨƬģе͸Meshύ (Model::setTransparentQueue)nullptrʾֱӻơȨ
+    void setTransparentQueue(TransparentQueue* queue) { m_transparentQueue = queue; }
+
+    // öȡĻ·ƬģеĲ͸Meshύ (Model::setGeometryArena)nullptrʾֱӻơ
+    // Ȩ
+    void setGeometryArena(GeometryArena* arena) { m_geometryArena = arena; }
+
+    // ýԱصģͰOBJļڱвҽ (Model::setObjectId)nullptrʾҡ
+    // ֻӰ֮صģ͡Ȩ
+    void setAttributeTable(const AttributeTable* attributes) { m_attributes = attributes; }
+
+    // ײõײ磬صģ (HLOD) ײУжʱƳnullptrʾ롣
+    // ֻӰ֮صģ͡Ȩworldʽøá
+    void setCollisionWorld(CollisionWorld* world) { m_collisionWorld = world; }
+
+    // ȼءԤжءÿ֡ڻ֮ǰһΡ
+    void update(const ViewState& view);
+
+    // ҰڵѼģ
+    void draw(Shader& shader, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix);
+
+    // ҰѼģ͵ (Model::drawOutlines)draw֮
+    void drawOutlines(Shader& shader, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix);
+
+    // жƬ
+    void clear();
+
+    const Stats& getStats() const { return m_stats; }
+    Settings& getSettings() { return m_settings; }
+    size_t getTileCount() const { return m_tiles.size(); }
+
+private:
+    enum class TileState { Unloaded, Loading, Resident };
+
+    static constexpr size_t NO_TILE = static_cast<size_t>(-1);
+
+    struct Tile {
+        TileDesc desc;
+        glm::vec3 center = glm::vec3(0.0f);
+        float radius = 0.0f;
+
+        TileState state = TileState::Unloaded;
+        std::vector<Model*> models;     // Ѽصģͣʱֻһ
+        std::vector<uint32_t> collisionBodies; // ģײеʵ
+        size_t pendingModels = 0;       // δصģͼ
+        uint64_t generation = 0;        // ÿμ/жؼ1ڵļػصᶪ
+        size_t cpuBytes = 0;
+        size_t gpuBytes = 0;
+
+        bool visible = false;           // ֡Ƿ׶
+        uint64_t lastVisibleFrame = 0;  // һοɼ֡ţLRU
+        float priority = 0.0f;          // ֡ļȼ0ʾҪ
+
+        // 㼶Ƭ (嵥еƬûиӹϵǱѡ)
+        std::vector<size_t> children;   // ӽڵƬ
+        size_t hlod = NO_TILE;          // ڵHLODӦƬ
+        float geometricError = 0.0f;    // HLODӽڵʱļ
+        bool isRoot = true;             // ûиڵƬ (HLODƬΪfalse)
+        bool isHlod = false;            // HLODƬ (򻯵ײ)
+        bool selected = true;           // ֡Ĳ㼶ѡҪغͻ
+        std::vector<uint32_t> contents; // 㼶еݱţǱڿɼ޳ (嵥еƬΪ)
+    };
+
+    // 㼶ѡ񣺴ӽڵ㿪ʼĻռ㹻СʱѡHLODϸ
+    void selectTile(size_t tileIndex, const glm::vec3& position, const glm::vec3& predicted, float projectionScale);
+    // ƬİΧȫƽе
+    bool isClipped(const Tile& tile) const;
+    // ڵӽڵǷѾԻ (ѼأδϸֵӽڵHLODҲѼ)
+    bool childrenReady(const Tile& tile) const;
+    // ƬǷκһλ
+    static bool potentiallyVisible(const Tile& tile, const std::vector<uint64_t>& visibleSet);
+
+    void startLoad(size_t tileIndex);
+    void onModelLoaded(size_t tileIndex, uint64_t generation, Model* model);
+    void unloadTile(Tile& tile);
+
+    // ԤʱLRUжزɼƬ
+    void evictOverBudget();
+    // CPUڴԴ泬Ԥnumerator/denominator
+    bool overBudget(size_t numerator = 1, size_t denominator = 1) const;
+
+private:
+    Settings m_settings;
+    std::vector<Tile> m_tiles;
+    Stats m_stats;
+    uint64_t m_frame = 0;
+    glm::dvec3 m_origin = glm::dvec3(0.0);  // 㼶ԭ㣬ڷģʱԭʼмȥ (HLODѾȥ)
+    PotentiallyVisibleSet* m_pvs = nullptr;
+    const ClipSet* m_clipSet = nullptr;
+    TransparentQueue* m_transparentQueue = nullptr;
+    GeometryArena* m_geometryArena = nullptr;
+    const AttributeTable* m_attributes = nullptr;
+    CollisionWorld* m_collisionWorld = nullptr;
+
+    // 첽ػصweak_ptrʽٺصٷthis
+    std::shared_ptr<TileStreamer*> m_self;
+};
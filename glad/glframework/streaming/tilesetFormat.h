@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>            // ڹ̶
+
+// Ƭ㼶ļ (.tileset) ĶƸʽ߹tools/tilerɣTileStreamer::loadTilesetȡ
+// ֣
+//   TilesetHeader
+//   TileNode[nodeCount]         У0Ϊڵ㣬ͬһڵӽڵ
+//   TileContent[contentCount]   ÿڵţHLODҲһTileContent
+//   ַ                     ģ· (.tilesetļĿ¼'/'ָ)
+// 궼Ѽȥoriginʱڷģʱͬȥoriginĸ㾫⣻
+// origin˫ȴţtilerɵHLODģļеҲѼȥorigin
+namespace tileset {
+
+    constexpr uint32_t TILESET_MAGIC = 0x4C495447u; // "GTIL"
+    constexpr uint32_t TILESET_VERSION = 2;    // 2: originΪ˫
+    constexpr uint32_t NO_INDEX = 0xFFFFFFFFu;
+
+    struct TilesetHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t nodeCount;
+        uint32_t contentCount;
+        uint64_t stringsSize;
+        double origin[3];       // ԭʼ () ԭ
+    };
+
+    // Ĳڵ
+    // - ڵĽ (firstContent, contentCount)Խӽڵ߽硢·ŵĽԼҶӽڵȫƣ
+    // - HLOD (hlodContent)ӽڵݵļ򻯺ϲģͣڵ㲻ϸʱӽڵƣ
+    // - geometricErrorHLODӽڵʱ󼸺 (絥λ)ҶӽڵΪ0
+    struct TileNode {
+        float minBounds[3];     // ڵȫ (ӽڵ) İΧ
+        float maxBounds[3];
+        float geometricError;
+        uint32_t firstChild;
+        uint32_t childCount;
+        uint32_t firstContent;
+        uint32_t contentCount;
+        uint32_t hlodContent;   // NO_INDEXʾûHLOD
+    };
+
+    struct TileContent {
+        uint32_t pathOffset;    // ַеƫ
+        uint32_t pathLength;
+    };
+}
@@ -1,4 +1,6 @@
 #include "texture.h"
+#include <utility>
+#include <iostream>
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "../application/stb_image.h"
@@ -9,11 +11,96 @@ Texture::Texture(const std::string& path, unsigned int unit) {
 	//1 stbImage ȡͼƬ
 	int channels;
 
-	//--תy
-	stbi_set_flip_vertically_on_load(true);
+	//--תyᣨֻӰ쵱ǰ̣߳߳ϵdecodeţ
+	stbi_set_flip_vertically_on_load_thread(true);
 
 	unsigned char* data = stbi_load(path.c_str(), &mWidth, &mHeight, &channels, STBI_rgb_alpha);
 
+	upload(data);
+
+	//***ͷ 
+	stbi_image_free(data);
+}
+
+Texture::Texture(const ImageData& image, unsigned int unit) {
+	mUnit = unit;
+	mWidth = image.width;
+	mHeight = image.height;
+	upload(image.empty() ? nullptr : image.pixels.data());
+}
+
+Texture::Texture(const unsigned char* rgbaPixels, int width, int height, unsigned int unit) {
+	mUnit = unit;
+	mWidth = width;
+	mHeight = height;
+	upload(rgbaPixels);
+}
+
+Texture::Texture(const std::vector<MipLevel>& mips, int width, int height, GLenum compressedFormat, unsigned int unit) {
+	mUnit = unit;
+	mWidth = width;
+	mHeight = height;
+	mCompressedFormat = compressedFormat;
+
+	glGenTextures(1, &mTexture);
+	glActiveTexture(GL_TEXTURE0 + mUnit);
+	glBindTexture(GL_TEXTURE_2D, mTexture);
+
+	//ϴglGenerateMipmapѹʽҲ޷ɣ
+	int levelWidth = width;
+	int levelHeight = height;
+	for (size_t level = 0; level < mips.size(); ++level) {
+		if (compressedFormat != 0) {
+			glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), compressedFormat, levelWidth, levelHeight, 0,
+				static_cast<GLsizei>(mips[level].size), mips[level].data);
+		}
+		else {
+			glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), GL_RGBA, levelWidth, levelHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, mips[level].data);
+		}
+		mGpuBytes += mips[level].size;
+		levelWidth = levelWidth > 1 ? levelWidth / 2 : 1;
+		levelHeight = levelHeight > 1 ? levelHeight / 2 : 1;
+	}
+	//mipmapʱ߼𣬷Ϊɫ
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, mips.empty() ? 0 : static_cast<GLint>(mips.size() - 1));
+
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);//u
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);//v
+}
+
+bool Texture::isCompressedFormatSupported(GLenum format) {
+	GLint count = 0;
+	glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &count);
+	if (count <= 0) {
+		return false;
+	}
+	std::vector<GLint> formats(count);
+	glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, formats.data());
+	for (GLint supported : formats) {
+		if (static_cast<GLenum>(supported) == format) {
+			return true;
+		}
+	}
+	return false;
+}
+
+bool Texture::decode(const unsigned char* bytes, size_t size, ImageData& image) {
+	int channels;
+	stbi_set_flip_vertically_on_load_thread(true);
+	unsigned char* data = stbi_load_from_memory(bytes, static_cast<int>(size), &image.width, &image.height, &channels, STBI_rgb_alpha);
+	if (data == nullptr) {
+		std::cerr << "ERROR: Could not decode image: " << stbi_failure_reason() << std::endl;
+		image = ImageData();
+		return false;
+	}
+	image.pixels.assign(data, data + static_cast<size_t>(image.width) * image.height * 4);
+	stbi_image_free(data);
+	return true;
+}
+
+void Texture::upload(const unsigned char* pixels) {
 	//2 ҼԪ
 	glGenTextures(1, &mTexture);
 	//--Ԫ--
@@ -22,13 +109,11 @@ Texture::Texture(const std::string& path, unsigned int unit) {
 	glBindTexture(GL_TEXTURE_2D, mTexture);
 
 	//3 ,Դ
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, mWidth, mHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, mWidth, mHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+	mGpuBytes = static_cast<size_t>(mWidth) * mHeight * 4 * 4 / 3;
 
 	glGenerateMipmap(GL_TEXTURE_2D);
 
-	//***ͷ 
-	stbi_image_free(data);
-
 	//4 Ĺ˷ʽ
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 	//glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -39,6 +124,29 @@ Texture::Texture(const std::string& path, unsigned int unit) {
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);//v
 }
 
+bool Texture::reload(const ImageData& image) {
+	if (image.empty() || mTexture == 0) {
+		return false;
+	}
+	glActiveTexture(GL_TEXTURE0 + mUnit);
+	glBindTexture(GL_TEXTURE_2D, mTexture);
+
+	if (image.width == mWidth && image.height == mHeight && mCompressedFormat == 0) {
+		//ߴ粻䣺ֻأ·Դ
+		glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, mWidth, mHeight, GL_RGBA, GL_UNSIGNED_BYTE, image.pixels.data());
+	}
+	else {
+		mWidth = image.width;
+		mHeight = image.height;
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, mWidth, mHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, image.pixels.data());
+		//ԭԤɵmipmapʱĻRGBA8mipmap
+		mCompressedFormat = 0;
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 1000);
+		mGpuBytes = static_cast<size_t>(mWidth) * mHeight * 4 * 4 / 3;
+	}
+	glGenerateMipmap(GL_TEXTURE_2D);
+	return true;
+}
 
 Texture::~Texture() {
 	if (mTexture != 0) {
@@ -46,6 +154,20 @@ Texture::~Texture() {
 	}
 }
 
+Texture::Texture(Texture&& other) noexcept {
+	*this = std::move(other);
+}
+
+Texture& Texture::operator=(Texture&& other) noexcept {
+	std::swap(mTexture, other.mTexture);
+	std::swap(mWidth, other.mWidth);
+	std::swap(mHeight, other.mHeight);
+	std::swap(mUnit, other.mUnit);
+	std::swap(mCompressedFormat, other.mCompressedFormat);
+	std::swap(mGpuBytes, other.mGpuBytes);
+	return *this;
+}
+
 void Texture::bind() {
 	//лԪȻtexture
 	glActiveTexture(GL_TEXTURE0 + mUnit);
@@ -1,22 +1,76 @@
 #pragma once
 #include"core.h"
 #include <string>
+#include <vector>
+
+//gladֻ˺Ĺ淶S3TC (EXT_texture_compression_s3tc) öֵﲹ
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#endif
+
+//ͼƬݣCPUࣩͳһΪRGBA8ѰOpenGLϰ߷תy
+//ڹ߳Ͻ룬֮GL߳Texture
+struct ImageData {
+	int width{ 0 };
+	int height{ 0 };
+	std::vector<unsigned char> pixels;
+
+	bool empty() const { return pixels.empty(); }
+};
 
 class Texture {
 public:
+	//Ԥɵһmipmapⲿڴ棬Դڴӳ䣩
+	struct MipLevel {
+		const unsigned char* data{ nullptr };
+		size_t size{ 0 };
+	};
+
 	Texture(const std::string& path, unsigned int unit);
+	//ѾõͼƬֻGLϴGL̵߳
+	Texture(const ImageData& image, unsigned int unit);
+	//ⲿڴеRGBA8شԴڴӳ䣩㿽ϴGL̵߳
+	Texture(const unsigned char* rgbaPixels, int width, int height, unsigned int unit);
+	//ɵmipmap0ߴΪwidth x height֮ÿ룬ٵglGenerateMipmap
+	//compressedFormatΪ0ʱΪRGBA8ΪѹʽGL_COMPRESSED_RGB_S3TC_DXT1_EXTGL̵߳
+	Texture(const std::vector<MipLevel>& mips, int width, int height, GLenum compressedFormat, unsigned int unit);
 	~Texture();
 
+	//ڴеͼƬļpng/jpgȣ룬κGL̵߳
+	static bool decode(const unsigned char* bytes, size_t size, ImageData& image);
+
+	//Ƿ֧ĳѹʽѯGL_COMPRESSED_TEXTURE_FORMATSGL̵߳
+	static bool isCompressedFormatSupported(GLenum format);
+
+	//ռһGLֹֻƶResourcePoolܴ洢ҪƶԪأ
+	//ƶֵýʵ֣ľԴʱͷ
+	Texture(const Texture&) = delete;
+	Texture& operator=(const Texture&) = delete;
+	Texture(Texture&& other) noexcept;
+	Texture& operator=(Texture&& other) noexcept;
+
 	void bind();
 
+	//½ͼƬ滻ݣأGL󲻱䣬ĲʲҪκθĶ
+	//ߴ粻ʱglTexSubImage2Dֻأ·Դ棻GL̵߳
+	bool reload(const ImageData& image);
+
 	int getWidth()const { return mWidth; }
 	int getHeight()const { return mHeight; }
 	GLuint getTextureID() const { return mTexture; } // OpenGLID
+	//ԴռãԤɵmipmapΪʵϴֽRGBA8mipmapԼ1/3
+	size_t getGpuBytes() const { return mGpuBytes; }
 
 
+private:
+	//GLϴRGBA8
+	void upload(const unsigned char* pixels);
+
 private:
 	GLuint mTexture{ 0 };
 	int mWidth{ 0 };
 	int mHeight{ 0 };
 	unsigned int mUnit{ 0 };
+	GLenum mCompressedFormat{ 0 };	//0ʾRGBA8
+	size_t mGpuBytes{ 0 };
 };
\ No newline at end of file
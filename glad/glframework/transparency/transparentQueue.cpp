@@ -0,0 +1,210 @@
+#include "transparentQueue.h"
+#include "../mesh.h"
+#include "../shader.h"
+#include "../resource/resourceManager.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <limits>
+
+namespace transparency {
+    namespace {
+        std::array<glm::vec3, DIRECTION_COUNT> makeDirections() {
+            std::array<glm::vec3, DIRECTION_COUNT> directions;
+            size_t count = 0;
+            for (int axis = 0; axis < 3; ++axis) {
+                glm::vec3 direction(0.0f);
+                direction[axis] = 1.0f;
+                directions[count++] = direction;
+                directions[count++] = -direction;
+            }
+            for (int corner = 0; corner < 8; ++corner) {
+                directions[count++] = glm::normalize(glm::vec3(corner & 1 ? 1.0f : -1.0f, corner & 2 ? 1.0f : -1.0f, corner & 4 ? 1.0f : -1.0f));
+            }
+            return directions;
+        }
+
+        const std::array<glm::vec3, DIRECTION_COUNT>& directions() {
+            static const std::array<glm::vec3, DIRECTION_COUNT> table = makeDirections();
+            return table;
+        }
+
+        // value[minValue, maxValue]еλ16λreversedʱֵӦС
+        uint16_t quantize(float value, float minValue, float maxValue, bool reversed) {
+            float range = maxValue - minValue;
+            float t = range > 0.0f ? (value - minValue) / range : 0.0f;
+            t = std::clamp(reversed ? 1.0f - t : t, 0.0f, 1.0f);
+            return static_cast<uint16_t>(t * 65535.0f + 0.5f);
+        }
+    }
+
+    const glm::vec3& getDirection(size_t index) {
+        return directions()[index];
+    }
+
+    int selectDirection(const glm::vec3& viewDirection) {
+        int best = 0;
+        float bestDot = -std::numeric_limits<float>::max();
+        for (size_t i = 0; i < DIRECTION_COUNT; ++i) {
+            // Ԥ㷽ǵλ󼴼нС
+            float dot = glm::dot(viewDirection, directions()[i]);
+            if (dot > bestDot) {
+                bestDot = dot;
+                best = static_cast<int>(i);
+            }
+        }
+        return best;
+    }
+
+    void sortByKey(const uint16_t* keys, size_t count, std::vector<uint32_t>& order, std::vector<uint32_t>& scratch) {
+        order.resize(count);
+        scratch.resize(count);
+        // һ˰8λԭʼ˳䵽scratchڶ˰8λscratch䵽order˶ȶ
+        size_t lowCounts[257] = {};
+        size_t highCounts[257] = {};
+        for (size_t i = 0; i < count; ++i) {
+            lowCounts[(keys[i] & 0xFF) + 1]++;
+            highCounts[(keys[i] >> 8) + 1]++;
+        }
+        for (int b = 1; b < 257; ++b) {
+            lowCounts[b] += lowCounts[b - 1];
+            highCounts[b] += highCounts[b - 1];
+        }
+        for (size_t i = 0; i < count; ++i) {
+            scratch[lowCounts[keys[i] & 0xFF]++] = static_cast<uint32_t>(i);
+        }
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t element = scratch[i];
+            order[highCounts[keys[element] >> 8]++] = element;
+        }
+    }
+
+    void buildDirectionalOrders(const float* positions, size_t stride, size_t vertexCount,
+        const uint32_t* indices, size_t indexCount, std::vector<uint32_t>& out) {
+        size_t triangleCount = indexCount / 3;
+        out.resize(DIRECTION_COUNT * indexCount);
+
+        //  (Խΰԭ㴦)
+        std::vector<glm::vec3> centroids(triangleCount);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            glm::vec3 sum(0.0f);
+            for (int corner = 0; corner < 3; ++corner) {
+                uint32_t index = indices[t * 3 + corner];
+                if (index < vertexCount) {
+                    const float* p = positions + static_cast<size_t>(index) * stride;
+                    sum += glm::vec3(p[0], p[1], p[2]);
+                }
+            }
+            centroids[t] = sum / 3.0f;
+        }
+
+        std::vector<float> projections(triangleCount);
+        std::vector<uint16_t> keys(triangleCount);
+        std::vector<uint32_t> order, scratch;
+        for (size_t d = 0; d < DIRECTION_COUNT; ++d) {
+            float minProjection = std::numeric_limits<float>::max();
+            float maxProjection = -std::numeric_limits<float>::max();
+            for (size_t t = 0; t < triangleCount; ++t) {
+                projections[t] = glm::dot(centroids[t], directions()[d]);
+                minProjection = std::min(minProjection, projections[t]);
+                maxProjection = std::max(maxProjection, projections[t]);
+            }
+            // طd۲ʱͶӰԽԽԶȻԶ
+            for (size_t t = 0; t < triangleCount; ++t) {
+                keys[t] = quantize(projections[t], minProjection, maxProjection, true);
+            }
+            sortByKey(keys.data(), triangleCount, order, scratch);
+
+            uint32_t* target = out.data() + d * indexCount;
+            for (size_t i = 0; i < triangleCount; ++i) {
+                const uint32_t* source = indices + static_cast<size_t>(order[i]) * 3;
+                target[i * 3 + 0] = source[0];
+                target[i * 3 + 1] = source[1];
+                target[i * 3 + 2] = source[2];
+            }
+            // һεβԭ
+            for (size_t i = triangleCount * 3; i < indexCount; ++i) {
+                target[i] = indices[i];
+            }
+        }
+    }
+}
+
+uint32_t TransparentQueue::addTransform(const glm::mat4& vertexToWorld, uint32_t objectId) {
+    m_transforms.push_back(vertexToWorld);
+    m_objectIds.push_back(objectId);
+    return static_cast<uint32_t>(m_transforms.size() - 1);
+}
+
+void TransparentQueue::submit(uint32_t transform, MeshHandle mesh, float viewDepth, int direction) {
+    m_items.push_back({ mesh, transform, viewDepth, direction });
+}
+
+void TransparentQueue::flush(Shader& shader, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) {
+    m_stats.items = m_items.size();
+    m_stats.sortMs = 0.0;
+    if (m_items.empty()) {
+        clear();
+        return;
+    }
+
+    // 1. ڱ֡ķΧ16λԶļС򼴴Զ
+    auto start = std::chrono::steady_clock::now();
+    float minDepth = std::numeric_limits<float>::max();
+    float maxDepth = -std::numeric_limits<float>::max();
+    for (const Item& item : m_items) {
+        minDepth = std::min(minDepth, item.viewDepth);
+        maxDepth = std::max(maxDepth, item.viewDepth);
+    }
+    m_keys.resize(m_items.size());
+    for (size_t i = 0; i < m_items.size(); ++i) {
+        m_keys[i] = transparency::quantize(m_items[i].viewDepth, minDepth, maxDepth, true);
+    }
+    transparency::sortByKey(m_keys.data(), m_keys.size(), m_order, m_scratch);
+    m_stats.sortMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // 2. ϻƣȲ (͸嵲סĲֲ)д (͸֮䲻ڵ)
+    GL_CALL(glEnable(GL_BLEND));
+    GL_CALL(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+    GL_CALL(glDepthMask(GL_FALSE));
+    drawItems(shader, viewMatrix, projectionMatrix, true);
+    GL_CALL(glDepthMask(GL_TRUE));
+    GL_CALL(glDisable(GL_BLEND));
+    clear();
+}
+
+void TransparentQueue::flushUnsorted(Shader& shader, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix) {
+    m_stats.items = m_items.size();
+    m_stats.sortMs = 0.0;
+    drawItems(shader, viewMatrix, projectionMatrix, false);
+    clear();
+}
+
+void TransparentQueue::drawItems(Shader& shader, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix, bool sorted) {
+    shader.setMatrix4x4("viewMatrix", viewMatrix);
+    shader.setMatrix4x4("projectionMatrix", projectionMatrix);
+
+    ResourcePool<Mesh>& meshPool = ResourceManager::getInstance()->meshes();
+    uint32_t currentTransform = std::numeric_limits<uint32_t>::max();
+    for (size_t i = 0; i < m_items.size(); ++i) {
+        const Item& item = m_items[sorted ? m_order[i] : i];
+        Mesh* mesh = meshPool.get(item.mesh);
+        if (!mesh) {
+            continue;
+        }
+        if (item.transform != currentTransform) {
+            currentTransform = item.transform;
+            shader.setMatrix4x4("transform", m_transforms[currentTransform]);
+            shader.setInt("objectId", static_cast<int>(m_objectIds[currentTransform]));
+        }
+        // ʱ˳Ӱʹԭʼ
+        mesh->draw(shader, sorted ? item.direction : -1);
+    }
+}
+
+void TransparentQueue::clear() {
+    m_items.clear();
+    m_transforms.clear();
+    m_objectIds.clear();
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "../core.h"          // glm
+#include "../resource/handle.h" // MeshHandle
+
+#include <cstddef>            // size_t
+#include <cstdint>            // uint16_t, uint32_t
+#include <vector>             // std::vector
+
+class Shader;
+
+// ͸ (Ļǽ) 򹤾
+namespace transparency {
+    // Ԥ˳ķ6᷽ + 8ԽǷ
+    constexpr size_t DIRECTION_COUNT = 14;
+
+    // iԤ㷽 (λ)
+    const glm::vec3& getDirection(size_t index);
+
+    // ѡ߷ӽԤ㷽viewDirectionΪ´ָķ򣬲Ҫһ
+    int selectDirection(const glm::vec3& viewDirection);
+
+    // 16λȶ (ˣÿ8λ)orderԪرţscratchΪʱռ
+    void sortByKey(const uint16_t* keys, size_t count, std::vector<uint32_t>& order, std::vector<uint32_t>& scratch);
+
+    // ΪһMeshԤDIRECTION_COUNT˳صd۲ʱԶ (ڷϵͶӰ)
+    // дout (ÿ˳indexCountDIRECTION_COUNT * indexCount)
+    // - positions: λãstridefloat
+    // ֻ룬ڹ߳ϵá
+    void buildDirectionalOrders(const float* positions, size_t stride, size_t vertexCount,
+        const uint32_t* indices, size_t indexCount, std::vector<uint32_t>& out);
+}
+
+// TransparentQueue͸ͨ
+// ͸Meshճƣʲ͸С1MeshModel::drawֻύ (Model::setTransparentQueue)
+// в͸廭֮flush()һ԰Զ˳ϻƣ
+// - ÿһMeshΧĵӿռȣڱ֡ȷΧ16λ˻
+//   ÿ֡Ըstd::sort
+// - ϶ĲMeshԤķ˳ (Mesh::buildDirectionalOrders)ύʱѡӽķ
+//   ʱֱʹöӦΧͬһMeshڵҲ´ԶҪÿ֡CPUΡ
+// ҲflushUnsorted()WeightedBlendedOitػ (˳޹͸weightedBlendedOit.h)
+// ֻGL߳ʹãÿ֡flush֮Ϊա
+class TransparentQueue {
+public:
+    // ﵽֵ͸MeshڴʱԤ㷽˳
+    static constexpr size_t DIRECTIONAL_ORDER_MIN_TRIANGLES = 128;
+
+    struct Stats {
+        size_t items = 0;           // һflush/flushUnsortedƵ
+        double sortMs = 0.0;        // һflushʱ (flushUnsortedΪ0)
+    };
+
+    // Ǽһ任 (굽)ظsubmitʹõıţͬһģ͵Meshһ
+    // objectIdΪģ͵Ľ (Model::setObjectId)ʱõShaderobjectId
+    uint32_t addTransform(const glm::mat4& vertexToWorld, uint32_t objectId);
+
+    // ύһ͸Mesh
+    // - transform: addTransformصıţ
+    // - viewDepth: Χĵӿռ (ԽԽԶ)
+    // - direction: Ԥ㷽˳ıţ-1ʾԭʼ˳ơ
+    void submit(uint32_t transform, MeshHandle mesh, float viewDepth, int direction);
+
+    // ԶϻύMeshȻնСshaderɵ÷ (ƽҲɵ÷)
+    // رд (Ȳ)ʹñ׼alphaϣָ
+    void flush(Shader& shader, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix);
+
+    // ذύ˳ύMeshȻնСڼȨOITۻͨ
+    // ״̬ȾĿWeightedBlendedOit::beginAccumulationãshaderɵ÷oitPass
+    void flushUnsorted(Shader& shader, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix);
+
+    // ύMesh
+    void clear();
+
+    size_t size() const { return m_items.size(); }
+    const Stats& getStats() const { return m_stats; }
+
+private:
+    // sortedΪtrueʱm_order˳ʹԤ㷽˳
+    void drawItems(Shader& shader, const glm::mat4& viewMatrix, const glm::mat4& projectionMatrix, bool sorted);
+
+    struct Item {
+        MeshHandle mesh;
+        uint32_t transform;
+        float viewDepth;
+        int32_t direction;
+    };
+
+    std::vector<Item> m_items;
+    std::vector<glm::mat4> m_transforms;
+    std::vector<uint32_t> m_objectIds;  // m_transformsһһӦ
+    // õʱռ䣬֡
+    std::vector<uint16_t> m_keys;
+    std::vector<uint32_t> m_order;
+    std::vector<uint32_t> m_scratch;
+    Stats m_stats;
+};
@@ -0,0 +1,146 @@
+#include "weightedBlendedOit.h"
+#include "../shader.h"
+#include "../../wrapper/checkError.h"
+
+#include <iostream>
+
+WeightedBlendedOit::~WeightedBlendedOit() {
+    releaseTargets();
+    if (m_emptyVao != 0) {
+        GL_CALL(glDeleteVertexArrays(1, &m_emptyVao));
+        m_emptyVao = 0;
+    }
+}
+
+bool WeightedBlendedOit::ensureTargets(int width, int height) {
+    if (m_fbo != 0 && width == m_width && height == m_height) {
+        return true;
+    }
+    releaseTargets();
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+    m_width = width;
+    m_height = height;
+
+    GL_CALL(glGenTextures(1, &m_accumulation));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, m_accumulation));
+    GL_CALL(glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA16F, width, height));
+    GL_CALL(glGenTextures(1, &m_revealage));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, m_revealage));
+    GL_CALL(glTexStorage2D(GL_TEXTURE_2D, 1, GL_R8, width, height));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, 0));
+
+    // Ĭ֡24λ + 8λģ (Application::init)ʽֱͬblit
+    GL_CALL(glGenRenderbuffers(1, &m_depth));
+    GL_CALL(glBindRenderbuffer(GL_RENDERBUFFER, m_depth));
+    GL_CALL(glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height));
+    GL_CALL(glBindRenderbuffer(GL_RENDERBUFFER, 0));
+
+    GL_CALL(glGenFramebuffers(1, &m_fbo));
+    GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, m_fbo));
+    GL_CALL(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_accumulation, 0));
+    GL_CALL(glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, m_revealage, 0));
+    GL_CALL(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_depth));
+    const GLenum drawBuffers[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
+    GL_CALL(glDrawBuffers(2, drawBuffers));
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "ERROR: OIT framebuffer incomplete (status 0x" << std::hex << status << std::dec << ")." << std::endl;
+        releaseTargets();
+        return false;
+    }
+    return true;
+}
+
+void WeightedBlendedOit::releaseTargets() {
+    if (m_fbo != 0) {
+        GL_CALL(glDeleteFramebuffers(1, &m_fbo));
+        m_fbo = 0;
+    }
+    if (m_accumulation != 0) {
+        GL_CALL(glDeleteTextures(1, &m_accumulation));
+        m_accumulation = 0;
+    }
+    if (m_revealage != 0) {
+        GL_CALL(glDeleteTextures(1, &m_revealage));
+        m_revealage = 0;
+    }
+    if (m_depth != 0) {
+        GL_CALL(glDeleteRenderbuffers(1, &m_depth));
+        m_depth = 0;
+    }
+    m_width = 0;
+    m_height = 0;
+}
+
+bool WeightedBlendedOit::beginAccumulation() {
+    // ӿǴ (0, 0) ʼ (main.cppOnResize)
+    GLint viewport[4];
+    GL_CALL(glGetIntegerv(GL_VIEWPORT, viewport));
+    m_active = ensureTargets(viewport[2], viewport[3]);
+    if (!m_active) {
+        return false;
+    }
+
+    // 1. Ʋ͸ȣۻֻͨȲ
+    GL_CALL(glBindFramebuffer(GL_READ_FRAMEBUFFER, 0));
+    GL_CALL(glBindFramebuffer(GL_DRAW_FRAMEBUFFER, m_fbo));
+    GL_CALL(glBlitFramebuffer(0, 0, m_width, m_height, 0, 0, m_width, m_height, GL_DEPTH_BUFFER_BIT, GL_NEAREST));
+    GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, m_fbo));
+
+    // 2. ۻɫΪ0͸Ϊ1 (û͸ʱȫ͸)
+    const GLfloat zero[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    const GLfloat one[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+    GL_CALL(glClearBufferfv(GL_COLOR, 0, zero));
+    GL_CALL(glClearBufferfv(GL_COLOR, 1, one));
+
+    // 3. ĿʹòͬĻϷ̣ɫӣ͸
+    GL_CALL(glEnable(GL_BLEND));
+    GL_CALL(glBlendFunci(0, GL_ONE, GL_ONE));
+    GL_CALL(glBlendFunci(1, GL_ZERO, GL_ONE_MINUS_SRC_COLOR));
+    GL_CALL(glDepthMask(GL_FALSE));
+    return true;
+}
+
+void WeightedBlendedOit::endAccumulation() {
+    if (!m_active) {
+        return;
+    }
+    GL_CALL(glDepthMask(GL_TRUE));
+    GL_CALL(glDisable(GL_BLEND));
+    GL_CALL(glBindFramebuffer(GL_FRAMEBUFFER, 0));
+}
+
+void WeightedBlendedOit::composite(Shader& compositeShader) {
+    if (!m_active) {
+        return;
+    }
+    m_active = false;
+    if (m_emptyVao == 0) {
+        GL_CALL(glGenVertexArrays(1, &m_emptyVao));
+    }
+
+    // ϳɽ = ƽɫ * (1 - revealage) +  * revealage
+    GL_CALL(glDisable(GL_DEPTH_TEST));
+    GL_CALL(glEnable(GL_BLEND));
+    GL_CALL(glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA));
+
+    compositeShader.begin();
+    GL_CALL(glActiveTexture(GL_TEXTURE0));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, m_accumulation));
+    GL_CALL(glActiveTexture(GL_TEXTURE1));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, m_revealage));
+    compositeShader.setInt("accumulation", 0);
+    compositeShader.setInt("revealage", 1);
+    GL_CALL(glBindVertexArray(m_emptyVao));
+    GL_CALL(glDrawArrays(GL_TRIANGLES, 0, 3));
+    GL_CALL(glBindVertexArray(0));
+    GL_CALL(glBindTexture(GL_TEXTURE_2D, 0));
+    GL_CALL(glActiveTexture(GL_TEXTURE0));
+    compositeShader.end();
+
+    GL_CALL(glDisable(GL_BLEND));
+    GL_CALL(glEnable(GL_DEPTH_TEST));
+}
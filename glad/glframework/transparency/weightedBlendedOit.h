@@ -0,0 +1,52 @@
+#pragma once
+
+#include "../core.h"          // GLAD
+
+class Shader;
+
+// WeightedBlendedOitȨϵ˳޹͸ (Weighted Blended OIT)
+// TransparentQueue::flush·ʺϳǧ鴰ĳ
+// - ۻͨ͸Meshػһ飬дȾĿ
+//   accumulation (RGBA16FȼȨԤɫ֮ͣONE, ONE) 
+//   revealage (R8͸֮ZERO, ONE_MINUS_SRC_COLOR)
+//   Ƭεļassets/shaders/fragment.glslеoitPass֧
+// - ϳͨȫΰѼȨƽɫ 1 - revealage ϵĬ֡
+//   (assets/shaders/oitCompositeVertex.glsl / oitCompositeFragment.glsl)
+// ۻͨʹôĬ֡帴ƹȣ͸嵲ס͸ƬճȲ޳
+// ǽƵ (͸֮ǰϵֻȨ)ûκ
+// ֻGL߳ʹãȾĿڵһʹúӿڴС仯ʱ () 
+class WeightedBlendedOit {
+public:
+    WeightedBlendedOit() = default;
+    ~WeightedBlendedOit();
+
+    // GL󣬽ֹ
+    WeightedBlendedOit(const WeightedBlendedOit&) = delete;
+    WeightedBlendedOit& operator=(const WeightedBlendedOit&) = delete;
+
+    // ʼۻͨǰӿ׼ȾĿ꣬Ĭ֡ȣĿ꣬
+    // ֡岢û״̬ (رд룬Ȳ)
+    // ֮ɵ÷oitPass = 1͸Mesh (TransparentQueue::flushUnsorted)
+    // ޷ȾĿʱfalseıκ״̬÷Ӧ
+    bool beginAccumulation();
+
+    // ۻָͨĬ֡ͻ״̬
+    void endAccumulation();
+
+    // ϳͨۻϵǰ֡ (Ҳд)
+    void composite(Shader& compositeShader);
+
+private:
+    // ӿڴС仯ʱؽȾĿ꣬ʧʱfalse
+    bool ensureTargets(int width, int height);
+    void releaseTargets();
+
+    GLuint m_fbo = 0;
+    GLuint m_accumulation = 0;      // RGBA16F
+    GLuint m_revealage = 0;         // R8
+    GLuint m_depth = 0;             // Ĭ֡ͬʽģ建壬glBlitFramebuffer
+    GLuint m_emptyVao = 0;          // ȫεĶgl_VertexID
+    int m_width = 0;
+    int m_height = 0;
+    bool m_active = false;          // beginAccumulationɹ֮Ϊtrue
+};
@@ -0,0 +1,210 @@
+#include "stagingRing.h"
+#include "../../wrapper/checkError.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    // Ķ룬ͬʱ㶥/Ķȡ룬ڵķͬһ
+    constexpr size_t ALIGNMENT = 64;
+    // εȴդĳʱ ()ʱȴ
+    constexpr GLuint64 WAIT_TIMEOUT = 1000000;
+
+    size_t alignUp(size_t value) {
+        return (value + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+}
+
+StagingRing* StagingRing::mInstance = nullptr;
+StagingRing* StagingRing::getInstance() {
+    if (mInstance == nullptr) {
+        mInstance = new StagingRing();
+    }
+    return mInstance;
+}
+
+bool StagingRing::init() {
+    if (m_initTried) {
+        return m_mapped != nullptr;
+    }
+    m_initTried = true;
+    if (glBufferStorage == nullptr || glMapBufferRange == nullptr) {
+        std::cerr << "WARNING: Persistent buffer mapping is not supported, uploads use glBufferData." << std::endl;
+        return false;
+    }
+    GLbitfield mapFlags = GL_MAP_WRITE_BIT | GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    GL_CALL(glGenBuffers(1, &m_buffer));
+    GL_CALL(glBindBuffer(GL_COPY_READ_BUFFER, m_buffer));
+    GL_CALL(glBufferStorage(GL_COPY_READ_BUFFER, static_cast<GLsizeiptr>(DEFAULT_CAPACITY), nullptr, mapFlags | GL_CLIENT_STORAGE_BIT));
+    m_mapped = static_cast<uint8_t*>(glMapBufferRange(GL_COPY_READ_BUFFER, 0, static_cast<GLsizeiptr>(DEFAULT_CAPACITY), mapFlags));
+    GL_CALL(glBindBuffer(GL_COPY_READ_BUFFER, 0));
+    if (m_mapped == nullptr) {
+        std::cerr << "WARNING: Could not map the staging buffer, uploads use glBufferData." << std::endl;
+        GL_CALL(glDeleteBuffers(1, &m_buffer));
+        m_buffer = 0;
+        return false;
+    }
+    m_capacity = DEFAULT_CAPACITY;
+    return true;
+}
+
+bool StagingRing::fit(size_t bytes, size_t& offset) {
+    if (m_used == 0) {
+        m_head = m_tail = 0;
+    }
+    if (m_head >= m_tail && m_used < m_capacity) {
+        // ռõĲûƻأβŲʱβͷʼ
+        if (m_capacity - m_head >= bytes) {
+            offset = m_head;
+            return true;
+        }
+        if (m_tail >= bytes) {
+            m_used += m_capacity - m_head;
+            m_pendingBytes += m_capacity - m_head;
+            offset = 0;
+            return true;
+        }
+        return false;
+    }
+    if (m_head < m_tail && m_tail - m_head >= bytes) {
+        offset = m_head;
+        return true;
+    }
+    return false;
+}
+
+void StagingRing::retireOldest(bool wait) {
+    Segment& segment = m_segments.front();
+    GLenum status = glClientWaitSync(segment.fence, 0, 0);
+    if (status == GL_TIMEOUT_EXPIRED) {
+        if (!wait) {
+            return;
+        }
+        auto start = std::chrono::steady_clock::now();
+        do {
+            status = glClientWaitSync(segment.fence, GL_SYNC_FLUSH_COMMANDS_BIT, WAIT_TIMEOUT);
+        } while (status == GL_TIMEOUT_EXPIRED);
+        m_stats.waits++;
+        m_stats.waitMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    if (status == GL_WAIT_FAILED) {
+        std::cerr << "WARNING: Waiting for a staging fence failed, reusing its space anyway." << std::endl;
+    }
+    GL_CALL(glDeleteSync(segment.fence));
+    m_tail = segment.end;
+    m_used -= segment.bytes;
+    m_segments.pop_front();
+}
+
+StagingRing::Allocation StagingRing::allocate(size_t bytes) {
+    Allocation allocation;
+    if (bytes == 0 || !init()) {
+        return allocation;
+    }
+    size_t aligned = alignUp(bytes);
+    size_t offset = 0;
+    bool found = false;
+    if (aligned <= m_capacity) {
+        // ռ䲻ʱεȴΣֻʣδύķʱ
+        found = fit(aligned, offset);
+        while (!found && !m_segments.empty()) {
+            retireOldest(true);
+            found = fit(aligned, offset);
+        }
+    }
+    if (!found) {
+        m_stats.fallbacks++;
+        return allocation;
+    }
+    m_head = offset + aligned;
+    m_used += aligned;
+    m_pendingBytes += aligned;
+    allocation.data = m_mapped + offset;
+    allocation.offset = offset;
+    allocation.size = bytes;
+    return allocation;
+}
+
+bool StagingRing::contains(const void* data, size_t bytes, size_t& offset) const {
+    const uint8_t* pointer = static_cast<const uint8_t*>(data);
+    if (m_mapped == nullptr || pointer < m_mapped || pointer >= m_mapped + m_capacity
+        || bytes > static_cast<size_t>(m_mapped + m_capacity - pointer)) {
+        return false;
+    }
+    offset = static_cast<size_t>(pointer - m_mapped);
+    return true;
+}
+
+void StagingRing::uploadBuffer(GLenum target, const void* data, size_t bytes) {
+    m_stats.uploadedBytes += bytes;
+    size_t offset = 0;
+    if (!contains(data, bytes, offset)) {
+        Allocation allocation = allocate(bytes);
+        if (!allocation) {
+            GL_CALL(glBufferData(target, static_cast<GLsizeiptr>(bytes), data, GL_STATIC_DRAW));
+            m_stats.directBytes += bytes;
+            return;
+        }
+        auto start = std::chrono::steady_clock::now();
+        std::memcpy(allocation.data, data, bytes);
+        m_stats.cpuCopyMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        m_stats.cpuCopyBytes += bytes;
+        offset = allocation.offset;
+    }
+    // ӳCOHERENTģд֮󷢳GLɼҪˢ
+    GL_CALL(glBufferData(target, static_cast<GLsizeiptr>(bytes), nullptr, GL_STATIC_DRAW));
+    GL_CALL(glBindBuffer(GL_COPY_READ_BUFFER, m_buffer));
+    GL_CALL(glCopyBufferSubData(GL_COPY_READ_BUFFER, target, static_cast<GLintptr>(offset), 0, static_cast<GLsizeiptr>(bytes)));
+    GL_CALL(glBindBuffer(GL_COPY_READ_BUFFER, 0));
+    m_stats.gpuCopyBytes += bytes;
+}
+
+void StagingRing::commit() {
+    if (m_mapped == nullptr) {
+        return;
+    }
+    // ػGPUѾɵ
+    while (!m_segments.empty()) {
+        size_t count = m_segments.size();
+        retireOldest(false);
+        if (m_segments.size() == count) {
+            break;
+        }
+    }
+    if (m_pendingBytes == 0) {
+        return;
+    }
+    Segment segment;
+    segment.end = m_head;
+    segment.bytes = m_pendingBytes;
+    segment.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_segments.push_back(segment);
+    m_pendingBytes = 0;
+}
+
+void StagingRing::release() {
+    for (Segment& segment : m_segments) {
+        GL_CALL(glDeleteSync(segment.fence));
+    }
+    m_segments.clear();
+    if (m_buffer != 0) {
+        GL_CALL(glBindBuffer(GL_COPY_READ_BUFFER, m_buffer));
+        GL_CALL(glUnmapBuffer(GL_COPY_READ_BUFFER));
+        GL_CALL(glBindBuffer(GL_COPY_READ_BUFFER, 0));
+        GL_CALL(glDeleteBuffers(1, &m_buffer));
+    }
+    m_buffer = 0;
+    m_mapped = nullptr;
+    m_capacity = 0;
+    m_head = m_tail = m_used = m_pendingBytes = 0;
+}
+
+void StagingRing::logStats(const std::string& label) const {
+    const double mb = 1024.0 * 1024.0;
+    double bandwidth = m_stats.cpuCopyMs > 0.0 ? m_stats.cpuCopyBytes / mb / (m_stats.cpuCopyMs / 1000.0) : 0.0;
+    std::cout << "Uploads '" << label << "': " << m_stats.uploadedBytes / mb << " MB, " << m_stats.copiesPerByte() << " copies per byte ("
+        << m_stats.decodedBytes / mb << " MB decompressed in place, " << m_stats.cpuCopyBytes / mb << " MB staged at " << bandwidth << " MB/s, "
+        << m_stats.directBytes / mb << " MB via glBufferData), " << m_stats.fallbacks << " fallbacks, "
+        << m_stats.waits << " fence waits (" << m_stats.waitMs << " ms)." << std::endl;
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "../core.h"          // GLAD
+
+#include <cstddef>            // size_t
+#include <cstdint>            // uint8_t
+#include <deque>              // ύ
+#include <string>             // std::string
+
+// StagingRingȫΨһĳ־ӳݴ (λ)
+// һglBufferStorageһֱӳŵĻ (GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT)
+// дӳڴGPUglCopyBufferSubDataƵĿ껺ڲһο
+// - ԴѹĿֱӽѹݴ (AssetPack::read)MeshʱֻGPUϸƣCPUûκο
+// - Դ (ڴӳ䡢Ķ) memcpyһεݴglBufferDataȲ
+// - GL_CLIENT_STORAGE_BITӳڴΪɻϵͳڴ棬MeshΧʱֱӶȡ
+// 䰴˳Уÿ֡commit()Ϊһ֡ķһդռ䲻ʱȴդٻ֮ǰΡ
+// ûύķ (÷ܻʹ) Զᱻգռ䱻ռݴʱʧܣ
+// ÷˻صglBufferData (ϵĻ)ֻͬǶһο
+// ֻGL߳ʹãһϴʱGL
+class StagingRing {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 64u << 20;
+
+    // ݴеһռ
+    struct Allocation {
+        uint8_t* data = nullptr;    // ӳڴеĵַ
+        size_t offset = 0;          // ݴ滺еƫ
+        size_t size = 0;
+        explicit operator bool() const { return data != nullptr; }
+    };
+
+    // ϴͳ (ۼ)ÿֽڵĿֻCPU () ݵİˣѹGPUϵĸƲ
+    struct Stats {
+        size_t uploadedBytes = 0;   // дĿ껺ֽ
+        size_t gpuCopyBytes = 0;    // ݴGPUϸƵֽ
+        size_t decodedBytes = 0;    // ֱӽѹݴֽ (0ο)
+        size_t cpuCopyBytes = 0;    // memcpyݴֽ (1ο)
+        size_t directBytes = 0;     // ˻glBufferDataֽ (ٿ1)
+        double cpuCopyMs = 0.0;     // memcpyݴĺʱ
+        size_t fallbacks = 0;       // ʧܵĴ
+        size_t waits = 0;           // ȴդĴ
+        double waitMs = 0.0;
+
+        double copiesPerByte() const {
+            return uploadedBytes > 0 ? static_cast<double>(cpuCopyBytes + directBytes) / static_cast<double>(uploadedBytes) : 0.0;
+        }
+    };
+
+    static StagingRing* getInstance();
+
+    // bytesֽ (64ֽڶ)ʧʱؿյAllocationGL̵߳
+    Allocation allocate(size_t bytes);
+
+    // [data, data + bytes)ǷλݴУʱݴ滺еƫ
+    bool contains(const void* data, size_t bytes, size_t& offset) const;
+
+    // ΪtargetѰ󶨵ĻbytesֽڵĴ洢 (GL_STATIC_DRAW) data
+    // dataݴʱֻGPUϸƣmemcpyݴݴʱglBufferData(data)
+    void uploadBuffer(GLenum target, const void* data, size_t bytes);
+
+    // ¼ֱӽѹݴֽ (AssetPack::read)
+    void recordDecoded(size_t bytes) { m_stats.decodedBytes += bytes; }
+
+    // Ϊһcommitķդ֮ЩռԱգͬʱGPUѾΡ
+    // ѭÿ֡һΣʱٳκAllocation
+    void commit();
+
+    // ɾGL󣬱GL֮ǰ
+    void release();
+
+    const Stats& getStats() const { return m_stats; }
+
+    // ϴͳƣÿֽڵĿmemcpyݴĴ
+    void logStats(const std::string& label) const;
+
+private:
+    StagingRing() = default;
+
+    // ӳݴ滺ʧܺٳ
+    bool init();
+
+    // ڵǰпռһbytesֽڵռ䣬Ųʱfalse
+    bool fit(size_t bytes, size_t& offset);
+
+    // ȴύɲ
+    void retireOldest(bool wait);
+
+private:
+    // һcommitύΣһεĽβendbytesֽ (ƻʱβ)
+    struct Segment {
+        size_t end = 0;
+        size_t bytes = 0;
+        GLsync fence = nullptr;
+    };
+
+    static StagingRing* mInstance;
+
+    GLuint m_buffer = 0;
+    uint8_t* m_mapped = nullptr;
+    size_t m_capacity = 0;
+    bool m_initTried = false;
+
+    size_t m_head = 0;          // һηλ
+    size_t m_tail = 0;          // δݵλ
+    size_t m_used = 0;          // ռõֽ ( + δύķ)
+    size_t m_pendingBytes = 0;  // һcommitռõֽ
+    std::deque<Segment> m_segments;
+    Stats m_stats;
+};
@@ -0,0 +1,175 @@
+#include "potentiallyVisibleSet.h"
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+namespace {
+    void writeVarint(std::vector<uint8_t>& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    bool readVarint(const uint8_t*& p, const uint8_t* end, uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (p >= end) {
+                return false;
+            }
+            uint8_t byte = *p++;
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+bool PotentiallyVisibleSet::load(const std::string& path) {
+    using namespace pvs;
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open()) {
+        std::cerr << "ERROR: Could not open PVS file: " << path << std::endl;
+        return false;
+    }
+    uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+    file.seekg(0);
+
+    PvsHeader header = {};
+    if (fileSize < sizeof(header) || !file.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || header.magic != PVS_MAGIC || header.version != PVS_VERSION) {
+        std::cerr << "ERROR: Invalid PVS file: " << path << std::endl;
+        return false;
+    }
+    uint64_t cellCount = static_cast<uint64_t>(header.cellCountX) * header.cellCountZ;
+    uint64_t expectedSize = sizeof(header) + cellCount * sizeof(uint32_t) + static_cast<uint64_t>(header.setCount) * sizeof(PvsSet) + header.dataSize;
+    if (expectedSize != fileSize || !(header.cellSize > 0.0f)) {
+        std::cerr << "ERROR: Invalid PVS file: " << path << std::endl;
+        return false;
+    }
+
+    m_cellSets.resize(static_cast<size_t>(cellCount));
+    m_sets.resize(header.setCount);
+    m_data.resize(static_cast<size_t>(header.dataSize));
+    file.read(reinterpret_cast<char*>(m_cellSets.data()), static_cast<std::streamsize>(cellCount * sizeof(uint32_t)));
+    file.read(reinterpret_cast<char*>(m_sets.data()), static_cast<std::streamsize>(m_sets.size() * sizeof(PvsSet)));
+    file.read(reinterpret_cast<char*>(m_data.data()), static_cast<std::streamsize>(m_data.size()));
+    if (!file) {
+        std::cerr << "ERROR: Failed to read PVS file: " << path << std::endl;
+        return false;
+    }
+    for (uint32_t set : m_cellSets) {
+        if (set != NO_SET && set >= header.setCount) {
+            std::cerr << "ERROR: Invalid PVS file: " << path << std::endl;
+            return false;
+        }
+    }
+    for (const PvsSet& set : m_sets) {
+        if (static_cast<uint64_t>(set.offset) + set.size > header.dataSize) {
+            std::cerr << "ERROR: Invalid PVS file: " << path << std::endl;
+            return false;
+        }
+    }
+
+    m_header = header;
+    m_cachedSet = NO_SET;
+    std::cout << "PVS '" << path << "' loaded: " << header.cellCountX << "x" << header.cellCountZ << " cells, "
+        << header.setCount << " unique sets, " << header.objectCount << " objects, " << header.dataSize << " bytes." << std::endl;
+    return true;
+}
+
+const std::vector<uint64_t>* PotentiallyVisibleSet::getVisibleSet(const glm::vec3& position) {
+    if (!isLoaded() || position.y < m_header.minY || position.y > m_header.maxY) {
+        return nullptr;
+    }
+    float cellX = std::floor((position.x - m_header.gridMin[0]) / m_header.cellSize);
+    float cellZ = std::floor((position.z - m_header.gridMin[1]) / m_header.cellSize);
+    if (cellX < 0.0f || cellZ < 0.0f || cellX >= static_cast<float>(m_header.cellCountX) || cellZ >= static_cast<float>(m_header.cellCountZ)) {
+        return nullptr;
+    }
+    uint32_t set = m_cellSets[static_cast<size_t>(cellX) + static_cast<size_t>(cellZ) * m_header.cellCountX];
+    if (set == pvs::NO_SET) {
+        return nullptr;
+    }
+
+    if (set != m_cachedSet) {
+        const pvs::PvsSet& entry = m_sets[set];
+        if (!decode(m_data.data() + entry.offset, entry.size, m_header.objectCount, m_visible)) {
+            std::cerr << "ERROR: Corrupt PVS set " << set << std::endl;
+            m_cachedSet = pvs::NO_SET;
+            return nullptr;
+        }
+        m_cachedSet = set;
+    }
+    return &m_visible;
+}
+
+void PotentiallyVisibleSet::encode(const std::vector<uint64_t>& bits, size_t bitCount, std::vector<uint8_t>& out) {
+    std::vector<uint8_t> runs;
+    bool current = false;
+    uint64_t run = 0;
+    for (size_t i = 0; i < bitCount; ++i) {
+        if (isVisible(bits, i) != current) {
+            writeVarint(runs, run);
+            current = !current;
+            run = 0;
+        }
+        run++;
+    }
+    writeVarint(runs, run);
+
+    size_t rawSize = (bitCount + 7) / 8;
+    if (runs.size() < rawSize) {
+        out.push_back(static_cast<uint8_t>(pvs::SetEncoding::RunLength));
+        out.insert(out.end(), runs.begin(), runs.end());
+        return;
+    }
+    out.push_back(static_cast<uint8_t>(pvs::SetEncoding::Raw));
+    for (size_t i = 0; i < rawSize; ++i) {
+        out.push_back(static_cast<uint8_t>(bits[i / 8] >> (i % 8 * 8)));
+    }
+}
+
+bool PotentiallyVisibleSet::decode(const uint8_t* data, size_t size, size_t bitCount, std::vector<uint64_t>& bits) {
+    bits.assign((bitCount + 63) / 64, 0);
+    if (size == 0) {
+        return false;
+    }
+    const uint8_t* p = data + 1;
+    const uint8_t* end = data + size;
+
+    if (data[0] == static_cast<uint8_t>(pvs::SetEncoding::Raw)) {
+        if (static_cast<size_t>(end - p) != (bitCount + 7) / 8) {
+            return false;
+        }
+        for (size_t i = 0; p < end; ++i, ++p) {
+            bits[i / 8] |= static_cast<uint64_t>(*p) << (i % 8 * 8);
+        }
+        return true;
+    }
+    if (data[0] != static_cast<uint8_t>(pvs::SetEncoding::RunLength)) {
+        return false;
+    }
+
+    bool current = false;
+    size_t position = 0;
+    while (p < end) {
+        uint64_t run;
+        if (!readVarint(p, end, run) || run > bitCount - position) {
+            return false;
+        }
+        if (current) {
+            for (size_t i = position; i < position + run; ++i) {
+                bits[i / 64] |= uint64_t(1) << (i % 64);
+            }
+        }
+        position += static_cast<size_t>(run);
+        current = !current;
+    }
+    return position == bitCount;
+}
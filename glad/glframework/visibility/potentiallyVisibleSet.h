@@ -0,0 +1,41 @@
+#pragma once
+
+#include "../core.h"          // glm
+#include "pvsFormat.h"
+
+#include <cstdint>            // uint64_t
+#include <string>             // std::string
+#include <vector>             // std::vector
+
+// PotentiallyVisibleSetʱԤɼ (pvsFormat.htools/pvsBuilder)
+// λĳԪʱֻиõԪλΪ1Ķܿɼ޳ֻһβ
+// ѹλԪ棬ͣͬһԪʱظѹ
+// ߶ȷΧ֮⡢ڵԪûʱ޳ (getVisibleSetnullptr)
+class PotentiallyVisibleSet {
+public:
+    // ȡ.pvsļʧʱfalse
+    bool load(const std::string& path);
+    bool isLoaded() const { return m_header.magic == pvs::PVS_MAGIC; }
+
+    // positionڵԪĿɼλûʱnullptrصλһεǰЧ
+    const std::vector<uint64_t>* getVisibleSet(const glm::vec3& position);
+
+    static bool isVisible(const std::vector<uint64_t>& bits, size_t object) {
+        return object / 64 < bits.size() && (bits[object / 64] >> (object % 64) & 1) != 0;
+    }
+
+    uint32_t getObjectCount() const { return m_header.objectCount; }
+
+    // λ/ (߹ߺʱãʽpvsFormat.h)
+    static void encode(const std::vector<uint64_t>& bits, size_t bitCount, std::vector<uint8_t>& out);
+    static bool decode(const uint8_t* data, size_t size, size_t bitCount, std::vector<uint64_t>& bits);
+
+private:
+    pvs::PvsHeader m_header = {};
+    std::vector<uint32_t> m_cellSets;
+    std::vector<pvs::PvsSet> m_sets;
+    std::vector<uint8_t> m_data;
+
+    uint32_t m_cachedSet = pvs::NO_SET;  // m_visibleӦλ
+    std::vector<uint64_t> m_visible;
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstdint>            // ڹ̶
+
+// Ǳڿɼļ (.pvs) ĶƸʽ߹tools/pvsBuilderɣPotentiallyVisibleSetȡ
+// ͨпռXZƽϻΪСΪcellSizeεԪ߶ȷΧ[minY, maxY]ΪӵֵܳķΧ
+// ÿԪ¼һɼλ㼶 (.tileset) TileContentıһ¡
+// ֣
+//   PvsHeader
+//   uint32_t cellSets[cellCountX * cellCountZ]   Ԫ (x + z * cellCountX) ʹõλţNO_SETʾû
+//   PvsSet sets[setCount]                         ȥغλ
+//   uint8_t data[dataSize]                        ѹλ
+// λѹһֽΪSetEncodingΪ
+//   Rawԭʼλ(objectCount + 7) / 8 ֽڣλǰ
+//   RunLength01γ̳ (0ʼ)ÿΪLEB128䳤һγ̿Ϊ0
+// ʱΪÿλѡ϶̵һ (ɼƬʱγ̱̣ɢʱԭʼλ)
+// 㼶ͬѼȥ㼶origin
+namespace pvs {
+
+    constexpr uint32_t PVS_MAGIC = 0x53565047u; // "GPVS"
+    constexpr uint32_t PVS_VERSION = 1;
+    constexpr uint32_t NO_SET = 0xFFFFFFFFu;
+
+    struct PvsHeader {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t objectCount;
+        uint32_t cellCountX;
+        uint32_t cellCountZ;
+        uint32_t setCount;
+        float gridMin[2];       // ½ (x, z)
+        float cellSize;
+        float minY;             // ӵ߶ȷΧ
+        float maxY;
+        uint32_t reserved;
+        uint64_t dataSize;
+    };
+
+    enum class SetEncoding : uint8_t {
+        Raw = 0,
+        RunLength = 1
+    };
+
+    struct PvsSet {
+        uint32_t offset;        // еƫ
+        uint32_t size;
+    };
+}
@@ -0,0 +1,195 @@
+#include "triangleBvh.h"
+#include "../spatial/spaceFillingCurve.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace {
+    // Χ (slab)ؽ룬ཻʱ
+    float intersectBox(const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance,
+        const glm::vec3& minBounds, const glm::vec3& maxBounds) {
+        glm::vec3 t0 = (minBounds - origin) * inverseDirection;
+        glm::vec3 t1 = (maxBounds - origin) * inverseDirection;
+        glm::vec3 tNear = glm::min(t0, t1);
+        glm::vec3 tFar = glm::max(t0, t1);
+        float enter = std::max({ tNear.x, tNear.y, tNear.z, 0.0f });
+        float exit = std::min({ tFar.x, tFar.y, tFar.z, maxDistance });
+        return enter <= exit ? enter : std::numeric_limits<float>::infinity();
+    }
+}
+
+void TriangleBvh::build(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices, const std::vector<uint32_t>& triangleObjects) {
+    m_nodes.clear();
+    m_triangles.clear();
+
+    uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+    std::vector<uint32_t> order(triangleCount);
+    std::vector<glm::vec3> centroids(triangleCount);
+    m_bounds.resize(size_t(triangleCount) * 2);
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+        const glm::vec3& a = positions[indices[t * 3]];
+        const glm::vec3& b = positions[indices[t * 3 + 1]];
+        const glm::vec3& c = positions[indices[t * 3 + 2]];
+        order[t] = t;
+        centroids[t] = (a + b + c) / 3.0f;
+        m_bounds[t * 2] = glm::min(a, glm::min(b, c));
+        m_bounds[t * 2 + 1] = glm::max(a, glm::max(b, c));
+    }
+    if (triangleCount == 0) {
+        m_bounds.clear();
+        return;
+    }
+
+    // ȰĵMorton˳Źݣݹ黮ʱʵİΧкڴмУ
+    // Ҷе (水Ҷ˳) Ҳڿռ
+    std::vector<uint32_t> curve = spatial::curveOrder(centroids, spatial::Curve::Morton);
+    centroids = spatial::permute(centroids, curve);
+    std::vector<glm::vec3> bounds(m_bounds.size());
+    for (uint32_t i = 0; i < triangleCount; ++i) {
+        bounds[i * 2] = m_bounds[curve[i] * 2];
+        bounds[i * 2 + 1] = m_bounds[curve[i] * 2 + 1];
+    }
+    m_bounds.swap(bounds);
+
+    m_nodes.reserve(size_t(triangleCount) * 2 / LEAF_SIZE + 1);
+    buildNode(order, centroids, 0, triangleCount);
+    for (uint32_t& t : order) {
+        t = curve[t];
+    }
+
+    // ΰҶ˳ţҶʱ
+    m_triangles.resize(triangleCount);
+    for (uint32_t i = 0; i < triangleCount; ++i) {
+        uint32_t t = order[i];
+        const glm::vec3& a = positions[indices[t * 3]];
+        Triangle& triangle = m_triangles[i];
+        triangle.v0 = a;
+        triangle.edge1 = positions[indices[t * 3 + 1]] - a;
+        triangle.edge2 = positions[indices[t * 3 + 2]] - a;
+        triangle.object = t < triangleObjects.size() ? triangleObjects[t] : NO_OBJECT;
+        triangle.index = t;
+    }
+    m_bounds.clear();
+    m_bounds.shrink_to_fit();
+}
+
+uint32_t TriangleBvh::buildNode(std::vector<uint32_t>& order, std::vector<glm::vec3>& centroids, uint32_t begin, uint32_t end) {
+    uint32_t nodeIndex = static_cast<uint32_t>(m_nodes.size());
+    m_nodes.emplace_back();
+
+    glm::vec3 minBounds(std::numeric_limits<float>::max());
+    glm::vec3 maxBounds(-std::numeric_limits<float>::max());
+    glm::vec3 minCentroid = minBounds;
+    glm::vec3 maxCentroid = maxBounds;
+    for (uint32_t i = begin; i < end; ++i) {
+        uint32_t t = order[i];
+        minBounds = glm::min(minBounds, m_bounds[t * 2]);
+        maxBounds = glm::max(maxBounds, m_bounds[t * 2 + 1]);
+        minCentroid = glm::min(minCentroid, centroids[t]);
+        maxCentroid = glm::max(maxCentroid, centroids[t]);
+    }
+    m_nodes[nodeIndex].minBounds = minBounds;
+    m_nodes[nodeIndex].maxBounds = maxBounds;
+
+    glm::vec3 extent = maxCentroid - minCentroid;
+    int axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+    // 㹻٣ȫغ޷ٷʱΪҶ
+    if (end - begin <= LEAF_SIZE || extent[axis] <= 0.0f) {
+        m_nodes[nodeIndex].first = begin;
+        m_nodes[nodeIndex].count = end - begin;
+        return nodeIndex;
+    }
+
+    uint32_t mid = begin + (end - begin) / 2;
+    std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end, [&](uint32_t a, uint32_t b) {
+        return centroids[a][axis] < centroids[b][axis];
+    });
+    buildNode(order, centroids, begin, mid);
+    // ݹʹm_nodes·䣬ܳ
+    uint32_t right = buildNode(order, centroids, mid, end);
+    m_nodes[nodeIndex].first = right;
+    m_nodes[nodeIndex].count = 0;
+    return nodeIndex;
+}
+
+template<bool ANY_HIT>
+bool TriangleBvh::traverse(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Hit& hit) const {
+    if (m_nodes.empty()) {
+        return false;
+    }
+    // Ϊ0ʱõslabȻȷ
+    glm::vec3 inverseDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+    float closest = maxDistance;
+    bool found = false;
+
+    uint32_t stack[64];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0) {
+        const Node& node = m_nodes[stack[--stackSize]];
+        if (intersectBox(origin, inverseDirection, closest, node.minBounds, node.maxBounds) == std::numeric_limits<float>::infinity()) {
+            continue;
+        }
+        if (node.count > 0) {
+            // Moller-Trumbore
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                const Triangle& triangle = m_triangles[i];
+                glm::vec3 p = glm::cross(direction, triangle.edge2);
+                float determinant = glm::dot(triangle.edge1, p);
+                if (std::abs(determinant) < 1e-12f) {
+                    continue;
+                }
+                float inverseDeterminant = 1.0f / determinant;
+                glm::vec3 s = origin - triangle.v0;
+                float u = glm::dot(s, p) * inverseDeterminant;
+                if (u < 0.0f || u > 1.0f) {
+                    continue;
+                }
+                glm::vec3 q = glm::cross(s, triangle.edge1);
+                float v = glm::dot(direction, q) * inverseDeterminant;
+                if (v < 0.0f || u + v > 1.0f) {
+                    continue;
+                }
+                float t = glm::dot(triangle.edge2, q) * inverseDeterminant;
+                if (t < 0.0f || t >= closest) {
+                    continue;
+                }
+                closest = t;
+                found = true;
+                hit.distance = t;
+                hit.triangle = triangle.index;
+                hit.object = triangle.object;
+                if (ANY_HIT) {
+                    return true;
+                }
+            }
+            continue;
+        }
+
+        // ȷʽϽӽڵ㣬Զӽڵܱ
+        uint32_t left = static_cast<uint32_t>(&node - m_nodes.data()) + 1;
+        uint32_t right = node.first;
+        float leftDistance = intersectBox(origin, inverseDirection, closest, m_nodes[left].minBounds, m_nodes[left].maxBounds);
+        float rightDistance = intersectBox(origin, inverseDirection, closest, m_nodes[right].minBounds, m_nodes[right].maxBounds);
+        if (leftDistance > rightDistance) {
+            std::swap(left, right);
+            std::swap(leftDistance, rightDistance);
+        }
+        if (rightDistance != std::numeric_limits<float>::infinity() && stackSize < 64) {
+            stack[stackSize++] = right;
+        }
+        if (leftDistance != std::numeric_limits<float>::infinity() && stackSize < 64) {
+            stack[stackSize++] = left;
+        }
+    }
+    return found;
+}
+
+bool TriangleBvh::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Hit& hit) const {
+    return traverse<false>(origin, direction, maxDistance, hit);
+}
+
+bool TriangleBvh::occluded(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const {
+    Hit hit;
+    return traverse<true>(origin, direction, maxDistance, hit);
+}
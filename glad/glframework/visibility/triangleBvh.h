@@ -0,0 +1,63 @@
+#pragma once
+
+#include "../core.h"          // glm
+
+#include <cstdint>            // uint32_t
+#include <vector>             // std::vector
+
+// TriangleBvh̬μϵİΧвνṹ߿ɼԼ/ײѯ
+// - ϵλݹ֣ҶLEAF_SIZEΣڵ㰴˳ţ
+//   ӽڵڸڵֻ֮Ҫ¼ӽڵλã
+// - ÿδһ (Ľ)߲ѯеκͶ
+// - ֻڶ߳ͬʱѯ
+class TriangleBvh {
+public:
+    static constexpr uint32_t NO_OBJECT = 0xFFFFFFFFu;
+
+    struct Hit {
+        float distance = 0.0f;
+        uint32_t triangle = 0;
+        uint32_t object = NO_OBJECT;
+    };
+
+    // positionsΪ㣬indicesÿ3һΣtriangleObjects[i]ΪiεĶ (Ϊ)
+    void build(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices, const std::vector<uint32_t>& triangleObjects = {});
+
+    // origindirection (λ) maxDistanceУûʱfalse
+    bool raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Hit& hit) const;
+
+    // maxDistanceǷκ (ҵһͷأraycast)
+    bool occluded(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const;
+
+    size_t getTriangleCount() const { return m_triangles.size(); }
+    size_t getNodeCount() const { return m_nodes.size(); }
+    glm::vec3 getMinBounds() const { return m_nodes.empty() ? glm::vec3(0.0f) : m_nodes[0].minBounds; }
+    glm::vec3 getMaxBounds() const { return m_nodes.empty() ? glm::vec3(0.0f) : m_nodes[0].maxBounds; }
+
+private:
+    static constexpr uint32_t LEAF_SIZE = 4;
+
+    struct Node {
+        glm::vec3 minBounds;
+        glm::vec3 maxBounds;
+        uint32_t first = 0;     // ҶӣһΣڲڵ㣺ӽڵ
+        uint32_t count = 0;     // Ҷӣڲڵ㣺0
+    };
+
+    struct Triangle {
+        glm::vec3 v0;
+        glm::vec3 edge1;
+        glm::vec3 edge2;
+        uint32_t object;
+        uint32_t index;         // ǰα
+    };
+
+    uint32_t buildNode(std::vector<uint32_t>& order, std::vector<glm::vec3>& centroids, uint32_t begin, uint32_t end);
+    template<bool ANY_HIT>
+    bool traverse(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Hit& hit) const;
+
+private:
+    std::vector<Node> m_nodes;
+    std::vector<Triangle> m_triangles;     // Ҷ˳
+    std::vector<glm::vec3> m_bounds;       // ʱÿεİΧ (min, max)ͷ
+};
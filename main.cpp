@@ -1,9 +1,28 @@
 #include <iostream>
+#include <filesystem>
+#include <chrono>
 
 // Զܺ͵ͷļ
 #include "glframework/core.h"        // Ŀͷļ (GLAD, GLFW, GLM)
 #include "glframework/shader.h"      // ԶShader
 #include "glframework/model.h"       // <<< ԶModel
+#include "glframework/resource/resourceManager.h" // Դִ+ü
+#include "glframework/resource/materialCache.h" // ͬʿģ͹
+#include "glframework/job/jobSystem.h" // ȡϵͳء޳決ã
+#include "glframework/asset/assetPipeline.h" // Э첽ˮ
+#include "glframework/hotreload/hotReloader.h" // ԴأShader/OBJ/MTL/ͼ
+#include "glframework/streaming/tileStreamer.h" // Ƭʽ
+#include "glframework/visibility/potentiallyVisibleSet.h" // ֵεԤɼ
+#include "glframework/clip/clipSet.h" // ƽ/к
+#include "glframework/transparency/transparentQueue.h" // ͸ (Ļǽ) Զ
+#include "glframework/transparency/weightedBlendedOit.h" // Ȩϵ˳޹͸
+#include "glframework/profiling/gpuTimer.h" // GPUʱѯ
+#include "glframework/pulling/geometryArena.h" // ɱ̶ȡ (SSBO + ؼӻ)
+#include "glframework/pulling/visibilityBuffer.h" // ɼԻ ( + ȣʽ)
+#include "glframework/attributes/attributeTable.h" // Եʽ洢
+#include "glframework/attributes/thematicColors.h" // Ըɫ
+#include "glframework/collision/collisionWorld.h" // ײ (ײBVH)
+#include "glframework/upload/stagingRing.h" // ־ӳϴݴ
 // #include "glframework/texture.h" // <<< ƳTextureModel/Material
 #include "application/Application.h" // ԶApplication
 #include "wrapper/checkError.h"      // OpenGLͺ
@@ -18,12 +37,57 @@
 
 // ȫֱ
 // -----------------------------------------------------------------------------
-Shader* shader = nullptr; // Shaderʵָ룬ɫ
+ShaderHandle shader; // ShaderɫResourceManager
+ShaderHandle outlineShader; //  ( + GPU) Shader
+bool showOutlines = true; // OлǷ
+ShaderHandle capShader; // ڵShader
+ClipSet* clipSet = nullptr; // ƽ棬зõGLЧڼ䴴
+enum class ClipMode { None, SectionPlane, Box };
+ClipMode clipMode = ClipMode::None; // Cл -> ˮƽ -> к
+float sectionHeight = 0.0f; // ˮƽĸ߶ (ʵϷ)PageUp/PageDown
+TransparentQueue transparentQueue; // ͸Meshڲ͸֮ͳһ򡢻ϻ
+ShaderHandle oitCompositeShader; // ȨOITĺϳShader
+WeightedBlendedOit* weightedOit = nullptr; // ȨOITȾĿ꣬Чڼ䴴
+enum class TransparencyMode { Sorted, WeightedBlended };
+TransparencyMode transparencyMode = TransparencyMode::Sorted; // Tл <-> ȨOIT
+GpuTimer* transparencyTimer = nullptr; // ͸ͨGPUʱڱȽģʽ
+int transparencyFrames = 0; // ϴͳ͸֡
+double transparencySortMs = 0.0; // ͬڵCPUʱ֮
+ShaderHandle pullingShader; // ȡShader (Ƭɫshaderͬ)
+GeometryArena* geometryArena = nullptr; // ȡĹЧڼ䴴
+ShaderHandle visibilityShader; // ɼͨShader (ɫpullingShaderͬ)
+ShaderHandle visibilityClassifyShader; // ɼԻͨShader (д)
+ShaderHandle visibilityResolveShader; // ɼԻͨShader
+ShaderHandle visibilityCompositeShader; // ѽϳɵĬ֡Shader
+VisibilityBuffer* visibilityBuffer = nullptr; // ɼԻȾĿ꣬Чڼ䴴
+enum class GeometryPath { PerMeshVao, VertexPulling, VisibilityBuffer };
+GeometryPath geometryPath = GeometryPath::PerMeshVao; // VлMeshVAO -> ȡ -> ɼԻ
+GpuTimer* sceneTimer = nullptr; // ͨ (͸) GPUʱڱȽϸ·
+int sceneFrames = 0; // ϴͳ֡
+double sceneCpuMs = 0.0; // ͬͨCPUʱ֮ (ģ + ύ)
 Model* myModel = nullptr; // Modelʵָ룬ģݺMVP
+TileStreamer* tileStreamer = nullptr; // ƬʽƬ嵥ʱŴ
+const char* TILESET_MANIFEST = "assets/city/tileset.txt"; // Ƭ嵥·
+const char* TILESET_INDEX = "assets/city/city.tileset"; // tools/tilerɵĲ㼶ʱʹ
+const char* TILESET_PVS = "assets/city/city.pvs"; // tools/pvsBuilderΪ㼶ɵǱڿɼѡ
+const char* MODEL_DIR = "C:/Users/16344/Desktop/DEHHALKAJ000160N"; // ģͼĿ¼
+const char* MODEL_OBJ = "C:/Users/16344/Desktop/DEHHALKAJ000160N/lod3.obj";
+const char* MODEL_PAK = "C:/Users/16344/Desktop/DEHHALKAJ000160N/lod3.pak"; // tools/modelConverterʱʹ
+PotentiallyVisibleSet cityPvs;
+const char* ATTRIBUTE_TABLE = "assets/city/attributes.csv"; // Ա (һΪ)ѡ
+AttributeTable buildingAttributes; // ֯ԣģͼغOBJļ (ģͰĿ¼) к
+ObjectColorBuffer* objectColors = nullptr; // רɫɫЧڼ䴴
+int thematicColumn = AttributeTable::NO_COLUMN; // Bлɫ -> Աĵ0 -> 1 -> ...
+
+CollisionWorld collisionWorld; // ģͺʽƬײģʽײ
+int collisionFrames = 0; // ϴͳģʽ֡
+double collisionMicroseconds = 0.0; // ͬײѯĺʱ֮
 
 // Ϳʵ
 PerspectiveCamera* camera = nullptr;
-TrackBallCameraControl* cameraControl = nullptr;
+TrackBallCameraControl* trackBallControl = nullptr;
+GameCameraControl* walkControl = nullptr; // һ˳ (ײ + )
+CameraControl* cameraControl = nullptr; // ǰʹõĿGڹ켣֮л
 
 // ڼdeltaTime
 double g_lastFrameTime = 0.0;
@@ -38,9 +102,135 @@ void OnResize(int width, int height) {
     std::cout << "OnResize" << std::endl;
 }
 
+// updateClipSet 
+// ģʽ߶ؽƽ
+// --------------------
+void updateClipSet() {
+    if (!clipSet) {
+        return;
+    }
+    clipSet->clear();
+    if (clipMode == ClipMode::SectionPlane) {
+        clipSet->addPlane(glm::vec3(0.0f, -1.0f, 0.0f), glm::vec3(0.0f, sectionHeight, 0.0f));
+    }
+    else if (clipMode == ClipMode::Box) {
+        // ģĻ׼ţкȡģĸһ
+        clipSet->setBox(glm::vec3(-0.5f, -1.0f, -0.5f), glm::vec3(0.5f, sectionHeight, 0.5f));
+    }
+}
+
+// geometryPathName 
+// ǰ·ƣ
+// --------------------
+const char* geometryPathName() {
+    switch (geometryPath) {
+    case GeometryPath::VertexPulling:
+        return "vertex pulling";
+    case GeometryPath::VisibilityBuffer:
+        return "visibility buffer";
+    default:
+        return "per-mesh VAO";
+    }
+}
+
+// updateThematicColors 
+// thematicColumnÿɫϴнֻҪһλ
+// --------------------
+void updateThematicColors() {
+    if (thematicColumn == AttributeTable::NO_COLUMN || !objectColors) {
+        std::cout << "Thematic coloring: off" << std::endl;
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    std::vector<glm::vec4> colors;
+    thematic::defaultColors(buildingAttributes, thematicColumn, colors);
+    objectColors->update(colors);
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Thematic coloring: " << buildingAttributes.getColumnName(thematicColumn);
+    AttributeTable::Selection all = buildingAttributes.selectAll();
+    if (buildingAttributes.isNumeric(thematicColumn)) {
+        AttributeTable::Summary summary = buildingAttributes.summarize(thematicColumn, all);
+        std::cout << " (" << summary.count << " values, " << summary.minValue << " ~ " << summary.maxValue << ", mean " << summary.mean() << ")";
+    }
+    else {
+        std::cout << " (" << buildingAttributes.getCategories(thematicColumn).size() - 1 << " categories)";
+    }
+    std::cout << ", " << colors.size() << " buildings recolored in " << ms << " ms" << std::endl;
+}
+
+// toggleWalking 
+// ڹ켣͵һ˳֮лײߴ簴׸㵽絥λ
+// ģͰΪ2׼ʽƬԭʼ (1λ = 1)
+// --------------------
+void toggleWalking() {
+    if (cameraControl == walkControl) {
+        cameraControl = trackBallControl;
+        std::cout << "Camera: trackball" << std::endl;
+        return;
+    }
+    float metersToWorld = 1.0f;
+    if (myModel) {
+        glm::vec3 extent = myModel->getMaxCoords() - myModel->getMinCoords();
+        float maxDim = std::max({ extent.x, extent.y, extent.z });
+        if (maxDim > 0.0f) {
+            metersToWorld = glm::length(glm::vec3(myModel->getModelMatrix()[0])) * 2.0f / maxDim;
+        }
+    }
+    walkControl->setCollisionShape(0.3f * metersToWorld, 1.7f * metersToWorld);
+    walkControl->setStepHeight(0.35f * metersToWorld);
+    walkControl->setGravity(9.81f * metersToWorld);
+    walkControl->setSpeed(0.05f * metersToWorld); // ÿ֡60֡ʱԼ3/
+    walkControl->levelCamera();
+    walkControl->setWalking(true);
+    cameraControl = walkControl;
+    collisionFrames = 0;
+    collisionMicroseconds = 0.0;
+    const CollisionWorld::Stats& stats = collisionWorld.getStats();
+    std::cout << "Camera: walking (" << stats.bodies << " collision bodies, " << stats.triangles << " triangles)" << std::endl;
+}
+
 // OnKey ص
 // -----------------
 void OnKey(int key, int action, int mods) {
+    if (key == GLFW_KEY_O && action == GLFW_PRESS) {
+        showOutlines = !showOutlines;
+    }
+    if (key == GLFW_KEY_C && action == GLFW_PRESS) {
+        clipMode = clipMode == ClipMode::None ? ClipMode::SectionPlane : (clipMode == ClipMode::SectionPlane ? ClipMode::Box : ClipMode::None);
+        updateClipSet();
+    }
+    if (key == GLFW_KEY_V && action == GLFW_PRESS) {
+        geometryPath = geometryPath == GeometryPath::PerMeshVao ? GeometryPath::VertexPulling
+            : (geometryPath == GeometryPath::VertexPulling ? GeometryPath::VisibilityBuffer : GeometryPath::PerMeshVao);
+        std::cout << "Geometry path: " << geometryPathName() << std::endl;
+        sceneFrames = 0;
+        sceneCpuMs = 0.0;
+        if (sceneTimer) {
+            sceneTimer->resetAverage();
+        }
+    }
+    if (key == GLFW_KEY_B && action == GLFW_PRESS && buildingAttributes.getColumnCount() > 0) {
+        thematicColumn = thematicColumn + 1 < static_cast<int>(buildingAttributes.getColumnCount()) ? thematicColumn + 1 : AttributeTable::NO_COLUMN;
+        updateThematicColors();
+    }
+    if (key == GLFW_KEY_T && action == GLFW_PRESS) {
+        transparencyMode = transparencyMode == TransparencyMode::Sorted ? TransparencyMode::WeightedBlended : TransparencyMode::Sorted;
+        std::cout << "Transparency: " << (transparencyMode == TransparencyMode::Sorted ? "sorted" : "weighted blended OIT") << std::endl;
+        // лͳƣģʽĺʱһ
+        transparencyFrames = 0;
+        transparencySortMs = 0.0;
+        if (transparencyTimer) {
+            transparencyTimer->resetAverage();
+        }
+    }
+    if (key == GLFW_KEY_G && action == GLFW_PRESS && walkControl) {
+        toggleWalking();
+    }
+    if ((key == GLFW_KEY_PAGE_UP || key == GLFW_KEY_PAGE_DOWN) && action != GLFW_RELEASE) {
+        sectionHeight += key == GLFW_KEY_PAGE_UP ? 0.05f : -0.05f;
+        updateClipSet();
+    }
     if (cameraControl) {
         cameraControl->onKey(key, action, mods);
     }
@@ -75,24 +265,87 @@ void OnScroll(double offset) {
 // prepareShader 
 // --------------------
 void prepareShader() {
-    shader = new Shader("assets/shaders/vertex.glsl", "assets/shaders/fragment.glsl");
+    shader = ResourceManager::getInstance()->create<Shader>("assets/shaders/vertex.glsl", "assets/shaders/fragment.glsl");
+    outlineShader = ResourceManager::getInstance()->create<Shader>("assets/shaders/outlineVertex.glsl", "assets/shaders/outlineFragment.glsl");
+    capShader = ResourceManager::getInstance()->create<Shader>("assets/shaders/capVertex.glsl", "assets/shaders/capFragment.glsl");
+    oitCompositeShader = ResourceManager::getInstance()->create<Shader>("assets/shaders/oitCompositeVertex.glsl", "assets/shaders/oitCompositeFragment.glsl");
+    pullingShader = ResourceManager::getInstance()->create<Shader>("assets/shaders/pullingVertex.glsl", "assets/shaders/fragment.glsl");
+    visibilityShader = ResourceManager::getInstance()->create<Shader>("assets/shaders/pullingVertex.glsl", "assets/shaders/visibilityFragment.glsl");
+    visibilityClassifyShader = ResourceManager::getInstance()->create<Shader>("assets/shaders/oitCompositeVertex.glsl", "assets/shaders/visibilityClassifyFragment.glsl");
+    visibilityResolveShader = ResourceManager::getInstance()->create<Shader>("assets/shaders/visibilityResolveVertex.glsl", "assets/shaders/visibilityResolveFragment.glsl");
+    visibilityCompositeShader = ResourceManager::getInstance()->create<Shader>("assets/shaders/oitCompositeVertex.glsl", "assets/shaders/visibilityCompositeFragment.glsl");
+    // shaderļԶ±
+    HotReloader::getInstance()->watchShader(shader);
+    HotReloader::getInstance()->watchShader(outlineShader);
+    HotReloader::getInstance()->watchShader(capShader);
+    HotReloader::getInstance()->watchShader(oitCompositeShader);
+    HotReloader::getInstance()->watchShader(pullingShader);
+    HotReloader::getInstance()->watchShader(visibilityShader);
+    HotReloader::getInstance()->watchShader(visibilityClassifyShader);
+    HotReloader::getInstance()->watchShader(visibilityResolveShader);
+    HotReloader::getInstance()->watchShader(visibilityCompositeShader);
+}
+
+// prepareAttributes 
+// ------------------
+void prepareAttributes() {
+    if (std::filesystem::exists(ATTRIBUTE_TABLE)) {
+        buildingAttributes.loadCsv(ATTRIBUTE_TABLE);
+    }
 }
 
 // prepareModel 
 // ------------------
 void prepareModel() {
-    // Model󣬴OBJļ·Ŀ¼
+    // 첽ģͣOBJļ·Ŀ¼
     // Ŀ¼ͨOBJļڵĿ¼MTLļmap_Kd·ĸĿ¼
     // OBJļ assets/models/your_new_model.obj
     // MTLļ assets/models/your_new_model.mtl
     //  assets/models/materials_textures/
     // ô textureBaseDir Ӧ "assets/models/"
-    myModel = new Model("C:/Users/16344/Desktop/DEHHALKAJ000160N/lod3.obj", "C:/Users/16344/Desktop/DEHHALKAJ000160N" ); // <<< ȷļ·Ŀ¼ȷ !!!
+    // ȡͼں̨УGLԴѭpumpGLQueueдǰΪ
+    // Ѿtools/modelConverterתʱֱӼŻõԴٽOBJ
+    bool packed = std::filesystem::exists(MODEL_PAK);
+    AssetPipeline::getInstance()->load(packed ? MODEL_PAK : MODEL_OBJ, MODEL_DIR, // <<< ȷļ·Ŀ¼ȷ !!!
+        [packed](Model* model) {
+            if (!model) {
+                return;
+            }
+            myModel = model;
+            myModel->setPosition(glm::vec3(0.0f, 0.0f, 0.0f)); // ģԭ
+            myModel->setRotation(0.0f, glm::vec3(0.0f, 1.0f, 0.0f)); // ʼת
+            myModel->setScale(glm::vec3(1.0f)); // Ĭ
+            myModel->setObjectId(buildingAttributes.findRow(AttributeTable::buildingIdFromPath(MODEL_DIR))); // Ŀ¼
+            myModel->setCollisionWorld(&collisionWorld); // ؼκģµǼ
+            // OBJ/MTL/ͼļֻӰԴ (ԴҪת)
+            if (!packed) {
+                HotReloader::getInstance()->watchModel(myModel, MODEL_DIR);
+            }
+            MaterialCache::getInstance()->logStats("main model");
+            StagingRing::getInstance()->logStats("main model");
+        });
+}
 
-    if (myModel) {
-        myModel->setPosition(glm::vec3(0.0f, 0.0f, 0.0f)); // ģԭ
-        myModel->setRotation(0.0f, glm::vec3(0.0f, 1.0f, 0.0f)); // ʼת
-        myModel->setScale(glm::vec3(1.0f)); // Ĭ
+// prepareTiles 
+// ------------------
+void prepareTiles() {
+    bool hasIndex = std::filesystem::exists(TILESET_INDEX);
+    if (!hasIndex && !std::filesystem::exists(TILESET_MANIFEST)) {
+        return;
+    }
+    tileStreamer = new TileStreamer();
+    bool loaded = hasIndex ? tileStreamer->loadTileset(TILESET_INDEX) : tileStreamer->loadManifest(TILESET_MANIFEST);
+    if (!loaded) {
+        delete tileStreamer;
+        tileStreamer = nullptr;
+        return;
+    }
+    if (buildingAttributes.getRowCount() > 0) {
+        tileStreamer->setAttributeTable(&buildingAttributes);
+    }
+    tileStreamer->setCollisionWorld(&collisionWorld);
+    if (hasIndex && std::filesystem::exists(TILESET_PVS) && cityPvs.load(TILESET_PVS)) {
+        tileStreamer->setPotentiallyVisibleSet(&cityPvs);
     }
 }
 
@@ -105,9 +358,13 @@ void prepareCameraAndControl() {
         0.1f,
         1000.0f
     );
-    cameraControl = new TrackBallCameraControl();
-    cameraControl->setCamera(camera);
-    cameraControl->setSensitivity(0.4f);
+    trackBallControl = new TrackBallCameraControl();
+    trackBallControl->setCamera(camera);
+    trackBallControl->setSensitivity(0.4f);
+    walkControl = new GameCameraControl();
+    walkControl->setCamera(camera);
+    walkControl->setCollisionWorld(&collisionWorld);
+    cameraControl = trackBallControl;
 }
 
 // prepareState 
@@ -115,14 +372,33 @@ void prepareCameraAndControl() {
 void prepareState() {
     GL_CALL(glEnable(GL_DEPTH_TEST));
     GL_CALL(glDepthFunc(GL_LESS));
+    clipSet = new ClipSet();
+    updateClipSet();
+    weightedOit = new WeightedBlendedOit();
+    transparencyTimer = new GpuTimer();
+    geometryArena = new GeometryArena();
+    visibilityBuffer = new VisibilityBuffer();
+    objectColors = new ObjectColorBuffer();
+    sceneTimer = new GpuTimer();
 }
 
-// render 
-// -------------
-void render() {
-    GL_CALL(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+// applyThematicColoring 
+// shaderǷʹרɫ (shaderѼ)ɫrenderʼʱ
+// ----------------
+void applyThematicColoring(Shader& shader) {
+    shader.setInt("thematicColoring", thematicColumn != AttributeTable::NO_COLUMN ? 1 : 0);
+}
 
-    shader->begin();
+// drawScene 
+// shaderģͺҰڵƬƽClipSetõshaderȫеMesh/Ƭơ
+// transparentΪʱ͸MeshֻύУMeshһֱӻƣ
+// pathPerMeshVaoʱMeshύgeometryArenaһԻ (ȡɼͨ + ͨ)
+// ----------------
+void drawScene(Shader& shader, TransparentQueue* transparent, GeometryPath path) {
+    GeometryArena* arena = path != GeometryPath::PerMeshVao ? geometryArena : nullptr;
+    shader.begin();
+    clipSet->apply(shader);
+    applyThematicColoring(shader);
 
     // ͼͶӰ󴫵ݸModel
     // Model::draw() ḺЩԼģ;һ͵ɫ
@@ -130,12 +406,186 @@ void render() {
     if (myModel && camera) {
         myModel->setViewMatrix(camera->getViewMatrix());
         myModel->setProjectionMatrix(camera->getProjectionMatrix());
-        myModel->draw(*shader); // ģ
+        myModel->setLodSelection(static_cast<float>(app->getHeight())); // ԴеMeshĻռѡLOD
+        myModel->setClipSet(clipSet);
+        myModel->setTransparentQueue(transparent);
+        myModel->setGeometryArena(arena);
+        myModel->draw(shader); // ģ
+    }
+    if (tileStreamer && camera) {
+        tileStreamer->setClipSet(clipSet);
+        tileStreamer->setTransparentQueue(transparent);
+        tileStreamer->setGeometryArena(arena);
+        tileStreamer->draw(shader, camera->getViewMatrix(), camera->getProjectionMatrix());
+    }
+
+    shader.end();
+
+    if (!arena || arena->size() == 0 || !camera) {
+        return;
+    }
+    Shader* pulling = ResourceManager::getInstance()->get(pullingShader);
+    Shader* visibility = ResourceManager::getInstance()->get(visibilityShader);
+    Shader* classify = ResourceManager::getInstance()->get(visibilityClassifyShader);
+    Shader* resolve = ResourceManager::getInstance()->get(visibilityResolveShader);
+    Shader* composite = ResourceManager::getInstance()->get(visibilityCompositeShader);
+    if (path == GeometryPath::VisibilityBuffer && visibility && classify && resolve && composite) {
+        // ɼԻһζؼӻдźȣٰȫ
+        visibility->begin();
+        clipSet->apply(*visibility);
+        bool drawn = geometryArena->drawVisibility(*visibility, *visibilityBuffer, camera->getViewMatrix(), camera->getProjectionMatrix());
+        visibility->end();
+        if (drawn) {
+            // ȫβдü룬ڿɼͨ
+            ClipSet::disableClipDistances();
+            // ͨShaderresolveVisibilityuniformڳУԤ
+            resolve->begin();
+            applyThematicColoring(*resolve);
+            resolve->end();
+            geometryArena->resolveVisibility(*classify, *resolve, *composite, *visibilityBuffer,
+                camera->getViewMatrix(), camera->getProjectionMatrix());
+        }
     }
+    else if (pulling) {
+        // ȡģύ֮ÿһζؼӻ
+        pulling->begin();
+        clipSet->apply(*pulling);
+        applyThematicColoring(*pulling);
+        geometryArena->flush(*pulling, camera->getViewMatrix(), camera->getProjectionMatrix());
+        pulling->end();
+    }
+    else {
+        geometryArena->clear();
+    }
+}
 
-    shader->end();
+// reportScene 
+// ÿ120֡һͨƽʱ (GPUʱ + CPUʱ)ڱȽMeshơȡͿɼԻ
+// --------------------
+void reportScene(double cpuMs) {
+    sceneCpuMs += cpuMs;
+    if (++sceneFrames < 120) {
+        return;
+    }
+    std::cout << "Scene (" << geometryPathName() << "): GPU " << sceneTimer->getAverageMs()
+        << " ms, CPU " << sceneCpuMs / sceneFrames << " ms per frame";
+    if (geometryPath != GeometryPath::PerMeshVao) {
+        const GeometryArena::Stats& stats = geometryArena->getStats();
+        std::cout << ", " << stats.draws << " draws in " << stats.batches << " multi-draws, "
+            << stats.residentMeshes << " meshes / " << (stats.vertexBytes + stats.indexBytes) / (1024 * 1024) << " MB resident";
+    }
+    std::cout << std::endl;
+    sceneFrames = 0;
+    sceneCpuMs = 0.0;
+    sceneTimer->resetAverage();
 }
 
+// reportTransparency 
+// ÿ120֡һ͸ͨƽʱ (GPUʱ + CPUʱ)ڲ϶ĳбȽģʽ
+// --------------------
+void reportTransparency() {
+    const TransparentQueue::Stats& stats = transparentQueue.getStats();
+    transparencySortMs += stats.sortMs;
+    if (++transparencyFrames < 120) {
+        return;
+    }
+    std::cout << "Transparency (" << (transparencyMode == TransparencyMode::Sorted ? "sorted" : "weighted blended OIT") << "): "
+        << stats.items << " items, GPU " << transparencyTimer->getAverageMs() << " ms, sort "
+        << transparencySortMs / transparencyFrames << " ms per frame" << std::endl;
+    transparencyFrames = 0;
+    transparencySortMs = 0.0;
+    transparencyTimer->resetAverage();
+}
+
+// reportCollision 
+// ģʽÿ120֡һײѯ (ɨ + ) ƽʱ
+// --------------------
+void reportCollision() {
+    if (cameraControl != walkControl) {
+        return;
+    }
+    collisionMicroseconds += walkControl->getCollisionMicroseconds();
+    if (++collisionFrames < 120) {
+        return;
+    }
+    const CollisionWorld::Stats& stats = collisionWorld.getStats();
+    std::cout << "Collision: " << collisionMicroseconds / collisionFrames << " us per frame, "
+        << stats.bodies << " bodies, " << stats.triangles << " triangles" << std::endl;
+    collisionFrames = 0;
+    collisionMicroseconds = 0.0;
+}
+
+// render 
+// -------------
+void render() {
+    GL_CALL(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+
+    Shader* shaderPtr = ResourceManager::getInstance()->get(shader);
+    if (!shaderPtr) {
+        return;
+    }
+    objectColors->bind();
+    auto sceneStart = std::chrono::steady_clock::now();
+    sceneTimer->begin();
+    drawScene(*shaderPtr, &transparentQueue, geometryPath);
+    sceneTimer->end();
+    reportScene(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - sceneStart).count());
+
+    // ڣģ建ҳƽλģڲĲֲ䣬ԶƽڵķΧ
+    Shader* capPtr = ResourceManager::getInstance()->get(capShader);
+    if (!clipSet->empty() && capPtr && camera) {
+        clipSet->drawCaps(*capPtr, camera->getViewMatrix(), camera->getProjectionMatrix(), camera->mPosition, camera->getFar(),
+            glm::vec3(0.8f, 0.3f, 0.2f), [shaderPtr]() { drawScene(*shaderPtr, nullptr, GeometryPath::PerMeshVao); });
+    }
+
+    // ߣÿMeshһζ߶λƣĹ⻬ɶɫͨü޳
+    Shader* outlinePtr = ResourceManager::getInstance()->get(outlineShader);
+    if (showOutlines && outlinePtr && camera) {
+        // ü0~5Ϊƽ (ClipSet)MAX_PLANESΪж
+        GL_CALL(glEnable(GL_CLIP_DISTANCE0 + ClipSet::MAX_PLANES));
+        outlinePtr->begin();
+        clipSet->apply(*outlinePtr);
+        outlinePtr->setVector3("outlineColor", 0.05f, 0.05f, 0.05f);
+        outlinePtr->setFloat("depthBias", 0.0002f);
+        if (myModel) {
+            myModel->drawOutlines(*outlinePtr);
+        }
+        if (tileStreamer) {
+            tileStreamer->drawOutlines(*outlinePtr, camera->getViewMatrix(), camera->getProjectionMatrix());
+        }
+        outlinePtr->end();
+        GL_CALL(glDisable(GL_CLIP_DISTANCE0 + ClipSet::MAX_PLANES));
+        ClipSet::disableClipDistances();
+    }
+
+    // ͸ͨ͸塢ں߶֮ơ
+    // ģʽӿռȴԶϣȨOITۻ֮һκϳ
+    Shader* compositePtr = ResourceManager::getInstance()->get(oitCompositeShader);
+    if (transparentQueue.size() > 0 && camera) {
+        transparencyTimer->begin();
+        // ȾĿ괴ʧʱһ֡˻ϣ͸ֱӻĬ֡
+        if (transparencyMode == TransparencyMode::WeightedBlended && compositePtr && weightedOit->beginAccumulation()) {
+            shaderPtr->begin();
+            clipSet->apply(*shaderPtr);
+            shaderPtr->setInt("oitPass", 1);
+            transparentQueue.flushUnsorted(*shaderPtr, camera->getViewMatrix(), camera->getProjectionMatrix());
+            shaderPtr->setInt("oitPass", 0);
+            shaderPtr->end();
+            ClipSet::disableClipDistances();
+            weightedOit->endAccumulation();
+            weightedOit->composite(*compositePtr);
+        }
+        else {
+            shaderPtr->begin();
+            clipSet->apply(*shaderPtr);
+            transparentQueue.flush(*shaderPtr, camera->getViewMatrix(), camera->getProjectionMatrix());
+            shaderPtr->end();
+            ClipSet::disableClipDistances();
+        }
+        transparencyTimer->end();
+        reportTransparency();
+    }
+}
 
 // main 
 // -----------
@@ -156,17 +606,87 @@ int main() {
     prepareShader();
     // prepareVAO(); // <<< ƳVAOModel
     // prepareTexture(); // <<< ƳTextureModel/Material
+    prepareAttributes();
     prepareModel();
+    prepareTiles();
     prepareCameraAndControl();
     prepareState();
 
     g_lastFrameTime = glfwGetTime();
 
     while (app->update()) {
+        // ÿһ֡ͳһһУƶڶкϲ
+        app->dispatchInput();
+        // 鱻޸ĵԴļ
+        HotReloader::getInstance()->update();
+        // Ѿ첽صGLϴÿ֡ռ4ms
+        AssetScheduler::getInstance()->pumpGLQueue(4.0);
         cameraControl->update();
+        reportCollision();
+        // λúٶȵפƬں̨У֡
+        if (tileStreamer) {
+            TileStreamer::ViewState view;
+            view.position = camera->mPosition;
+            view.velocity = cameraControl->getVelocity();
+            view.viewProjection = camera->getProjectionMatrix() * camera->getViewMatrix();
+            view.fovY = glm::radians(camera->getFovy());
+            view.viewportHeight = static_cast<float>(app->getHeight());
+            tileStreamer->update(view);
+        }
         render();
+
+        // һ֡ͳһüԴ
+        ResourceManager::getInstance()->collectGarbage();
+        // һ֡ϴѾȫΪݴդ
+        StagingRing::getInstance()->commit();
     }
 
+    // ֹ̨ͣأδɵļֱӷ
+    AssetScheduler::getInstance()->shutdown();
+    // Ự (ʽصƬ) Ĳȥͳ
+    MaterialCache::getInstance()->logStats("session");
+    StagingRing::getInstance()->logStats("session");
+
+    // ͷжGLԴapp->destroy()֮ǰȻЧʱ
+    HotReloader::getInstance()->unwatchModel(myModel);
+    delete myModel;
+    myModel = nullptr;
+    delete tileStreamer;
+    tileStreamer = nullptr;
+    cameraControl = nullptr;
+    delete trackBallControl;
+    trackBallControl = nullptr;
+    delete walkControl;
+    walkControl = nullptr;
+    delete camera;
+    camera = nullptr;
+    delete clipSet;
+    clipSet = nullptr;
+    delete weightedOit;
+    weightedOit = nullptr;
+    delete transparencyTimer;
+    transparencyTimer = nullptr;
+    delete geometryArena;
+    geometryArena = nullptr;
+    delete visibilityBuffer;
+    visibilityBuffer = nullptr;
+    delete objectColors;
+    objectColors = nullptr;
+    delete sceneTimer;
+    sceneTimer = nullptr;
+    ResourceManager::getInstance()->release(shader);
+    ResourceManager::getInstance()->release(outlineShader);
+    ResourceManager::getInstance()->release(capShader);
+    ResourceManager::getInstance()->release(oitCompositeShader);
+    ResourceManager::getInstance()->release(pullingShader);
+    ResourceManager::getInstance()->release(visibilityShader);
+    ResourceManager::getInstance()->release(visibilityClassifyShader);
+    ResourceManager::getInstance()->release(visibilityResolveShader);
+    ResourceManager::getInstance()->release(visibilityCompositeShader);
+    ResourceManager::getInstance()->shutdown();
+    StagingRing::getInstance()->release();
+    JobSystem::getInstance()->shutdown();
+
     app->destroy();
 
     return 0;
@@ -0,0 +1,266 @@
+// geometryBenchԱglframework/simd/geometryKernelsеں˺ģͼԭʹõıѭ
+// ÷geometryBench [--vertices N] [--runs N]
+// N (Ĭ400) һ v/vt ãÿCPUֵָ֧ֱʱ
+//   bounds        ߽ (߳)
+//   bounds-mt     ߽ (JobSystemֿԼ)
+//   sphere        Χ (߳)
+//   sphere-mt     Χ (JobSystemֿԼ)
+//   transform     ӦinitialTransformдPosXYZ + UV (߳)
+// ÿȡһΣѭĽȽϡ
+// ֮ͬһ鶥 (Ϊļ˳СΰΧ) ȽϿռ (glframework/spatial) Ч
+//   curve-morton/curve-hilbert   ˳
+//   bvh-build                    collision::buildBvh (ڲȰMorton˳)
+//   query-file/query-curve       BVHΧвѯҶеͼԪݰļ˳ (orderӷ) / Ҷ˳
+#include "glframework/simd/geometryKernels.h"
+#include "glframework/job/jobSystem.h"
+#include "glframework/collision/bvh.h"
+#include "glframework/spatial/spaceFillingCurve.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    // ---------------- ԭıѭ (Model::calculateBoundingBoxModel::buildGroupGeometry) ----------------
+
+    void referenceBounds(const std::vector<glm::vec3>& positions, glm::vec3& minCoords, glm::vec3& maxCoords) {
+        minCoords = glm::vec3(std::numeric_limits<float>::max());
+        maxCoords = glm::vec3(std::numeric_limits<float>::lowest());
+        for (const glm::vec3& pos : positions) {
+            minCoords.x = std::min(minCoords.x, pos.x);
+            minCoords.y = std::min(minCoords.y, pos.y);
+            minCoords.z = std::min(minCoords.z, pos.z);
+            maxCoords.x = std::max(maxCoords.x, pos.x);
+            maxCoords.y = std::max(maxCoords.y, pos.y);
+            maxCoords.z = std::max(maxCoords.z, pos.z);
+        }
+    }
+
+    float referenceRadius(const std::vector<glm::vec3>& positions, const glm::vec3& center) {
+        float result = 0.0f;
+        for (const glm::vec3& pos : positions) {
+            glm::vec3 d = pos - center;
+            result = std::max(result, d.x * d.x + d.y * d.y + d.z * d.z);
+        }
+        return std::sqrt(result);
+    }
+
+    void referenceTransform(const glm::mat4& matrix, const std::vector<glm::vec3>& positions, const std::vector<glm::vec2>& texCoords,
+        const std::vector<geometry::VertexIndices>& vertices, std::vector<float>& out) {
+        float* dst = out.data();
+        for (const geometry::VertexIndices& vi : vertices) {
+            glm::vec4 transformed_pos = matrix * glm::vec4(positions[vi.posIndex], 1.0f);
+            dst[0] = transformed_pos.x;
+            dst[1] = transformed_pos.y;
+            dst[2] = transformed_pos.z;
+            if (vi.texCoordIndex < texCoords.size()) {
+                dst[3] = texCoords[vi.texCoordIndex].x;
+                dst[4] = texCoords[vi.texCoordIndex].y;
+            }
+            else {
+                dst[3] = 0.0f;
+                dst[4] = 0.0f;
+            }
+            dst += 5;
+        }
+    }
+
+    // ---------------- ʱ ----------------
+
+    double bestOf(int runs, const std::function<void()>& fn) {
+        double best = std::numeric_limits<double>::max();
+        for (int run = 0; run < runs; ++run) {
+            auto start = std::chrono::steady_clock::now();
+            fn();
+            best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        return best;
+    }
+
+    void printRow(const char* kernel, const char* level, double ms, double referenceMs, size_t bytes, const std::string& check) {
+        std::cout << std::left << std::setw(12) << kernel << std::setw(11) << level
+            << std::right << std::fixed << std::setprecision(3) << std::setw(10) << ms << " ms"
+            << std::setprecision(2) << std::setw(8) << referenceMs / ms << "x"
+            << std::setprecision(0) << std::setw(9) << bytes / (ms * 1000.0) << " MB/s"
+            << "  " << check << std::endl;
+    }
+
+    // ռߣļ˳ڿռʱʣ (Ҷ) ˳źӽ˳
+    void benchmarkCurveOrder(const std::vector<glm::vec3>& positions, int runs) {
+        std::vector<glm::vec3> boxesMin(positions.size()), boxesMax(positions.size());
+        for (size_t i = 0; i < positions.size(); ++i) {
+            boxesMin[i] = positions[i] - glm::vec3(0.5f);
+            boxesMax[i] = positions[i] + glm::vec3(0.5f);
+        }
+        auto printTime = [](const char* name, double ms, const std::string& note) {
+            std::cout << std::left << std::setw(23) << name << std::right << std::fixed << std::setprecision(3) << std::setw(10) << ms << " ms"
+                << "  " << note << std::endl;
+        };
+        std::vector<uint32_t> curve;
+        printTime("curve-morton", bestOf(runs, [&]() { curve = spatial::curveOrder(positions, spatial::Curve::Morton); }), "");
+        printTime("curve-hilbert", bestOf(runs, [&]() { curve = spatial::curveOrder(positions, spatial::Curve::Hilbert); }), "");
+
+        std::vector<collision::BvhNode> nodes;
+        std::vector<uint32_t> order;
+        double buildMs = bestOf(runs, [&]() { collision::buildBvh(boxesMin, boxesMax, 4, nodes, order); });
+        printTime("bvh-build", buildMs, std::to_string(nodes.size()) + " nodes");
+
+        // ̶һѯУִŷʽеͼԪȫͬ
+        std::mt19937 random(777);
+        glm::vec3 sceneMin = nodes[0].boundsMin, sceneExtent = nodes[0].boundsMax - nodes[0].boundsMin;
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::vector<glm::vec3> queries(200000);
+        for (glm::vec3& q : queries) {
+            q = sceneMin + glm::vec3(unit(random), unit(random), unit(random)) * sceneExtent;
+        }
+        glm::vec3 queryHalfSize = sceneExtent * 0.01f;
+        std::vector<glm::vec3> leafMin = spatial::permute(boxesMin, order), leafMax = spatial::permute(boxesMax, order);
+        auto runQueries = [&](bool leafOrder) {
+            size_t overlaps = 0;
+            for (const glm::vec3& q : queries) {
+                glm::vec3 qMin = q - queryHalfSize, qMax = q + queryHalfSize;
+                collision::traverseBox(nodes, qMin, qMax, [&](uint32_t first, uint32_t count) {
+                    for (uint32_t i = first; i < first + count; ++i) {
+                        const glm::vec3& bMin = leafOrder ? leafMin[i] : boxesMin[order[i]];
+                        const glm::vec3& bMax = leafOrder ? leafMax[i] : boxesMax[order[i]];
+                        overlaps += bMin.x <= qMax.x && bMin.y <= qMax.y && bMin.z <= qMax.z && bMax.x >= qMin.x && bMax.y >= qMin.y && bMax.z >= qMin.z;
+                    }
+                });
+            }
+            return overlaps;
+        };
+        size_t fileOverlaps = 0, curveOverlaps = 0;
+        double fileMs = bestOf(runs, [&]() { fileOverlaps = runQueries(false); });
+        double curveMs = bestOf(runs, [&]() { curveOverlaps = runQueries(true); });
+        printTime("query-file", fileMs, std::to_string(fileOverlaps) + " overlaps");
+        printTime("query-curve", curveMs, std::to_string(curveOverlaps) + " overlaps, " + std::to_string(fileMs / curveMs).substr(0, 4) + "x");
+    }
+
+    std::string compareFloats(const float* a, const float* b, size_t count, bool& ok) {
+        float maxError = 0.0f;
+        for (size_t i = 0; i < count; ++i) {
+            maxError = std::max(maxError, std::abs(a[i] - b[i]));
+        }
+        if (std::memcmp(a, b, count * sizeof(float)) == 0) {
+            return "exact";
+        }
+        // ѱѭϲFMAʱһλĲ
+        if (maxError > 1e-4f) {
+            ok = false;
+            return "MISMATCH (max error " + std::to_string(maxError) + ")";
+        }
+        return "max error " + std::to_string(maxError);
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t vertexCount = 4000000;
+    int runs = 5;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--vertices") == 0) {
+            vertexCount = static_cast<size_t>(std::max(1, std::atoi(argv[i + 1])));
+        }
+        else if (std::strcmp(argv[i], "--runs") == 0) {
+            runs = std::max(1, std::atoi(argv[i + 1]));
+        }
+    }
+
+    // ̶ӣÿеͬ
+    std::mt19937 random(12345);
+    std::uniform_real_distribution<float> coordinate(-500.0f, 500.0f);
+    std::vector<glm::vec3> positions(vertexCount);
+    for (glm::vec3& p : positions) {
+        p = glm::vec3(coordinate(random), coordinate(random), coordinate(random));
+    }
+    std::vector<glm::vec2> texCoords(vertexCount / 2 + 1);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+    for (glm::vec2& t : texCoords) {
+        t = glm::vec2(unit(random), unit(random));
+    }
+    // ȥغĶһ°˳λãЧ
+    std::vector<geometry::VertexIndices> vertices(vertexCount);
+    std::uniform_int_distribution<uint32_t> jitter(0, 64);
+    for (size_t i = 0; i < vertexCount; ++i) {
+        vertices[i].posIndex = static_cast<uint32_t>(std::min(vertexCount - 1, i + jitter(random)));
+        vertices[i].texCoordIndex = i % 97 == 0 ? 0xFFFFFFFFu : static_cast<uint32_t>((i / 2 + jitter(random)) % texCoords.size());
+    }
+    glm::mat4 matrix = glm::mat4(1.0f);
+    matrix = glm::scale(matrix, glm::vec3(0.004f));
+    matrix = glm::translate(matrix, -glm::vec3(12.5f, -3.0f, 40.0f));
+
+    std::cout << "Vertices: " << vertexCount << ", runs: " << runs << ", threads: " << JobSystem::getInstance()->getThreadCount()
+        << ", supported SIMD level: " << geometry::getSimdLevelName(geometry::getSupportedSimdLevel()) << std::endl;
+
+    // ѭĻ׼
+    glm::vec3 referenceMin, referenceMax;
+    double boundsReferenceMs = bestOf(runs, [&]() { referenceBounds(positions, referenceMin, referenceMax); });
+    glm::vec3 referenceCenter = (referenceMin + referenceMax) * 0.5f;
+    float referenceRadiusValue = 0.0f;
+    double sphereReferenceMs = bestOf(runs, [&]() {
+        referenceBounds(positions, referenceMin, referenceMax);
+        referenceRadiusValue = referenceRadius(positions, referenceCenter);
+    });
+    std::vector<float> referenceVertices(vertexCount * 5);
+    double transformReferenceMs = bestOf(runs, [&]() { referenceTransform(matrix, positions, texCoords, vertices, referenceVertices); });
+
+    size_t positionBytes = vertexCount * sizeof(glm::vec3);
+    size_t transformBytes = vertexCount * (sizeof(geometry::VertexIndices) + sizeof(glm::vec3) + sizeof(glm::vec2) + 5 * sizeof(float));
+    printRow("bounds", "reference", boundsReferenceMs, boundsReferenceMs, positionBytes, "");
+    printRow("sphere", "reference", sphereReferenceMs, sphereReferenceMs, positionBytes * 2, "");
+    printRow("transform", "reference", transformReferenceMs, transformReferenceMs, transformBytes, "");
+
+    bool ok = true;
+    std::vector<float> out(vertexCount * 5);
+    for (int level = 0; level <= static_cast<int>(geometry::getSupportedSimdLevel()); ++level) {
+        const char* levelName = geometry::getSimdLevelName(geometry::setSimdLevel(static_cast<geometry::SimdLevel>(level)));
+
+        auto boundsCheck = [&](const glm::vec3& minCoords, const glm::vec3& maxCoords) -> std::string {
+            if (minCoords == referenceMin && maxCoords == referenceMax) {
+                return "exact";
+            }
+            ok = false;
+            return "MISMATCH";
+        };
+        auto sphereCheck = [&](const glm::vec3& center, float radius) -> std::string {
+            if (center == referenceCenter && radius == referenceRadiusValue) {
+                return "exact";
+            }
+            ok = false;
+            return "MISMATCH (radius " + std::to_string(radius) + " vs " + std::to_string(referenceRadiusValue) + ")";
+        };
+
+        glm::vec3 minCoords, maxCoords, center;
+        float radius = 0.0f;
+        double ms = bestOf(runs, [&]() { geometry::computeBounds(positions.data(), vertexCount, minCoords, maxCoords); });
+        printRow("bounds", levelName, ms, boundsReferenceMs, positionBytes, boundsCheck(minCoords, maxCoords));
+        ms = bestOf(runs, [&]() { geometry::computeBoundsParallel(positions.data(), vertexCount, minCoords, maxCoords); });
+        printRow("bounds-mt", levelName, ms, boundsReferenceMs, positionBytes, boundsCheck(minCoords, maxCoords));
+        ms = bestOf(runs, [&]() { geometry::computeBoundingSphere(positions.data(), vertexCount, center, radius); });
+        printRow("sphere", levelName, ms, sphereReferenceMs, positionBytes * 2, sphereCheck(center, radius));
+        ms = bestOf(runs, [&]() { geometry::computeBoundingSphereParallel(positions.data(), vertexCount, center, radius); });
+        printRow("sphere-mt", levelName, ms, sphereReferenceMs, positionBytes * 2, sphereCheck(center, radius));
+
+        std::fill(out.begin(), out.end(), -1.0f);
+        ms = bestOf(runs, [&]() {
+            geometry::transformInterleaved(matrix, positions.data(), texCoords.data(), texCoords.size(), vertices.data(), vertexCount, out.data());
+        });
+        printRow("transform", levelName, ms, transformReferenceMs, transformBytes, compareFloats(out.data(), referenceVertices.data(), out.size(), ok));
+    }
+
+    benchmarkCurveOrder(positions, runs);
+
+    JobSystem::getInstance()->shutdown();
+    if (!ok) {
+        std::cerr << "ERROR: Kernel results differ from the scalar loops." << std::endl;
+        return 1;
+    }
+    return 0;
+}
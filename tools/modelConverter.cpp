@@ -0,0 +1,283 @@
+// modelConverterOBJģתΪʱֱʹõԴ (.pak)鿴ʱκδ
+// ÷modelConverter <.obj | Ŀ¼> <Ŀ¼> [--lods N] [--crease-angle ] [--no-texture-compression] [--compress] [--cache Ŀ¼] [--no-cache] [--cache-size MB]
+// ÿOBJһ (Ŀ¼/·.pakOBJͬ)
+// - ģĿ (EntryType::CompactModelΪOBJļ)ǻۺ۽ɷߡӶ㡢
+//   㻺/Ȼ/ȡŻLODΪ16ֽڶ (bake/meshBaker.h)
+// - MTLõͼ (EntryType::CompressedTextureΪOBJĿ¼·)sRGBȷmipmap
+//   ͸ͼѹΪBC1 (bake/textureBaker.h)
+// ׶εĲﰴݴݻ (bake/derivedDataCache.h)Ͳûб仯ģ͡ͼֱӸã
+// --cacheָĿ¼ (ĬϼDerivedDataCache::getDefaultDirectory)--no-cacheرջ棬--cache-sizeΪ (MB)
+// ΪĿ¼ʱݹתOBJģJobSystemϲд (ģڲĸ׶Ҳ)
+// Ŀ¼Ŀ¼ͬʱOBJԱߣmain.cppȼ
+#include "glframework/bake/derivedDataCache.h"
+#include "glframework/bake/meshBaker.h"
+#include "glframework/bake/textureBaker.h"
+#include "glframework/pack/packWriter.h"
+#include "glframework/job/jobSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    struct ConvertOptions {
+        bake::MeshBakeOptions mesh;
+        bake::TextureBakeOptions texture;
+        bool compressPack = false;
+    };
+
+    bool isObj(const fs::path& path) {
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return extension == ".obj";
+    }
+
+    bool readFile(const fs::path& path, std::vector<uint8_t>& bytes) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            return false;
+        }
+        bytes.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size())));
+    }
+
+    // ͼڰеĿƣOBJĿ¼·OBJĿ¼ʱֻȡļ
+    std::string textureEntryName(const fs::path& objDir, const std::string& texturePath) {
+        fs::path relative = fs::path(texturePath).lexically_normal().lexically_relative(objDir);
+        std::string name = relative.generic_string();
+        if (name.empty() || name.rfind("..", 0) == 0) {
+            return fs::path(texturePath).filename().generic_string();
+        }
+        return name;
+    }
+
+    // ģͲǰ׺ģĿ
+    struct ModelSummary {
+        bake::MeshBakeStats stats;
+        uint64_t lodCount = 0;
+    };
+
+    // 決һͼѹĿݣʧʱfalse
+    bool bakeTextureEntry(const fs::path& texturePath, const ConvertOptions& options, DerivedDataCache& cache, std::vector<uint8_t>& entry) {
+        std::vector<uint8_t> bytes;
+        if (!readFile(texturePath, bytes)) {
+            return false;
+        }
+        // ֻȡͼݺͲģõͬһͼֻ決һ
+        DerivedDataKey key("texture", bake::TEXTURE_BAKE_VERSION);
+        key.addValue(pack::PACK_VERSION).addBytes(bytes.data(), bytes.size()).addValue(options.texture.compress);
+        return cache.getOrBuild(key, entry, [&](std::vector<uint8_t>& out) {
+            ImageData image;
+            if (!Texture::decode(bytes.data(), bytes.size(), image)) {
+                return false;
+            }
+            bake::BakedTexture texture;
+            bake::bakeTexture(image, options.texture, texture);
+            out = PackWriter::bakeCompressedTexture(texture);
+            return true;
+        });
+    }
+
+    // תһOBJرУʧʱؿַ
+    std::string convertModel(const fs::path& objPath, const fs::path& outputPath, const ConvertOptions& options, DerivedDataCache& cache) {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<uint8_t> objBytes;
+        if (!readFile(objPath, objBytes)) {
+            std::cerr << "ERROR: Could not open OBJ file: " << objPath << std::endl;
+            return std::string();
+        }
+        std::string_view objText(reinterpret_cast<const char*>(objBytes.data()), objBytes.size());
+
+        // Model캯ͬԼOBJĿ¼µmaterials_texturesĿ¼С
+        // ʿڽ֮ǰȷʱҪOBJ
+        fs::path objDir = objPath.parent_path();
+        std::string objBaseDir = objDir.string() + "/";
+        std::string mtlLibName = Model::scanMtlLibName(objText);
+        std::vector<MaterialData> materials;
+        if (!mtlLibName.empty()) {
+            materials = Material::loadMtlFile(objBaseDir + mtlLibName, objBaseDir + "materials_textures/");
+        }
+
+        PackWriter writer(options.compressPack);
+
+        // 1. ͼÿֻ決һΣʸΪðڵĿ
+        std::set<std::string> bakedTextures;
+        size_t compressedTextures = 0;
+        for (MaterialData& material : materials) {
+            if (material.diffuseTexturePath.empty()) {
+                continue;
+            }
+            std::string textureName = textureEntryName(objDir, material.diffuseTexturePath);
+            if (bakedTextures.count(textureName) == 0) {
+                std::vector<uint8_t> entry;
+                if (!bakeTextureEntry(material.diffuseTexturePath, options, cache, entry) || entry.size() < sizeof(pack::CompressedTextureHeader)) {
+                    std::cerr << "WARNING: Texture could not be decoded and is dropped: " << material.diffuseTexturePath << std::endl;
+                    material.diffuseTexturePath.clear();
+                    continue;
+                }
+                pack::CompressedTextureHeader header;
+                std::memcpy(&header, entry.data(), sizeof(header));
+                compressedTextures += header.format == pack::TextureFormat::Bc1;
+                writer.addEntry(textureName, pack::EntryType::CompressedTexture, std::move(entry));
+                bakedTextures.insert(textureName);
+            }
+            material.diffuseTexturePath = textureName;
+        }
+
+        // 2. 񣺼OBJݡ決ͽĲʱ (ʱдģĿ)
+        DerivedDataKey key("compact-model", bake::MESH_BAKE_VERSION);
+        key.addValue(pack::PACK_VERSION).addBytes(objBytes.data(), objBytes.size())
+            .addValue(options.mesh.lodCount).addValue(options.mesh.creaseAngle)
+            .addValue(options.mesh.lodGridResolution).addValue(options.mesh.minLodReduction);
+        for (const MaterialData& material : materials) {
+            key.addString(material.name).addValue(material.Ks.x).addValue(material.Ks.y).addValue(material.Ks.z)
+                .addValue(material.opacity).addString(material.diffuseTexturePath);
+        }
+        std::vector<uint8_t> cached;
+        bool baked = cache.getOrBuild(key, cached, [&](std::vector<uint8_t>& out) {
+            ModelData data;
+            if (!Model::parseObj(objText, objPath.string(), data)) {
+                return false;
+            }
+            ModelSummary summary;
+            bake::CompactModelData compact;
+            bake::bakeModel(data, options.mesh, compact, &summary.stats);
+            for (const bake::CompactMeshData& mesh : compact.meshes) {
+                summary.lodCount = std::max<uint64_t>(summary.lodCount, mesh.lods.size());
+            }
+            std::vector<uint8_t> entry = PackWriter::bakeCompactModel(compact, materials);
+            out.resize(sizeof(ModelSummary));
+            std::memcpy(out.data(), &summary, sizeof(summary));
+            out.insert(out.end(), entry.begin(), entry.end());
+            return true;
+        });
+        if (!baked || cached.size() < sizeof(ModelSummary)) {
+            std::cerr << "ERROR: Model could not be loaded or is empty: " << objPath << std::endl;
+            return std::string();
+        }
+        ModelSummary summary;
+        std::memcpy(&summary, cached.data(), sizeof(summary));
+        const bake::MeshBakeStats& stats = summary.stats;
+        size_t lodCount = static_cast<size_t>(summary.lodCount);
+        writer.addEntry(objPath.filename().generic_string(), pack::EntryType::CompactModel,
+            std::vector<uint8_t>(cached.begin() + sizeof(ModelSummary), cached.end()));
+
+        std::error_code error;
+        fs::create_directories(outputPath.parent_path(), error);
+        if (!writer.write(outputPath.string())) {
+            return std::string();
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::ostringstream report;
+        report << std::fixed << std::setprecision(3)
+            << outputPath.generic_string() << ": "
+            << stats.inputVertices << " -> " << stats.outputVertices << " vertices, "
+            << stats.triangles << " triangles, " << lodCount << " LODs (" << stats.lodTriangles << " LOD triangles), "
+            << "ACMR " << stats.acmrBefore << " -> " << stats.acmrAfter << ", "
+            << bakedTextures.size() << " textures (" << compressedTextures << " BC1), "
+            << fs::file_size(outputPath, error) / 1024 << " KB, "
+            << std::setprecision(2) << seconds << " s";
+        return report.str();
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: modelConverter <input.obj|inputDir> <outputDir> [--lods N] [--crease-angle degrees] [--no-texture-compression] [--compress]"
+            " [--cache dir] [--no-cache] [--cache-size MB]" << std::endl;
+        return 1;
+    }
+    fs::path input = fs::path(argv[1]).lexically_normal();
+    fs::path outputDir = fs::path(argv[2]).lexically_normal();
+    ConvertOptions options;
+    std::string cacheDir = DerivedDataCache::getDefaultDirectory();
+    uint64_t cacheSize = DerivedDataCache::DEFAULT_MAX_BYTES;
+    for (int i = 3; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--lods") == 0 && i + 1 < argc) {
+            options.mesh.lodCount = static_cast<uint32_t>(std::clamp(std::atoi(argv[++i]), 1, static_cast<int>(pack::MAX_LODS)));
+        }
+        else if (std::strcmp(argv[i], "--crease-angle") == 0 && i + 1 < argc) {
+            options.mesh.creaseAngle = static_cast<float>(std::atof(argv[++i]));
+        }
+        else if (std::strcmp(argv[i], "--no-texture-compression") == 0) {
+            options.texture.compress = false;
+        }
+        else if (std::strcmp(argv[i], "--compress") == 0) {
+            options.compressPack = true;
+        }
+        else if (std::strcmp(argv[i], "--cache") == 0 && i + 1 < argc) {
+            cacheDir = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--no-cache") == 0) {
+            cacheDir.clear();
+        }
+        else if (std::strcmp(argv[i], "--cache-size") == 0 && i + 1 < argc) {
+            cacheSize = static_cast<uint64_t>(std::max(std::atoll(argv[++i]), 1LL)) << 20;
+        }
+        else {
+            std::cerr << "WARNING: Unknown option ignored: " << argv[i] << std::endl;
+        }
+    }
+
+    // ļʱΪ Ŀ¼/ļ.pakĿ¼ʱ·
+    std::vector<fs::path> inputs, outputs;
+    if (fs::is_directory(input)) {
+        for (const fs::directory_entry& entry : fs::recursive_directory_iterator(input)) {
+            if (entry.is_regular_file() && isObj(entry.path())) {
+                inputs.push_back(entry.path());
+            }
+        }
+        // ̶˳򣬱֤˳ȶ
+        std::sort(inputs.begin(), inputs.end());
+        for (const fs::path& path : inputs) {
+            outputs.push_back((outputDir / path.lexically_relative(input)).replace_extension(".pak"));
+        }
+    }
+    else if (fs::is_regular_file(input)) {
+        inputs.push_back(input);
+        outputs.push_back((outputDir / input.filename()).replace_extension(".pak"));
+    }
+    if (inputs.empty()) {
+        std::cerr << "ERROR: No OBJ files found in: " << input << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    DerivedDataCache cache(cacheDir, cacheSize);
+    std::vector<std::string> reports(inputs.size());
+    std::atomic<size_t> failures{ 0 };
+    JobSystem::getInstance()->parallelFor(0, inputs.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            reports[i] = convertModel(inputs[i], outputs[i], options, cache);
+            if (reports[i].empty()) {
+                failures++;
+            }
+        }
+    }, 1);
+    JobSystem::getInstance()->shutdown();
+
+    for (const std::string& report : reports) {
+        if (!report.empty()) {
+            std::cout << report << std::endl;
+        }
+    }
+    cache.trim();
+    cache.logStats("modelConverter");
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Converted " << inputs.size() - failures.load() << " of " << inputs.size() << " models in " << seconds << " s." << std::endl;
+    return failures.load() == 0 ? 0 : 1;
+}
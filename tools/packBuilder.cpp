@@ -0,0 +1,213 @@
+// packBuilderһԴĿ¼ɵԴļ (.pak)
+// ÷packBuilder <ԴĿ¼> <.pak> [--compress] [--cache Ŀ¼] [--no-cache]
+// - .obj ļĻ/׼ȥغͬʱΪģĿ (EntryType::Model)
+//   MTLõͼΪðڵĿ
+// - ͼƬļԤȽΪRGBA8ΪĿ (EntryType::Texture)ʱҪ룻
+// - ļ (MTLɫ)ԭΪԭʼĿ
+// ĿΪԴĿ¼·ͳһʹ'/'ָļJobSystemϲд
+// ģͺͼƬĴݻ (bake/derivedDataCache.h)δıļ´ʱٽ/롣
+#include "glframework/bake/derivedDataCache.h"
+#include "glframework/pack/packWriter.h"
+#include "glframework/job/jobSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    // ޸ģ/Ŀɷʽʱ1ʹݻеľɽʧЧ
+    constexpr uint32_t BAKE_VERSION = 1;
+
+    enum class FileKind { Model, Image, Raw };
+
+    FileKind classify(const fs::path& path) {
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (extension == ".obj") {
+            return FileKind::Model;
+        }
+        if (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".bmp"
+            || extension == ".tga" || extension == ".ppm" || extension == ".pgm" || extension == ".psd") {
+            return FileKind::Image;
+        }
+        return FileKind::Raw;
+    }
+
+    bool readFile(const fs::path& path, std::vector<uint8_t>& bytes) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            return false;
+        }
+        bytes.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        return static_cast<bool>(file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size())));
+    }
+
+    // ԴĿ¼µĿƣڸĿ¼ʱؿַ
+    std::string entryName(const fs::path& root, const fs::path& path) {
+        fs::path relative = fs::path(path).lexically_normal().lexically_relative(root);
+        std::string name = relative.generic_string();
+        if (name.empty() || name.rfind("..", 0) == 0) {
+            return std::string();
+        }
+        return name;
+    }
+
+    bool bakeModel(const fs::path& root, const fs::path& path, PackWriter& writer, DerivedDataCache& cache) {
+        std::vector<uint8_t> objBytes;
+        if (!readFile(path, objBytes)) {
+            std::cerr << "ERROR: Could not open OBJ file: " << path << std::endl;
+            return false;
+        }
+        std::string_view objText(reinterpret_cast<const char*>(objBytes.data()), objBytes.size());
+        // Model캯ͬԼOBJĿ¼µmaterials_texturesĿ¼
+        std::string objBaseDir = path.parent_path().string() + "/";
+        std::string mtlLibName = Model::scanMtlLibName(objText);
+        std::vector<MaterialData> materials;
+        if (!mtlLibName.empty()) {
+            materials = Material::loadMtlFile(objBaseDir + mtlLibName, objBaseDir + "materials_textures/");
+        }
+        for (MaterialData& material : materials) {
+            if (material.diffuseTexturePath.empty()) {
+                continue;
+            }
+            std::string textureName = entryName(root, material.diffuseTexturePath);
+            if (textureName.empty()) {
+                std::cerr << "WARNING: Texture outside of the pack root is dropped: " << material.diffuseTexturePath << std::endl;
+            }
+            material.diffuseTexturePath = textureName;
+        }
+
+        // OBJݺͽĲʱ (ʱдģĿ)
+        DerivedDataKey key("model", BAKE_VERSION);
+        key.addValue(pack::PACK_VERSION).addBytes(objBytes.data(), objBytes.size());
+        for (const MaterialData& material : materials) {
+            key.addString(material.name).addValue(material.Ks.x).addValue(material.Ks.y).addValue(material.Ks.z)
+                .addValue(material.opacity).addString(material.diffuseTexturePath);
+        }
+        std::vector<uint8_t> entry;
+        bool baked = cache.getOrBuild(key, entry, [&](std::vector<uint8_t>& out) {
+            ModelData data;
+            if (!Model::parseObj(objText, path.string(), data)) {
+                return false;
+            }
+            out = PackWriter::bakeModel(data, materials);
+            return true;
+        });
+        if (!baked) {
+            std::cerr << "ERROR: Model could not be loaded or is empty: " << path << std::endl;
+            return false;
+        }
+        return writer.addEntry(entryName(root, path), pack::EntryType::Model, std::move(entry));
+    }
+
+    bool bakeImage(const fs::path& root, const fs::path& path, PackWriter& writer, DerivedDataCache& cache) {
+        std::vector<uint8_t> bytes;
+        if (!readFile(path, bytes)) {
+            std::cerr << "ERROR: Could not read file: " << path << std::endl;
+            return false;
+        }
+        DerivedDataKey key("texture-rgba8", BAKE_VERSION);
+        key.addValue(pack::PACK_VERSION).addBytes(bytes.data(), bytes.size());
+        std::vector<uint8_t> entry;
+        bool decoded = cache.getOrBuild(key, entry, [&](std::vector<uint8_t>& out) {
+            ImageData image;
+            if (!Texture::decode(bytes.data(), bytes.size(), image)) {
+                return false;
+            }
+            out = PackWriter::bakeTexture(image);
+            return true;
+        });
+        if (!decoded) {
+            std::cerr << "ERROR: Could not decode image: " << path << std::endl;
+            return false;
+        }
+        return writer.addEntry(entryName(root, path), pack::EntryType::Texture, std::move(entry));
+    }
+
+    bool addRaw(const fs::path& root, const fs::path& path, PackWriter& writer) {
+        std::vector<uint8_t> bytes;
+        if (!readFile(path, bytes)) {
+            std::cerr << "ERROR: Could not read file: " << path << std::endl;
+            return false;
+        }
+        return writer.addEntry(entryName(root, path), pack::EntryType::Raw, std::move(bytes));
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: packBuilder <assetRootDir> <output.pak> [--compress] [--cache dir] [--no-cache]" << std::endl;
+        return 1;
+    }
+    fs::path root = fs::path(argv[1]).lexically_normal();
+    std::string output = argv[2];
+    bool compress = false;
+    std::string cacheDir = DerivedDataCache::getDefaultDirectory();
+    for (int i = 3; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--compress") == 0) {
+            compress = true;
+        }
+        else if (std::strcmp(argv[i], "--cache") == 0 && i + 1 < argc) {
+            cacheDir = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--no-cache") == 0) {
+            cacheDir.clear();
+        }
+        else {
+            std::cerr << "WARNING: Unknown option ignored: " << argv[i] << std::endl;
+        }
+    }
+
+    if (!fs::is_directory(root)) {
+        std::cerr << "ERROR: Not a directory: " << root << std::endl;
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<fs::path> files;
+    for (const fs::directory_entry& entry : fs::recursive_directory_iterator(root)) {
+        if (entry.is_regular_file()) {
+            files.push_back(entry.path());
+        }
+    }
+    // ̶˳򣬱֤ͬͬİ
+    std::sort(files.begin(), files.end());
+
+    DerivedDataCache cache(cacheDir);
+    PackWriter writer(compress);
+    std::atomic<size_t> failures{ 0 };
+    JobSystem::getInstance()->parallelFor(0, files.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            bool ok = false;
+            switch (classify(files[i])) {
+            case FileKind::Model: ok = bakeModel(root, files[i], writer, cache); break;
+            case FileKind::Image: ok = bakeImage(root, files[i], writer, cache); break;
+            case FileKind::Raw: ok = addRaw(root, files[i], writer); break;
+            }
+            if (!ok) {
+                failures++;
+            }
+        }
+    }, 1);
+
+    bool written = writer.write(output);
+    JobSystem::getInstance()->shutdown();
+    cache.trim();
+    cache.logStats("packBuilder");
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Packed " << writer.getEntryCount() << " entries from " << files.size() << " files into '" << output
+        << "' in " << seconds << " s (" << failures.load() << " failed)." << std::endl;
+    return written && failures.load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,418 @@
+// pvsBuilderΪtools/tilerɵĲ㼶ԤǱڿɼ (PVS)ڽֵ߶ȵ
+// ÷pvsBuilder <tilesetļ> <.pvs> [--cell-size S] [--eye-min H] [--eye-max H] [--samples N] [--rays N]
+// 裺
+//   1. ȡ㼶еȫ (HLOD)JobSystemϲнBVHεĶΪݱţ
+//   2. ѽռطΧXZƽϻΪcell-sizeСĵԪԪıռݵĵԪͨУݣ
+//   3. ÿͨеԪвڵԪȡsamplesӵ (߶ڵeye-mineye-max֮)
+//      ÿӵȷraysߣÿδȷϿɼĽΧеġǵķߣ
+//      иý (ͨ赽Ŀ) Ϊɼӵ㲻һԪĽֱΪɼ
+//   4. HLODκһɼʱɼ
+//   5. λγ̱룬ͬλֻһݡ
+// õǽƿɼСķ϶ܱ©ԪͲԽԽ׼ȷ
+#include "glframework/streaming/tilesetFormat.h"
+#include "glframework/visibility/pvsFormat.h"
+#include "glframework/visibility/potentiallyVisibleSet.h"
+#include "glframework/visibility/triangleBvh.h"
+#include "glframework/model.h"
+#include "glframework/job/jobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+    constexpr float GOLDEN_ANGLE = 2.39996323f;
+
+    struct Building {
+        uint32_t content = 0;       // 㼶еݱ
+        std::string path;
+        glm::vec3 minBounds = glm::vec3(0.0f);  // Ѽȥԭ
+        glm::vec3 maxBounds = glm::vec3(0.0f);
+        std::vector<glm::vec3> positions;
+        std::vector<uint32_t> indices;
+        bool valid = false;
+    };
+
+    struct Options {
+        float cellSize = 8.0f;
+        float eyeMin = 1.0f;        // ӵԵĸ߶ȷΧ
+        float eyeMax = 3.0f;
+        int samples = 4;            // ÿԪӵ
+        int rays = 256;             // ÿӵ
+    };
+
+    struct Tileset {
+        tileset::TilesetHeader header = {};
+        std::vector<tileset::TileNode> nodes;
+        std::vector<tileset::TileContent> contents;
+        std::string strings;
+    };
+
+    bool readTileset(const std::string& path, Tileset& tileset) {
+        using namespace tileset;
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            std::cerr << "ERROR: Could not open tileset: " << path << std::endl;
+            return false;
+        }
+        uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+        file.seekg(0);
+        if (fileSize < sizeof(TilesetHeader) || !file.read(reinterpret_cast<char*>(&tileset.header), sizeof(TilesetHeader))
+            || tileset.header.magic != TILESET_MAGIC || tileset.header.version != TILESET_VERSION
+            || sizeof(TilesetHeader) + sizeof(TileNode) * uint64_t(tileset.header.nodeCount)
+                + sizeof(TileContent) * uint64_t(tileset.header.contentCount) + tileset.header.stringsSize != fileSize) {
+            std::cerr << "ERROR: Invalid tileset: " << path << std::endl;
+            return false;
+        }
+        tileset.nodes.resize(tileset.header.nodeCount);
+        tileset.contents.resize(tileset.header.contentCount);
+        tileset.strings.resize(static_cast<size_t>(tileset.header.stringsSize));
+        file.read(reinterpret_cast<char*>(tileset.nodes.data()), static_cast<std::streamsize>(sizeof(TileNode) * tileset.nodes.size()));
+        file.read(reinterpret_cast<char*>(tileset.contents.data()), static_cast<std::streamsize>(sizeof(TileContent) * tileset.contents.size()));
+        file.read(tileset.strings.data(), static_cast<std::streamsize>(tileset.strings.size()));
+        if (!file) {
+            std::cerr << "ERROR: Failed to read tileset: " << path << std::endl;
+            return false;
+        }
+        for (const TileNode& node : tileset.nodes) {
+            if (node.firstContent + uint64_t(node.contentCount) > tileset.header.contentCount
+                || node.firstChild + uint64_t(node.childCount) > tileset.header.nodeCount
+                || (node.hlodContent != NO_INDEX && node.hlodContent >= tileset.header.contentCount)) {
+                std::cerr << "ERROR: Invalid tileset node in " << path << std::endl;
+                return false;
+            }
+        }
+        for (const TileContent& content : tileset.contents) {
+            if (content.pathOffset + uint64_t(content.pathLength) > tileset.header.stringsSize) {
+                std::cerr << "ERROR: Invalid tileset content in " << path << std::endl;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Ͼȷֲĵi (Fibonacci)
+    glm::vec3 sphereDirection(int i, int count) {
+        float y = 1.0f - (static_cast<float>(i) + 0.5f) * 2.0f / static_cast<float>(count);
+        float radius = std::sqrt(std::max(0.0f, 1.0f - y * y));
+        float angle = GOLDEN_ANGLE * static_cast<float>(i);
+        return glm::vec3(std::cos(angle) * radius, y, std::sin(angle) * radius);
+    }
+
+    class PvsBuilder {
+    public:
+        PvsBuilder(std::string tilesetPath, const Options& options)
+            : m_tilesetPath(std::move(tilesetPath)), m_options(options) {}
+
+        bool run(const std::string& outputPath);
+
+    private:
+        bool loadBuildings();
+        void setupGrid();
+        // λ (x, z) ߵ㣬ûнʱص߶
+        float surfaceHeight(float x, float z) const;
+        void computeCell(size_t cellIndex, std::vector<uint64_t>& visible) const;
+        void markHlods(std::vector<uint64_t>& visible) const;
+        bool write(const std::string& outputPath, const std::vector<std::vector<uint8_t>>& encoded) const;
+
+    private:
+        std::string m_tilesetPath;
+        Options m_options;
+        Tileset m_tileset;
+        std::vector<Building> m_buildings;
+        TriangleBvh m_bvh;
+
+        float m_ground = 0.0f;
+        float m_top = 0.0f;
+        glm::vec2 m_gridMin = glm::vec2(0.0f);
+        uint32_t m_cellCountX = 0;
+        uint32_t m_cellCountZ = 0;
+    };
+
+    bool PvsBuilder::loadBuildings() {
+        if (!readTileset(m_tilesetPath, m_tileset)) {
+            return false;
+        }
+        std::string baseDir = m_tilesetPath.substr(0, m_tilesetPath.find_last_of("/\\") + 1);
+        glm::dvec3 origin(m_tileset.header.origin[0], m_tileset.header.origin[1], m_tileset.header.origin[2]);
+
+        for (const tileset::TileNode& node : m_tileset.nodes) {
+            for (uint32_t c = 0; c < node.contentCount; ++c) {
+                const tileset::TileContent& content = m_tileset.contents[node.firstContent + c];
+                Building building;
+                building.content = node.firstContent + c;
+                building.path = baseDir + m_tileset.strings.substr(content.pathOffset, content.pathLength);
+                m_buildings.push_back(std::move(building));
+            }
+        }
+
+        JobSystem::getInstance()->parallelFor(0, m_buildings.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                Building& building = m_buildings[i];
+                ModelData data;
+                if (!Model::loadObjFile(building.path, data)) {
+                    std::cerr << "WARNING: Skipping building that could not be loaded: " << building.path << std::endl;
+                    continue;
+                }
+                Model::appendSourceGeometry(data, building.positions, building.indices, origin);
+                building.minBounds = glm::vec3(glm::dvec3(data.minCoords) + (data.origin - origin));
+                building.maxBounds = glm::vec3(glm::dvec3(data.maxCoords) + (data.origin - origin));
+                building.valid = true;
+            }
+        }, 1);
+        m_buildings.erase(std::remove_if(m_buildings.begin(), m_buildings.end(), [](const Building& b) { return !b.valid; }), m_buildings.end());
+        if (m_buildings.empty()) {
+            std::cerr << "ERROR: No buildings could be loaded from " << m_tilesetPath << std::endl;
+            return false;
+        }
+
+        // ȫϲΪһBVH
+        std::vector<glm::vec3> positions;
+        std::vector<uint32_t> indices;
+        std::vector<uint32_t> triangleObjects;
+        for (const Building& building : m_buildings) {
+            uint32_t base = static_cast<uint32_t>(positions.size());
+            positions.insert(positions.end(), building.positions.begin(), building.positions.end());
+            for (uint32_t index : building.indices) {
+                indices.push_back(base + index);
+            }
+            triangleObjects.insert(triangleObjects.end(), building.indices.size() / 3, building.content);
+        }
+        m_bvh.build(positions, indices, triangleObjects);
+        std::cout << "Loaded " << m_buildings.size() << " buildings, " << m_bvh.getTriangleCount() << " triangles, "
+            << m_bvh.getNodeCount() << " BVH nodes." << std::endl;
+        return true;
+    }
+
+    void PvsBuilder::setupGrid() {
+        glm::vec3 minBounds = m_bvh.getMinBounds();
+        glm::vec3 maxBounds = m_bvh.getMaxBounds();
+        m_ground = minBounds.y;
+        m_top = maxBounds.y;
+        // ܸһԪȺԵĽֵҲ
+        float cellSize = m_options.cellSize;
+        m_gridMin = glm::vec2(minBounds.x, minBounds.z) - cellSize;
+        m_cellCountX = static_cast<uint32_t>(std::ceil((maxBounds.x - minBounds.x) / cellSize)) + 2;
+        m_cellCountZ = static_cast<uint32_t>(std::ceil((maxBounds.z - minBounds.z) / cellSize)) + 2;
+    }
+
+    float PvsBuilder::surfaceHeight(float x, float z) const {
+        float start = m_top + 1.0f;
+        TriangleBvh::Hit hit;
+        if (m_bvh.raycast(glm::vec3(x, start, z), glm::vec3(0.0f, -1.0f, 0.0f), start - m_ground + 1.0f, hit)) {
+            return start - hit.distance;
+        }
+        return m_ground;
+    }
+
+    void PvsBuilder::computeCell(size_t cellIndex, std::vector<uint64_t>& visible) const {
+        float cellSize = m_options.cellSize;
+        glm::vec2 cellMin = m_gridMin + glm::vec2(static_cast<float>(cellIndex % m_cellCountX), static_cast<float>(cellIndex / m_cellCountX)) * cellSize;
+        glm::vec2 cellCenter = cellMin + cellSize * 0.5f;
+        visible.clear();
+        // Ԫڽڲ (ݶ) ʱͨ
+        if (surfaceHeight(cellCenter.x, cellCenter.y) > m_ground + m_options.eyeMin) {
+            return;
+        }
+        visible.assign((m_tileset.header.contentCount + 63) / 64, 0);
+        auto markVisible = [&](uint32_t object) {
+            visible[object / 64] |= uint64_t(1) << (object % 64);
+        };
+
+        // Ԫڵķֲ㣺k x k񣬸߶eyeMineyeMax֮佻
+        int perSide = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<float>(m_options.samples)))));
+        for (int s = 0; s < m_options.samples; ++s) {
+            float u = (static_cast<float>(s % perSide) + 0.5f) / static_cast<float>(perSide);
+            float v = (static_cast<float>((s / perSide) % perSide) + 0.5f) / static_cast<float>(perSide);
+            float h = m_options.samples > 1 ? static_cast<float>(s) / static_cast<float>(m_options.samples - 1) : 0.5f;
+            glm::vec3 eye(cellMin.x + u * cellSize, m_ground + m_options.eyeMin + h * (m_options.eyeMax - m_options.eyeMin), cellMin.y + v * cellSize);
+            // ڽڲʱ
+            if (surfaceHeight(eye.x, eye.z) > eye.y) {
+                continue;
+            }
+
+            // 1. 
+            TriangleBvh::Hit hit;
+            for (int r = 0; r < m_options.rays; ++r) {
+                if (m_bvh.raycast(eye, sphereDirection(r, m_options.rays), std::numeric_limits<float>::max(), hit)) {
+                    markVisible(hit.object);
+                }
+            }
+
+            // 2. Ķ
+            for (const Building& building : m_buildings) {
+                if (PotentiallyVisibleSet::isVisible(visible, building.content)) {
+                    continue;
+                }
+                glm::vec3 closest = glm::clamp(eye, building.minBounds, building.maxBounds);
+                if (glm::length(closest - eye) <= cellSize) {
+                    markVisible(building.content);
+                    continue;
+                }
+                // Ŀ㣺ġ8ǵ6ģǵ΢
+                glm::vec3 center = (building.minBounds + building.maxBounds) / 2.0f;
+                glm::vec3 half = (building.maxBounds - building.minBounds) / 2.0f * 0.98f;
+                glm::vec3 targets[15];
+                int targetCount = 0;
+                targets[targetCount++] = center;
+                for (int corner = 0; corner < 8; ++corner) {
+                    targets[targetCount++] = center + glm::vec3(corner & 1 ? half.x : -half.x, corner & 2 ? half.y : -half.y, corner & 4 ? half.z : -half.z);
+                }
+                for (int axis = 0; axis < 3; ++axis) {
+                    for (float side : { -1.0f, 1.0f }) {
+                        glm::vec3 target = center;
+                        target[axis] += side * half[axis];
+                        targets[targetCount++] = target;
+                    }
+                }
+                for (int t = 0; t < targetCount; ++t) {
+                    glm::vec3 offset = targets[t] - eye;
+                    float distance = glm::length(offset);
+                    if (distance <= 0.0f) {
+                        markVisible(building.content);
+                        break;
+                    }
+                    glm::vec3 direction = offset / distance;
+                    if (!m_bvh.raycast(eye, direction, distance * 1.001f, hit) || hit.object == building.content) {
+                        markVisible(building.content);
+                        break;
+                    }
+                }
+            }
+        }
+        markHlods(visible);
+    }
+
+    void PvsBuilder::markHlods(std::vector<uint64_t>& visible) const {
+        // ڵ㰴ȴţԵϣɼ = ݿɼһӽڵɼ
+        std::vector<char> subtreeVisible(m_tileset.nodes.size(), 0);
+        for (size_t i = m_tileset.nodes.size(); i-- > 0;) {
+            const tileset::TileNode& node = m_tileset.nodes[i];
+            bool any = false;
+            for (uint32_t c = 0; c < node.contentCount && !any; ++c) {
+                any = PotentiallyVisibleSet::isVisible(visible, node.firstContent + c);
+            }
+            for (uint32_t c = 0; c < node.childCount && !any; ++c) {
+                any = subtreeVisible[node.firstChild + c] != 0;
+            }
+            subtreeVisible[i] = any ? 1 : 0;
+            if (any && node.hlodContent != tileset::NO_INDEX) {
+                visible[node.hlodContent / 64] |= uint64_t(1) << (node.hlodContent % 64);
+            }
+        }
+    }
+
+    bool PvsBuilder::write(const std::string& outputPath, const std::vector<std::vector<uint8_t>>& encoded) const {
+        using namespace pvs;
+
+        // ȥأܶڵԪĿɼȫͬ
+        std::vector<uint32_t> cellSets(encoded.size(), NO_SET);
+        std::vector<PvsSet> sets;
+        std::vector<uint8_t> data;
+        std::unordered_map<std::string, uint32_t> uniqueSets;
+        for (size_t i = 0; i < encoded.size(); ++i) {
+            if (encoded[i].empty()) {
+                continue;
+            }
+            std::string key(encoded[i].begin(), encoded[i].end());
+            auto [it, inserted] = uniqueSets.try_emplace(std::move(key), static_cast<uint32_t>(sets.size()));
+            if (inserted) {
+                sets.push_back({ static_cast<uint32_t>(data.size()), static_cast<uint32_t>(encoded[i].size()) });
+                data.insert(data.end(), encoded[i].begin(), encoded[i].end());
+            }
+            cellSets[i] = it->second;
+        }
+
+        PvsHeader header = {};
+        header.magic = PVS_MAGIC;
+        header.version = PVS_VERSION;
+        header.objectCount = m_tileset.header.contentCount;
+        header.cellCountX = m_cellCountX;
+        header.cellCountZ = m_cellCountZ;
+        header.setCount = static_cast<uint32_t>(sets.size());
+        header.gridMin[0] = m_gridMin.x;
+        header.gridMin[1] = m_gridMin.y;
+        header.cellSize = m_options.cellSize;
+        header.minY = m_ground;
+        // ӵԸڲΧ (Ծ) ʱȻʹãһԪ
+        header.maxY = m_ground + m_options.eyeMax + m_options.cellSize;
+        header.dataSize = data.size();
+
+        std::ofstream file(outputPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(cellSets.data()), static_cast<std::streamsize>(sizeof(uint32_t) * cellSets.size()));
+        file.write(reinterpret_cast<const char*>(sets.data()), static_cast<std::streamsize>(sizeof(PvsSet) * sets.size()));
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        if (!file) {
+            std::cerr << "ERROR: Could not write PVS file: " << outputPath << std::endl;
+            return false;
+        }
+
+        size_t navigable = encoded.size() - static_cast<size_t>(std::count(cellSets.begin(), cellSets.end(), NO_SET));
+        size_t rawBytes = navigable * ((header.objectCount + 7) / 8);
+        std::cout << "PVS written: " << navigable << " of " << encoded.size() << " cells navigable, " << sets.size()
+            << " unique sets, " << data.size() << " bytes of set data (" << rawBytes << " bytes uncompressed)." << std::endl;
+        return true;
+    }
+
+    bool PvsBuilder::run(const std::string& outputPath) {
+        if (!loadBuildings()) {
+            return false;
+        }
+        setupGrid();
+        size_t cellCount = static_cast<size_t>(m_cellCountX) * m_cellCountZ;
+        std::cout << "Computing visibility for " << m_cellCountX << "x" << m_cellCountZ << " cells..." << std::endl;
+
+        std::vector<std::vector<uint8_t>> encoded(cellCount);
+        JobSystem::getInstance()->parallelFor(0, cellCount, [&](size_t begin, size_t end) {
+            std::vector<uint64_t> visible;
+            for (size_t i = begin; i < end; ++i) {
+                computeCell(i, visible);
+                if (!visible.empty()) {
+                    PotentiallyVisibleSet::encode(visible, m_tileset.header.contentCount, encoded[i]);
+                }
+            }
+        });
+        return write(outputPath, encoded);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: pvsBuilder <tileset> <output.pvs> [--cell-size S] [--eye-min H] [--eye-max H] [--samples N] [--rays N]" << std::endl;
+        return 1;
+    }
+    Options options;
+    for (int i = 3; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--cell-size") == 0) {
+            options.cellSize = std::max(0.1f, static_cast<float>(std::atof(argv[i + 1])));
+        }
+        else if (std::strcmp(argv[i], "--eye-min") == 0) {
+            options.eyeMin = static_cast<float>(std::atof(argv[i + 1]));
+        }
+        else if (std::strcmp(argv[i], "--eye-max") == 0) {
+            options.eyeMax = static_cast<float>(std::atof(argv[i + 1]));
+        }
+        else if (std::strcmp(argv[i], "--samples") == 0) {
+            options.samples = std::max(1, std::atoi(argv[i + 1]));
+        }
+        else if (std::strcmp(argv[i], "--rays") == 0) {
+            options.rays = std::max(0, std::atoi(argv[i + 1]));
+        }
+    }
+    options.eyeMax = std::max(options.eyeMax, options.eyeMin);
+
+    auto start = std::chrono::steady_clock::now();
+    PvsBuilder builder(argv[1], options);
+    bool ok = builder.run(argv[2]);
+    JobSystem::getInstance()->shutdown();
+    std::cout << "Done in " << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << " s." << std::endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,607 @@
+// tilerһĿ¼дĽOBJ֯ĲƬ㼶TileStreamerʽ
+// ÷tiler <Ŀ¼> <Ŀ¼> [--leaf-size N] [--max-depth N]
+// 
+//   <Ŀ¼>/city.tileset   Ʋ㼶 (glframework/streaming/tilesetFormat.h)
+//   <Ŀ¼>/hlod/*.obj     ÿڲڵHLODӽڵȫݺϲö
+//   <Ŀ¼>/tiler.cache    
+// ĲXZƽ (Y)һռطΧڵУ
+// Խӽڵ߽Ľڸڵ㡣Ҷӽڵleaf-size (ȴﵽmax-depthʱ)
+// ڵ㰴ȱ (ͬһڼĲZ)ڵеĽHilbert˳š
+// HLODԵɣڵHLODӽڵHLODӽڵĽ򻯶ͬһĽڵJobSystemϲд
+// ¼ÿļĴС޸ʱԼÿHLODϣ
+// ٴʱδ޸ĵĽٽûб仯HLODֱá
+#include "glframework/streaming/tilesetFormat.h"
+#include "glframework/model.h"
+#include "glframework/job/jobSystem.h"
+#include "glframework/spatial/spaceFillingCurve.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+    constexpr int HLOD_GRID = 48;           // HLODֱ (ڵϵĸ)
+    constexpr uint32_t HLOD_VERSION = 2;    // ޸ļ㷨HLODļϵʱ1ʹеHLODȫʧЧ
+
+    struct Building {
+        std::string path;           // ·
+        uint64_t fileSize = 0;
+        int64_t modifiedTime = 0;
+        glm::dvec3 sourceMin = glm::dvec3(0.0);   // ԭʼµİΧ (˫ȣд뻺)
+        glm::dvec3 sourceMax = glm::dvec3(0.0);
+        glm::vec3 minBounds = glm::vec3(0.0f);    // ȥԭİΧУbuildTree
+        glm::vec3 maxBounds = glm::vec3(0.0f);
+        bool valid = false;
+    };
+
+    struct Node {
+        glm::vec2 cellMin;          // XZƽϵĸ
+        glm::vec2 cellMax;
+        int depth = 0;
+        int gridX = 0;              // ڱе꣬ȶHLODļ
+        int gridZ = 0;
+        std::vector<size_t> buildings;
+        std::vector<size_t> children;
+        glm::vec3 minBounds = glm::vec3(std::numeric_limits<float>::max());
+        glm::vec3 maxBounds = glm::vec3(-std::numeric_limits<float>::max());
+        uint64_t subtreeHash = 0;   // ڵȫݵĹϣ
+        uint64_t hlodHash = 0;      // HLOD (ӽڵ) Ĺϣ
+        std::string hlodFile;       // Ŀ¼
+        float geometricError = 0.0f;
+        bool hasHlod = false;
+    };
+
+    // 򵥵 (ȥԭ)
+    struct Geometry {
+        std::vector<glm::vec3> positions;
+        std::vector<uint32_t> indices;
+    };
+
+    struct CachedHlod {
+        uint64_t hash = 0;
+        float error = 0.0f;
+    };
+
+    uint64_t hashBytes(uint64_t hash, const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    template<typename T>
+    uint64_t hashValue(uint64_t hash, const T& value) {
+        return hashBytes(hash, &value, sizeof(T));
+    }
+
+    int64_t modifiedTime(const fs::path& path) {
+        std::error_code error;
+        auto time = fs::last_write_time(path, error);
+        return error ? 0 : static_cast<int64_t>(time.time_since_epoch().count());
+    }
+
+    // ȡOBJѶ㻹ԭļеԭʼټȥorigin (loadObjFileĻͱ׼)
+    // minBounds/maxBoundsΪԭʼµİΧ
+    bool loadWorldGeometry(const std::string& path, Geometry& geometry, const glm::dvec3& origin,
+        glm::dvec3* minBounds = nullptr, glm::dvec3* maxBounds = nullptr) {
+        ModelData data;
+        if (!Model::loadObjFile(path, data)) {
+            return false;
+        }
+        Model::appendSourceGeometry(data, geometry.positions, geometry.indices, origin);
+        if (minBounds) {
+            *minBounds = glm::dvec3(data.minCoords) + data.origin;
+        }
+        if (maxBounds) {
+            *maxBounds = glm::dvec3(data.maxCoords) + data.origin;
+        }
+        return true;
+    }
+
+    // 򻯣ͬһеĶϲΪǵƽλã˻α
+    // ÿƶ벻ӵĶԽ߳ȡ
+    void simplify(const Geometry& input, const glm::vec3& minBounds, float cellSize, Geometry& output) {
+        struct Cluster {
+            glm::vec3 sum = glm::vec3(0.0f);
+            uint32_t count = 0;
+        };
+        std::unordered_map<uint64_t, uint32_t> cellToCluster;
+        std::vector<Cluster> clusters;
+        std::vector<uint32_t> vertexCluster(input.positions.size());
+        cellToCluster.reserve(input.positions.size() / 4 + 16);
+
+        for (size_t i = 0; i < input.positions.size(); ++i) {
+            glm::vec3 cell = glm::floor((input.positions[i] - minBounds) / cellSize);
+            uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(cell.x) & 0x1FFFFF) << 42)
+                | (static_cast<uint64_t>(static_cast<uint32_t>(cell.y) & 0x1FFFFF) << 21)
+                | static_cast<uint64_t>(static_cast<uint32_t>(cell.z) & 0x1FFFFF);
+            auto [it, inserted] = cellToCluster.try_emplace(key, static_cast<uint32_t>(clusters.size()));
+            if (inserted) {
+                clusters.emplace_back();
+            }
+            clusters[it->second].sum += input.positions[i];
+            clusters[it->second].count++;
+            vertexCluster[i] = it->second;
+        }
+
+        output.positions.resize(clusters.size());
+        for (size_t i = 0; i < clusters.size(); ++i) {
+            output.positions[i] = clusters[i].sum / static_cast<float>(clusters[i].count);
+        }
+        for (size_t t = 0; t + 2 < input.indices.size(); t += 3) {
+            uint32_t a = vertexCluster[input.indices[t]];
+            uint32_t b = vertexCluster[input.indices[t + 1]];
+            uint32_t c = vertexCluster[input.indices[t + 2]];
+            if (a == b || b == c || a == c) {
+                continue;
+            }
+            output.indices.push_back(a);
+            output.indices.push_back(b);
+            output.indices.push_back(c);
+        }
+    }
+
+    // дHLODģͣ걣ּȥԭֵ (tilesetFormat.h)
+    bool writeObj(const std::string& path, const Geometry& geometry) {
+        std::ofstream file(path, std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "ERROR: Could not write HLOD: " << path << std::endl;
+            return false;
+        }
+        file << "# HLOD generated by tiler\n";
+        char line[96];
+        for (const glm::vec3& p : geometry.positions) {
+            snprintf(line, sizeof(line), "v %.6f %.6f %.6f\n", p.x, p.y, p.z);
+            file << line;
+        }
+        // HLODͼж㹲һ (loadObjFileҪ)
+        file << "vt 0 0\n";
+        for (size_t t = 0; t + 2 < geometry.indices.size(); t += 3) {
+            file << "f " << geometry.indices[t] + 1 << "/1 " << geometry.indices[t + 1] + 1 << "/1 " << geometry.indices[t + 2] + 1 << "/1\n";
+        }
+        return static_cast<bool>(file);
+    }
+
+    class Tiler {
+    public:
+        Tiler(fs::path inputDir, fs::path outputDir, size_t leafSize, int maxDepth)
+            : m_inputDir(std::move(inputDir)), m_outputDir(std::move(outputDir)), m_leafSize(leafSize), m_maxDepth(maxDepth) {}
+
+        bool run();
+
+    private:
+        void loadCache();
+        void saveCache() const;
+        void scanBuildings();
+        void buildTree();
+        size_t buildNode(glm::vec2 cellMin, glm::vec2 cellMax, int depth, int gridX, int gridZ, std::vector<size_t> buildings);
+        // ڵеĽռĵHilbert˳УʽغͻʱڵĽȺ
+        void sortBuildings(std::vector<size_t>& buildings) const;
+        void computeBounds(size_t nodeIndex);
+        void buildHlods();
+        void buildHlod(Node& node);
+        bool writeTileset() const;
+
+    private:
+        fs::path m_inputDir;
+        fs::path m_outputDir;
+        size_t m_leafSize;
+        int m_maxDepth;
+
+        std::vector<Building> m_buildings;
+        std::vector<Node> m_nodes;
+        glm::dvec3 m_origin = glm::dvec3(0.0);  //  (ڵ㡢HLODļ) Ѽȥ
+
+        std::unordered_map<std::string, Building> m_cachedBuildings;
+        std::unordered_map<std::string, CachedHlod> m_cachedHlods;
+        std::atomic<size_t> m_parsedBuildings{ 0 };
+        std::atomic<size_t> m_builtHlods{ 0 };
+        std::atomic<size_t> m_reusedHlods{ 0 };
+    };
+
+    void Tiler::loadCache() {
+        std::ifstream file(m_outputDir / "tiler.cache");
+        std::string line;
+        while (std::getline(file, line)) {
+            std::istringstream iss(line);
+            std::string type;
+            iss >> type;
+            if (type == "building") {
+                Building building;
+                iss >> building.fileSize >> building.modifiedTime
+                    >> building.sourceMin.x >> building.sourceMin.y >> building.sourceMin.z
+                    >> building.sourceMax.x >> building.sourceMax.y >> building.sourceMax.z;
+                std::getline(iss >> std::ws, building.path);
+                // ʧܵ (ضϡɸʽ) 棬scanBuildings½ӦĽ
+                building.valid = static_cast<bool>(iss);
+                if (building.valid) {
+                    m_cachedBuildings[building.path] = building;
+                }
+            }
+            else if (type == "hlod") {
+                CachedHlod hlod;
+                std::string hlodFile;
+                iss >> hlod.hash >> hlod.error;
+                std::getline(iss >> std::ws, hlodFile);
+                m_cachedHlods[hlodFile] = hlod;
+            }
+        }
+    }
+
+    void Tiler::saveCache() const {
+        std::ofstream file(m_outputDir / "tiler.cache", std::ios::trunc);
+        file.precision(17);
+        for (const Building& building : m_buildings) {
+            if (!building.valid) {
+                continue;
+            }
+            file << "building " << building.fileSize << ' ' << building.modifiedTime << ' '
+                << building.sourceMin.x << ' ' << building.sourceMin.y << ' ' << building.sourceMin.z << ' '
+                << building.sourceMax.x << ' ' << building.sourceMax.y << ' ' << building.sourceMax.z << ' '
+                << building.path << '\n';
+        }
+        for (const Node& node : m_nodes) {
+            if (node.hasHlod) {
+                file << "hlod " << node.hlodHash << ' ' << node.geometricError << ' ' << node.hlodFile << '\n';
+            }
+        }
+    }
+
+    void Tiler::scanBuildings() {
+        for (const fs::directory_entry& entry : fs::recursive_directory_iterator(m_inputDir)) {
+            std::string extension = entry.path().extension().string();
+            std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            if (!entry.is_regular_file() || extension != ".obj") {
+                continue;
+            }
+            Building building;
+            building.path = fs::absolute(entry.path()).lexically_normal().generic_string();
+            building.fileSize = static_cast<uint64_t>(entry.file_size());
+            building.modifiedTime = modifiedTime(entry.path());
+            m_buildings.push_back(std::move(building));
+        }
+        // ̶˳򣬱֤ͬͬĲ㼶
+        std::sort(m_buildings.begin(), m_buildings.end(), [](const Building& a, const Building& b) { return a.path < b.path; });
+
+        // ûб仯ĽûеİΧУJobSystemϲн
+        JobSystem::getInstance()->parallelFor(0, m_buildings.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                Building& building = m_buildings[i];
+                auto cached = m_cachedBuildings.find(building.path);
+                if (cached != m_cachedBuildings.end() && cached->second.valid
+                    && cached->second.fileSize == building.fileSize && cached->second.modifiedTime == building.modifiedTime) {
+                    building.sourceMin = cached->second.sourceMin;
+                    building.sourceMax = cached->second.sourceMax;
+                    building.valid = true;
+                    continue;
+                }
+                Geometry geometry;
+                building.valid = loadWorldGeometry(building.path, geometry, glm::dvec3(0.0), &building.sourceMin, &building.sourceMax);
+                m_parsedBuildings++;
+                if (!building.valid) {
+                    std::cerr << "WARNING: Skipping building that could not be loaded: " << building.path << std::endl;
+                }
+            }
+        }, 1);
+
+        m_buildings.erase(std::remove_if(m_buildings.begin(), m_buildings.end(), [](const Building& b) { return !b.valid; }), m_buildings.end());
+    }
+
+    void Tiler::buildTree() {
+        glm::dvec3 sourceMin(std::numeric_limits<double>::max());
+        glm::dvec3 sourceMax(-std::numeric_limits<double>::max());
+        std::vector<size_t> all(m_buildings.size());
+        for (size_t i = 0; i < m_buildings.size(); ++i) {
+            sourceMin = glm::min(sourceMin, m_buildings[i].sourceMin);
+            sourceMax = glm::max(sourceMax, m_buildings[i].sourceMax);
+            all[i] = i;
+        }
+        // ԭȡ벻ʱȶ֮Ĳ㼶֡ΧкHLODڼȥԭfloat
+        m_origin = glm::floor((sourceMin + sourceMax) / 2.0);
+        glm::vec3 minBounds(std::numeric_limits<float>::max());
+        glm::vec3 maxBounds(-std::numeric_limits<float>::max());
+        for (Building& building : m_buildings) {
+            building.minBounds = glm::vec3(building.sourceMin - m_origin);
+            building.maxBounds = glm::vec3(building.sourceMax - m_origin);
+            minBounds = glm::min(minBounds, building.minBounds);
+            maxBounds = glm::max(maxBounds, building.maxBounds);
+        }
+
+        // ȡΣӸҲ
+        glm::vec2 center((minBounds.x + maxBounds.x) / 2.0f, (minBounds.z + maxBounds.z) / 2.0f);
+        float halfSize = std::max(maxBounds.x - minBounds.x, maxBounds.z - minBounds.z) / 2.0f * 1.001f + 0.001f;
+        m_nodes.reserve(m_buildings.size() * 2 + 1);
+        buildNode(center - halfSize, center + halfSize, 0, 0, 0, std::move(all));
+        computeBounds(0);
+    }
+
+    size_t Tiler::buildNode(glm::vec2 cellMin, glm::vec2 cellMax, int depth, int gridX, int gridZ, std::vector<size_t> buildings) {
+        size_t nodeIndex = m_nodes.size();
+        m_nodes.emplace_back();
+        {
+            Node& node = m_nodes[nodeIndex];
+            node.cellMin = cellMin;
+            node.cellMax = cellMax;
+            node.depth = depth;
+            node.gridX = gridX;
+            node.gridZ = gridZ;
+        }
+        if (buildings.size() <= m_leafSize || depth >= m_maxDepth) {
+            sortBuildings(buildings);
+            m_nodes[nodeIndex].buildings = std::move(buildings);
+            return nodeIndex;
+        }
+
+        // ŽĳӸӵĽ·ţڱڵ
+        glm::vec2 mid = (cellMin + cellMax) / 2.0f;
+        std::vector<size_t> quadrants[4];
+        std::vector<size_t> own;
+        for (size_t index : buildings) {
+            const Building& building = m_buildings[index];
+            int qx = building.maxBounds.x <= mid.x ? 0 : (building.minBounds.x >= mid.x ? 1 : -1);
+            int qz = building.maxBounds.z <= mid.y ? 0 : (building.minBounds.z >= mid.y ? 1 : -1);
+            if (qx < 0 || qz < 0) {
+                own.push_back(index);
+            }
+            else {
+                quadrants[qz * 2 + qx].push_back(index);
+            }
+        }
+        sortBuildings(own);
+        m_nodes[nodeIndex].buildings = std::move(own);
+
+        std::vector<size_t> children;
+        for (int q = 0; q < 4; ++q) {
+            if (quadrants[q].empty()) {
+                continue;
+            }
+            int qx = q & 1;
+            int qz = q >> 1;
+            glm::vec2 childMin(qx ? mid.x : cellMin.x, qz ? mid.y : cellMin.y);
+            glm::vec2 childMax(qx ? cellMax.x : mid.x, qz ? cellMax.y : mid.y);
+            // ݹʹm_nodes·䣬ӽڵȴ浽ֲ
+            children.push_back(buildNode(childMin, childMax, depth + 1, gridX * 2 + qx, gridZ * 2 + qz, std::move(quadrants[q])));
+        }
+        m_nodes[nodeIndex].children = std::move(children);
+        return nodeIndex;
+    }
+
+    void Tiler::sortBuildings(std::vector<size_t>& buildings) const {
+        std::vector<glm::vec3> centers(buildings.size());
+        for (size_t i = 0; i < buildings.size(); ++i) {
+            centers[i] = (m_buildings[buildings[i]].minBounds + m_buildings[buildings[i]].maxBounds) / 2.0f;
+        }
+        std::vector<size_t> sorted;
+        sorted.reserve(buildings.size());
+        for (uint32_t i : spatial::curveOrder(centers, spatial::Curve::Hilbert)) {
+            sorted.push_back(buildings[i]);
+        }
+        buildings = std::move(sorted);
+    }
+
+    void Tiler::computeBounds(size_t nodeIndex) {
+        uint64_t hash = 1469598103934665603ull;
+        for (size_t child : m_nodes[nodeIndex].children) {
+            computeBounds(child);
+        }
+        Node& node = m_nodes[nodeIndex];
+        for (size_t index : node.buildings) {
+            const Building& building = m_buildings[index];
+            node.minBounds = glm::min(node.minBounds, building.minBounds);
+            node.maxBounds = glm::max(node.maxBounds, building.maxBounds);
+            hash = hashBytes(hash, building.path.data(), building.path.size());
+            hash = hashValue(hash, building.fileSize);
+            hash = hashValue(hash, building.modifiedTime);
+        }
+        // HLODȫӽڵ
+        uint64_t hlodHash = hashValue(1469598103934665603ull, HLOD_VERSION);
+        hlodHash = hashValue(hlodHash, HLOD_GRID);
+        hlodHash = hashValue(hlodHash, m_origin); // HLODļеԭ
+        for (size_t child : node.children) {
+            const Node& childNode = m_nodes[child];
+            node.minBounds = glm::min(node.minBounds, childNode.minBounds);
+            node.maxBounds = glm::max(node.maxBounds, childNode.maxBounds);
+            hlodHash = hashValue(hlodHash, childNode.subtreeHash);
+        }
+        node.subtreeHash = hashValue(hash, hlodHash);
+        node.hlodHash = hlodHash;
+        node.hasHlod = !node.children.empty();
+        if (node.hasHlod) {
+            node.hlodFile = "hlod/node_" + std::to_string(node.depth) + "_" + std::to_string(node.gridX) + "_" + std::to_string(node.gridZ) + ".obj";
+        }
+    }
+
+    void Tiler::buildHlod(Node& node) {
+        // ûб仯ļȻʱ
+        auto cached = m_cachedHlods.find(node.hlodFile);
+        if (cached != m_cachedHlods.end() && cached->second.hash == node.hlodHash && fs::exists(m_outputDir / node.hlodFile)) {
+            node.geometricError = cached->second.error;
+            m_reusedHlods++;
+            return;
+        }
+
+        // ӽڵĽ + ӽڵHLOD (ӽڵһ㣬Ѿ)
+        Geometry input;
+        float maxChildError = 0.0f;
+        for (size_t child : node.children) {
+            const Node& childNode = m_nodes[child];
+            for (size_t index : childNode.buildings) {
+                loadWorldGeometry(m_buildings[index].path, input, m_origin);
+            }
+            if (childNode.hasHlod) {
+                // ӽڵHLODļѾȥԭ
+                loadWorldGeometry((m_outputDir / childNode.hlodFile).string(), input, glm::dvec3(0.0));
+                maxChildError = std::max(maxChildError, childNode.geometricError);
+            }
+        }
+
+        glm::vec3 extent = node.maxBounds - node.minBounds;
+        float cellSize = std::max({ extent.x, extent.y, extent.z, 1e-3f }) / HLOD_GRID;
+        Geometry output;
+        simplify(input, node.minBounds, cellSize, output);
+        writeObj((m_outputDir / node.hlodFile).string(), output);
+
+        // ӶԽߣ㼶ϵ
+        node.geometricError = cellSize * std::sqrt(3.0f) + maxChildError;
+        m_builtHlods++;
+    }
+
+    void Tiler::buildHlods() {
+        int maxDepth = 0;
+        for (const Node& node : m_nodes) {
+            maxDepth = std::max(maxDepth, node.depth);
+        }
+        // ԵɣͬһĽڵ㻥
+        for (int depth = maxDepth; depth >= 0; --depth) {
+            std::vector<size_t> level;
+            for (size_t i = 0; i < m_nodes.size(); ++i) {
+                if (m_nodes[i].depth == depth && m_nodes[i].hasHlod) {
+                    level.push_back(i);
+                }
+            }
+            JobSystem::getInstance()->parallelFor(0, level.size(), [&](size_t begin, size_t end) {
+                for (size_t i = begin; i < end; ++i) {
+                    buildHlod(m_nodes[level[i]]);
+                }
+            }, 1);
+        }
+    }
+
+    bool Tiler::writeTileset() const {
+        using namespace tileset;
+
+        // ±ţʹÿڵӽڵ
+        std::vector<size_t> order{ 0 };
+        for (size_t i = 0; i < order.size(); ++i) {
+            for (size_t child : m_nodes[order[i]].children) {
+                order.push_back(child);
+            }
+        }
+        std::vector<uint32_t> newIndex(m_nodes.size());
+        for (size_t i = 0; i < order.size(); ++i) {
+            newIndex[order[i]] = static_cast<uint32_t>(i);
+        }
+
+        std::vector<TileNode> nodes(order.size());
+        std::vector<TileContent> contents;
+        std::string strings;
+        auto addContent = [&](const std::string& path) {
+            contents.push_back({ static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(path.size()) });
+            strings += path;
+            return static_cast<uint32_t>(contents.size() - 1);
+        };
+
+        for (size_t i = 0; i < order.size(); ++i) {
+            const Node& node = m_nodes[order[i]];
+            TileNode& out = nodes[i];
+            for (int axis = 0; axis < 3; ++axis) {
+                out.minBounds[axis] = node.minBounds[axis];
+                out.maxBounds[axis] = node.maxBounds[axis];
+            }
+            out.geometricError = node.geometricError;
+            out.childCount = static_cast<uint32_t>(node.children.size());
+            out.firstChild = node.children.empty() ? 0 : newIndex[node.children.front()];
+            out.firstContent = static_cast<uint32_t>(contents.size());
+            out.contentCount = static_cast<uint32_t>(node.buildings.size());
+            for (size_t index : node.buildings) {
+                addContent(fs::path(m_buildings[index].path).lexically_relative(fs::absolute(m_outputDir).lexically_normal()).generic_string());
+            }
+            out.hlodContent = node.hasHlod ? addContent(node.hlodFile) : NO_INDEX;
+        }
+        // ӽڵ㰴ȱźһ
+        for (size_t i = 0; i < order.size(); ++i) {
+            const Node& node = m_nodes[order[i]];
+            for (size_t c = 0; c < node.children.size(); ++c) {
+                if (newIndex[node.children[c]] != nodes[i].firstChild + c) {
+                    std::cerr << "ERROR: Internal error, tile children are not contiguous." << std::endl;
+                    return false;
+                }
+            }
+        }
+
+        TilesetHeader header = {};
+        header.magic = TILESET_MAGIC;
+        header.version = TILESET_VERSION;
+        header.nodeCount = static_cast<uint32_t>(nodes.size());
+        header.contentCount = static_cast<uint32_t>(contents.size());
+        header.stringsSize = strings.size();
+        for (int axis = 0; axis < 3; ++axis) {
+            header.origin[axis] = m_origin[axis];
+        }
+
+        std::ofstream file(m_outputDir / "city.tileset", std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(nodes.data()), static_cast<std::streamsize>(sizeof(TileNode) * nodes.size()));
+        file.write(reinterpret_cast<const char*>(contents.data()), static_cast<std::streamsize>(sizeof(TileContent) * contents.size()));
+        file.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+        if (!file) {
+            std::cerr << "ERROR: Could not write tileset: " << (m_outputDir / "city.tileset") << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    bool Tiler::run() {
+        std::error_code error;
+        fs::create_directories(m_outputDir / "hlod", error);
+        if (error) {
+            std::cerr << "ERROR: Could not create output directory: " << m_outputDir << std::endl;
+            return false;
+        }
+
+        loadCache();
+        scanBuildings();
+        if (m_buildings.empty()) {
+            std::cerr << "ERROR: No buildings found in " << m_inputDir << std::endl;
+            return false;
+        }
+        buildTree();
+        buildHlods();
+        if (!writeTileset()) {
+            return false;
+        }
+        saveCache();
+
+        std::cout << "Tiled " << m_buildings.size() << " buildings into " << m_nodes.size() << " nodes ("
+            << m_parsedBuildings.load() << " buildings parsed, " << m_builtHlods.load() << " HLODs built, "
+            << m_reusedHlods.load() << " reused)." << std::endl;
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: tiler <buildingDir> <outputDir> [--leaf-size N] [--max-depth N]" << std::endl;
+        return 1;
+    }
+    size_t leafSize = 16;
+    int maxDepth = 8;
+    for (int i = 3; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--leaf-size") == 0) {
+            leafSize = static_cast<size_t>(std::max(1, std::atoi(argv[i + 1])));
+        }
+        else if (std::strcmp(argv[i], "--max-depth") == 0) {
+            maxDepth = std::max(0, std::atoi(argv[i + 1]));
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    Tiler tiler(argv[1], argv[2], leafSize, maxDepth);
+    bool ok = tiler.run();
+    JobSystem::getInstance()->shutdown();
+    std::cout << "Done in " << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << " s." << std::endl;
+    return ok ? 0 : 1;
+}